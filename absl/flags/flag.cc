@@ -41,6 +41,13 @@ ABSL_FLAGS_INTERNAL_FOR_EACH_LOCK_FREE(ABSL_FLAGS_ATOMIC_GET)
 
 #undef ABSL_FLAGS_ATOMIC_GET
 
+void FlagSubscription::Unsubscribe() {
+  if (watcher_) {
+    watcher_->Cancel();
+    watcher_.reset();
+  }
+}
+
 // This global nutex protects on-demand construction of flag objects in MSVC
 // builds.
 #if defined(_MSC_VER)
@@ -29,6 +29,10 @@
 #ifndef ABSL_FLAGS_FLAG_H_
 #define ABSL_FLAGS_FLAG_H_
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+
 #include "absl/base/attributes.h"
 #include "absl/base/casts.h"
 #include "absl/flags/config.h"
@@ -123,6 +127,7 @@ class Flag {
   bool IsSpecifiedOnCommandLine() const {
     return GetImpl()->IsSpecifiedOnCommandLine();
   }
+  int64_t Version() const { return GetImpl()->Version(); }
   absl::string_view Typename() const { return GetImpl()->Typename(); }
   std::string Filename() const { return GetImpl()->Filename(); }
   std::string DefaultValue() const { return GetImpl()->DefaultValue(); }
@@ -141,6 +146,11 @@ class Flag {
     GetImpl()->SetCallback(mutation_callback);
   }
   void InvokeCallback() { GetImpl()->InvokeCallback(); }
+  std::shared_ptr<flags_internal::FlagWatcher> Watch(
+      flags_internal::FlagUpdateExecutor executor,
+      std::function<void(const T&)> callback) const {
+    return GetImpl()->Watch(std::move(executor), std::move(callback));
+  }
 
  private:
   const char* name_;
@@ -209,6 +219,90 @@ void SetFlag(absl::Flag<T>* flag, const V& v) {
   flag->Set(value);
 }
 
+// GetFlagVersion()
+//
+// Returns the version of the value of an `absl::Flag`, which increases every
+// time the value changes. Reading the version costs a single atomic load, so
+// code deriving expensive state from a flag's value (e.g. a compiled regular
+// expression) can check it on every use and rebuild the state only when the
+// flag changes. Read the version before the value, so that a concurrent change
+// is never missed:
+//
+//   int64_t version = absl::GetFlagVersion(FLAGS_pattern);
+//   if (version != cached_version) {
+//     cached_matcher = Matcher(absl::GetFlag(FLAGS_pattern));
+//     cached_version = version;
+//   }
+template <typename T>
+int64_t GetFlagVersion(const absl::Flag<T>& flag) {
+  return flag.Version();
+}
+
+// FlagUpdateExecutor
+//
+// Runs the task it is passed, possibly asynchronously, e.g. by posting it to a
+// thread pool. See `absl::WatchFlag()`.
+using FlagUpdateExecutor = flags_internal::FlagUpdateExecutor;
+
+// FlagSubscription
+//
+// A handle to the subscription created by `absl::WatchFlag()`. The
+// subscription is cancelled when the handle is destroyed.
+class FlagSubscription {
+ public:
+  FlagSubscription() = default;
+  explicit FlagSubscription(
+      std::shared_ptr<flags_internal::FlagWatcher> watcher)
+      : watcher_(std::move(watcher)) {}
+
+  FlagSubscription(FlagSubscription&&) = default;
+  FlagSubscription& operator=(FlagSubscription&& other) {
+    if (this != &other) {
+      Unsubscribe();
+      watcher_ = std::move(other.watcher_);
+    }
+    return *this;
+  }
+
+  ~FlagSubscription() { Unsubscribe(); }
+
+  // Cancels the subscription. No new deliveries start after this call, and a
+  // delivery in progress completes before it returns, unless it is called from
+  // the callback itself.
+  void Unsubscribe();
+
+ private:
+  std::shared_ptr<flags_internal::FlagWatcher> watcher_;
+};
+
+// WatchFlag()
+//
+// Subscribes `callback`, a callable accepting `const T&`, to the updates of an
+// `absl::Flag<T>`. The callback is invoked with the flag's value via `executor`
+// once upon subscription, and then after every change of the value. Changes
+// made while a delivery is pending are merged into it, deliveries for a
+// subscription never run concurrently, and each delivery observes the latest
+// value at the time it runs. Unlike `OnUpdate()` callbacks, the callback does
+// not delay the code setting the flag, unless the executor runs it inline.
+//
+// The executor is invoked while the flag's update callbacks are serialized, so
+// if it runs the task inline the callback must not set the flag.
+//
+// Example:
+//
+//   absl::FlagSubscription subscription = absl::WatchFlag(
+//       FLAGS_pattern, [&pool](std::function<void()> task) {
+//         pool.Schedule(std::move(task));
+//       },
+//       [](const std::string& pattern) { RebuildMatcher(pattern); });
+template <typename T, typename Callback>
+ABSL_MUST_USE_RESULT FlagSubscription WatchFlag(const absl::Flag<T>& flag,
+                                                FlagUpdateExecutor executor,
+                                                Callback callback) {
+  return FlagSubscription(flag.Watch(
+      std::move(executor), std::function<void(const T&)>(std::move(callback))));
+}
+
 }  // namespace absl
 
 
@@ -0,0 +1,258 @@
+//
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/flags/flag.h"
+#include "absl/flags/internal/flag.h"
+#include "absl/flags/internal/parse.h"
+#include "absl/flags/internal/registry.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+namespace flags = absl::flags_internal;
+
+// Large binaries link tens of thousands of flags.
+constexpr int kNumFlags = 20000;
+
+std::string BenchmarkFlagHelp() { return "benchmark flag"; }
+
+template <typename T>
+void* BenchmarkFlagInitialValue() {
+  return new T();
+}
+
+// Flags and their names are never unregistered, so they must outlive the
+// benchmarks.
+const char* MakeFlagName(absl::string_view prefix, int i) {
+  static auto* names = new std::deque<std::string>;
+  names->push_back(absl::StrCat(prefix, "_", i));
+  return names->back().c_str();
+}
+
+template <typename T = int>
+flags::Flag<T>* NewFlag(const char* name) {
+  return new flags::Flag<T>(name, &BenchmarkFlagHelp, __FILE__,
+                            &flags::FlagMarshallingOps<T>,
+                            &BenchmarkFlagInitialValue<T>);
+}
+
+// Registers kNumFlags flags named "<prefix>_<i>" and returns their names.
+template <typename T = int>
+const std::vector<const char*>& RegisterFlags(absl::string_view prefix) {
+  auto* names = new std::vector<const char*>;
+  for (int i = 0; i < kNumFlags; ++i) {
+    names->push_back(MakeFlagName(prefix, i));
+    flags::RegisterCommandLineFlag(NewFlag<T>(names->back()));
+  }
+  return *names;
+}
+
+std::vector<char*> ParseArgs(std::vector<std::string>* args,
+                             flags::ValueParsingAction value_parsing_act) {
+  std::vector<char*> argv;
+  for (auto& arg : *args) {
+    argv.push_back(&arg[0]);
+  }
+  return flags::ParseCommandLineImpl(
+      argv.size(), argv.data(), flags::ArgvListAction::kRemoveParsedArgs,
+      flags::UsageFlagsAction::kIgnoreUsage,
+      flags::OnUndefinedFlag::kAbortIfUndefined, value_parsing_act);
+}
+
+void BM_RegisterFlags(benchmark::State& state) {
+  int batch = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<flags::Flag<int>*> new_flags;
+    const std::string prefix = absl::StrCat("register_bm_", batch++);
+    for (int i = 0; i < state.range(0); ++i) {
+      new_flags.push_back(NewFlag(MakeFlagName(prefix, i)));
+    }
+    state.ResumeTiming();
+
+    for (auto* flag : new_flags) {
+      flags::RegisterCommandLineFlag(flag);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Every iteration permanently grows the global registry, so keep the number
+// of iterations bounded.
+BENCHMARK(BM_RegisterFlags)->Arg(kNumFlags)->Iterations(8);
+
+void BM_FindCommandLineFlag(benchmark::State& state) {
+  static const auto& names = RegisterFlags("find_bm");
+  if (state.range(0)) flags::FinalizeRegistry();
+
+  for (auto _ : state) {
+    for (const char* name : names) {
+      benchmark::DoNotOptimize(flags::FindCommandLineFlag(name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+// Arg is whether the registry is finalized. Finalization is irreversible, so
+// the unfinalized variant has to run first.
+BENCHMARK(BM_FindCommandLineFlag)->Arg(0)->Arg(1);
+
+void BM_ParseCommandLine(benchmark::State& state) {
+  static const auto& names = RegisterFlags("parse_bm");
+
+  std::vector<std::string> args = {"bm_binary"};
+  for (int i = 0; i < kNumFlags; ++i) {
+    args.push_back(absl::StrCat("--", names[i], "=", i));
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ParseArgs(&args, flags::ValueParsingAction::kParseEagerly));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumFlags);
+}
+BENCHMARK(BM_ParseCommandLine);
+
+void BM_FlagSaver(benchmark::State& state) {
+  static const auto& names = RegisterFlags("saver_bm");
+
+  std::vector<flags::CommandLineFlag*> modified_flags;
+  for (int i = 0; i < state.range(0); ++i) {
+    modified_flags.push_back(flags::FindCommandLineFlag(names[i]));
+  }
+
+  std::string err;
+  int value = 0;
+  for (auto _ : state) {
+    flags::FlagSaver saver;
+    const std::string new_value = absl::StrCat(++value);
+    for (auto* flag : modified_flags) {
+      flag->SetFromString(new_value, flags::SET_FLAGS_VALUE,
+                          flags::kProgrammaticChange, &err);
+    }
+  }
+}
+// Arg is the number of flags modified while the saver is alive.
+BENCHMARK(BM_FlagSaver)->Arg(0)->Arg(1)->Arg(100);
+
+std::string FlagfileName(absl::string_view prefix) {
+  const char* tmp_dir = std::getenv("TEST_TMPDIR");
+  return absl::StrCat(tmp_dir ? tmp_dir : "/tmp", "/", prefix, ".flagfile");
+}
+
+// Writes a flagfile setting each of the named flags to a list of strings and
+// returns the name of the file.
+std::string WriteFlagfile(absl::string_view prefix,
+                          const std::vector<const char*>& names) {
+  std::string file_name = FlagfileName(prefix);
+
+  std::ofstream flagfile(file_name);
+  for (const char* name : names) {
+    flagfile << "--" << name << "=alpha,beta,gamma,delta,epsilon\n";
+  }
+  return file_name;
+}
+
+template <flags::ValueParsingAction value_parsing_act>
+void BM_ParseLargeFlagfile(benchmark::State& state) {
+  // Each instantiation has its own set of flags, so that flags accessed by
+  // one never affect the other.
+  static const auto& names =
+      RegisterFlags<std::vector<std::string>>(absl::StrCat(
+          "flagfile_bm_", static_cast<int>(value_parsing_act)));
+  static const std::string* flagfile = new std::string(WriteFlagfile(
+      absl::StrCat("flag_benchmark_", static_cast<int>(value_parsing_act)),
+      names));
+
+  std::vector<std::string> args = {"bm_binary",
+                                   absl::StrCat("--flagfile=", *flagfile)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseArgs(&args, value_parsing_act));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumFlags);
+}
+BENCHMARK_TEMPLATE(BM_ParseLargeFlagfile,
+                   flags::ValueParsingAction::kParseEagerly);
+BENCHMARK_TEMPLATE(BM_ParseLargeFlagfile,
+                   flags::ValueParsingAction::kDeferParsing);
+
+// Generated flagfiles are dominated by comments and blank lines, which makes
+// the cost of reading the files stand out. The flags are split between
+// state.range(0) files included from a top level flagfile.
+void BM_ReadGeneratedFlagfiles(benchmark::State& state) {
+  static const auto& names = RegisterFlags("read_bm");
+
+  const int num_files = state.range(0);
+  const std::string top_file_name =
+      FlagfileName(absl::StrCat("flag_benchmark_read_", num_files));
+  int64_t total_size = 0;
+  {
+    std::ofstream top_file(top_file_name);
+    top_file << "# Generated flagfile, do not edit.\n\n";
+    for (int f = 0; f < num_files; ++f) {
+      const std::string file_name = FlagfileName(
+          absl::StrCat("flag_benchmark_read_", num_files, "_", f));
+      top_file << "--flagfile=" << file_name << "\n";
+
+      std::ofstream flagfile(file_name);
+      for (int i = f; i < kNumFlags; i += num_files) {
+        flagfile << "# " << names[i] << ": generated from the target config\n"
+                 << "#   owner: benchmark, last updated: never\n"
+                 << "\n"
+                 << "  --" << names[i] << "=" << i << "\n";
+      }
+      total_size += flagfile.tellp();
+    }
+    total_size += top_file.tellp();
+  }
+
+  std::vector<std::string> args = {"bm_binary",
+                                   absl::StrCat("--flagfile=", top_file_name)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ParseArgs(&args, flags::ValueParsingAction::kParseEagerly));
+  }
+  state.SetBytesProcessed(state.iterations() * total_size);
+}
+BENCHMARK(BM_ReadGeneratedFlagfiles)->Arg(1)->Arg(16);
+
+}  // namespace
+
+ABSL_FLAG(std::string, bm_string_flag, "some reasonably long default value",
+          "benchmark flag");
+
+namespace {
+
+void BM_GetStringFlag(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::GetFlag(FLAGS_bm_string_flag));
+  }
+}
+BENCHMARK(BM_GetStringFlag);
+
+void BM_GetStringFlagVersion(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::GetFlagVersion(FLAGS_bm_string_flag));
+  }
+}
+BENCHMARK(BM_GetStringFlagVersion);
+
+}  // namespace
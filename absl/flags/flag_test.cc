@@ -16,7 +16,10 @@
 #include "absl/flags/flag.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/flags/usage_config.h"
@@ -334,6 +337,71 @@ TEST_F(FlagTest, CallbackInvocation) {
 
 // --------------------------------------------------------------------
 
+}  // namespace
+
+ABSL_FLAG(int, test_flag_versioned, 0, "");
+ABSL_FLAG(int, test_flag_watched, 10, "");
+
+namespace {
+
+TEST_F(FlagTest, TestFlagVersion) {
+  EXPECT_EQ(absl::GetFlag(FLAGS_test_flag_versioned), 0);
+  int64_t version = absl::GetFlagVersion(FLAGS_test_flag_versioned);
+
+  absl::SetFlag(&FLAGS_test_flag_versioned, 1);
+  EXPECT_GT(absl::GetFlagVersion(FLAGS_test_flag_versioned), version);
+
+  version = absl::GetFlagVersion(FLAGS_test_flag_versioned);
+  EXPECT_EQ(absl::GetFlag(FLAGS_test_flag_versioned), 1);
+  EXPECT_EQ(absl::GetFlagVersion(FLAGS_test_flag_versioned), version);
+}
+
+TEST_F(FlagTest, TestWatchFlagInlineExecutor) {
+  std::vector<int> values;
+  {
+    absl::FlagSubscription subscription = absl::WatchFlag(
+        FLAGS_test_flag_watched,
+        [](std::function<void()> task) { task(); },
+        [&values](const int& value) { values.push_back(value); });
+    EXPECT_EQ(values, std::vector<int>({10}));
+
+    absl::SetFlag(&FLAGS_test_flag_watched, 11);
+    absl::SetFlag(&FLAGS_test_flag_watched, 12);
+  }
+  absl::SetFlag(&FLAGS_test_flag_watched, 13);
+
+  EXPECT_EQ(values, std::vector<int>({10, 11, 12}));
+}
+
+TEST_F(FlagTest, TestWatchFlagQueuedExecutor) {
+  std::vector<std::function<void()>> tasks;
+  std::vector<int> values;
+  absl::FlagSubscription subscription = absl::WatchFlag(
+      FLAGS_test_flag_watched,
+      [&tasks](std::function<void()> task) {
+        tasks.push_back(std::move(task));
+      },
+      [&values](const int& value) { values.push_back(value); });
+  ASSERT_EQ(tasks.size(), 1);
+
+  // Updates made while a delivery is pending are merged into it.
+  absl::SetFlag(&FLAGS_test_flag_watched, 21);
+  absl::SetFlag(&FLAGS_test_flag_watched, 22);
+  ASSERT_EQ(tasks.size(), 1);
+  tasks[0]();
+  tasks.clear();
+  EXPECT_EQ(values, std::vector<int>({22}));
+
+  // Pending deliveries are dropped once the subscription is cancelled.
+  absl::SetFlag(&FLAGS_test_flag_watched, 23);
+  ASSERT_EQ(tasks.size(), 1);
+  subscription.Unsubscribe();
+  tasks[0]();
+  EXPECT_EQ(values, std::vector<int>({22}));
+}
+
+// --------------------------------------------------------------------
+
 struct CustomUDT {
   CustomUDT() : a(1), b(1) {}
   CustomUDT(int a_, int b_) : a(a_), b(b_) {}
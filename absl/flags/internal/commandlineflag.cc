@@ -15,7 +15,10 @@
 
 #include "absl/flags/internal/commandlineflag.h"
 
+#include <algorithm>
 #include <cassert>
+#include <string>
+#include <vector>
 
 #include "absl/base/internal/raw_logging.h"
 #include "absl/base/optimization.h"
@@ -49,22 +52,49 @@ bool ShouldValidateFlagValue(const CommandLineFlag& flag) {
   return true;
 }
 
-}  // namespace
+// Values of the lock free types are cheap to construct and parse, so these are
+// never deferred.
+bool ShouldDeferFlagValue(const CommandLineFlag& flag) {
+#define DONT_DEFER(T) \
+  if (flag.IsOfType<T>()) return false;
+  ABSL_FLAGS_INTERNAL_FOR_EACH_LOCK_FREE(DONT_DEFER)
+#undef DONT_DEFER
 
-absl::Mutex* InitFlag(CommandLineFlag* flag) {
-  ABSL_CONST_INIT static absl::Mutex init_lock(absl::kConstInit);
-  absl::Mutex* mu;
+  return true;
+}
 
-  {
-    absl::MutexLock lock(&init_lock);
+ABSL_CONST_INIT absl::Mutex init_lock(absl::kConstInit);
 
-    if (flag->locks_ == nullptr) {  // Must initialize Mutexes for this flag.
-      flag->locks_ = new flags_internal::CommandLineFlagLocks;
-    }
+// Flags with the values set by SetFromStringDeferred().
+ABSL_CONST_INIT absl::Mutex deferred_flags_guard(absl::kConstInit);
+ABSL_CONST_INIT std::vector<CommandLineFlag*>* deferred_flags
+    ABSL_GUARDED_BY(deferred_flags_guard) = nullptr;
 
-    mu = &flag->locks_->primary_mu;
+// Active FlagSnapshots, in the order of creation.
+ABSL_CONST_INIT absl::Mutex snapshots_guard(absl::kConstInit);
+ABSL_CONST_INIT std::vector<FlagSnapshot*>* active_snapshots
+    ABSL_GUARDED_BY(snapshots_guard) = nullptr;
+ABSL_CONST_INIT int64_t last_snapshot_epoch ABSL_GUARDED_BY(snapshots_guard) =
+    0;
+// Epoch of the latest active FlagSnapshot or 0 if there are none. Checked
+// without the lock on every flag modification.
+ABSL_CONST_INIT std::atomic<int64_t> latest_snapshot_epoch(0);
+
+}  // namespace
+
+absl::Mutex* InitFlagLocks(CommandLineFlag* flag) {
+  absl::MutexLock lock(&init_lock);
+
+  if (flag->locks_ == nullptr) {  // Must initialize Mutexes for this flag.
+    flag->locks_ = new flags_internal::CommandLineFlagLocks;
   }
 
+  return &flag->locks_->primary_mu;
+}
+
+absl::Mutex* InitFlag(CommandLineFlag* flag) {
+  absl::Mutex* mu = InitFlagLocks(flag);
+
   {
     absl::MutexLock lock(mu);
 
@@ -72,6 +102,15 @@ absl::Mutex* InitFlag(CommandLineFlag* flag) {
       // Need to initialize def and cur fields.
       flag->def_ = (*flag->make_init_value_)();
       flag->cur_ = Clone(flag->op_, flag->def_);
+      if (flag->pending_value_ != nullptr) {
+        // Parse the value set by SetFromStringDeferred().
+        std::string err;
+        if (!TryParseLocked(flag, flag->cur_, *flag->pending_value_, &err)) {
+          ABSL_INTERNAL_LOG(FATAL, err);
+        }
+        delete flag->pending_value_;
+        flag->pending_value_ = nullptr;
+      }
       UpdateCopy(flag);
       flag->inited_.store(true, std::memory_order_release);
       flag->InvokeCallback();
@@ -205,6 +244,7 @@ bool CommandLineFlag::SetFromString(absl::string_view value,
   if (IsRetired()) return false;
 
   absl::MutexLock l(InitFlagIfNecessary());
+  SaveStateToSnapshots();
 
   // Direct-access flags can be modified without going through the
   // flag API. Detect such changes and update the flag->modified_ bit.
@@ -267,6 +307,39 @@ bool CommandLineFlag::SetFromString(absl::string_view value,
   return true;
 }
 
+bool CommandLineFlag::SetFromStringDeferred(absl::string_view value,
+                                            std::string* err) {
+  if (IsRetired()) return false;
+
+  // A deferred value is not a modification a FlagSnapshot could save the
+  // previous state for, so values are parsed eagerly while one is active.
+  if (!inited_.load(std::memory_order_acquire) && ShouldDeferFlagValue(*this) &&
+      latest_snapshot_epoch.load(std::memory_order_acquire) == 0) {
+    absl::MutexLock l(InitFlagLocks(this));
+
+    // Recheck under the lock, the flag could have been accessed concurrently.
+    if (def_ == nullptr) {
+      if (pending_value_ == nullptr) {
+        pending_value_ = new std::string(value);
+
+        absl::MutexLock deferred_lock(&deferred_flags_guard);
+        if (deferred_flags == nullptr) {
+          deferred_flags = new std::vector<CommandLineFlag*>;
+        }
+        deferred_flags->push_back(this);
+      } else {
+        pending_value_->assign(value.data(), value.size());
+      }
+
+      modified_ = true;
+      on_command_line_ = true;
+      return true;
+    }
+  }
+
+  return SetFromString(value, SET_FLAGS_VALUE, kCommandLine, err);
+}
+
 void CommandLineFlag::CheckDefaultValueParsingRoundtrip() const {
   std::string v = DefaultValue();
 
@@ -346,6 +419,7 @@ void CommandLineFlag::Write(const void* src,
     Delete(op_, obj);
   }
 
+  SaveStateToSnapshots();
   modified_ = true;
   counter_++;
   Copy(op_, src, cur_);
@@ -354,6 +428,76 @@ void CommandLineFlag::Write(const void* src,
   InvokeCallback();
 }
 
+void CommandLineFlag::SaveStateToSnapshots() {
+  // Snapshots taken before snapshot_epoch_ hold the state already, and the
+  // later ones were taken after the last modification.
+  const int64_t latest_epoch =
+      latest_snapshot_epoch.load(std::memory_order_acquire);
+  if (snapshot_epoch_ >= latest_epoch) return;
+
+  absl::MutexLock l(&snapshots_guard);
+  if (active_snapshots == nullptr || active_snapshots->empty()) return;
+
+  for (FlagSnapshot* snapshot : *active_snapshots) {
+    if (snapshot->epoch_ <= snapshot_epoch_) continue;
+    if (auto flag_state = SaveState()) {
+      snapshot->saved_states_.push_back(std::move(flag_state));
+    }
+  }
+  snapshot_epoch_ = active_snapshots->back()->epoch_;
+}
+
+FlagSnapshot::FlagSnapshot() {
+  absl::MutexLock l(&snapshots_guard);
+  if (active_snapshots == nullptr) {
+    active_snapshots = new std::vector<FlagSnapshot*>;
+  }
+
+  epoch_ = ++last_snapshot_epoch;
+  active_snapshots->push_back(this);
+  latest_snapshot_epoch.store(epoch_, std::memory_order_release);
+}
+
+FlagSnapshot::~FlagSnapshot() { Deactivate(); }
+
+void FlagSnapshot::Deactivate() {
+  absl::MutexLock l(&snapshots_guard);
+  auto it =
+      std::find(active_snapshots->begin(), active_snapshots->end(), this);
+  if (it == active_snapshots->end()) return;
+
+  active_snapshots->erase(it);
+  latest_snapshot_epoch.store(
+      active_snapshots->empty() ? 0 : active_snapshots->back()->epoch_,
+      std::memory_order_release);
+}
+
+void FlagSnapshot::Restore() {
+  // Restoring modifies the flags, which must not save their states into this
+  // snapshot anymore.
+  Deactivate();
+
+  for (const auto& flag_state : saved_states_) {
+    flag_state->Restore();
+  }
+  saved_states_.clear();
+}
+
+void ParseDeferredFlagValues() {
+  std::vector<CommandLineFlag*> flags;
+  {
+    absl::MutexLock l(&deferred_flags_guard);
+    if (deferred_flags == nullptr) return;
+    flags.swap(*deferred_flags);
+  }
+
+  // Flags which were already accessed are initialized, so this is a no-op for
+  // them.
+  for (CommandLineFlag* flag : flags) {
+    flag->InitFlagIfNecessary();
+  }
+}
+
 std::string HelpText::GetHelpText() const {
   if (help_function_) return help_function_();
   if (help_message_) return help_message_;
@@ -361,8 +505,8 @@ std::string HelpText::GetHelpText() const {
   return {};
 }
 
-// Update any copy of the flag value that is stored in an atomic word.
-// In addition if flag has a mutation callback this function invokes it.
+// Update any copy of the flag value that is stored in an atomic word and the
+// version of the value.
 void UpdateCopy(CommandLineFlag* flag) {
 #define STORE_ATOMIC(T)           \
   else if (flag->IsOfType<T>()) { \
@@ -373,6 +517,10 @@ void UpdateCopy(CommandLineFlag* flag) {
   }
   ABSL_FLAGS_INTERNAL_FOR_EACH_LOCK_FREE(STORE_ATOMIC)
 #undef STORE_ATOMIC
+
+  // Published last, so that readers which observe the new version also observe
+  // the new value.
+  flag->version_.fetch_add(1, std::memory_order_release);
 }
 
 // Return true iff flag value was changed via direct-access.
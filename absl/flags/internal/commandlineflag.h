@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "absl/base/macros.h"
 #include "absl/flags/marshalling.h"
@@ -197,6 +198,36 @@ class FlagStateInterface {
   virtual void Restore() const = 0;
 };
 
+// Copy-on-write snapshot of the states of all flags. While the snapshot is
+// active, the state of a flag is saved into it right before the first
+// modification of the flag. Taking a snapshot is therefore O(1) and restoring
+// it is O(number of modified flags), regardless of the number of flags in the
+// program. Snapshots may be nested. This class is thread-safe.
+class FlagSnapshot {
+ public:
+  // Activates the snapshot.
+  FlagSnapshot();
+  // Deactivates the snapshot without restoring it.
+  ~FlagSnapshot();
+
+  FlagSnapshot(const FlagSnapshot&) = delete;
+  void operator=(const FlagSnapshot&) = delete;
+
+  // Deactivates the snapshot and restores the flags modified while it was
+  // active to their saved states.
+  void Restore();
+
+ private:
+  friend class CommandLineFlag;
+
+  void Deactivate();
+
+  // Snapshots are numbered in the order of creation.
+  int64_t epoch_;
+  // Saved states of the modified flags, in the order of modification.
+  std::vector<std::unique_ptr<FlagStateInterface>> saved_states_;
+};
+
 // Holds all information for a flag.
 class CommandLineFlag {
  public:
@@ -217,7 +248,10 @@ class CommandLineFlag {
         on_command_line_(false),
         def_(def),
         cur_(cur),
+        pending_value_(nullptr),
         counter_(0),
+        version_(0),
+        snapshot_epoch_(0),
         locks_(nullptr) {}
 
   // Virtual destructor
@@ -239,6 +273,10 @@ class CommandLineFlag {
   bool IsModified() const;
   void SetModified(bool is_modified);
   bool IsSpecifiedOnCommandLine() const;
+  // Returns the version of the flag's value, which increases every time the
+  // value changes. The version has to be read before the value, so that a
+  // concurrent change is never missed.
+  int64_t Version() const { return version_.load(std::memory_order_acquire); }
 
   absl::string_view Typename() const;
   std::string Filename() const;
@@ -275,7 +313,8 @@ class CommandLineFlag {
   }
 
   // Interface to save flag to some persistent state. Returns current flag state
-  // or nullptr if flag does not support saving and restoring a state.
+  // or nullptr if flag does not support saving and restoring a state. Requires
+  // the primary lock to be held.
   virtual std::unique_ptr<FlagStateInterface> SaveState() = 0;
 
   // Interfaces to overate on callbacks.
@@ -293,6 +332,15 @@ class CommandLineFlag {
                      flags_internal::FlagSettingMode set_mode,
                      flags_internal::ValueSource source, std::string* error);
 
+  // Same as SetFromString(value, SET_FLAGS_VALUE, kCommandLine, error), except
+  // that if the flag was never accessed before, is not of one of the lock free
+  // types and no FlagSnapshot is active, neither the flag's default value is
+  // constructed nor `value` is parsed at this point. Instead `value` is stored
+  // and parsed once the flag is first accessed, or by
+  // ParseDeferredFlagValues(). Failure to parse or validate the deferred value
+  // at that point is fatal.
+  bool SetFromStringDeferred(absl::string_view value, std::string* error);
+
   void CheckDefaultValueParsingRoundtrip() const;
 
   // Constant configuration for a particular flag.
@@ -316,7 +364,14 @@ class CommandLineFlag {
   bool on_command_line_;  // Specified on command line.
   void* def_;             // Lazily initialized pointer to default value
   void* cur_;             // Lazily initialized pointer to current value
+  std::string* pending_value_;  // Unparsed value set by SetFromStringDeferred
   int64_t counter_;         // Mutation counter
+  // Version of the current value. Only increased under the primary lock, after
+  // the value is updated, but can be read without a lock.
+  std::atomic<int64_t> version_;
+  // Epoch of the latest FlagSnapshot the state was saved into since the last
+  // modification.
+  int64_t snapshot_epoch_;
 
   // Lazily initialized mutexes for this flag value.  We cannot inline a
   // SpinLock or Mutex here because those have non-constexpr constructors and
@@ -334,30 +389,35 @@ class CommandLineFlag {
   // updates flag's value to *src (locked)
   void Write(const void* src, const flags_internal::FlagOpFn src_op);
 
+  // Saves the flag's state into the active FlagSnapshots which do not hold it
+  // yet. Must be called before every modification of the flag's value.
+  void SaveStateToSnapshots() ABSL_EXCLUSIVE_LOCKS_REQUIRED(locks_->primary_mu);
+
   friend class FlagRegistry;
   friend class FlagPtrMap;
-  friend class FlagSaverImpl;
   friend bool TryParseLocked(CommandLineFlag* flag, void* dst,
                              absl::string_view value, std::string* err);
   friend absl::Mutex* InitFlag(CommandLineFlag* flag);
+  friend absl::Mutex* InitFlagLocks(CommandLineFlag* flag);
+  friend void ParseDeferredFlagValues();
+  friend void UpdateCopy(CommandLineFlag* flag);
 };
 
-// Update any copy of the flag value that is stored in an atomic word.
-// In addition if flag has a mutation callback this function invokes it. While
-// callback is being invoked the primary flag's mutex is unlocked and it is
-// re-locked back after call to callback is completed. Callback invocation is
-// guarded by flag's secondary mutex instead which prevents concurrent callback
-// invocation. Note that it is possible for other thread to grab the primary
-// lock and update flag's value at any time during the callback invocation.
-// This is by design. Callback can get a value of the flag if necessary, but it
-// might be different from the value initiated the callback and it also can be
-// different by the time the callback invocation is completed.
-// Requires that *primary_lock be held in exclusive mode; it may be released
-// and reacquired by the implementation.
+// Update any copy of the flag value that is stored in an atomic word, then
+// bump the flag's version so that readers of GetFlagVersion() and the flag's
+// watchers see the change. The version is published last, so a reader that
+// observes the new version also observes the new value. This does not run the
+// mutation callback or notify watchers itself: callers follow it with
+// InvokeCallback(), which does both once the new value is visible.
+// Requires that *primary_lock be held in exclusive mode.
 void UpdateCopy(CommandLineFlag* flag);
 // Return true iff flag value was changed via direct-access.
 bool ChangedDirectly(CommandLineFlag* flag, const void* a, const void* b);
 
+// Parses the values of all the flags set by SetFromStringDeferred(), which were
+// not accessed yet. Terminates the program if any of these values is invalid.
+void ParseDeferredFlagValues();
+
 // This macro is the "source of truth" for the list of supported flag types we
 // expect to perform lock free operations on. Specifically it generates code,
 // a one argument macro operating on a type, supplied as a macro argument, for
@@ -35,6 +35,32 @@ namespace {
 
 namespace flags = absl::flags_internal;
 
+struct DeferredUDT {
+  int value;
+};
+
+bool AbslParseFlag(absl::string_view in, DeferredUDT* udt, std::string* err) {
+  if (in == "A" || in == "B") {
+    udt->value = in == "A" ? 1 : 2;
+    return true;
+  }
+
+  *err = "Use values A, B instead";
+  return false;
+}
+std::string AbslUnparseFlag(const DeferredUDT& udt) {
+  return udt.value == 1 ? "A" : "B";
+}
+
+int num_deferred_udt_inits = 0;
+
+void* MakeDeferredUDT() {
+  ++num_deferred_udt_inits;
+  return new DeferredUDT{0};
+}
+
+std::string DeferredUDTHelp() { return "deferred help"; }
+
 class CommandLineFlagTest : public testing::Test {
  protected:
   static void SetUpTestSuite() {
@@ -215,4 +241,102 @@ TEST_F(CommandLineFlagTest, TestSetFromStringIfDefault) {
   // EXPECT_EQ(err, "ERROR: int_flag is already set to 201");
 }
 
+// --------------------------------------------------------------------
+
+TEST_F(CommandLineFlagTest, TestLookupAfterRegistryFinalization) {
+  flags::FinalizeRegistry();
+  // Finalization is idempotent.
+  flags::FinalizeRegistry();
+
+  auto* flag_01 = flags::FindCommandLineFlag("int_flag");
+  ASSERT_TRUE(flag_01);
+  EXPECT_EQ(flag_01->Name(), "int_flag");
+
+  EXPECT_TRUE(flags::FindRetiredFlag("bool_retired_flag"));
+  EXPECT_FALSE(flags::FindRetiredFlag("int_flag"));
+  EXPECT_FALSE(flags::FindCommandLineFlag("int_fla"));
+  EXPECT_FALSE(flags::FindCommandLineFlag("int_flag_"));
+  EXPECT_FALSE(flags::FindCommandLineFlag(""));
+
+  // Flags registered after finalization are still accessible.
+  flags::RetiredFlag<int>("int_retired_after_finalization");
+  auto* flag_02 = flags::FindRetiredFlag("int_retired_after_finalization");
+  ASSERT_TRUE(flag_02);
+  EXPECT_TRUE(flag_02->IsOfType<int>());
+}
+
+// --------------------------------------------------------------------
+
+TEST_F(CommandLineFlagTest, TestNestedFlagSavers) {
+  absl::SetFlag(&FLAGS_int_flag, 1);
+  {
+    flags::FlagSaver outer_saver;
+    absl::SetFlag(&FLAGS_string_flag, "outer");
+    {
+      flags::FlagSaver inner_saver;
+      absl::SetFlag(&FLAGS_int_flag, 2);
+      absl::SetFlag(&FLAGS_int_flag, 3);
+      absl::SetFlag(&FLAGS_string_flag, "inner");
+    }
+    EXPECT_EQ(absl::GetFlag(FLAGS_int_flag), 1);
+    EXPECT_EQ(absl::GetFlag(FLAGS_string_flag), "outer");
+
+    absl::SetFlag(&FLAGS_int_flag, 4);
+  }
+  EXPECT_EQ(absl::GetFlag(FLAGS_int_flag), 1);
+  EXPECT_EQ(absl::GetFlag(FLAGS_string_flag), "dflt");
+  EXPECT_FALSE(flags::FindCommandLineFlag("string_flag")->IsModified());
+}
+
+TEST_F(CommandLineFlagTest, TestIgnoredFlagSaver) {
+  auto saver = absl::make_unique<flags::FlagSaver>();
+  absl::SetFlag(&FLAGS_int_flag, 5);
+  saver->Ignore();
+  absl::SetFlag(&FLAGS_string_flag, "ignored");
+  saver.reset();
+
+  EXPECT_EQ(absl::GetFlag(FLAGS_int_flag), 5);
+  EXPECT_EQ(absl::GetFlag(FLAGS_string_flag), "ignored");
+}
+
+// --------------------------------------------------------------------
+
+TEST(DeferredFlagValueTest, TestSetFromStringDeferred) {
+  static flags::Flag<DeferredUDT> flag(
+      "deferred_udt_flag", &DeferredUDTHelp, __FILE__,
+      &flags::FlagMarshallingOps<DeferredUDT>, &MakeDeferredUDT);
+  std::string err;
+
+  EXPECT_TRUE(flag.SetFromStringDeferred("A", &err));
+  EXPECT_TRUE(flag.SetFromStringDeferred("B", &err));
+  EXPECT_EQ(num_deferred_udt_inits, 0);
+
+  // The last value is parsed on the first access.
+  EXPECT_EQ(flag.Get().value, 2);
+  EXPECT_EQ(num_deferred_udt_inits, 1);
+  EXPECT_TRUE(flag.IsModified());
+  EXPECT_TRUE(flag.IsSpecifiedOnCommandLine());
+
+  // Once the flag is accessed, values are parsed eagerly.
+  EXPECT_FALSE(flag.SetFromStringDeferred("C", &err));
+  EXPECT_EQ(err,
+            "Illegal value 'C' specified for flag 'deferred_udt_flag'; "
+            "Use values A, B instead");
+  EXPECT_TRUE(flag.SetFromStringDeferred("A", &err));
+  EXPECT_EQ(flag.Get().value, 1);
+  EXPECT_EQ(num_deferred_udt_inits, 1);
+}
+
+TEST(DeferredFlagValueDeathTest, TestInvalidDeferredValue) {
+  static flags::Flag<DeferredUDT> flag(
+      "invalid_deferred_udt_flag", &DeferredUDTHelp, __FILE__,
+      &flags::FlagMarshallingOps<DeferredUDT>, &MakeDeferredUDT);
+  std::string err;
+
+  EXPECT_TRUE(flag.SetFromStringDeferred("C", &err));
+  EXPECT_DEATH(flags::ParseDeferredFlagValues(),
+               "Illegal value 'C' specified for flag "
+               "'invalid_deferred_udt_flag'");
+}
+
 }  // namespace
@@ -15,6 +15,8 @@
 
 #include "absl/flags/internal/flag.h"
 
+#include <algorithm>
+
 #include "absl/synchronization/mutex.h"
 
 namespace absl {
@@ -30,10 +32,12 @@ namespace flags_internal {
 // necessary, but it might be different from the value initiated the callback
 // and it also can be different by the time the callback invocation is
 // completed. Requires that *primary_lock be held in exclusive mode; it may be
-// released and reacquired by the implementation.
+// released and reacquired by the implementation. The subscribers in `watchers`
+// are notified the same way.
 void InvokeCallback(absl::Mutex* primary_mu, absl::Mutex* callback_mu,
-                    FlagCallback cb) ABSL_EXCLUSIVE_LOCKS_REQUIRED(primary_mu) {
-  if (!cb) return;
+                    FlagCallback cb, FlagWatchers* watchers)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(primary_mu) {
+  if (!cb && !watchers) return;
 
   // When executing the callback we need the primary flag's mutex to be
   // unlocked so that callback can retrieve the flag's value.
@@ -41,11 +45,74 @@ void InvokeCallback(absl::Mutex* primary_mu, absl::Mutex* callback_mu,
 
   {
     absl::MutexLock lock(callback_mu);
-    cb();
+    if (cb) cb();
+
+    if (watchers) {
+      // Drop the cancelled subscriptions while we are at it.
+      watchers->erase(
+          std::remove_if(watchers->begin(), watchers->end(),
+                         [](const std::shared_ptr<FlagWatcher>& watcher) {
+                           return watcher->IsCancelled();
+                         }),
+          watchers->end());
+      for (const auto& watcher : *watchers) {
+        watcher->Notify();
+      }
+    }
   }
 
   primary_mu->Lock();
 }
 
+void FlagWatcher::Notify() {
+  {
+    absl::MutexLock l(&mu_);
+    if (scheduled_ || cancelled_) return;
+    scheduled_ = true;
+  }
+
+  std::shared_ptr<FlagWatcher> self = shared_from_this();
+  executor_([self]() { self->Deliver(); });
+}
+
+namespace {
+
+// The subscriber whose callback is running on this thread, if any.
+thread_local const FlagWatcher* current_delivery = nullptr;
+
+}  // namespace
+
+void FlagWatcher::Deliver() {
+  absl::MutexLock delivery_lock(&delivery_mu_);
+  {
+    absl::MutexLock l(&mu_);
+    // Changes made from now on schedule another delivery.
+    scheduled_ = false;
+    if (cancelled_) return;
+  }
+
+  const FlagWatcher* outer_delivery = current_delivery;
+  current_delivery = this;
+  callback_();
+  current_delivery = outer_delivery;
+}
+
+void FlagWatcher::Cancel() {
+  {
+    absl::MutexLock l(&mu_);
+    cancelled_ = true;
+  }
+
+  // Wait for the delivery in progress, if any, unless we are called from it.
+  if (current_delivery != this) {
+    absl::MutexLock delivery_lock(&delivery_mu_);
+  }
+}
+
+bool FlagWatcher::IsCancelled() const {
+  absl::MutexLock l(&mu_);
+  return cancelled_;
+}
+
 }  // namespace flags_internal
 }  // namespace absl
@@ -17,6 +17,9 @@
 #define ABSL_FLAGS_INTERNAL_FLAG_H_
 
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include "absl/flags/internal/commandlineflag.h"
 #include "absl/flags/internal/registry.h"
@@ -63,8 +66,54 @@ class FlagState : public flags_internal::FlagStateInterface {
 // TODO(rogeeff): add noexcept after C++17 support is added.
 using FlagCallback = void (*)();
 
+// Signature of the executor used to deliver flag updates to the subscribers
+// created by absl::WatchFlag(). The executor runs the supplied task, possibly
+// asynchronously.
+using FlagUpdateExecutor = std::function<void(std::function<void()>)>;
+
+// A subscriber to the updates of a flag's value. Notifications arriving while
+// a delivery is already scheduled are merged into that delivery, and
+// deliveries to the same subscriber never run concurrently.
+class FlagWatcher : public std::enable_shared_from_this<FlagWatcher> {
+ public:
+  FlagWatcher(FlagUpdateExecutor executor, std::function<void()> callback)
+      : executor_(std::move(executor)), callback_(std::move(callback)) {}
+
+  FlagWatcher(const FlagWatcher&) = delete;
+  FlagWatcher& operator=(const FlagWatcher&) = delete;
+
+  // Schedules a delivery via the executor unless one is already pending.
+  void Notify();
+
+  // Stops all future deliveries. Waits for a delivery in progress, if any, to
+  // complete, unless called from the delivery itself.
+  void Cancel();
+
+  bool IsCancelled() const;
+
+ private:
+  void Deliver();
+
+  const FlagUpdateExecutor executor_;
+  const std::function<void()> callback_;
+
+  mutable absl::Mutex mu_;
+  bool scheduled_ ABSL_GUARDED_BY(mu_) = false;
+  bool cancelled_ ABSL_GUARDED_BY(mu_) = false;
+
+  // Held while the callback runs.
+  absl::Mutex delivery_mu_;
+};
+
+using FlagWatchers = std::vector<std::shared_ptr<FlagWatcher>>;
+
+// Invokes the mutation callback `cb`, if any, and notifies the `watchers`, if
+// any. Requires that *primary_mu be held in exclusive mode; it is released
+// while the callback is running. Both are serialized by *callback_mu, which
+// also guards the contents of `watchers`.
 void InvokeCallback(absl::Mutex* primary_mu, absl::Mutex* callback_mu,
-                    FlagCallback cb) ABSL_EXCLUSIVE_LOCKS_REQUIRED(primary_mu);
+                    FlagCallback cb, FlagWatchers* watchers)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(primary_mu);
 
 // This is "unspecified" implementation of absl::Flag<T> type.
 template <typename T>
@@ -81,7 +130,8 @@ class Flag final : public flags_internal::CommandLineFlag {
             /*def=*/nullptr,
             /*cur=*/nullptr),
         atomic_(flags_internal::AtomicInit()),
-        callback_(nullptr) {}
+        callback_(nullptr),
+        watchers_(nullptr) {}
 
   T Get() const {
     // Implementation notes:
@@ -131,6 +181,31 @@ class Flag final : public flags_internal::CommandLineFlag {
     InvokeCallback();
   }
 
+  // Subscribes `callback` to the updates of the flag's value. The callback is
+  // invoked with the current value via `executor` once upon subscription and
+  // after the value changes.
+  std::shared_ptr<FlagWatcher> Watch(
+      FlagUpdateExecutor executor,
+      std::function<void(const T&)> callback) const {
+    auto watcher = std::make_shared<FlagWatcher>(
+        std::move(executor), [this, callback]() { callback(Get()); });
+
+    absl::Mutex* primary_mu = InitFlagIfNecessary();
+    FlagWatchers* watchers;
+    {
+      absl::MutexLock l(primary_mu);
+      if (watchers_ == nullptr) watchers_ = new FlagWatchers;
+      watchers = watchers_;
+    }
+    {
+      absl::MutexLock l(&locks_->callback_mu);
+      watchers->push_back(watcher);
+    }
+
+    watcher->Notify();
+    return watcher;
+  }
+
  private:
   friend class FlagState<T>;
 
@@ -138,7 +213,9 @@ class Flag final : public flags_internal::CommandLineFlag {
     // Values are heap allocated for Abseil Flags.
     if (cur_) Delete(op_, cur_);
     if (def_) Delete(op_, def_);
+    delete pending_value_;
 
+    delete watchers_;
     delete locks_;
   }
 
@@ -153,10 +230,9 @@ class Flag final : public flags_internal::CommandLineFlag {
   // Interfaces to save and restore flags to/from persistent state.
   // Returns current flag state or nullptr if flag does not support
   // saving and restoring a state.
-  std::unique_ptr<flags_internal::FlagStateInterface> SaveState() override {
-    T curr_value = Get();
-
-    absl::MutexLock l(InitFlagIfNecessary());
+  std::unique_ptr<flags_internal::FlagStateInterface> SaveState() override
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(locks_->primary_mu) {
+    T curr_value = *static_cast<const T*>(cur_);
 
     return absl::make_unique<flags_internal::FlagState<T>>(
         this, std::move(curr_value), modified_, on_command_line_, counter_);
@@ -182,7 +258,7 @@ class Flag final : public flags_internal::CommandLineFlag {
   void InvokeCallback() override
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(locks_->primary_mu) {
     flags_internal::InvokeCallback(&locks_->primary_mu, &locks_->callback_mu,
-                                   callback_);
+                                   callback_, watchers_);
   }
 
   // Flag's data
@@ -190,6 +266,9 @@ class Flag final : public flags_internal::CommandLineFlag {
   // accessible field.
   std::atomic<int64_t> atomic_;
   FlagCallback callback_;  // Mutation callback
+  // Subscribers created by Watch(). Allocated once under the primary lock, the
+  // contents are guarded by the callback lock.
+  mutable FlagWatchers* watchers_;
 };
 
 template <typename T>
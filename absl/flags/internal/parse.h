@@ -36,11 +36,13 @@ enum class OnUndefinedFlag {
   kReportUndefined,
   kAbortIfUndefined
 };
+enum class ValueParsingAction { kParseEagerly, kDeferParsing };
 
 std::vector<char*> ParseCommandLineImpl(int argc, char* argv[],
                                         ArgvListAction arg_list_act,
                                         UsageFlagsAction usage_flag_act,
-                                        OnUndefinedFlag on_undef_flag);
+                                        OnUndefinedFlag on_undef_flag,
+                                        ValueParsingAction value_parsing_act);
 
 }  // namespace flags_internal
 }  // namespace absl
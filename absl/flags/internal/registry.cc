@@ -15,8 +15,11 @@
 
 #include "absl/flags/internal/registry.h"
 
+#include <atomic>
+
 #include "absl/base/dynamic_annotations.h"
 #include "absl/base/internal/raw_logging.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/flags/config.h"
 #include "absl/flags/usage_config.h"
 #include "absl/strings/str_cat.h"
@@ -40,11 +43,15 @@ namespace flags_internal {
 //    FooLocked(), you must own the registry lock before calling
 //    the function; otherwise, you should *not* hold the lock, and
 //    the function will acquire it itself if needed.
+//
+//    Once the registry is finalized (see FinalizeRegistry()) an immutable
+//    copy of the index of all the flags registered so far is published, and
+//    lookups of these flags no longer acquire the registry lock.
 // --------------------------------------------------------------------
 
 class FlagRegistry {
  public:
-  FlagRegistry() = default;
+  FlagRegistry() : finalized_(false) {}
   ~FlagRegistry() {
     for (auto& p : flags_) {
       p.second->Destroy();
@@ -65,19 +72,33 @@ class FlagRegistry {
   // found or not retired.  Does not emit a warning.
   CommandLineFlag* FindRetiredFlagLocked(absl::string_view name);
 
+  // Returns the flag object for the specified name from the finalized flags
+  // snapshot, or nullptr if the registry is not finalized or the flag was not
+  // registered at the time of finalization. Does not acquire the lock.
+  CommandLineFlag* FindFinalizedFlag(absl::string_view name) const;
+
+  // Publishes the snapshot of all the flags registered so far. Only the first
+  // call has any effect.
+  void Finalize();
+
   static FlagRegistry* GlobalRegistry();  // returns a singleton registry
 
  private:
-  friend class FlagSaverImpl;  // reads all the flags in order to copy them
   friend void ForEachFlagUnlocked(
       std::function<void(CommandLineFlag*)> visitor);
 
   // The map from name to flag, for FindFlagLocked().
-  using FlagMap = std::map<absl::string_view, CommandLineFlag*>;
+  using FlagMap = absl::flat_hash_map<absl::string_view, CommandLineFlag*>;
   using FlagIterator = FlagMap::iterator;
   using FlagConstIterator = FlagMap::const_iterator;
   FlagMap flags_;
 
+  // The snapshot of flags_, for FindFinalizedFlag(). Written once under the
+  // lock before finalized_ is set and never modified afterwards, so it can be
+  // read concurrently without the lock.
+  FlagMap finalized_flags_;
+  std::atomic<bool> finalized_;
+
   absl::Mutex lock_;
 
   // Disallow
@@ -176,12 +197,30 @@ CommandLineFlag* FlagRegistry::FindRetiredFlagLocked(absl::string_view name) {
   return i->second;
 }
 
+CommandLineFlag* FlagRegistry::FindFinalizedFlag(absl::string_view name) const {
+  if (!finalized_.load(std::memory_order_acquire)) return nullptr;
+
+  FlagConstIterator i = finalized_flags_.find(name);
+  return i == finalized_flags_.end() ? nullptr : i->second;
+}
+
+void FlagRegistry::Finalize() {
+  if (finalized_.load(std::memory_order_acquire)) return;
+
+  FlagRegistryLock registry_lock(this);
+  if (finalized_.load(std::memory_order_relaxed)) return;
+
+  finalized_flags_ = flags_;
+  finalized_.store(true, std::memory_order_release);
+}
+
 // --------------------------------------------------------------------
 // FlagSaver
 // FlagSaverImpl
 //    This class stores the states of all flags at construct time,
-//    and restores all flags to that state at destruct time.
-//    Its major implementation challenge is that it never modifies
+//    and restores all flags to that state at destruct time. The states
+//    are stored lazily by a FlagSnapshot, so only the flags modified in
+//    between are ever copied. It never modifies
 //    pointers in the 'main' registry, so global FLAG_* vars always
 //    point to the right place.
 // --------------------------------------------------------------------
@@ -192,30 +231,15 @@ class FlagSaverImpl {
   FlagSaverImpl(const FlagSaverImpl&) = delete;
   void operator=(const FlagSaverImpl&) = delete;
 
-  // Saves the flag states from the flag registry into this object.
-  // It's an error to call this more than once.
-  void SaveFromRegistry() {
-    assert(backup_registry_.empty());  // call only once!
-    flags_internal::ForEachFlag([&](flags_internal::CommandLineFlag* flag) {
-      if (auto flag_state = flag->SaveState()) {
-        backup_registry_.emplace_back(std::move(flag_state));
-      }
-    });
-  }
-
-  // Restores the saved flag states into the flag registry.
-  void RestoreToRegistry() {
-    for (const auto& flag_state : backup_registry_) {
-      flag_state->Restore();
-    }
-  }
+  // Restores the flags modified since construction to their saved states.
+  void RestoreToRegistry() { snapshot_.Restore(); }
 
  private:
-  std::vector<std::unique_ptr<flags_internal::FlagStateInterface>>
-      backup_registry_;
+  // Saves the flag states lazily, on their first modification.
+  flags_internal::FlagSnapshot snapshot_;
 };
 
-FlagSaver::FlagSaver() : impl_(new FlagSaverImpl) { impl_->SaveFromRegistry(); }
+FlagSaver::FlagSaver() : impl_(new FlagSaverImpl) {}
 
 void FlagSaver::Ignore() {
   delete impl_;
@@ -234,6 +258,18 @@ FlagSaver::~FlagSaver() {
 CommandLineFlag* FindCommandLineFlag(absl::string_view name) {
   if (name.empty()) return nullptr;
   FlagRegistry* const registry = FlagRegistry::GlobalRegistry();
+
+  CommandLineFlag* flag = registry->FindFinalizedFlag(name);
+  if (flag != nullptr) {
+    if (flag->IsRetired()) {
+      flags_internal::ReportUsageError(
+          absl::StrCat("Accessing retired flag '", name, "'"), false);
+    }
+    return flag;
+  }
+
+  // Flags registered after finalization (or any lookup before it) go through
+  // the locked map.
   FlagRegistryLock frl(registry);
 
   return registry->FindFlagLocked(name);
@@ -241,11 +277,19 @@ CommandLineFlag* FindCommandLineFlag(absl::string_view name) {
 
 CommandLineFlag* FindRetiredFlag(absl::string_view name) {
   FlagRegistry* const registry = FlagRegistry::GlobalRegistry();
+
+  CommandLineFlag* flag = registry->FindFinalizedFlag(name);
+  if (flag != nullptr) {
+    return flag->IsRetired() ? flag : nullptr;
+  }
+
   FlagRegistryLock frl(registry);
 
   return registry->FindRetiredFlagLocked(name);
 }
 
+void FinalizeRegistry() { FlagRegistry::GlobalRegistry()->Finalize(); }
+
 // --------------------------------------------------------------------
 
 void ForEachFlagUnlocked(std::function<void(CommandLineFlag*)> visitor) {
@@ -17,7 +17,6 @@
 #define ABSL_FLAGS_INTERNAL_REGISTRY_H_
 
 #include <functional>
-#include <map>
 #include <string>
 
 #include "absl/base/macros.h"
@@ -32,7 +31,16 @@ namespace flags_internal {
 CommandLineFlag* FindCommandLineFlag(absl::string_view name);
 CommandLineFlag* FindRetiredFlag(absl::string_view name);
 
-// Executes specified visitor for each non-retired flag in the registry.
+// Publishes a snapshot of all the flags registered so far. Lookups of
+// these flags via FindCommandLineFlag() and FindRetiredFlag() do not acquire
+// the registry lock afterwards. Flags registered after this call remain
+// accessible through the locked lookup path. Only the first call has any
+// effect; it is invoked by the command line parsing routines, after all static
+// registrations are done.
+void FinalizeRegistry();
+
+// Executes specified visitor for each non-retired flag in the registry. The
+// order of visitation is unspecified.
 // Requires the caller hold the registry lock.
 void ForEachFlagUnlocked(std::function<void(CommandLineFlag*)> visitor);
 // Executes specified visitor for each non-retired flag in the registry. While
@@ -94,7 +102,8 @@ bool IsRetiredFlag(absl::string_view name, bool* type_is_bool);
 //-----------------------------------------------------------------------------
 // Saves the states (value, default value, whether the user has set
 // the flag, registered validators, etc) of all flags, and restores
-// them when the FlagSaver is destroyed.
+// them when the FlagSaver is destroyed. Only the flags modified while the
+// FlagSaver is alive are copied, on their first modification.
 //
 // This class is thread-safe.  However, its destructor writes to
 // exactly the set of flags that have changed value during its
@@ -15,6 +15,7 @@
 
 #include "absl/flags/internal/usage.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -285,20 +286,28 @@ void FlagsHelpImpl(std::ostream& out, flags_internal::FlagKindFilter filter_cb,
   absl::string_view
       package_separator;             // controls blank lines between packages.
   absl::string_view file_separator;  // controls blank lines between files.
-  for (const auto& package : matching_flags) {
+  for (auto& package : matching_flags) {
     if (format == HelpFormat::kHumanReadable) {
       out << package_separator;
       package_separator = "\n\n";
     }
 
     file_separator = "";
-    for (const auto& flags_in_file : package.second) {
+    for (auto& flags_in_file : package.second) {
       if (format == HelpFormat::kHumanReadable) {
         out << file_separator << "  Flags from " << flags_in_file.first
             << ":\n";
         file_separator = "\n";
       }
 
+      // The registry does not visit flags in any particular order.
+      std::sort(std::begin(flags_in_file.second),
+                std::end(flags_in_file.second),
+                [](const flags_internal::CommandLineFlag* lhs,
+                   const flags_internal::CommandLineFlag* rhs) {
+                  return lhs->Name() < rhs->Name();
+                });
+
       for (const auto* flag : flags_in_file.second) {
         flags_internal::FlagHelp(out, *flag, format);
       }
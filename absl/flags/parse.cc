@@ -17,8 +17,8 @@
 
 #include <stdlib.h>
 
-#include <fstream>
 #include <iostream>
+#include <memory>
 #include <tuple>
 
 #ifdef _WIN32
@@ -31,6 +31,8 @@
 #include "absl/flags/internal/usage.h"
 #include "absl/flags/usage.h"
 #include "absl/flags/usage_config.h"
+#include "absl/strings/line_reader.h"
+#include "absl/strings/mapped_file.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/strip.h"
 #include "absl/synchronization/mutex.h"
@@ -113,12 +115,17 @@ namespace flags_internal {
 
 namespace {
 
+// Arguments are views into either argv, a flagfile's contents or strings owned
+// by the list. Copies of the list share the ownership of the latter two.
 class ArgsList {
  public:
   ArgsList() : next_arg_(0) {}
   ArgsList(int argc, char* argv[]) : args_(argv, argv + argc), next_arg_(0) {}
-  explicit ArgsList(const std::vector<std::string>& args)
-      : args_(args), next_arg_(0) {}
+  explicit ArgsList(std::vector<std::string> args)
+      : owned_args_(
+            std::make_shared<const std::vector<std::string>>(std::move(args))),
+        args_(owned_args_->begin(), owned_args_->end()),
+        next_arg_(0) {}
 
   // Returns success status: true if parsing successful, false otherwise.
   bool ReadFromFlagfile(const std::string& flag_file_name);
@@ -129,28 +136,31 @@ class ArgsList {
   void PopFront() { next_arg_++; }
 
  private:
-  std::vector<std::string> args_;
+  std::shared_ptr<const std::vector<std::string>> owned_args_;
+  std::shared_ptr<const absl::MappedFile> flagfile_;
+  std::vector<absl::string_view> args_;
   int next_arg_;
 };
 
 bool ArgsList::ReadFromFlagfile(const std::string& flag_file_name) {
-  std::ifstream flag_file(flag_file_name);
+  auto flagfile = std::make_shared<absl::MappedFile>();
 
-  if (!flag_file) {
+  if (!flagfile->Open(flag_file_name)) {
     flags_internal::ReportUsageError(
         absl::StrCat("Can't open flagfile ", flag_file_name), true);
 
     return false;
   }
+  flagfile_ = flagfile;
 
   // This argument represents fake argv[0], which should be present in all arg
   // lists.
   args_.push_back("");
 
-  std::string line;
+  absl::LineReader lines(flagfile->contents());
   bool success = true;
 
-  while (std::getline(flag_file, line)) {
+  for (absl::string_view line; lines.Next(&line);) {
     absl::string_view stripped = absl::StripLeadingAsciiWhitespace(line);
 
     if (stripped.empty() || stripped[0] == '#') {
@@ -167,7 +177,7 @@ bool ArgsList::ReadFromFlagfile(const std::string& flag_file_name) {
         break;
       }
 
-      args_.push_back(std::string(stripped));
+      args_.push_back(stripped);
       continue;
     }
 
@@ -301,7 +311,7 @@ bool ReadFlagfiles(const std::vector<std::string>& flagfiles,
     ArgsList al;
 
     if (al.ReadFromFlagfile(*it)) {
-      input_args->push_back(al);
+      input_args->push_back(std::move(al));
     } else {
       success = false;
     }
@@ -352,7 +362,7 @@ bool ReadFlagsFromEnv(const std::vector<std::string>& flag_names,
   }
 
   if (success) {
-    input_args->emplace_back(args);
+    input_args->emplace_back(std::move(args));
   }
 
   return success;
@@ -562,11 +572,20 @@ bool CanIgnoreUndefinedFlag(absl::string_view flag_name) {
 std::vector<char*> ParseCommandLineImpl(int argc, char* argv[],
                                         ArgvListAction arg_list_act,
                                         UsageFlagsAction usage_flag_act,
-                                        OnUndefinedFlag on_undef_flag) {
+                                        OnUndefinedFlag on_undef_flag,
+                                        ValueParsingAction value_parsing_act) {
   ABSL_INTERNAL_CHECK(argc > 0, "Missing argv[0]");
 
-  // This routine does not return anything since we abort on failure.
-  CheckDefaultValuesParsingRoundtrip();
+  // All the statically defined flags are registered by now. Publish them so
+  // that flag lookups below do not contend on the registry lock.
+  FinalizeRegistry();
+
+  // This routine does not return anything since we abort on failure. It
+  // constructs the default value of every flag, which is exactly what deferred
+  // parsing avoids, so it is skipped in that mode.
+  if (value_parsing_act == ValueParsingAction::kParseEagerly) {
+    CheckDefaultValuesParsingRoundtrip();
+  }
 
   std::vector<std::string> flagfile_value;
 
@@ -680,7 +699,11 @@ std::vector<char*> ParseCommandLineImpl(int argc, char* argv[],
     if (flag->IsRetired()) continue;
 
     std::string error;
-    if (!flag->SetFromString(value, SET_FLAGS_VALUE, kCommandLine, &error)) {
+    bool set_success =
+        value_parsing_act == ValueParsingAction::kDeferParsing
+            ? flag->SetFromStringDeferred(value, &error)
+            : flag->SetFromString(value, SET_FLAGS_VALUE, kCommandLine, &error);
+    if (!set_success) {
       flags_internal::ReportUsageError(error, true);
       success = false;
     }
@@ -745,7 +768,18 @@ std::vector<char*> ParseCommandLine(int argc, char* argv[]) {
   return flags_internal::ParseCommandLineImpl(
       argc, argv, flags_internal::ArgvListAction::kRemoveParsedArgs,
       flags_internal::UsageFlagsAction::kHandleUsage,
-      flags_internal::OnUndefinedFlag::kAbortIfUndefined);
+      flags_internal::OnUndefinedFlag::kAbortIfUndefined,
+      flags_internal::ValueParsingAction::kParseEagerly);
+}
+
+std::vector<char*> ParseCommandLineLazily(int argc, char* argv[]) {
+  return flags_internal::ParseCommandLineImpl(
+      argc, argv, flags_internal::ArgvListAction::kRemoveParsedArgs,
+      flags_internal::UsageFlagsAction::kHandleUsage,
+      flags_internal::OnUndefinedFlag::kAbortIfUndefined,
+      flags_internal::ValueParsingAction::kDeferParsing);
 }
 
+void ParseDeferredFlagValues() { flags_internal::ParseDeferredFlagValues(); }
+
 }  // namespace absl
@@ -17,8 +17,8 @@
 // File: parse.h
 // -----------------------------------------------------------------------------
 //
-// This file defines the main parsing function for Abseil flags:
-// `absl::ParseCommandLine()`.
+// This file defines the main parsing functions for Abseil flags:
+// `absl::ParseCommandLine()` and `absl::ParseCommandLineLazily()`.
 
 #ifndef ABSL_FLAGS_PARSE_H_
 #define ABSL_FLAGS_PARSE_H_
@@ -53,6 +53,28 @@ namespace absl {
 // help messages and then exits the program.
 std::vector<char*> ParseCommandLine(int argc, char* argv[]);
 
+// ParseCommandLineLazily()
+//
+// Same as `ParseCommandLine()`, except that the values specified for flags of
+// types other than the built-in arithmetic types and `bool` are not parsed, and
+// the default values of these flags are not constructed, until the flag is
+// first accessed. This makes startup cheaper for programs with many flags set
+// on the command line or in flagfiles, most of which are never read. Flags
+// which were accessed before this call, including flags with `OnUpdate()`
+// callbacks, are parsed eagerly.
+//
+// Invalid values of the deferred flags are not reported by this function.
+// Instead, the program is terminated once such a flag is first accessed. Call
+// `absl::ParseDeferredFlagValues()` to detect these errors at a predictable
+// point, e.g. from a background thread once startup is complete.
+std::vector<char*> ParseCommandLineLazily(int argc, char* argv[]);
+
+// ParseDeferredFlagValues()
+//
+// Parses all the flag values deferred by `ParseCommandLineLazily()` which were
+// not parsed yet. Terminates the program if any of these values is invalid.
+void ParseDeferredFlagValues();
+
 }  // namespace absl
 
 #endif  // ABSL_FLAGS_PARSE_H_
@@ -635,6 +635,49 @@ TEST_F(ParseTest, TestFlagfileInFlagfile) {
 
 // --------------------------------------------------------------------
 
+TEST_F(ParseTest, TestFlagfileWithCrLfLineEnds) {
+  std::string flagfile_flag;
+
+  constexpr const char* const ff_crlf_data[] = {
+      "# comment\r",
+      "\r",
+      "--int_flag=7\r",
+      "--string_flag=crlf\r",
+  };
+
+  const char* in_args1[] = {
+      "testbin",
+      GetFlagfileFlag(
+          {{"parse_test.ff_crlf", absl::MakeConstSpan(ff_crlf_data)}},
+          &flagfile_flag),
+  };
+  TestParse(in_args1, 7, 1.1, "crlf", false);
+}
+
+// --------------------------------------------------------------------
+
+TEST_F(ParseTest, TestFlagfileEdgeCases) {
+  const std::string empty_file_name =
+      absl::StrCat(GetTestTempDir(), "parse_test.ff_empty");
+  const std::string no_eol_file_name =
+      absl::StrCat(GetTestTempDir(), "parse_test.ff_no_eol");
+  {
+    std::ofstream empty_file(empty_file_name);
+    std::ofstream no_eol_file(no_eol_file_name);
+    no_eol_file << "--int_flag=7\n\n  --string_flag=eof";
+  }
+
+  const std::string flagfile_flag =
+      absl::StrCat("--flagfile=", empty_file_name, ",", no_eol_file_name);
+  const char* in_args1[] = {
+      "testbin",
+      flagfile_flag.c_str(),
+  };
+  TestParse(in_args1, 7, 1.1, "eof", false);
+}
+
+// --------------------------------------------------------------------
+
 TEST_F(ParseDeathTest, TestInvalidFlagfiles) {
   std::string flagfile_flag;
 
@@ -757,6 +800,26 @@ TEST_F(ParseTest, TestReadingFlagsFromEnvMoxedWithRegularFlags) {
 
 // --------------------------------------------------------------------
 
+TEST_F(ParseTest, TestParseCommandLineLazily) {
+  const char* in_args[] = {
+      "testbin",        "--int_flag=10", "--string_flag=lazy",
+      "--udt_flag=AAA", "arg1",
+  };
+
+  auto out_args = absl::ParseCommandLineLazily(5, const_cast<char**>(in_args));
+
+  EXPECT_THAT(out_args, ElementsAreArray({absl::string_view("testbin"),
+                                          absl::string_view("arg1")}));
+
+  absl::ParseDeferredFlagValues();
+
+  EXPECT_EQ(absl::GetFlag(FLAGS_int_flag), 10);
+  EXPECT_EQ(absl::GetFlag(FLAGS_string_flag), "lazy");
+  EXPECT_EQ(absl::GetFlag(FLAGS_udt_flag).value, 10);
+}
+
+// --------------------------------------------------------------------
+
 TEST_F(ParseTest, TestKeepParsedArgs) {
   const char* in_args1[] = {
       "testbin",        "arg1", "--bool_flag",
@@ -776,7 +839,8 @@ TEST_F(ParseTest, TestKeepParsedArgs) {
   auto out_args2 = flags::ParseCommandLineImpl(
       11, const_cast<char**>(in_args1), flags::ArgvListAction::kKeepParsedArgs,
       flags::UsageFlagsAction::kHandleUsage,
-      flags::OnUndefinedFlag::kAbortIfUndefined);
+      flags::OnUndefinedFlag::kAbortIfUndefined,
+      flags::ValueParsingAction::kParseEagerly);
 
   EXPECT_THAT(
       out_args2,
@@ -803,7 +867,8 @@ TEST_F(ParseTest, TestIgnoreUndefinedFlags) {
   auto out_args1 = flags::ParseCommandLineImpl(
       4, const_cast<char**>(in_args1), flags::ArgvListAction::kRemoveParsedArgs,
       flags::UsageFlagsAction::kHandleUsage,
-      flags::OnUndefinedFlag::kIgnoreUndefined);
+      flags::OnUndefinedFlag::kIgnoreUndefined,
+      flags::ValueParsingAction::kParseEagerly);
 
   EXPECT_THAT(out_args1, ElementsAreArray({absl::string_view("testbin"),
                                            absl::string_view("arg1")}));
@@ -820,7 +885,8 @@ TEST_F(ParseTest, TestIgnoreUndefinedFlags) {
   auto out_args2 = flags::ParseCommandLineImpl(
       4, const_cast<char**>(in_args2), flags::ArgvListAction::kKeepParsedArgs,
       flags::UsageFlagsAction::kHandleUsage,
-      flags::OnUndefinedFlag::kIgnoreUndefined);
+      flags::OnUndefinedFlag::kIgnoreUndefined,
+      flags::ValueParsingAction::kParseEagerly);
 
   EXPECT_THAT(
       out_args2,
@@ -850,7 +916,8 @@ TEST_F(ParseDeathTest, TestHelpFlagHandling) {
   auto out_args2 = flags::ParseCommandLineImpl(
       3, const_cast<char**>(in_args2), flags::ArgvListAction::kRemoveParsedArgs,
       flags::UsageFlagsAction::kIgnoreUsage,
-      flags::OnUndefinedFlag::kAbortIfUndefined);
+      flags::OnUndefinedFlag::kAbortIfUndefined,
+      flags::ValueParsingAction::kParseEagerly);
 
   EXPECT_EQ(absl::GetFlag(FLAGS_int_flag), 3);
 }
@@ -119,6 +119,56 @@ class HashStateBase {
   static H combine_contiguous(H state, const T* data, size_t size);
 };
 
+// PiecewiseChunkSize()
+//
+// Returns the chunk size used by `combine_contiguous()` for large inputs, and
+// by `PiecewiseCombiner` to regroup fragmented inputs.
+constexpr size_t PiecewiseChunkSize() { return 1024; }
+
+// PiecewiseCombiner
+//
+// Combines a contiguous byte range presented as a sequence of fragments, for
+// types (such as `absl::Cord`) whose contents are not stored contiguously.
+//
+//   PiecewiseCombiner combiner;
+//   for (absl::string_view chunk : value.Chunks()) {
+//     state = combiner.add_buffer(std::move(state), chunk.data(),
+//                                 chunk.size());
+//   }
+//   state = combiner.finalize(std::move(state));
+//
+// produces the same hash expansion as a single `combine_contiguous()` of the
+// concatenated fragments, regardless of where the fragment boundaries fall.
+// `finalize()` must be called exactly once, after the last `add_buffer()`.
+class PiecewiseCombiner {
+ public:
+  PiecewiseCombiner() : position_(0) {}
+  PiecewiseCombiner(const PiecewiseCombiner&) = delete;
+  PiecewiseCombiner& operator=(const PiecewiseCombiner&) = delete;
+
+  // PiecewiseCombiner::add_buffer()
+  //
+  // Appends the given range of bytes to the sequence to be hashed, which may
+  // modify the provided hash state.
+  template <typename H>
+  H add_buffer(H state, const unsigned char* data, size_t size);
+  template <typename H>
+  H add_buffer(H state, const char* data, size_t size) {
+    return add_buffer(std::move(state),
+                      reinterpret_cast<const unsigned char*>(data), size);
+  }
+
+  // PiecewiseCombiner::finalize()
+  //
+  // Combines the bytes still buffered into the hash state and returns it.
+  template <typename H>
+  H finalize(H state);
+
+ private:
+  unsigned char buf_[PiecewiseChunkSize()];
+  size_t position_;
+};
+
 // is_uniquely_represented
 //
 // `is_uniquely_represented<T>` is a trait class that indicates whether `T`
@@ -709,6 +759,28 @@ class CityHashState : public HashStateBase<CityHashState> {
                                         std::integral_constant<int, 8>
                                         /* sizeof_size_t*/);
 
+  // Slow dispatch path for calls to CombineContiguousImpl with a size argument
+  // larger than PiecewiseChunkSize().  Hashes the input in chunks of that
+  // size so that fragmented inputs fed through a PiecewiseCombiner produce
+  // the same result as the equivalent contiguous range.
+  template <int kSizeofSizeT>
+  static uint64_t CombineLargeContiguousImpl(
+      uint64_t state, const unsigned char* first, size_t len,
+      std::integral_constant<int, kSizeofSizeT> sizeof_size_t) {
+    while (len >= PiecewiseChunkSize()) {
+      state = Mix(state, kSizeofSizeT == 4
+                             ? absl::hash_internal::CityHash32(
+                                   reinterpret_cast<const char*>(first),
+                                   PiecewiseChunkSize())
+                             : absl::hash_internal::CityHash64(
+                                   reinterpret_cast<const char*>(first),
+                                   PiecewiseChunkSize()));
+      len -= PiecewiseChunkSize();
+      first += PiecewiseChunkSize();
+    }
+    return CombineContiguousImpl(state, first, len, sizeof_size_t);
+  }
+
   // Reads 9 to 16 bytes from p.
   // The first 8 bytes are in .first, the rest (zero padded) bytes are in
   // .second.
@@ -775,7 +847,10 @@ inline uint64_t CityHashState::CombineContiguousImpl(
   // For large values we use CityHash, for small ones we just use a
   // multiplicative hash.
   uint64_t v;
-  if (len > 8) {
+  if (len > PiecewiseChunkSize()) {
+    return CombineLargeContiguousImpl(state, first, len,
+                                      std::integral_constant<int, 4>{});
+  } else if (len > 8) {
     v = absl::hash_internal::CityHash32(reinterpret_cast<const char*>(first), len);
   } else if (len >= 4) {
     v = Read4To8(first, len);
@@ -795,7 +870,10 @@ inline uint64_t CityHashState::CombineContiguousImpl(
   // For large values we use CityHash, for small ones we just use a
   // multiplicative hash.
   uint64_t v;
-  if (len > 16) {
+  if (len > PiecewiseChunkSize()) {
+    return CombineLargeContiguousImpl(state, first, len,
+                                      std::integral_constant<int, 8>{});
+  } else if (len > 16) {
     v = absl::hash_internal::CityHash64(reinterpret_cast<const char*>(first), len);
   } else if (len > 8) {
     auto p = Read9To16(first, len);
@@ -849,6 +927,47 @@ template <typename T>
 H HashStateBase<H>::combine_contiguous(H state, const T* data, size_t size) {
   return hash_internal::hash_range_or_bytes(std::move(state), data, size);
 }
+
+// PiecewiseCombiner::add_buffer()
+template <typename H>
+H PiecewiseCombiner::add_buffer(H state, const unsigned char* data,
+                                size_t size) {
+  if (position_ + size <= PiecewiseChunkSize()) {
+    // This partial chunk does not fill our existing buffer.
+    memcpy(buf_ + position_, data, size);
+    position_ += size;
+    return state;
+  }
+
+  // Complete the buffered chunk and hash it.
+  if (position_ != 0) {
+    const size_t bytes_needed = PiecewiseChunkSize() - position_;
+    memcpy(buf_ + position_, data, bytes_needed);
+    state = H::combine_contiguous(std::move(state), buf_,
+                                  PiecewiseChunkSize());
+    data += bytes_needed;
+    size -= bytes_needed;
+  }
+
+  // Hash whatever full chunks we can without copying.
+  while (size >= PiecewiseChunkSize()) {
+    state = H::combine_contiguous(std::move(state), data,
+                                  PiecewiseChunkSize());
+    data += PiecewiseChunkSize();
+    size -= PiecewiseChunkSize();
+  }
+  // Fill the buffer with the remainder.
+  memcpy(buf_, data, size);
+  position_ = size;
+  return state;
+}
+
+// PiecewiseCombiner::finalize()
+template <typename H>
+H PiecewiseCombiner::finalize(H state) {
+  // Hash the remainder left in the buffer, which may be empty.
+  return H::combine_contiguous(std::move(state), buf_, position_);
+}
 }  // namespace hash_internal
 }  // namespace absl
 
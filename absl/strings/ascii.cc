@@ -14,6 +14,9 @@
 
 #include "absl/strings/ascii.h"
 
+#include "absl/strings/internal/ascii_simd.h"
+#include "absl/strings/internal/simd.h"
+
 namespace absl {
 namespace ascii_internal {
 
@@ -152,18 +155,30 @@ const char kToUpper[256] = {
 };
 // clang-format on
 
+void AsciiStrToLower(char* dest, const char* src, size_t n) {
+  size_t i = strings_internal::AsciiToLowerSimd(
+      strings_internal::BestSimdLevel(), src, n, dest);
+  for (; i < n; ++i) {
+    dest[i] = absl::ascii_tolower(src[i]);
+  }
+}
+
+void AsciiStrToUpper(char* dest, const char* src, size_t n) {
+  size_t i = strings_internal::AsciiToUpperSimd(
+      strings_internal::BestSimdLevel(), src, n, dest);
+  for (; i < n; ++i) {
+    dest[i] = absl::ascii_toupper(src[i]);
+  }
+}
+
 }  // namespace ascii_internal
 
 void AsciiStrToLower(std::string* s) {
-  for (auto& ch : *s) {
-    ch = absl::ascii_tolower(ch);
-  }
+  ascii_internal::AsciiStrToLower(&(*s)[0], s->data(), s->size());
 }
 
 void AsciiStrToUpper(std::string* s) {
-  for (auto& ch : *s) {
-    ch = absl::ascii_toupper(ch);
-  }
+  ascii_internal::AsciiStrToUpper(&(*s)[0], s->data(), s->size());
 }
 
 void RemoveExtraAsciiWhitespace(std::string* str) {
@@ -53,6 +53,7 @@
 #define ABSL_STRINGS_ASCII_H_
 
 #include <algorithm>
+#include <cstddef>
 #include <string>
 
 #include "absl/base/attributes.h"
@@ -70,6 +71,12 @@ extern const char kToUpper[256];
 // Declaration for the array of characters to lower-case characters.
 extern const char kToLower[256];
 
+// Write the `n` bytes at `src` to `dest`, which may be `src`, converted to
+// lowercase or uppercase. They back AsciiStrToLower() and AsciiStrToUpper(),
+// and are declared here for the case-insensitive hash.
+void AsciiStrToLower(char* dest, const char* src, size_t n);
+void AsciiStrToUpper(char* dest, const char* src, size_t n);
+
 }  // namespace ascii_internal
 
 // ascii_isalpha()
@@ -18,8 +18,12 @@
 #include <string>
 #include <array>
 #include <random>
+#include <vector>
 
 #include "benchmark/benchmark.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/ascii_case_insensitive.h"
+#include "absl/strings/match.h"
 
 namespace {
 
@@ -117,4 +121,54 @@ static void BM_StrToUpper(benchmark::State& state) {
 }
 BENCHMARK(BM_StrToUpper)->Range(1, 1 << 20);
 
+static void BM_StrToLowerInPlace(benchmark::State& state) {
+  const int size = state.range(0);
+  std::string s;
+  for (int i = 0; i < size; ++i) s.push_back("Mixed Case Text. "[i % 17]);
+  for (auto _ : state) {
+    std::string copy = s;
+    absl::AsciiStrToLower(&copy);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_StrToLowerInPlace)->Range(16, 1 << 20);
+
+static void BM_EqualsIgnoreCase(benchmark::State& state) {
+  const int size = state.range(0);
+  std::string a(size, 'x');
+  std::string b(size, 'X');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    benchmark::DoNotOptimize(absl::EqualsIgnoreCase(a, b));
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_EqualsIgnoreCase)->Range(8, 1 << 20);
+
+static void BM_CaseInsensitiveHeaderLookup(benchmark::State& state) {
+  const std::vector<std::string> names = {
+      "Accept",        "Accept-Encoding", "Accept-Language", "Cache-Control",
+      "Connection",    "Content-Length",  "Content-Type",    "Cookie",
+      "Host",          "If-None-Match",   "Referer",         "User-Agent",
+      "X-Forwarded-For"};
+  absl::flat_hash_map<std::string, int, absl::AsciiCaseInsensitiveHash,
+                      absl::AsciiCaseInsensitiveEq>
+      headers;
+  for (size_t i = 0; i < names.size(); ++i) {
+    headers[names[i]] = static_cast<int>(i);
+  }
+  std::vector<std::string> keys;
+  for (const std::string& name : names) {
+    keys.push_back(absl::AsciiStrToLower(name));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(headers.find(keys[i]));
+    if (++i == keys.size()) i = 0;
+  }
+}
+BENCHMARK(BM_CaseInsensitiveHeaderLookup);
+
 }  // namespace
@@ -0,0 +1,60 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/ascii_case_insensitive.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/hash/hash.h"
+#include "absl/strings/ascii.h"
+
+namespace absl {
+
+namespace {
+
+// Keys are lowercased on the stack this many bytes at a time.
+constexpr size_t kChunkSize = 256;
+
+// Hashes as the lowercase form of `s` would as an `absl::string_view`. Longer
+// keys are lowercased a chunk at a time and fed to a PiecewiseCombiner, which
+// hashes the pieces exactly as it would the contiguous string.
+struct LowercaseView {
+  absl::string_view s;
+
+  template <typename H>
+  friend H AbslHashValue(H state, LowercaseView view) {
+    hash_internal::PiecewiseCombiner combiner;
+    char lower[kChunkSize];
+    for (size_t i = 0; i < view.s.size(); i += kChunkSize) {
+      const size_t n = std::min(kChunkSize, view.s.size() - i);
+      ascii_internal::AsciiStrToLower(lower, view.s.data() + i, n);
+      state = combiner.add_buffer(std::move(state), lower, n);
+    }
+    return H::combine(combiner.finalize(std::move(state)), view.s.size());
+  }
+};
+
+}  // namespace
+
+size_t AsciiCaseInsensitiveHash::operator()(absl::string_view s) const {
+  if (s.size() > kChunkSize) {
+    return absl::Hash<LowercaseView>{}(LowercaseView{s});
+  }
+  char lower[kChunkSize];
+  ascii_internal::AsciiStrToLower(lower, s.data(), s.size());
+  return absl::Hash<absl::string_view>{}(absl::string_view(lower, s.size()));
+}
+
+}  // namespace absl
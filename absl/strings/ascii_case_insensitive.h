@@ -0,0 +1,67 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: ascii_case_insensitive.h
+// -----------------------------------------------------------------------------
+//
+// This file defines a hash and an equality functor that ignore ASCII case, for
+// hash containers keyed by strings such as HTTP header names.
+//
+// Example:
+//
+//   absl::flat_hash_map<std::string, std::string,
+//                       absl::AsciiCaseInsensitiveHash,
+//                       absl::AsciiCaseInsensitiveEq>
+//       headers;
+//   headers["Content-Type"] = "text/plain";
+//   auto it = headers.find("content-type");  // Found.
+//
+// Both functors are transparent, so lookups may use any type convertible to
+// `absl::string_view` without constructing a key.
+#ifndef ABSL_STRINGS_ASCII_CASE_INSENSITIVE_H_
+#define ABSL_STRINGS_ASCII_CASE_INSENSITIVE_H_
+
+#include <cstddef>
+
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+
+// AsciiCaseInsensitiveHash
+//
+// Hashes a string as `absl::Hash<absl::string_view>` hashes its ASCII
+// lowercase form, so that strings equal under `absl::EqualsIgnoreCase()` hash
+// alike.
+struct AsciiCaseInsensitiveHash {
+  using is_transparent = void;
+
+  size_t operator()(absl::string_view s) const;
+};
+
+// AsciiCaseInsensitiveEq
+//
+// Compares strings with `absl::EqualsIgnoreCase()`.
+struct AsciiCaseInsensitiveEq {
+  using is_transparent = void;
+
+  bool operator()(absl::string_view a, absl::string_view b) const {
+    return absl::EqualsIgnoreCase(a, b);
+  }
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_ASCII_CASE_INSENSITIVE_H_
@@ -0,0 +1,77 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/ascii_case_insensitive.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/ascii.h"
+
+namespace {
+
+TEST(AsciiCaseInsensitive, Hash) {
+  const absl::AsciiCaseInsensitiveHash hash;
+  EXPECT_EQ(hash("Content-Type"), hash("content-type"));
+  EXPECT_EQ(hash("Content-Type"), hash("CONTENT-TYPE"));
+  EXPECT_EQ(hash(""), absl::Hash<absl::string_view>{}(""));
+  EXPECT_EQ(hash("Content-Type"),
+            absl::Hash<absl::string_view>{}("content-type"));
+  EXPECT_NE(hash("Content-Type"), hash("Content-Typo"));
+  // Only ASCII letters fold.
+  EXPECT_NE(hash("@"), hash("`"));
+  EXPECT_NE(hash("\xc0"), hash("\xe0"));
+
+  // Longer keys are lowercased in chunks, which must not change the hash.
+  for (size_t size : {255, 256, 257, 512, 1000, 1023, 1024, 1025, 5000}) {
+    std::string long_key;
+    for (size_t i = 0; i < size; ++i) long_key.push_back("aBcD-"[i % 5]);
+    EXPECT_EQ(hash(long_key), hash(absl::AsciiStrToLower(long_key))) << size;
+    EXPECT_EQ(hash(long_key), absl::Hash<absl::string_view>{}(
+                                  absl::AsciiStrToLower(long_key)))
+        << size;
+  }
+}
+
+TEST(AsciiCaseInsensitive, Eq) {
+  const absl::AsciiCaseInsensitiveEq eq;
+  EXPECT_TRUE(eq("Content-Type", "content-TYPE"));
+  EXPECT_TRUE(eq("", ""));
+  EXPECT_FALSE(eq("Content-Type", "Content-Typo"));
+  EXPECT_FALSE(eq("Content-Type", "Content-Type "));
+  EXPECT_FALSE(eq("@", "`"));
+}
+
+TEST(AsciiCaseInsensitive, FlatHashMap) {
+  absl::flat_hash_map<std::string, int, absl::AsciiCaseInsensitiveHash,
+                      absl::AsciiCaseInsensitiveEq>
+      headers;
+  headers["Content-Type"] = 1;
+  headers["content-type"] = 2;
+  headers["Accept"] = 3;
+  EXPECT_EQ(2, headers.size());
+  EXPECT_EQ(2, headers["CONTENT-TYPE"]);
+
+  // Heterogeneous lookup.
+  const absl::string_view key = "ACCEPT";
+  auto it = headers.find(key);
+  ASSERT_NE(it, headers.end());
+  EXPECT_EQ("Accept", it->first);
+  EXPECT_EQ(1, headers.count("accept"));
+  EXPECT_EQ(0, headers.count("accepts"));
+}
+
+}  // namespace
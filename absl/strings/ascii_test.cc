@@ -224,6 +224,31 @@ TEST(AsciiStrTo, Upper) {
   EXPECT_STREQ("MUTABLE", mutable_buf);
 }
 
+// Every byte value, at every offset within strings long enough for the
+// vectorized conversions, followed by a tail they leave to the scalar code.
+TEST(AsciiStrTo, AllBytesLong) {
+  std::string all_bytes;
+  for (int i = 0; i < 3 * 256 + 7; ++i) all_bytes += static_cast<char>(i);
+  for (size_t len = 0; len <= 100; ++len) {
+    const std::string s = all_bytes.substr(len, len + 1);
+    std::string lower = s;
+    std::string upper = s;
+    absl::AsciiStrToLower(&lower);
+    absl::AsciiStrToUpper(&upper);
+    ASSERT_EQ(s.size(), lower.size());
+    ASSERT_EQ(s.size(), upper.size());
+    for (size_t i = 0; i < s.size(); ++i) {
+      ASSERT_EQ(absl::ascii_tolower(s[i]), lower[i]) << len << " " << i;
+      ASSERT_EQ(absl::ascii_toupper(s[i]), upper[i]) << len << " " << i;
+    }
+  }
+  std::string lower = all_bytes;
+  absl::AsciiStrToLower(&lower);
+  for (size_t i = 0; i < all_bytes.size(); ++i) {
+    ASSERT_EQ(absl::ascii_tolower(all_bytes[i]), lower[i]) << i;
+  }
+}
+
 TEST(StripLeadingAsciiWhitespace, FromStringView) {
   EXPECT_EQ(absl::string_view{},
             absl::StripLeadingAsciiWhitespace(absl::string_view{}));
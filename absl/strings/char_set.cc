@@ -0,0 +1,98 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/char_set.h"
+
+#include <algorithm>
+
+namespace absl {
+
+namespace {
+
+constexpr size_t npos = absl::string_view::npos;
+
+// Scalar searches, for the sets that the vectorized ones cannot represent.
+
+template <bool kNegate>
+size_t ScanForward(const strings_internal::Charmap& map,
+                   absl::string_view text, size_t pos) {
+  for (; pos < text.size(); ++pos) {
+    if (map.contains(static_cast<unsigned char>(text[pos])) != kNegate) {
+      return pos;
+    }
+  }
+  return npos;
+}
+
+template <bool kNegate>
+size_t ScanBackward(const strings_internal::Charmap& map,
+                    absl::string_view text, size_t pos) {
+  if (text.empty()) return npos;
+  for (size_t i = std::min(pos, text.size() - 1) + 1; i > 0;) {
+    --i;
+    if (map.contains(static_cast<unsigned char>(text[i])) != kNegate) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+}  // namespace
+
+CharSet::CharSet(absl::string_view chars)
+    : map_(chars.data(), static_cast<int>(chars.size())),
+      vectorize_(strings_internal::MakeNibbleTables(chars, &tables_)) {}
+
+size_t CharSet::FindFirstOf(absl::string_view text, size_t pos) const {
+  if (!vectorize_) return ScanForward<false>(map_, text, pos);
+  if (pos >= text.size()) return npos;
+  const size_t i = pos + strings_internal::FindFirstOf(
+                             tables_, text.data() + pos, text.size() - pos);
+  return i != text.size() ? i : npos;
+}
+
+size_t CharSet::FindFirstNotOf(absl::string_view text, size_t pos) const {
+  if (!vectorize_) return ScanForward<true>(map_, text, pos);
+  if (pos >= text.size()) return npos;
+  const size_t i = pos + strings_internal::FindFirstNotOf(
+                             tables_, text.data() + pos, text.size() - pos);
+  return i != text.size() ? i : npos;
+}
+
+size_t CharSet::FindLastOf(absl::string_view text, size_t pos) const {
+  if (!vectorize_) return ScanBackward<false>(map_, text, pos);
+  if (text.empty()) return npos;
+  const size_t searched = std::min(pos, text.size() - 1) + 1;
+  const size_t i = strings_internal::FindLastOf(tables_, text.data(), searched);
+  return i != searched ? i : npos;
+}
+
+size_t CharSet::FindLastNotOf(absl::string_view text, size_t pos) const {
+  if (!vectorize_) return ScanBackward<true>(map_, text, pos);
+  if (text.empty()) return npos;
+  const size_t searched = std::min(pos, text.size() - 1) + 1;
+  const size_t i =
+      strings_internal::FindLastNotOf(tables_, text.data(), searched);
+  return i != searched ? i : npos;
+}
+
+namespace strings_internal {
+
+const NibbleTables* VectorizedTables(const CharSet& set) {
+  return set.vectorize_ ? &set.tables_ : nullptr;
+}
+
+}  // namespace strings_internal
+
+}  // namespace absl
@@ -0,0 +1,100 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: char_set.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `absl::CharSet`, a set of bytes prepared for searching.
+// `absl::string_view::find_first_of()` and its relatives take the set as a
+// string and prepare it on every call; when the same set is searched for
+// again and again, build an `absl::CharSet` once and search with it instead.
+//
+// Example:
+//
+//   static const absl::CharSet* const kSeparators =
+//       new absl::CharSet(" \t,;");
+//   size_t pos = kSeparators->FindFirstOf(line);
+//   if (pos != absl::string_view::npos) { ... }
+#ifndef ABSL_STRINGS_CHAR_SET_H_
+#define ABSL_STRINGS_CHAR_SET_H_
+
+#include <cstddef>
+
+#include "absl/strings/internal/char_map.h"
+#include "absl/strings/internal/find_simd.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+
+class CharSet;
+
+namespace strings_internal {
+
+// Returns the tables that represent `set`, or null if it can only be searched
+// a byte at a time. For splitters that use the kernels in find_simd.h
+// directly.
+const NibbleTables* VectorizedTables(const CharSet& set);
+
+}  // namespace strings_internal
+
+// CharSet
+//
+// A set of bytes. NUL is a byte like any other, and bytes are compared as
+// unsigned values. It is thread-compatible: concurrent calls to its const
+// methods are safe.
+class CharSet {
+ public:
+  // Creates an empty set.
+  CharSet() : CharSet(absl::string_view()) {}
+
+  // Creates the set of the bytes in `chars`.
+  explicit CharSet(absl::string_view chars);
+
+  // CharSet::Contains()
+  //
+  // Returns whether `c` is in the set.
+  bool Contains(char c) const {
+    return map_.contains(static_cast<unsigned char>(c));
+  }
+
+  // CharSet::FindFirstOf()
+  // CharSet::FindFirstNotOf()
+  // CharSet::FindLastOf()
+  // CharSet::FindLastNotOf()
+  //
+  // Return the offset of the first or last byte of `text` that is in the set,
+  // or that is not, or `absl::string_view::npos` if there is none. They
+  // search from `pos` onwards, or backwards from it, just as
+  // `absl::string_view::find_first_of()` and its relatives do.
+  size_t FindFirstOf(absl::string_view text, size_t pos = 0) const;
+  size_t FindFirstNotOf(absl::string_view text, size_t pos = 0) const;
+  size_t FindLastOf(absl::string_view text,
+                    size_t pos = absl::string_view::npos) const;
+  size_t FindLastNotOf(absl::string_view text,
+                       size_t pos = absl::string_view::npos) const;
+
+ private:
+  friend const strings_internal::NibbleTables*
+  strings_internal::VectorizedTables(const CharSet& set);
+
+  strings_internal::Charmap map_;
+  strings_internal::NibbleTables tables_;
+  // Whether `tables_` represents the set, so that searches can be vectorized.
+  bool vectorize_;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_CHAR_SET_H_
@@ -0,0 +1,97 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/char_set.h"
+
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr size_t npos = absl::string_view::npos;
+
+TEST(CharSet, Contains) {
+  const absl::CharSet set(std::string("a,\0\xff", 4));
+  EXPECT_TRUE(set.Contains('a'));
+  EXPECT_TRUE(set.Contains(','));
+  EXPECT_TRUE(set.Contains('\0'));
+  EXPECT_TRUE(set.Contains('\xff'));
+  EXPECT_FALSE(set.Contains('b'));
+  EXPECT_FALSE(set.Contains('\x7f'));
+
+  const absl::CharSet empty;
+  for (int c = 0; c < 256; ++c) EXPECT_FALSE(empty.Contains(c));
+}
+
+TEST(CharSet, Find) {
+  const absl::CharSet set(" ,");
+  const absl::string_view text = "ab, cd ef";
+  EXPECT_EQ(2, set.FindFirstOf(text));
+  EXPECT_EQ(3, set.FindFirstOf(text, 3));
+  EXPECT_EQ(6, set.FindFirstOf(text, 4));
+  EXPECT_EQ(npos, set.FindFirstOf(text, 7));
+  EXPECT_EQ(npos, set.FindFirstOf(text, 100));
+  EXPECT_EQ(0, set.FindFirstNotOf(text));
+  EXPECT_EQ(4, set.FindFirstNotOf(text, 2));
+  EXPECT_EQ(6, set.FindLastOf(text));
+  EXPECT_EQ(3, set.FindLastOf(text, 5));
+  EXPECT_EQ(npos, set.FindLastOf(text, 1));
+  EXPECT_EQ(8, set.FindLastNotOf(text));
+  EXPECT_EQ(1, set.FindLastNotOf(text, 3));
+
+  EXPECT_EQ(npos, set.FindFirstOf(""));
+  EXPECT_EQ(npos, set.FindFirstNotOf(""));
+  EXPECT_EQ(npos, set.FindLastOf(""));
+  EXPECT_EQ(npos, set.FindLastNotOf(""));
+  EXPECT_EQ(npos, set.FindFirstNotOf(" , ,"));
+  EXPECT_EQ(npos, set.FindLastNotOf(" , ,"));
+
+  const absl::CharSet empty;
+  EXPECT_EQ(npos, empty.FindFirstOf(text));
+  EXPECT_EQ(0, empty.FindFirstNotOf(text));
+  EXPECT_EQ(8, empty.FindLastNotOf(text));
+}
+
+// Compares against absl::string_view, for sets that the vectorized searches
+// can and cannot represent, at lengths either side of the block sizes.
+TEST(CharSet, MatchesStringView) {
+  std::mt19937 rng(1234);
+  for (int iter = 0; iter < 400; ++iter) {
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::string chars(iter % 20, '\0');
+    for (char& c : chars) c = static_cast<char>(byte(rng));
+    const absl::CharSet set(chars);
+
+    // Mostly bytes of the set, or mostly bytes not in it.
+    std::string text(iter % 100, '\0');
+    const bool dense = !chars.empty() && iter % 2 == 0;
+    for (char& c : text) {
+      c = dense && byte(rng) < 240 ? chars[byte(rng) % chars.size()]
+                                   : static_cast<char>(byte(rng));
+    }
+    const absl::string_view sv = text;
+    for (size_t pos = 0; pos <= text.size() + 1; ++pos) {
+      ASSERT_EQ(sv.find_first_of(chars, pos), set.FindFirstOf(sv, pos));
+      ASSERT_EQ(sv.find_first_not_of(chars, pos), set.FindFirstNotOf(sv, pos));
+      ASSERT_EQ(sv.find_last_of(chars, pos), set.FindLastOf(sv, pos));
+      ASSERT_EQ(sv.find_last_not_of(chars, pos), set.FindLastNotOf(sv, pos));
+    }
+    ASSERT_EQ(sv.find_last_of(chars), set.FindLastOf(sv));
+    ASSERT_EQ(sv.find_last_not_of(chars), set.FindLastNotOf(sv));
+  }
+}
+
+}  // namespace
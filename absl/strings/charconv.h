@@ -21,8 +21,8 @@ namespace absl {
 
 // Workalike compatibilty version of std::chars_format from C++17.
 //
-// This is an bitfield enumerator which can be passed to absl::from_chars to
-// configure the string-to-float conversion.
+// This is an bitfield enumerator which can be passed to absl::from_chars and
+// absl::to_chars to configure the conversion.
 enum class chars_format {
   scientific = 1,
   fixed = 2,
@@ -80,6 +80,50 @@ absl::from_chars_result from_chars(const char* first, const char* last,
                                    float& value,  // NOLINT
                                    chars_format fmt = chars_format::general);
 
+// The return result of a number-to-string conversion.
+//
+// `ec` will be set to `value_too_large` if the output did not fit in the
+// provided range, in which case `ptr` is set to the `last` argument to
+// to_chars and the contents of the range are unspecified.  Otherwise `ec` is
+// std::errc() and `ptr` is set to one past the last character written.
+//
+// No terminating NUL character is written.
+struct to_chars_result {
+  char* ptr;
+  std::errc ec;
+};
+
+// Workalike compatibilty version of std::to_chars from C++17.  Currently
+// this only supports the `double` and `float` types.
+//
+// Writes the shortest representation of `value` into [first, last) such that
+// absl::from_chars() (or strtod()) reads back exactly `value`.  Among the
+// representations of that length, the one closest to `value` is chosen.
+//
+// Without a `fmt` argument, the output uses fixed or scientific notation,
+// whichever is shorter, preferring fixed notation on ties ("0.1", "100",
+// "1e+21").  When `fmt` is given, the output uses the notation of printf()'s
+// "%f", "%e", "%g" or "%a" respectively, still with the shortest round-trip
+// digits.  In `hex` mode, no "0x" prefix is written, to match from_chars().
+//
+// Infinities are written as "inf" and NaNs as "nan", with a leading '-' when
+// the sign bit is set.  The C locale is not respected.
+absl::to_chars_result to_chars(char* first, char* last, double value);
+absl::to_chars_result to_chars(char* first, char* last, float value);
+absl::to_chars_result to_chars(char* first, char* last, double value,
+                               chars_format fmt);
+absl::to_chars_result to_chars(char* first, char* last, float value,
+                               chars_format fmt);
+
+// As above, but with an explicit `precision`, with the same meaning as in the
+// printf() conversions "%.*f", "%.*e", "%.*g" and "%.*a".  The output is
+// exactly what snprintf() would produce in the "C" locale, except for the "0x"
+// prefix in `hex` mode.  As above, the current locale is not respected.
+absl::to_chars_result to_chars(char* first, char* last, double value,
+                               chars_format fmt, int precision);
+absl::to_chars_result to_chars(char* first, char* last, float value,
+                               chars_format fmt, int precision);
+
 // std::chars_format is specified as a bitmask type, which means the following
 // operations must be provided:
 inline constexpr chars_format operator&(chars_format lhs, chars_format rhs) {
@@ -14,11 +14,17 @@
 
 #include "absl/strings/charconv.h"
 
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "benchmark/benchmark.h"
+#include "absl/strings/internal/numbers_test_common.h"
+#include "absl/strings/numbers.h"
 
 namespace {
 
@@ -175,6 +181,120 @@ void BM_Absl_Big_And_Difficult(benchmark::State& state) {
 }
 BENCHMARK(BM_Absl_Big_And_Difficult)->Range(3, 5000);
 
+void BM_Strtod_RealWorld(benchmark::State& state) {
+  const std::vector<std::string> corpus =
+      absl::strings_internal::RealWorldNumberStrings(1024);
+  for (auto s : state) {
+    for (const std::string& number : corpus) {
+      benchmark::DoNotOptimize(strtod(number.c_str(), nullptr));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_Strtod_RealWorld);
+
+void BM_Absl_RealWorld(benchmark::State& state) {
+  const std::vector<std::string> corpus =
+      absl::strings_internal::RealWorldNumberStrings(1024);
+  for (auto s : state) {
+    for (const std::string& number : corpus) {
+      double v;
+      absl::from_chars(number.data(), number.data() + number.size(), v);
+      benchmark::DoNotOptimize(v);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_Absl_RealWorld);
+
+void BM_Strtod_RealWorld_float(benchmark::State& state) {
+  const std::vector<std::string> corpus =
+      absl::strings_internal::RealWorldNumberStrings(1024);
+  for (auto s : state) {
+    for (const std::string& number : corpus) {
+      benchmark::DoNotOptimize(strtof(number.c_str(), nullptr));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_Strtod_RealWorld_float);
+
+void BM_Absl_RealWorld_float(benchmark::State& state) {
+  const std::vector<std::string> corpus =
+      absl::strings_internal::RealWorldNumberStrings(1024);
+  for (auto s : state) {
+    for (const std::string& number : corpus) {
+      float v;
+      absl::from_chars(number.data(), number.data() + number.size(), v);
+      benchmark::DoNotOptimize(v);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_Absl_RealWorld_float);
+
+// Returns 1024 values with a wide spread of exponents and full mantissas.
+template <typename Float>
+std::vector<Float> MakeValues(int max_exponent) {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> mantissa(1.0, 10.0);
+  std::uniform_int_distribution<int> exponent(-max_exponent, max_exponent);
+  std::vector<Float> values;
+  for (int i = 0; i < 1024; ++i) {
+    values.push_back(
+        static_cast<Float>(mantissa(rng) * std::pow(10.0, exponent(rng))));
+  }
+  return values;
+}
+
+void BM_Snprintf_RoundTrip(benchmark::State& state) {
+  const std::vector<double> values = MakeValues<double>(300);
+  char buffer[32];
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        snprintf(buffer, sizeof(buffer), "%.17g", values[i++ & 1023]));
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK(BM_Snprintf_RoundTrip);
+
+void BM_SixDigitsToBuffer(benchmark::State& state) {
+  const std::vector<double> values = MakeValues<double>(300);
+  char buffer[absl::numbers_internal::kSixDigitsToBufferSize];
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        absl::numbers_internal::SixDigitsToBuffer(values[i++ & 1023], buffer));
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK(BM_SixDigitsToBuffer);
+
+void BM_Absl_ToChars(benchmark::State& state) {
+  const std::vector<double> values = MakeValues<double>(300);
+  char buffer[32];
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        absl::to_chars(buffer, buffer + sizeof(buffer), values[i++ & 1023]));
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK(BM_Absl_ToChars);
+
+void BM_Absl_ToChars_float(benchmark::State& state) {
+  const std::vector<float> values = MakeValues<float>(36);
+  char buffer[32];
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        absl::to_chars(buffer, buffer + sizeof(buffer), values[i++ & 1023]));
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK(BM_Absl_ToChars_float);
+
 }  // namespace
 
 // ------------------------------------------------------------------------
@@ -202,3 +322,11 @@ BENCHMARK(BM_Absl_Big_And_Difficult)->Range(3, 5000);
 // BM_Absl_Big_And_Difficult/512          4167 ns       4167 ns     171414
 // BM_Absl_Big_And_Difficult/4096         9160 ns       9159 ns      76297
 // BM_Absl_Big_And_Difficult/5000         9738 ns       9738 ns      70140
+// BM_Strtod_RealWorld                  114115 ns     112856 ns       6893
+// BM_Absl_RealWorld                     36572 ns      36340 ns      16301
+// BM_Strtod_RealWorld_float             79169 ns      78583 ns       7993
+// BM_Absl_RealWorld_float               33286 ns      32739 ns      22802
+// BM_Snprintf_RoundTrip                   722 ns        712 ns    1049828
+// BM_SixDigitsToBuffer                     21 ns         20 ns   38788680
+// BM_Absl_ToChars                          66 ns         65 ns   12327959
+// BM_Absl_ToChars_float                    56 ns         55 ns   12030898
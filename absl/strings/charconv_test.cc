@@ -14,7 +14,14 @@
 
 #include "absl/strings/charconv.h"
 
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -154,6 +161,24 @@ TEST(FromChars, NearRoundingCases) {
   FROM_CHARS_TEST_FLOAT(459926601011.e15);
 }
 
+TEST(FromChars, ExactHalfwayCases) {
+  // Ties are broken to even.
+  TestDoubleParse("9007199254740993", 9007199254740992.0);
+  TestDoubleParse("9007199254740995", 9007199254740996.0);
+  TestDoubleParse("4503599627370496.5", 4503599627370496.0);
+  TestDoubleParse("4503599627370497.5", 4503599627370498.0);
+  TestFloatParse("16777217", 16777216.0f);
+  TestFloatParse("16777219", 16777220.0f);
+  // Just above a tie.
+  TestDoubleParse("9007199254740993.0000000001", 9007199254740994.0);
+  TestDoubleParse("4503599627370496.5000001", 4503599627370497.0);
+  // Near the boundary between subnormals and normals.
+  TestDoubleParse("2.2250738585072011e-308", 2.2250738585072011e-308);
+  TestDoubleParse("2.2250738585072014e-308", 2.2250738585072014e-308);
+  TestDoubleParse("4.9406564584124654e-324", 4.9406564584124654e-324);
+  TestFloatParse("1.17549421e-38", 1.17549421e-38f);
+}
+
 #undef FROM_CHARS_TEST_DOUBLE
 #undef FROM_CHARS_TEST_FLOAT
 #endif
@@ -578,6 +603,32 @@ TEST(FromChars, TestVersusStrtof) {
   }
 }
 
+// Check that inputs with up to 19 significant digits and any exponent, which
+// take the fast path, agree with strtod() and strtof().
+TEST(FromChars, TestLongMantissasVersusStrtod) {
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 200000; ++i) {
+    const uint64_t mantissa = rng() % 10000000000000000000u;
+    const int exponent = static_cast<int>(rng() % 700) - 360;
+    std::string candidate = absl::StrCat(mantissa, "e", exponent);
+    double strtod_value = strtod(candidate.c_str(), nullptr);
+    double absl_value = 0;
+    absl::from_chars(candidate.data(), candidate.data() + candidate.size(),
+                     absl_value);
+    // Overflow gives the largest finite value rather than infinity.
+    if (std::isfinite(strtod_value)) {
+      ASSERT_EQ(strtod_value, absl_value) << candidate;
+    }
+    float strtof_value = strtof(candidate.c_str(), nullptr);
+    float absl_float_value = 0;
+    absl::from_chars(candidate.data(), candidate.data() + candidate.size(),
+                     absl_float_value);
+    if (std::isfinite(strtof_value)) {
+      ASSERT_EQ(strtof_value, absl_float_value) << candidate;
+    }
+  }
+}
+
 // Tests if two floating point values have identical bit layouts.  (EXPECT_EQ
 // is not suitable for NaN testing, since NaNs are never equal.)
 template <typename Float>
@@ -777,4 +828,185 @@ TEST(FromChars, DecimalFloatLimits) {
   TestOverflowAndUnderflow<float>(input_gen, expected_gen, -45, 38);
 }
 
+// Returns the output of absl::to_chars as a string, or "error".
+template <typename Float, typename... Args>
+std::string ToChars(Float value, Args... args) {
+  char buffer[2048];
+  absl::to_chars_result result =
+      absl::to_chars(buffer, buffer + sizeof(buffer), value, args...);
+  if (result.ec != std::errc()) return "error";
+  return std::string(buffer, result.ptr);
+}
+
+TEST(ToChars, Shortest) {
+  EXPECT_EQ(ToChars(0.0), "0");
+  EXPECT_EQ(ToChars(-0.0), "-0");
+  EXPECT_EQ(ToChars(0.1), "0.1");
+  EXPECT_EQ(ToChars(0.1 + 0.2), "0.30000000000000004");
+  EXPECT_EQ(ToChars(100.0), "100");
+  EXPECT_EQ(ToChars(-2.5), "-2.5");
+  EXPECT_EQ(ToChars(1e16), "1e+16");
+  EXPECT_EQ(ToChars(1e21), "1e+21");
+  EXPECT_EQ(ToChars(123456789.0), "123456789");
+  EXPECT_EQ(ToChars(0.001), "0.001");
+  EXPECT_EQ(ToChars(0.0001), "1e-04");
+  EXPECT_EQ(ToChars(5e-324), "5e-324");
+  EXPECT_EQ(ToChars(1.7976931348623157e308), "1.7976931348623157e+308");
+  EXPECT_EQ(ToChars(2.2250738585072014e-308), "2.2250738585072014e-308");
+  EXPECT_EQ(ToChars(9007199254740993.0), "9007199254740992");
+  EXPECT_EQ(ToChars(0.1f), "0.1");
+  EXPECT_EQ(ToChars(16777216.0f), "16777216");
+  EXPECT_EQ(ToChars(3.4028235e38f), "3.4028235e+38");
+  EXPECT_EQ(ToChars(1e-45f), "1e-45");
+  EXPECT_EQ(ToChars(std::numeric_limits<double>::infinity()), "inf");
+  EXPECT_EQ(ToChars(-std::numeric_limits<float>::infinity()), "-inf");
+  EXPECT_EQ(ToChars(std::numeric_limits<double>::quiet_NaN()), "nan");
+}
+
+TEST(ToChars, Formats) {
+  EXPECT_EQ(ToChars(1234.5, absl::chars_format::scientific), "1.2345e+03");
+  EXPECT_EQ(ToChars(1e100, absl::chars_format::scientific), "1e+100");
+  EXPECT_EQ(ToChars(0.0, absl::chars_format::scientific), "0e+00");
+  EXPECT_EQ(ToChars(1e-5, absl::chars_format::fixed), "0.00001");
+  EXPECT_EQ(ToChars(1e21, absl::chars_format::fixed),
+            "1000000000000000000000");
+  EXPECT_EQ(ToChars(12.25, absl::chars_format::fixed), "12.25");
+  EXPECT_EQ(ToChars(123456.0, absl::chars_format::general), "123456");
+  EXPECT_EQ(ToChars(1234567.0, absl::chars_format::general), "1.234567e+06");
+  EXPECT_EQ(ToChars(0.0001, absl::chars_format::general), "0.0001");
+  EXPECT_EQ(ToChars(0.00001, absl::chars_format::general), "1e-05");
+  EXPECT_EQ(ToChars(3.0, absl::chars_format::hex), "1.8p+1");
+  EXPECT_EQ(ToChars(-0.1, absl::chars_format::hex), "-1.999999999999ap-4");
+  EXPECT_EQ(ToChars(0.0, absl::chars_format::hex), "0p+0");
+  EXPECT_EQ(ToChars(5e-324, absl::chars_format::hex), "0.0000000000001p-1022");
+  EXPECT_EQ(ToChars(1.0f, absl::chars_format::hex), "1p+0");
+  EXPECT_EQ(ToChars(1e-45f, absl::chars_format::hex), "0.000002p-126");
+}
+
+TEST(ToChars, Precision) {
+  for (double d : {0.0, -1.5, 1.0 / 3, 12345.6789, 1e-300, 1e300}) {
+    for (int precision : {0, 1, 6, 17, 40}) {
+      SCOPED_TRACE(absl::StrCat(d, " ", precision));
+      EXPECT_EQ(ToChars(d, absl::chars_format::fixed, precision),
+                absl::StrFormat("%.*f", precision, d));
+      EXPECT_EQ(ToChars(d, absl::chars_format::scientific, precision),
+                absl::StrFormat("%.*e", precision, d));
+      EXPECT_EQ(ToChars(d, absl::chars_format::general, precision),
+                absl::StrFormat("%.*g", precision, d));
+    }
+  }
+  EXPECT_EQ(ToChars(-3.0, absl::chars_format::hex, 3), "-1.800p+1");
+  EXPECT_EQ(ToChars(1.0f / 3, absl::chars_format::fixed, 10), "0.3333333433");
+}
+
+TEST(ToChars, PrecisionIgnoresLocale) {
+  const std::string old_locale = setlocale(LC_NUMERIC, nullptr);
+  // Locales with a ',' radix character, which are not installed everywhere.
+  bool found = false;
+  for (const char* name : {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8",
+                           "fr_FR.utf8", "fr_FR"}) {
+    if (setlocale(LC_NUMERIC, name) != nullptr) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) return;
+
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), "%.1f", 1.5);
+  EXPECT_STREQ("1,5", buffer);
+  EXPECT_EQ(ToChars(1.5, absl::chars_format::fixed, 3), "1.500");
+  EXPECT_EQ(ToChars(-1.5, absl::chars_format::scientific, 2), "-1.50e+00");
+  EXPECT_EQ(ToChars(1.5f, absl::chars_format::general, 6), "1.5");
+  EXPECT_EQ(ToChars(1.5, absl::chars_format::hex, 2), "1.80p+0");
+  EXPECT_EQ(ToChars(1e300, absl::chars_format::fixed, 70).find(','),
+            std::string::npos);
+  ASSERT_TRUE(setlocale(LC_NUMERIC, old_locale.c_str()));
+}
+
+TEST(ToChars, ValueTooLarge) {
+  char buffer[8];
+  absl::to_chars_result result = absl::to_chars(buffer, buffer + 3, 0.25);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  EXPECT_EQ(result.ptr, buffer + 3);
+  result = absl::to_chars(buffer, buffer + 4, 0.25);
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(std::string(buffer, result.ptr), "0.25");
+  result = absl::to_chars(buffer, buffer, -1.0);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  result = absl::to_chars(buffer, buffer + sizeof(buffer), 1e300,
+                          absl::chars_format::fixed);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  EXPECT_EQ(result.ptr, buffer + sizeof(buffer));
+}
+
+// Checks that the output of absl::to_chars reads back as the same value, and
+// that no shorter decimal does, and that it is the closest one of its length.
+template <typename Float>
+void TestShortestRoundTrip(Float value) {
+  std::string shortest = ToChars(value, absl::chars_format::scientific);
+  SCOPED_TRACE(shortest);
+  Float actual;
+  absl::from_chars(shortest.data(), shortest.data() + shortest.size(), actual);
+  ASSERT_EQ(value, actual);
+
+  const size_t start = shortest[0] == '-' ? 1 : 0;
+  const int digits = static_cast<int>(shortest.find('e') - start -
+                                      (shortest[start + 1] == '.' ? 1 : 0));
+  // %.*e is correctly rounded, so it gives the closest decimal of each length.
+  for (int precision = 0; precision < digits - 1; ++precision) {
+    std::string candidate = absl::StrFormat("%.*e", precision, value);
+    absl::from_chars_result result = absl::from_chars(
+        candidate.data(), candidate.data() + candidate.size(), actual);
+    if (result.ec == std::errc()) {
+      ASSERT_NE(value, actual) << candidate;
+    }
+  }
+  std::string closest = absl::StrFormat("%.*e", digits - 1, value);
+  double shortest_value = 0;
+  double closest_value = 0;
+  absl::from_chars(shortest.data(), shortest.data() + shortest.size(),
+                   shortest_value);
+  absl::from_chars(closest.data(), closest.data() + closest.size(),
+                   closest_value);
+  ASSERT_EQ(shortest_value, closest_value) << closest;
+}
+
+TEST(ToChars, ShortestRoundTripDoubles) {
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t bits = rng();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value)) TestShortestRoundTrip(value);
+  }
+  for (uint64_t mantissa = 0; mantissa < 100; ++mantissa) {
+    for (uint64_t exponent : {0, 1, 2, 1075, 2045, 2046}) {
+      double value;
+      uint64_t bits = (exponent << 52) | mantissa;
+      memcpy(&value, &bits, sizeof(value));
+      if (value != 0) TestShortestRoundTrip(value);
+      bits = (exponent << 52) | ((uint64_t{1} << 52) - 1 - mantissa);
+      memcpy(&value, &bits, sizeof(value));
+      TestShortestRoundTrip(value);
+    }
+  }
+  for (int exponent = -323; exponent <= 308; ++exponent) {
+    TestShortestRoundTrip(std::pow(10.0, exponent));
+  }
+}
+
+TEST(ToChars, ShortestRoundTripFloats) {
+  std::mt19937 rng(1);
+  for (int i = 0; i < 20000; ++i) {
+    uint32_t bits = rng();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value)) TestShortestRoundTrip(value);
+  }
+  for (int i = 1; i < 100000; i += 7) {
+    TestShortestRoundTrip(static_cast<float>(i) / 1000);
+  }
+}
+
 }  // namespace
@@ -0,0 +1,744 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/cord.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <ostream>
+
+#include "absl/base/optimization.h"
+#include "absl/strings/internal/resize_uninitialized.h"
+#include "absl/utility/utility.h"
+
+namespace absl {
+
+using cord_internal::CordRep;
+using cord_internal::CordRepConcat;
+using cord_internal::CordRepExternal;
+using cord_internal::CordRepFlat;
+using cord_internal::CordRepSubstring;
+using cord_internal::LeafData;
+
+using cord_internal::CONCAT;
+using cord_internal::EXTERNAL;
+using cord_internal::FLAT;
+using cord_internal::SUBSTRING;
+
+namespace {
+
+// The largest allocation made for a FLAT node, header included. Larger
+// strings are split across several flats, except by Flatten().
+constexpr size_t kMaxFlatSize = 4096;
+constexpr size_t kMaxFlatLength = kMaxFlatSize - sizeof(CordRepFlat);
+
+// Cords and strings at most this long are copied when appended to a Cord, or
+// when moved into one, rather than shared; this keeps trees from filling up
+// with tiny leaves.
+constexpr size_t kMaxBytesToCopy = 511;
+
+// Fibonacci(n), for the balance table below.
+constexpr uint64_t Fibonacci(unsigned char n, uint64_t a = 0, uint64_t b = 1) {
+  return n == 0 ? a : Fibonacci(n - 1, b, a + b);
+}
+
+// Minimum length required for a given depth tree -- a tree is considered
+// balanced if
+//      length(t) >= min_length[depth(t)]
+// The root node depth is allowed to become twice as large to reduce
+// rebalancing for larger strings (see IsRootBalanced).
+template <size_t... I>
+struct MinLengthTable {
+  static constexpr uint64_t values[] = {Fibonacci(I + 2)...};
+};
+template <size_t... I>
+constexpr uint64_t MinLengthTable<I...>::values[];
+
+template <size_t... I>
+constexpr const uint64_t* MakeMinLength(absl::index_sequence<I...>) {
+  return MinLengthTable<I...>::values;
+}
+
+// Fibonacci(93) is the largest Fibonacci number that fits in 64 bits.
+constexpr size_t kMinLengthSize = 92;
+constexpr const uint64_t* min_length =
+    MakeMinLength(absl::make_index_sequence<kMinLengthSize>());
+
+inline int Depth(const CordRep* rep) {
+  return rep->tag == CONCAT ? rep->concat()->depth : 0;
+}
+
+inline bool IsRootBalanced(const CordRep* node) {
+  if (node->tag != CONCAT) {
+    return true;
+  } else if (node->concat()->depth <= 15) {
+    return true;
+  } else if (node->concat()->depth > kMinLengthSize) {
+    return false;
+  } else {
+    // Allow depth to become twice as large as implied by fibonacci rule to
+    // reduce rebalancing for larger strings.
+    return node->length >= min_length[node->concat()->depth / 2];
+  }
+}
+
+inline CordRep* Ref(CordRep* rep) {
+  if (rep != nullptr) rep->refcount.Increment();
+  return rep;
+}
+
+CordRepFlat* NewFlat(size_t length_hint) {
+  // Round the allocation up so that the spare bytes the allocator would hand
+  // out anyway become usable capacity.
+  const size_t size = (sizeof(CordRepFlat) + length_hint + 15) & ~size_t{15};
+  CordRepFlat* rep = new (::operator new(size)) CordRepFlat();
+  rep->length = 0;
+  rep->tag = FLAT;
+  rep->capacity = size - sizeof(CordRepFlat);
+  return rep;
+}
+
+void DeleteFlat(CordRepFlat* rep) {
+  rep->~CordRepFlat();
+  ::operator delete(rep);
+}
+
+// Destroys a node whose reference count has dropped to zero, along with any
+// children that this leaves unreferenced. Iterative, so that destroying a
+// deep tree does not overflow the stack.
+void Destroy(CordRep* rep) {
+  absl::InlinedVector<CordRep*, 16> pending;
+  while (true) {
+    if (rep->tag == CONCAT) {
+      CordRepConcat* node = rep->concat();
+      CordRep* left = node->left;
+      CordRep* right = node->right;
+      delete node;
+      if (!right->refcount.Decrement()) pending.push_back(right);
+      if (!left->refcount.Decrement()) {
+        rep = left;
+        continue;
+      }
+    } else if (rep->tag == SUBSTRING) {
+      CordRepSubstring* node = rep->substring();
+      CordRep* child = node->child;
+      delete node;
+      if (!child->refcount.Decrement()) {
+        rep = child;
+        continue;
+      }
+    } else if (rep->tag == EXTERNAL) {
+      CordRepExternal* node = rep->external();
+      node->releaser_invoker(node);
+    } else {
+      DeleteFlat(rep->flat());
+    }
+
+    if (pending.empty()) break;
+    rep = pending.back();
+    pending.pop_back();
+  }
+}
+
+inline void Unref(CordRep* rep) {
+  if (rep != nullptr && ABSL_PREDICT_FALSE(!rep->refcount.Decrement())) {
+    Destroy(rep);
+  }
+}
+
+// Joins two non-null trees without rebalancing. Takes ownership of both.
+CordRepConcat* MakeConcat(CordRep* left, CordRep* right) {
+  CordRepConcat* rep = new CordRepConcat();
+  rep->tag = CONCAT;
+  rep->left = left;
+  rep->right = right;
+  rep->length = left->length + right->length;
+  rep->depth =
+      static_cast<uint8_t>(1 + (std::max)(Depth(left), Depth(right)));
+  return rep;
+}
+
+// Joins two trees, either of which may be null, without rebalancing.
+CordRep* RawConcat(CordRep* left, CordRep* right) {
+  if (left == nullptr) return right;
+  if (right == nullptr) return left;
+  return MakeConcat(left, right);
+}
+
+// Builds a balanced tree over `reps[0, n)`, which must not be empty, taking
+// ownership of them. Reuses `reps` as scratch space.
+CordRep* MakeBalancedTree(CordRep** reps, size_t n) {
+  while (n > 1) {
+    size_t dst = 0;
+    for (size_t src = 0; src < n; src += 2) {
+      reps[dst++] = src + 1 < n ? MakeConcat(reps[src], reps[src + 1])
+                                : reps[src];
+    }
+    n = dst;
+  }
+  return reps[0];
+}
+
+// Returns a tree of flats holding a copy of `data`. The last flat gets up to
+// `alloc_hint` bytes of spare capacity for later appends.
+CordRep* NewTree(const char* data, size_t length, size_t alloc_hint) {
+  if (length == 0) return nullptr;
+  absl::InlinedVector<CordRep*, 8> leaves;
+  do {
+    const size_t n = (std::min)(length, kMaxFlatLength);
+    CordRepFlat* rep = NewFlat((std::min)(n + alloc_hint, kMaxFlatLength));
+    rep->length = n;
+    memcpy(rep->Data(), data, n);
+    leaves.push_back(rep);
+    data += n;
+    length -= n;
+  } while (length != 0);
+  return MakeBalancedTree(leaves.data(), leaves.size());
+}
+
+// A Boehm-style rebalancer: the tree is decomposed into balanced subtrees,
+// which are reused whole, and the remaining leaves. These are inserted, in
+// order, into a forest in which slot `i` holds a tree whose length is at least
+// `min_length[i]`, merging slots as they fill up, and finally concatenated.
+// Only the unbalanced part of the tree is visited, which keeps the amortized
+// cost of repeated appends logarithmic.
+class CordForest {
+ public:
+  explicit CordForest(size_t length) : root_length_(length), trees_() {}
+
+  // Adds the tree rooted at `cord_root` to the forest, taking ownership of it.
+  void Build(CordRep* cord_root) {
+    absl::InlinedVector<CordRep*, 47> pending;
+    pending.push_back(cord_root);
+
+    while (!pending.empty()) {
+      CordRep* node = pending.back();
+      pending.pop_back();
+      if (node->tag != CONCAT) {
+        AddNode(node);
+        continue;
+      }
+
+      CordRepConcat* concat_node = node->concat();
+      if (concat_node->depth >= kMinLengthSize ||
+          concat_node->length < min_length[concat_node->depth]) {
+        pending.push_back(concat_node->right);
+        pending.push_back(concat_node->left);
+
+        if (concat_node->refcount.IsOne()) {
+          // Recycle the node for the concatenations built below.
+          concat_node->left = concat_freelist_;
+          concat_freelist_ = concat_node;
+        } else {
+          Ref(concat_node->right);
+          Ref(concat_node->left);
+          Unref(concat_node);
+        }
+      } else {
+        AddNode(node);
+      }
+    }
+  }
+
+  // Concatenates the trees in the forest and returns the result.
+  CordRep* ConcatNodes() {
+    CordRep* sum = nullptr;
+    for (CordRep* node : trees_) {
+      if (node == nullptr) continue;
+
+      sum = PrependNode(node, sum);
+      root_length_ -= node->length;
+      if (root_length_ == 0) break;
+    }
+    while (concat_freelist_ != nullptr) {
+      CordRepConcat* next = static_cast<CordRepConcat*>(concat_freelist_->left);
+      delete concat_freelist_;
+      concat_freelist_ = next;
+    }
+    return sum;
+  }
+
+ private:
+  void AddNode(CordRep* node) {
+    CordRep* sum = nullptr;
+
+    // Collect together everything with which we will merge `node`.
+    size_t i = 0;
+    for (; node->length > min_length[i + 1]; ++i) {
+      CordRep*& tree_at_i = trees_[i];
+      if (tree_at_i == nullptr) continue;
+      sum = PrependNode(tree_at_i, sum);
+      tree_at_i = nullptr;
+    }
+
+    sum = AppendNode(node, sum);
+
+    // Insert `sum` into the appropriate place in the forest.
+    for (; sum->length >= min_length[i]; ++i) {
+      CordRep*& tree_at_i = trees_[i];
+      if (tree_at_i == nullptr) continue;
+      sum = MakeConcat(tree_at_i, sum);
+      tree_at_i = nullptr;
+    }
+
+    // min_length[0] == 1, which means sum->length >= min_length[0].
+    assert(i > 0);
+    trees_[i - 1] = sum;
+  }
+
+  // Makes a concat node, trying to reuse an existing concat to avoid
+  // allocating a new node.
+  CordRep* MakeConcat(CordRep* left, CordRep* right) {
+    if (concat_freelist_ == nullptr) return absl::MakeConcat(left, right);
+
+    CordRepConcat* rep = concat_freelist_;
+    concat_freelist_ = static_cast<CordRepConcat*>(rep->left);
+
+    rep->left = left;
+    rep->right = right;
+    rep->length = left->length + right->length;
+    rep->depth =
+        static_cast<uint8_t>(1 + (std::max)(Depth(left), Depth(right)));
+    return rep;
+  }
+
+  CordRep* AppendNode(CordRep* node, CordRep* sum) {
+    return (sum == nullptr) ? node : MakeConcat(sum, node);
+  }
+
+  CordRep* PrependNode(CordRep* node, CordRep* sum) {
+    return (sum == nullptr) ? node : MakeConcat(node, sum);
+  }
+
+  size_t root_length_;
+  CordRep* trees_[kMinLengthSize];
+  CordRepConcat* concat_freelist_ = nullptr;
+};
+
+CordRep* Rebalance(CordRep* node) {
+  CordForest forest(node->length);
+  forest.Build(node);
+  return forest.ConcatNodes();
+}
+
+// Joins two trees, either of which may be null, rebalancing the result if it
+// has grown too deep. Takes ownership of both.
+CordRep* Concat(CordRep* left, CordRep* right) {
+  CordRep* rep = RawConcat(left, right);
+  if (rep != nullptr && !IsRootBalanced(rep)) {
+    rep = Rebalance(rep);
+  }
+  return rep;
+}
+
+// Returns a SUBSTRING of a leaf, taking ownership of `child`.
+CordRep* NewSubstring(CordRep* child, size_t offset, size_t length) {
+  if (child->tag == SUBSTRING) {
+    CordRepSubstring* sub = child->substring();
+    offset += sub->start;
+    child = Ref(sub->child);
+    Unref(sub);
+  }
+  CordRepSubstring* rep = new CordRepSubstring();
+  rep->length = length;
+  rep->tag = SUBSTRING;
+  rep->start = offset;
+  rep->child = child;
+  return rep;
+}
+
+// Returns a new tree holding bytes `[pos, pos + n)` of `node`, sharing its
+// leaves. Does not take ownership of `node`.
+CordRep* NewSubRange(CordRep* node, size_t pos, size_t n) {
+  if (n == 0) return nullptr;
+  if (pos == 0 && n == node->length) return Ref(node);
+  if (node->tag == CONCAT) {
+    CordRep* left = node->concat()->left;
+    CordRep* right = node->concat()->right;
+    const size_t left_length = left->length;
+    if (pos + n <= left_length) return NewSubRange(left, pos, n);
+    if (pos >= left_length) return NewSubRange(right, pos - left_length, n);
+    const size_t left_n = left_length - pos;
+    return RawConcat(NewSubRange(left, pos, left_n),
+                     NewSubRange(right, 0, n - left_n));
+  }
+  return NewSubstring(Ref(node), pos, n);
+}
+
+// If the rightmost leaf of `root` is a flat with spare capacity, and it and
+// every node above it are uniquely owned, grows it by up to `max_length`
+// bytes, returning the new region in `*region` and `*size`.
+bool PrepareAppendRegion(CordRep* root, char** region, size_t* size,
+                         size_t max_length) {
+  // Search down the right-hand path for a non-full FLAT node.
+  CordRep* dst = root;
+  while (dst->tag == CONCAT && dst->refcount.IsOne()) {
+    dst = dst->concat()->right;
+  }
+
+  if (dst->tag != FLAT || !dst->refcount.IsOne()) return false;
+
+  const size_t in_use = dst->length;
+  const size_t capacity = dst->flat()->capacity;
+  if (in_use == capacity) return false;
+
+  const size_t size_increase = (std::min)(capacity - in_use, max_length);
+
+  // We need to update the length fields for all nodes, including the leaf.
+  for (CordRep* rep = root; rep != dst; rep = rep->concat()->right) {
+    rep->length += size_increase;
+  }
+  dst->length += size_increase;
+
+  *region = dst->flat()->Data() + in_use;
+  *size = size_increase;
+  return true;
+}
+
+// Holds the contents of a `std::string` adopted by a Cord.
+struct StringReleaser {
+  void operator()(absl::string_view /* data */) {}
+  std::string data;
+};
+
+}  // namespace
+
+Cord::Cord(const Cord& src) : rep_(Ref(src.rep_)) {}
+
+Cord& Cord::operator=(const Cord& x) {
+  CordRep* tmp = Ref(x.rep_);
+  Unref(rep_);
+  rep_ = tmp;
+  return *this;
+}
+
+Cord& Cord::operator=(Cord&& x) noexcept {
+  if (this != &x) {
+    Unref(rep_);
+    rep_ = x.rep_;
+    x.rep_ = nullptr;
+  }
+  return *this;
+}
+
+Cord::Cord(absl::string_view src) : rep_(NewTree(src.data(), src.size(), 0)) {}
+
+Cord& Cord::operator=(absl::string_view src) {
+  // `src` may point into this Cord, so release the old tree afterwards.
+  CordRep* old = rep_;
+  rep_ = NewTree(src.data(), src.size(), 0);
+  Unref(old);
+  return *this;
+}
+
+CordRep* Cord::NewTreeFromString(std::string&& src) {
+  if (src.size() <= kMaxBytesToCopy) {
+    return NewTree(src.data(), src.size(), 0);
+  }
+  auto* rep = new cord_internal::CordRepExternalImpl<StringReleaser>(
+      StringReleaser{std::move(src)});
+  rep->length = rep->releaser.data.size();
+  rep->tag = EXTERNAL;
+  rep->base = rep->releaser.data.data();
+  return rep;
+}
+
+Cord::~Cord() { Unref(rep_); }
+
+void Cord::Clear() {
+  Unref(rep_);
+  rep_ = nullptr;
+}
+
+void Cord::Append(absl::string_view src) {
+  if (src.empty()) return;
+  if (rep_ == nullptr) {
+    rep_ = NewTree(src.data(), src.size(), 0);
+    return;
+  }
+
+  // Fill the spare capacity of the last flat first.
+  char* region;
+  size_t appended;
+  if (PrepareAppendRegion(rep_, &region, &appended, src.size())) {
+    memcpy(region, src.data(), appended);
+    src.remove_prefix(appended);
+    if (src.empty()) return;
+  }
+
+  // A single small flat is cheaper to regrow, string-style, than to extend
+  // with a second leaf.
+  const size_t total = rep_->length + src.size();
+  if (rep_->tag == FLAT && total <= kMaxFlatLength) {
+    CordRepFlat* flat = NewFlat(
+        (std::min)((std::max)(total, 2 * rep_->length), kMaxFlatLength));
+    memcpy(flat->Data(), rep_->flat()->Data(), rep_->length);
+    memcpy(flat->Data() + rep_->length, src.data(), src.size());
+    flat->length = total;
+    Unref(rep_);
+    rep_ = flat;
+    return;
+  }
+
+  // Give the new tail headroom proportional to the Cord, so that a sequence
+  // of small appends allocates geometrically fewer flats.
+  const size_t alloc_hint =
+      (std::max)(rep_->length / 10, src.size()) - src.size();
+  rep_ = Concat(rep_, NewTree(src.data(), src.size(), alloc_hint));
+}
+
+void Cord::Append(const Cord& src) {
+  if (src.rep_ == nullptr) return;
+  if (&src == this) {
+    // Append a temporary copy, which keeps the shared tree alive and stops it
+    // from being modified in place.
+    Append(Cord(src));
+    return;
+  }
+  if (src.size() <= kMaxBytesToCopy) {
+    for (absl::string_view chunk : src.Chunks()) Append(chunk);
+    return;
+  }
+  rep_ = Concat(rep_, Ref(src.rep_));
+}
+
+void Cord::Append(Cord&& src) {
+  if (src.rep_ == nullptr) return;
+  if (&src == this) {
+    // Moving from `src` would clear this Cord too, so append a copy.
+    Append(Cord(src));
+    return;
+  }
+  if (src.size() <= kMaxBytesToCopy) {
+    for (absl::string_view chunk : src.Chunks()) Append(chunk);
+    return;
+  }
+  CordRep* rep = src.rep_;
+  src.rep_ = nullptr;
+  rep_ = Concat(rep_, rep);
+}
+
+void Cord::Prepend(const Cord& src) {
+  rep_ = Concat(Ref(src.rep_), rep_);
+}
+
+void Cord::Prepend(absl::string_view src) {
+  if (src.empty()) return;
+  rep_ = Concat(NewTree(src.data(), src.size(), 0), rep_);
+}
+
+void Cord::RemovePrefix(size_t n) {
+  assert(n <= size());
+  if (n == 0) return;
+  CordRep* tree = rep_;
+  rep_ = NewSubRange(tree, n, tree->length - n);
+  Unref(tree);
+}
+
+void Cord::RemoveSuffix(size_t n) {
+  assert(n <= size());
+  if (n == 0) return;
+  CordRep* tree = rep_;
+  rep_ = NewSubRange(tree, 0, tree->length - n);
+  Unref(tree);
+}
+
+Cord Cord::Subcord(size_t pos, size_t new_size) const {
+  Cord sub;
+  const size_t length = size();
+  if (pos > length) pos = length;
+  if (new_size > length - pos) new_size = length - pos;
+  if (new_size != 0) sub.rep_ = NewSubRange(rep_, pos, new_size);
+  return sub;
+}
+
+size_t Cord::EstimatedMemoryUsage() const {
+  size_t total = sizeof(Cord);
+  if (rep_ == nullptr) return total;
+  absl::InlinedVector<const CordRep*, 47> pending;
+  pending.push_back(rep_);
+  while (!pending.empty()) {
+    const CordRep* rep = pending.back();
+    pending.pop_back();
+    switch (rep->tag) {
+      case CONCAT:
+        total += sizeof(CordRepConcat);
+        pending.push_back(rep->concat()->left);
+        pending.push_back(rep->concat()->right);
+        break;
+      case SUBSTRING:
+        total += sizeof(CordRepSubstring);
+        pending.push_back(rep->substring()->child);
+        break;
+      case EXTERNAL:
+        total += sizeof(CordRepExternal) + rep->length;
+        break;
+      default:
+        total += sizeof(CordRepFlat) + rep->flat()->capacity;
+        break;
+    }
+  }
+  return total;
+}
+
+int Cord::Compare(absl::string_view rhs) const {
+  for (absl::string_view chunk : Chunks()) {
+    const size_t n = (std::min)(chunk.size(), rhs.size());
+    if (n != 0) {
+      const int c = memcmp(chunk.data(), rhs.data(), n);
+      if (c != 0) return c < 0 ? -1 : 1;
+    }
+    if (chunk.size() > rhs.size()) return 1;
+    rhs.remove_prefix(n);
+  }
+  return rhs.empty() ? 0 : -1;
+}
+
+int Cord::Compare(const Cord& rhs) const {
+  if (rep_ == rhs.rep_) return 0;
+  ChunkIterator lhs_it = chunk_begin();
+  ChunkIterator rhs_it = rhs.chunk_begin();
+  const ChunkIterator end;
+  absl::string_view lhs_chunk;
+  absl::string_view rhs_chunk;
+  while (true) {
+    if (lhs_chunk.empty() && lhs_it != end) {
+      lhs_chunk = *lhs_it;
+      ++lhs_it;
+    }
+    if (rhs_chunk.empty() && rhs_it != end) {
+      rhs_chunk = *rhs_it;
+      ++rhs_it;
+    }
+    if (lhs_chunk.empty() || rhs_chunk.empty()) {
+      return lhs_chunk.empty() ? (rhs_chunk.empty() ? 0 : -1) : 1;
+    }
+    const size_t n = (std::min)(lhs_chunk.size(), rhs_chunk.size());
+    const int c = memcmp(lhs_chunk.data(), rhs_chunk.data(), n);
+    if (c != 0) return c < 0 ? -1 : 1;
+    lhs_chunk.remove_prefix(n);
+    rhs_chunk.remove_prefix(n);
+  }
+}
+
+bool Cord::StartsWith(absl::string_view rhs) const {
+  if (size() < rhs.size()) return false;
+  for (absl::string_view chunk : Chunks()) {
+    if (rhs.empty()) break;
+    const size_t n = (std::min)(chunk.size(), rhs.size());
+    if (memcmp(chunk.data(), rhs.data(), n) != 0) return false;
+    rhs.remove_prefix(n);
+  }
+  return true;
+}
+
+bool Cord::StartsWith(const Cord& rhs) const {
+  return size() >= rhs.size() && Subcord(0, rhs.size()) == rhs;
+}
+
+bool Cord::EndsWith(absl::string_view rhs) const {
+  return size() >= rhs.size() &&
+         Subcord(size() - rhs.size(), rhs.size()) == rhs;
+}
+
+bool Cord::EndsWith(const Cord& rhs) const {
+  return size() >= rhs.size() &&
+         Subcord(size() - rhs.size(), rhs.size()) == rhs;
+}
+
+Cord::operator std::string() const {
+  std::string s;
+  CopyCordToString(*this, &s);
+  return s;
+}
+
+void CopyCordToString(const Cord& src, std::string* dst) {
+  strings_internal::STLStringResizeUninitialized(dst, src.size());
+  char* out = &(*dst)[0];
+  for (absl::string_view chunk : src.Chunks()) {
+    memcpy(out, chunk.data(), chunk.size());
+    out += chunk.size();
+  }
+}
+
+Cord::ChunkIterator::ChunkIterator(const Cord* cord)
+    : bytes_remaining_(cord->size()) {
+  if (cord->rep_ != nullptr) {
+    stack_of_right_children_.push_back(cord->rep_);
+    AdvanceStack();
+  }
+}
+
+Cord::ChunkIterator& Cord::ChunkIterator::AdvanceStack() {
+  assert(!stack_of_right_children_.empty());
+  CordRep* node = stack_of_right_children_.back();
+  stack_of_right_children_.pop_back();
+
+  // Descend to the leftmost leaf of the popped subtree, remembering the right
+  // children on the way down.
+  while (node->tag == CONCAT) {
+    stack_of_right_children_.push_back(node->concat()->right);
+    node = node->concat()->left;
+  }
+  current_chunk_ = LeafData(node);
+  return *this;
+}
+
+char Cord::operator[](size_t i) const {
+  assert(i < size());
+  const CordRep* rep = rep_;
+  while (rep->tag == CONCAT) {
+    const CordRep* left = rep->concat()->left;
+    if (i < left->length) {
+      rep = left;
+    } else {
+      i -= left->length;
+      rep = rep->concat()->right;
+    }
+  }
+  return LeafData(rep)[i];
+}
+
+absl::optional<absl::string_view> Cord::TryFlat() const {
+  if (rep_ == nullptr) return absl::string_view();
+  if (rep_->tag == CONCAT) return absl::nullopt;
+  return LeafData(rep_);
+}
+
+absl::string_view Cord::Flatten() {
+  if (rep_ == nullptr) return absl::string_view();
+  if (rep_->tag != CONCAT) return LeafData(rep_);
+
+  CordRepFlat* flat = NewFlat(rep_->length);
+  char* out = flat->Data();
+  for (absl::string_view chunk : Chunks()) {
+    memcpy(out, chunk.data(), chunk.size());
+    out += chunk.size();
+  }
+  flat->length = rep_->length;
+  Unref(rep_);
+  rep_ = flat;
+  return absl::string_view(flat->Data(), flat->length);
+}
+
+std::ostream& operator<<(std::ostream& out, const Cord& cord) {
+  for (absl::string_view chunk : cord.Chunks()) {
+    out.write(chunk.data(), chunk.size());
+  }
+  return out;
+}
+
+}  // namespace absl
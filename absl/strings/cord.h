@@ -0,0 +1,501 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: cord.h
+// -----------------------------------------------------------------------------
+//
+// This file defines the `absl::Cord` data structure, a sequence of characters
+// designed for large payloads that are assembled, sliced and passed around
+// more often than they are inspected byte by byte.
+//
+// Internally a Cord is a tree of reference-counted chunks, so that:
+//
+//   * copying a Cord is O(1) and shares the underlying data;
+//   * appending or prepending another Cord shares its data rather than copying
+//     it, and appending small strings fills spare capacity at the end of the
+//     Cord in place;
+//   * `Subcord()`, `RemovePrefix()` and `RemoveSuffix()` are O(log n) and
+//     share the underlying data;
+//   * memory owned by the caller can be adopted without a copy using
+//     `absl::MakeCordFromExternal()`.
+//
+// The price is that a Cord is not contiguous: its contents are visited one
+// chunk at a time with `Chunks()`, or copied out with `std::string(cord)`.
+// `Flatten()` makes a Cord contiguous when an API really needs a single
+// buffer.
+//
+// Cords are thread-compatible: concurrent const access is safe, and copies of
+// a Cord may be used by different threads without synchronization even though
+// they share data.
+//
+// Example:
+//
+//   absl::Cord payload;
+//   payload.Append(header);
+//   payload.Append(body);              // shares `body`'s chunks
+//   absl::Cord tail = payload.Subcord(10, payload.size() - 10);
+//   for (absl::string_view chunk : tail.Chunks()) {
+//     Write(chunk);
+//   }
+//
+// `absl::Cord` works with `absl::Hash`, `absl::StrFormat()` ("%s" and as an
+// output sink), `absl::StrAppend()` and `absl::StrSplit()`.
+
+#ifndef ABSL_STRINGS_CORD_H_
+#define ABSL_STRINGS_CORD_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/port.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
+#include "absl/meta/type_traits.h"
+#include "absl/strings/internal/cord_internal.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace absl {
+
+class Cord;
+template <typename Releaser>
+Cord MakeCordFromExternal(absl::string_view data, Releaser&& releaser);
+
+// Cord
+//
+// A mutable sequence of characters stored as a tree of shared chunks. See the
+// file comment above.
+class Cord {
+ private:
+  template <typename T>
+  using EnableIfString =
+      absl::enable_if_t<std::is_same<T, std::string>::value, int>;
+
+ public:
+  // Cord::Cord() Constructors
+
+  // Creates an empty Cord.
+  constexpr Cord() noexcept : rep_(nullptr) {}
+
+  // Creates a Cord from an existing Cord, sharing its data.
+  Cord(const Cord& src);
+  Cord(Cord&& src) noexcept : rep_(src.rep_) { src.rep_ = nullptr; }
+  Cord& operator=(const Cord& x);
+  Cord& operator=(Cord&& x) noexcept;
+
+  // Creates a Cord holding a copy of `src`.
+  explicit Cord(absl::string_view src);
+  Cord& operator=(absl::string_view src);
+
+  // Creates a Cord from a `std::string&&` rvalue. Large strings are adopted
+  // without copying their contents.
+  template <typename T, EnableIfString<T> = 0>
+  explicit Cord(T&& src) : rep_(NewTreeFromString(std::forward<T>(src))) {}
+  template <typename T, EnableIfString<T> = 0>
+  Cord& operator=(T&& src);
+
+  ~Cord();
+
+  // Cord::Clear()
+  //
+  // Releases the Cord's data, leaving it empty.
+  void Clear();
+
+  // Cord::Append()
+  //
+  // Appends data to the Cord. Appending a large Cord shares its chunks;
+  // appending a string copies it, filling any spare capacity at the end of
+  // this Cord before allocating.
+  void Append(const Cord& src);
+  void Append(Cord&& src);
+  void Append(absl::string_view src);
+  template <typename T, EnableIfString<T> = 0>
+  void Append(T&& src);
+
+  // Cord::Prepend()
+  //
+  // Prepends data to the Cord, sharing the chunks of `src` when it is a Cord.
+  void Prepend(const Cord& src);
+  void Prepend(absl::string_view src);
+
+  // Cord::RemovePrefix()
+  //
+  // Removes the first `n` bytes of the Cord. `n` must not exceed `size()`.
+  void RemovePrefix(size_t n);
+
+  // Cord::RemoveSuffix()
+  //
+  // Removes the last `n` bytes of the Cord. `n` must not exceed `size()`.
+  void RemoveSuffix(size_t n);
+
+  // Cord::Subcord()
+  //
+  // Returns a new Cord sharing the `new_size` bytes of this Cord that start at
+  // offset `pos`. Both arguments are clamped to the bounds of the Cord, as with
+  // `std::string::substr()` (but without throwing).
+  Cord Subcord(size_t pos, size_t new_size) const;
+
+  // Cord::swap()
+  //
+  // Exchanges the contents of two Cords.
+  void swap(Cord& other) noexcept {
+    cord_internal::CordRep* tmp = rep_;
+    rep_ = other.rep_;
+    other.rep_ = tmp;
+  }
+  friend void swap(Cord& x, Cord& y) noexcept { x.swap(y); }
+
+  // Cord::size()
+  //
+  // Returns the number of bytes in the Cord.
+  size_t size() const { return rep_ == nullptr ? 0 : rep_->length; }
+
+  // Cord::empty()
+  //
+  // Determines whether the Cord is empty.
+  bool empty() const { return rep_ == nullptr; }
+
+  // Cord::EstimatedMemoryUsage()
+  //
+  // Returns the approximate number of bytes held by the Cord, counting shared
+  // chunks in full.
+  size_t EstimatedMemoryUsage() const;
+
+  // Cord::Compare()
+  //
+  // Compares the Cord against `rhs` lexicographically, as with
+  // `absl::string_view::compare()`: returns a negative value, zero or a
+  // positive value if the Cord is less than, equal to or greater than `rhs`.
+  int Compare(absl::string_view rhs) const;
+  int Compare(const Cord& rhs) const;
+
+  // Cord::StartsWith()
+  //
+  // Determines whether the Cord starts with `rhs`.
+  bool StartsWith(const Cord& rhs) const;
+  bool StartsWith(absl::string_view rhs) const;
+
+  // Cord::EndsWith()
+  //
+  // Determines whether the Cord ends with `rhs`.
+  bool EndsWith(const Cord& rhs) const;
+  bool EndsWith(absl::string_view rhs) const;
+
+  // Converts the Cord to a `std::string`, copying its contents.
+  explicit operator std::string() const;
+
+  // CopyCordToString()
+  //
+  // Replaces the contents of `*dst` with a copy of `src`, reusing the
+  // capacity of `*dst` where possible.
+  friend void CopyCordToString(const Cord& src, std::string* dst);
+
+  //----------------------------------------------------------------------------
+  // Cord::ChunkIterator
+  //----------------------------------------------------------------------------
+  //
+  // An input iterator over the chunks of a Cord, from front to back. Chunks
+  // are never empty. The `absl::string_view`s it returns stay valid for as
+  // long as the Cord is not modified, even after the iterator is advanced.
+  //
+  // Comparing iterators from different Cords is undefined.
+  class ChunkIterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = absl::string_view;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    ChunkIterator() = default;
+
+    ChunkIterator& operator++();
+    ChunkIterator operator++(int) {
+      ChunkIterator tmp(*this);
+      operator++();
+      return tmp;
+    }
+    bool operator==(const ChunkIterator& other) const {
+      return bytes_remaining_ == other.bytes_remaining_;
+    }
+    bool operator!=(const ChunkIterator& other) const {
+      return !(*this == other);
+    }
+    reference operator*() const {
+      assert(bytes_remaining_ != 0);
+      return current_chunk_;
+    }
+    pointer operator->() const {
+      assert(bytes_remaining_ != 0);
+      return &current_chunk_;
+    }
+
+   private:
+    friend class Cord;
+
+    explicit ChunkIterator(const Cord* cord);
+
+    // Pops the next leaf off the stack and makes it the current chunk.
+    ChunkIterator& AdvanceStack();
+
+    // The current chunk, and the number of bytes from its start to the end of
+    // the Cord; zero at the end.
+    absl::string_view current_chunk_;
+    size_t bytes_remaining_ = 0;
+    // Subtrees still to be visited, innermost last.
+    absl::InlinedVector<cord_internal::CordRep*, 4> stack_of_right_children_;
+  };
+
+  // Cord::ChunkRange
+  //
+  // A range over the chunks of a Cord, for use in range-based for loops:
+  //
+  //   for (absl::string_view chunk : cord.Chunks()) { ... }
+  class ChunkRange {
+   public:
+    explicit ChunkRange(const Cord* cord) : cord_(cord) {}
+
+    ChunkIterator begin() const { return cord_->chunk_begin(); }
+    ChunkIterator end() const { return cord_->chunk_end(); }
+
+   private:
+    const Cord* cord_;
+  };
+
+  // Cord::Chunks()
+  //
+  // Returns a range over the chunks of the Cord.
+  ChunkRange Chunks() const { return ChunkRange(this); }
+  ChunkIterator chunk_begin() const { return ChunkIterator(this); }
+  ChunkIterator chunk_end() const { return ChunkIterator(); }
+
+  // Cord::operator[]
+  //
+  // Returns the character at position `i`, which must be less than `size()`.
+  // This walks the tree, so prefer `Chunks()` for sequential access.
+  char operator[](size_t i) const;
+
+  // Cord::TryFlat()
+  //
+  // Returns the contents of the Cord as a single `absl::string_view` if they
+  // are already stored contiguously, and `absl::nullopt` otherwise.
+  absl::optional<absl::string_view> TryFlat() const;
+
+  // Cord::Flatten()
+  //
+  // Makes the contents of the Cord contiguous, copying them into a single new
+  // chunk if necessary, and returns a view of them. The view is valid until
+  // the Cord is next modified.
+  absl::string_view Flatten();
+
+  // Support for absl::Hash. A Cord hashes identically to a `std::string` or
+  // `absl::string_view` with the same contents, however it is chunked.
+  template <typename H>
+  friend H AbslHashValue(H hash_state, const absl::Cord& c) {
+    absl::optional<absl::string_view> maybe_flat = c.TryFlat();
+    if (maybe_flat.has_value()) {
+      return H::combine(std::move(hash_state), *maybe_flat);
+    }
+    return c.HashFragmented(std::move(hash_state));
+  }
+
+ private:
+  template <typename Releaser>
+  friend Cord MakeCordFromExternal(absl::string_view data,
+                                   Releaser&& releaser);
+
+  // Returns a tree holding `src`, adopting its buffer if it is large enough.
+  static cord_internal::CordRep* NewTreeFromString(std::string&& src);
+
+  template <typename H>
+  H HashFragmented(H hash_state) const {
+    hash_internal::PiecewiseCombiner combiner;
+    for (absl::string_view chunk : Chunks()) {
+      hash_state = combiner.add_buffer(std::move(hash_state), chunk.data(),
+                                       chunk.size());
+    }
+    return H::combine(combiner.finalize(std::move(hash_state)), size());
+  }
+
+  // The root of the tree, or nullptr for an empty Cord. A non-null tree is
+  // never empty.
+  cord_internal::CordRep* rep_;
+};
+
+// MakeCordFromExternal()
+//
+// Creates a Cord that refers to `data` without copying it. `data` must stay
+// valid and unchanged until `releaser` is invoked, which happens exactly once,
+// when the last Cord sharing the data lets go of it (possibly on another
+// thread). `releaser` is moved into the Cord, and is invoked with the
+// original `data` if it accepts an `absl::string_view`, or with no arguments
+// otherwise. If `data` is empty, `releaser` is invoked immediately.
+//
+// Example:
+//
+//   std::string* buffer = new std::string(ReadFile(path));
+//   absl::Cord cord = absl::MakeCordFromExternal(
+//       *buffer, [buffer](absl::string_view) { delete buffer; });
+template <typename Releaser>
+Cord MakeCordFromExternal(absl::string_view data, Releaser&& releaser) {
+  Cord cord;
+  if (data.empty()) {
+    cord_internal::InvokeReleaser(cord_internal::Rank0{},
+                                  std::forward<Releaser>(releaser), data);
+    return cord;
+  }
+  auto* rep = new cord_internal::CordRepExternalImpl<Releaser>(
+      std::forward<Releaser>(releaser));
+  rep->length = data.size();
+  rep->tag = cord_internal::EXTERNAL;
+  rep->base = data.data();
+  cord.rep_ = rep;
+  return cord;
+}
+
+template <typename T, Cord::EnableIfString<T>>
+Cord& Cord::operator=(T&& src) {
+  return *this = Cord(std::forward<T>(src));
+}
+
+template <typename T, Cord::EnableIfString<T>>
+void Cord::Append(T&& src) {
+  Append(Cord(std::forward<T>(src)));
+}
+
+inline Cord::ChunkIterator& Cord::ChunkIterator::operator++() {
+  assert(bytes_remaining_ >= current_chunk_.size());
+  bytes_remaining_ -= current_chunk_.size();
+  if (stack_of_right_children_.empty()) {
+    assert(bytes_remaining_ == 0);
+    current_chunk_ = absl::string_view();
+    return *this;
+  }
+  return AdvanceStack();
+}
+
+// Comparison operators
+inline bool operator==(const Cord& lhs, const Cord& rhs) {
+  return lhs.size() == rhs.size() && lhs.Compare(rhs) == 0;
+}
+inline bool operator!=(const Cord& lhs, const Cord& rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator<(const Cord& lhs, const Cord& rhs) {
+  return lhs.Compare(rhs) < 0;
+}
+inline bool operator>(const Cord& lhs, const Cord& rhs) {
+  return lhs.Compare(rhs) > 0;
+}
+inline bool operator<=(const Cord& lhs, const Cord& rhs) {
+  return lhs.Compare(rhs) <= 0;
+}
+inline bool operator>=(const Cord& lhs, const Cord& rhs) {
+  return lhs.Compare(rhs) >= 0;
+}
+
+inline bool operator==(const Cord& lhs, absl::string_view rhs) {
+  return lhs.size() == rhs.size() && lhs.Compare(rhs) == 0;
+}
+inline bool operator!=(const Cord& lhs, absl::string_view rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator<(const Cord& lhs, absl::string_view rhs) {
+  return lhs.Compare(rhs) < 0;
+}
+inline bool operator>(const Cord& lhs, absl::string_view rhs) {
+  return lhs.Compare(rhs) > 0;
+}
+inline bool operator<=(const Cord& lhs, absl::string_view rhs) {
+  return lhs.Compare(rhs) <= 0;
+}
+inline bool operator>=(const Cord& lhs, absl::string_view rhs) {
+  return lhs.Compare(rhs) >= 0;
+}
+
+inline bool operator==(absl::string_view lhs, const Cord& rhs) {
+  return rhs == lhs;
+}
+inline bool operator!=(absl::string_view lhs, const Cord& rhs) {
+  return rhs != lhs;
+}
+inline bool operator<(absl::string_view lhs, const Cord& rhs) {
+  return rhs > lhs;
+}
+inline bool operator>(absl::string_view lhs, const Cord& rhs) {
+  return rhs < lhs;
+}
+inline bool operator<=(absl::string_view lhs, const Cord& rhs) {
+  return rhs >= lhs;
+}
+inline bool operator>=(absl::string_view lhs, const Cord& rhs) {
+  return rhs <= lhs;
+}
+
+// Writes the contents of the Cord to `out`.
+std::ostream& operator<<(std::ostream& out, const Cord& cord);
+
+// StrAppend()
+//
+// Appends the string representations of the arguments to `*dest`, as
+// `absl::StrAppend()` does for a `std::string`. Each piece is copied into
+// the spare capacity at the end of the Cord where possible.
+inline void StrAppend(Cord*) {}
+template <typename... AV>
+void StrAppend(Cord* dest, const AlphaNum& a, const AV&... args) {
+  dest->Append(a.Piece());
+  StrAppend(dest, args...);
+}
+
+// StrSplit()
+//
+// Splits a Cord as `absl::StrSplit()` splits a string, using any of its
+// delimiters and (optionally) predicates, and returns the pieces as Cords.
+// A fragmented Cord is flattened into a single shared chunk first, so that
+// the pieces share memory instead of each holding a copy.
+//
+// Example:
+//
+//   std::vector<absl::Cord> fields =
+//       absl::StrSplit(record, ',', absl::SkipEmpty());
+template <typename Delimiter, typename Predicate>
+std::vector<Cord> StrSplit(const Cord& cord, Delimiter d, Predicate p) {
+  Cord flat = cord;
+  // An empty Cord splits like "", not like a null `absl::string_view`.
+  const absl::string_view text = flat.empty() ? "" : flat.Flatten();
+  std::vector<Cord> pieces;
+  for (absl::string_view piece :
+       absl::StrSplit(text, std::move(d), std::move(p))) {
+    pieces.push_back(flat.Subcord(piece.data() - text.data(), piece.size()));
+  }
+  return pieces;
+}
+template <typename Delimiter>
+std::vector<Cord> StrSplit(const Cord& cord, Delimiter d) {
+  return absl::StrSplit(cord, std::move(d), AllowEmpty());
+}
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_CORD_H_
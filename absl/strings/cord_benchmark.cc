@@ -0,0 +1,204 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/cord.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/str_cat.h"
+
+namespace {
+
+// The payloads are assembled from fragments of this size, as they would be
+// when read from the network or a file.
+constexpr size_t kFragmentSize = 4096;
+
+std::vector<std::string> MakeFragments(size_t total) {
+  std::vector<std::string> fragments;
+  for (size_t size = 0; size < total; size += kFragmentSize) {
+    fragments.push_back(std::string(kFragmentSize, static_cast<char>(
+                                                       'a' + size % 26)));
+  }
+  return fragments;
+}
+
+std::vector<absl::Cord> MakeCordFragments(size_t total) {
+  std::vector<absl::Cord> fragments;
+  for (const std::string& s : MakeFragments(total)) {
+    fragments.push_back(absl::Cord(s));
+  }
+  return fragments;
+}
+
+absl::Cord MakePayloadCord(size_t total) {
+  absl::Cord cord;
+  for (const absl::Cord& fragment : MakeCordFragments(total)) {
+    cord.Append(fragment);
+  }
+  return cord;
+}
+
+void BM_AssembleString(benchmark::State& state) {
+  const std::vector<std::string> fragments = MakeFragments(state.range(0));
+  for (auto _ : state) {
+    std::string payload;
+    for (const std::string& fragment : fragments) payload.append(fragment);
+    benchmark::DoNotOptimize(payload);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AssembleString)->Range(1 << 16, 1 << 24);
+
+void BM_AssembleCord(benchmark::State& state) {
+  const std::vector<absl::Cord> fragments = MakeCordFragments(state.range(0));
+  for (auto _ : state) {
+    absl::Cord payload;
+    for (const absl::Cord& fragment : fragments) payload.Append(fragment);
+    benchmark::DoNotOptimize(payload);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AssembleCord)->Range(1 << 16, 1 << 24);
+
+void BM_PrependString(benchmark::State& state) {
+  const std::vector<std::string> fragments = MakeFragments(state.range(0));
+  for (auto _ : state) {
+    std::string payload;
+    for (const std::string& fragment : fragments) payload.insert(0, fragment);
+    benchmark::DoNotOptimize(payload);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PrependString)->Range(1 << 16, 1 << 22);
+
+void BM_PrependCord(benchmark::State& state) {
+  const std::vector<absl::Cord> fragments = MakeCordFragments(state.range(0));
+  for (auto _ : state) {
+    absl::Cord payload;
+    for (const absl::Cord& fragment : fragments) payload.Prepend(fragment);
+    benchmark::DoNotOptimize(payload);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PrependCord)->Range(1 << 16, 1 << 22);
+
+// Many small appends, as when building a message field by field.
+void BM_AppendSmallString(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string out;
+    for (int i = 0; i < state.range(0); ++i) {
+      out.append("0123456789abcdef");
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 16);
+}
+BENCHMARK(BM_AppendSmallString)->Range(16, 1 << 16);
+
+void BM_AppendSmallCord(benchmark::State& state) {
+  for (auto _ : state) {
+    absl::Cord out;
+    for (int i = 0; i < state.range(0); ++i) {
+      out.Append("0123456789abcdef");
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 16);
+}
+BENCHMARK(BM_AppendSmallCord)->Range(16, 1 << 16);
+
+void BM_StrAppendCord(benchmark::State& state) {
+  for (auto _ : state) {
+    absl::Cord out;
+    for (int i = 0; i < state.range(0); ++i) {
+      absl::StrAppend(&out, "key", i, "=", i * 3, ";");
+    }
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_StrAppendCord)->Range(16, 1 << 14);
+
+// Takes the middle half of a payload.
+void BM_SliceString(benchmark::State& state) {
+  std::string payload;
+  for (const std::string& fragment : MakeFragments(state.range(0))) {
+    payload.append(fragment);
+  }
+  for (auto _ : state) {
+    std::string slice = payload.substr(payload.size() / 4, payload.size() / 2);
+    benchmark::DoNotOptimize(slice);
+  }
+}
+BENCHMARK(BM_SliceString)->Range(1 << 16, 1 << 24);
+
+void BM_SliceCord(benchmark::State& state) {
+  const absl::Cord payload = MakePayloadCord(state.range(0));
+  for (auto _ : state) {
+    absl::Cord slice =
+        payload.Subcord(payload.size() / 4, payload.size() / 2);
+    benchmark::DoNotOptimize(slice);
+  }
+}
+BENCHMARK(BM_SliceCord)->Range(1 << 16, 1 << 24);
+
+void BM_IterateChunks(benchmark::State& state) {
+  const absl::Cord payload = MakePayloadCord(state.range(0));
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (absl::string_view chunk : payload.Chunks()) {
+      sum += static_cast<unsigned char>(chunk.front()) + chunk.size();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) /
+                          kFragmentSize);
+}
+BENCHMARK(BM_IterateChunks)->Range(1 << 16, 1 << 24);
+
+void BM_CopyCordToString(benchmark::State& state) {
+  const absl::Cord payload = MakePayloadCord(state.range(0));
+  std::string out;
+  for (auto _ : state) {
+    CopyCordToString(payload, &out);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CopyCordToString)->Range(1 << 16, 1 << 24);
+
+void BM_HashString(benchmark::State& state) {
+  std::string payload;
+  for (const std::string& fragment : MakeFragments(state.range(0))) {
+    payload.append(fragment);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Hash<std::string>()(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashString)->Range(1 << 12, 1 << 20);
+
+void BM_HashCord(benchmark::State& state) {
+  const absl::Cord payload = MakePayloadCord(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Hash<absl::Cord>()(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashCord)->Range(1 << 12, 1 << 20);
+
+}  // namespace
@@ -0,0 +1,460 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/cord.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/hash/hash_testing.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+
+namespace {
+
+// Returns a Cord whose chunks are exactly `pieces`, by adopting a heap copy of
+// each one as external memory. Prepending a Cord always shares it, whereas
+// small Cords are copied when appended.
+absl::Cord MakeFragmentedCord(const std::vector<std::string>& pieces) {
+  absl::Cord cord;
+  for (auto it = pieces.rbegin(); it != pieces.rend(); ++it) {
+    std::string* copy = new std::string(*it);
+    cord.Prepend(absl::MakeCordFromExternal(
+        *copy, [copy](absl::string_view) { delete copy; }));
+  }
+  return cord;
+}
+
+std::vector<std::string> ChunksOf(const absl::Cord& cord) {
+  std::vector<std::string> chunks;
+  for (absl::string_view chunk : cord.Chunks()) {
+    chunks.push_back(std::string(chunk));
+  }
+  return chunks;
+}
+
+std::string RandomString(std::minstd_rand* rng, size_t length) {
+  std::uniform_int_distribution<int> chars('a', 'z');
+  std::string s(length, '\0');
+  for (char& c : s) c = static_cast<char>(chars(*rng));
+  return s;
+}
+
+TEST(Cord, Empty) {
+  absl::Cord cord;
+  EXPECT_TRUE(cord.empty());
+  EXPECT_EQ(cord.size(), 0);
+  EXPECT_EQ(std::string(cord), "");
+  EXPECT_TRUE(ChunksOf(cord).empty());
+  EXPECT_EQ(cord.TryFlat(), absl::string_view());
+  EXPECT_EQ(cord.Flatten(), "");
+
+  EXPECT_TRUE(absl::Cord("").empty());
+  cord.Append("");
+  cord.Prepend("");
+  cord.Append(absl::Cord());
+  EXPECT_TRUE(cord.empty());
+}
+
+TEST(Cord, ConstructionAndAssignment) {
+  absl::Cord a("hello");
+  EXPECT_EQ(a.size(), 5);
+  EXPECT_EQ(a, "hello");
+
+  absl::Cord b = a;
+  EXPECT_EQ(b, "hello");
+  absl::Cord c = std::move(b);
+  EXPECT_EQ(c, "hello");
+  EXPECT_TRUE(b.empty());  // NOLINT(bugprone-use-after-move)
+
+  c = "world";
+  EXPECT_EQ(c, "world");
+  EXPECT_EQ(a, "hello");
+  c = a;
+  EXPECT_EQ(c, "hello");
+
+  const std::string big(10000, 'x');
+  absl::Cord d(big);
+  EXPECT_EQ(std::string(d), big);
+  d = absl::string_view(std::string(d)).substr(10);
+  EXPECT_EQ(d.size(), 9990);
+
+  // Assigning a view of the Cord's own contents.
+  absl::Cord e("abcdef");
+  e = e.Flatten().substr(2);
+  EXPECT_EQ(e, "cdef");
+
+  std::string moved(5000, 'm');
+  const char* data = moved.data();
+  absl::Cord adopted(std::move(moved));
+  EXPECT_EQ(adopted, std::string(5000, 'm'));
+  ASSERT_TRUE(adopted.TryFlat().has_value());
+  EXPECT_EQ(adopted.TryFlat()->data(), data);
+
+  absl::Cord small(std::string("tiny"));
+  EXPECT_EQ(small, "tiny");
+  small = std::string(600, 's');
+  EXPECT_EQ(small, std::string(600, 's'));
+}
+
+TEST(Cord, AppendAndPrepend) {
+  std::string expected;
+  absl::Cord cord;
+  for (int i = 0; i < 1000; ++i) {
+    const std::string piece = absl::StrCat(i, ",");
+    cord.Append(piece);
+    expected += piece;
+  }
+  EXPECT_EQ(std::string(cord), expected);
+
+  cord.Prepend("<");
+  cord.Append(">");
+  EXPECT_EQ(std::string(cord), "<" + expected + ">");
+
+  absl::Cord other(std::string(2000, 'z'));
+  cord.Append(other);
+  cord.Prepend(other);
+  EXPECT_EQ(std::string(cord),
+            std::string(2000, 'z') + "<" + expected + ">" +
+                std::string(2000, 'z'));
+  EXPECT_EQ(other, std::string(2000, 'z'));
+
+  cord.Append(absl::Cord("tail"));
+  EXPECT_TRUE(cord.EndsWith("zztail"));
+}
+
+TEST(Cord, AppendSelf) {
+  absl::Cord small("ab");
+  small.Append(small);
+  EXPECT_EQ(small, "abab");
+
+  absl::Cord big(std::string(3000, 'q'));
+  big.Append(big);
+  EXPECT_EQ(big, std::string(6000, 'q'));
+  big.Prepend(big);
+  EXPECT_EQ(big, std::string(12000, 'q'));
+
+  absl::Cord view("0123456789");
+  view.Append(view.Flatten().substr(5));
+  EXPECT_EQ(view, "012345678956789");
+}
+
+TEST(Cord, AppendSelfMoved) {
+  absl::Cord small("ab");
+  small.Append(std::move(small));
+  EXPECT_EQ(small, "abab");
+
+  absl::Cord big(std::string(3000, 'q'));
+  big.Append(std::move(big));
+  EXPECT_EQ(big, std::string(6000, 'q'));
+}
+
+TEST(Cord, AppendDoesNotModifySharedCopies) {
+  absl::Cord a;
+  a.Append("abc");
+  absl::Cord b = a;
+  a.Append("def");
+  b.Append("xyz");
+  EXPECT_EQ(a, "abcdef");
+  EXPECT_EQ(b, "abcxyz");
+
+  absl::Cord tree(std::string(5000, 'x'));
+  tree.Append("y");
+  absl::Cord copy = tree;
+  tree.Append("1");
+  copy.Append("2");
+  EXPECT_EQ(tree, std::string(5000, 'x') + "y1");
+  EXPECT_EQ(copy, std::string(5000, 'x') + "y2");
+}
+
+TEST(Cord, SmallAppendsReuseCapacity) {
+  absl::Cord cord;
+  for (int i = 0; i < 100000; ++i) cord.Append("x");
+  EXPECT_EQ(cord.size(), 100000);
+  // Appends fill flats of up to 4K rather than creating one leaf apiece.
+  EXPECT_LT(ChunksOf(cord).size(), 100);
+  EXPECT_LT(cord.EstimatedMemoryUsage(), 2 * cord.size());
+}
+
+TEST(Cord, Subcord) {
+  std::minstd_rand rng(42);
+  std::vector<std::string> pieces;
+  std::string expected;
+  for (int i = 0; i < 50; ++i) {
+    pieces.push_back(RandomString(&rng, rng() % 200 + 1));
+    expected += pieces.back();
+  }
+  const absl::Cord cord = MakeFragmentedCord(pieces);
+  ASSERT_EQ(std::string(cord), expected);
+
+  for (int i = 0; i < 500; ++i) {
+    const size_t pos = rng() % (expected.size() + 10);
+    const size_t n = rng() % (expected.size() + 10);
+    const absl::Cord sub = cord.Subcord(pos, n);
+    const std::string want =
+        pos > expected.size() ? "" : expected.substr(pos, n);
+    EXPECT_EQ(std::string(sub), want) << pos << " " << n;
+    EXPECT_EQ(sub.size(), want.size());
+
+    // Subcords of Subcords.
+    const size_t pos2 = rng() % (want.size() + 1);
+    EXPECT_EQ(std::string(sub.Subcord(pos2, 17)), want.substr(pos2, 17));
+  }
+  EXPECT_EQ(std::string(cord), expected);
+}
+
+TEST(Cord, RemovePrefixAndSuffix) {
+  absl::Cord cord = MakeFragmentedCord({"abc", "defg", "hi", "jklmn"});
+  cord.RemovePrefix(2);
+  EXPECT_EQ(cord, "cdefghijklmn");
+  cord.RemoveSuffix(3);
+  EXPECT_EQ(cord, "cdefghijk");
+  cord.RemovePrefix(4);
+  EXPECT_EQ(cord, "ghijk");
+  cord.RemoveSuffix(0);
+  cord.RemovePrefix(0);
+  EXPECT_EQ(cord, "ghijk");
+  cord.RemovePrefix(5);
+  EXPECT_TRUE(cord.empty());
+
+  absl::Cord flat("0123456789");
+  absl::Cord copy = flat;
+  flat.RemovePrefix(3);
+  flat.RemoveSuffix(3);
+  EXPECT_EQ(flat, "3456");
+  EXPECT_EQ(copy, "0123456789");
+}
+
+TEST(Cord, ExternalMemory) {
+  int releases = 0;
+  std::string released_data;
+  const char kData[] = "external data";
+  {
+    absl::Cord cord = absl::MakeCordFromExternal(
+        kData, [&](absl::string_view data) {
+          ++releases;
+          released_data = std::string(data);
+        });
+    EXPECT_EQ(cord, kData);
+    EXPECT_EQ(cord.TryFlat()->data(), kData);
+
+    absl::Cord sub = cord.Subcord(9, 4);
+    cord.Clear();
+    EXPECT_EQ(releases, 0);
+    EXPECT_EQ(sub, "data");
+  }
+  EXPECT_EQ(releases, 1);
+  EXPECT_EQ(released_data, kData);
+
+  // A releaser taking no arguments, and one called for empty data.
+  int no_arg_releases = 0;
+  {
+    absl::Cord cord = absl::MakeCordFromExternal(
+        "x", [&no_arg_releases] { ++no_arg_releases; });
+    absl::Cord copy = cord;
+  }
+  EXPECT_EQ(no_arg_releases, 1);
+  absl::Cord empty = absl::MakeCordFromExternal(
+      "", [&no_arg_releases] { ++no_arg_releases; });
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(no_arg_releases, 2);
+}
+
+TEST(Cord, Chunks) {
+  const absl::Cord cord = MakeFragmentedCord({"ab", "cde", "f"});
+  EXPECT_THAT(ChunksOf(cord), testing::ElementsAre("ab", "cde", "f"));
+
+  absl::Cord::ChunkIterator it = cord.chunk_begin();
+  EXPECT_EQ(*it, "ab");
+  EXPECT_EQ(it->size(), 2);
+  EXPECT_EQ(*it++, "ab");
+  EXPECT_EQ(*it, "cde");
+  ++it;
+  ++it;
+  EXPECT_TRUE(it == cord.chunk_end());
+
+  EXPECT_FALSE(cord.TryFlat().has_value());
+}
+
+TEST(Cord, Compare) {
+  const absl::Cord abc = MakeFragmentedCord({"a", "bc"});
+  const absl::Cord abd = MakeFragmentedCord({"ab", "d"});
+  EXPECT_EQ(abc.Compare(abd), -1);
+  EXPECT_EQ(abd.Compare(abc), 1);
+  EXPECT_EQ(abc.Compare(absl::Cord("abc")), 0);
+  EXPECT_EQ(abc.Compare("ab"), 1);
+  EXPECT_EQ(abc.Compare("abcd"), -1);
+  EXPECT_EQ(abc.Compare(""), 1);
+  EXPECT_EQ(absl::Cord().Compare(""), 0);
+  EXPECT_EQ(absl::Cord().Compare(abc), -1);
+
+  EXPECT_TRUE(abc == "abc");
+  EXPECT_TRUE("abc" == abc);
+  EXPECT_TRUE(abc != abd);
+  EXPECT_TRUE(abc < abd);
+  EXPECT_TRUE(abd > abc);
+  EXPECT_TRUE(abc <= "abc");
+  EXPECT_TRUE("abd" >= abc);
+  EXPECT_TRUE(std::string("abb") < abc);
+
+  EXPECT_TRUE(abc.StartsWith("ab"));
+  EXPECT_TRUE(abc.StartsWith(""));
+  EXPECT_FALSE(abc.StartsWith("abcd"));
+  EXPECT_FALSE(abc.StartsWith("ac"));
+  EXPECT_TRUE(abc.StartsWith(absl::Cord("a")));
+  EXPECT_TRUE(abc.EndsWith("bc"));
+  EXPECT_FALSE(abc.EndsWith("b"));
+  EXPECT_TRUE(abc.EndsWith(absl::Cord("abc")));
+}
+
+TEST(Cord, IndexAndFlatten) {
+  absl::Cord cord = MakeFragmentedCord({"ab", "cde", "f"});
+  std::string collected;
+  for (size_t i = 0; i < cord.size(); ++i) collected += cord[i];
+  EXPECT_EQ(collected, "abcdef");
+
+  absl::Cord copy = cord;
+  EXPECT_EQ(cord.Flatten(), "abcdef");
+  EXPECT_TRUE(cord.TryFlat().has_value());
+  EXPECT_EQ(copy, "abcdef");
+  EXPECT_THAT(ChunksOf(copy), testing::ElementsAre("ab", "cde", "f"));
+}
+
+TEST(Cord, ManyAppendsStayBalanced) {
+  // Appending many shared leaves exercises rebalancing; a degenerate tree
+  // would make this test quadratic and blow the stack when destroyed.
+  const absl::Cord piece(std::string(600, 'p'));
+  absl::Cord cord;
+  for (int i = 0; i < 20000; ++i) {
+    cord.Append(piece);
+    cord.Prepend(piece);
+  }
+  EXPECT_EQ(cord.size(), 40000 * 600);
+  EXPECT_EQ(cord[cord.size() / 2], 'p');
+  EXPECT_EQ(cord.Subcord(12345, 3), "ppp");
+  size_t chunks = 0;
+  for (absl::string_view chunk : cord.Chunks()) {
+    EXPECT_EQ(chunk.size(), 600);
+    ++chunks;
+  }
+  EXPECT_EQ(chunks, 40000);
+}
+
+TEST(Cord, RandomOperations) {
+  std::minstd_rand rng(7);
+  absl::Cord cord;
+  std::string expected;
+  for (int i = 0; i < 2000; ++i) {
+    const std::string s = RandomString(&rng, rng() % 700);
+    switch (rng() % 6) {
+      case 0:
+        cord.Append(s);
+        expected += s;
+        break;
+      case 1:
+        cord.Prepend(s);
+        expected = s + expected;
+        break;
+      case 2:
+        cord.Append(absl::Cord(s));
+        expected += s;
+        break;
+      case 3: {
+        const size_t n = rng() % (expected.size() / 4 + 1);
+        cord.RemovePrefix(n);
+        expected.erase(0, n);
+        break;
+      }
+      case 4: {
+        const size_t n = rng() % (expected.size() / 4 + 1);
+        cord.RemoveSuffix(n);
+        expected.erase(expected.size() - n);
+        break;
+      }
+      default: {
+        const size_t pos = rng() % (expected.size() + 1);
+        cord.Append(cord.Subcord(pos, s.size()));
+        expected += expected.substr(pos, s.size());
+        break;
+      }
+    }
+    ASSERT_EQ(cord.size(), expected.size());
+  }
+  EXPECT_EQ(std::string(cord), expected);
+}
+
+TEST(Cord, Hash) {
+  const std::string big = std::string(3000, 'b') + "end";
+  std::vector<std::string> big_pieces;
+  for (size_t i = 0; i < big.size(); i += 700) {
+    big_pieces.push_back(big.substr(i, 700));
+  }
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly(std::make_tuple(
+      absl::Cord(), std::string(), absl::Cord("abc"),
+      MakeFragmentedCord({"a", "bc"}), std::string("abc"),
+      absl::string_view("abd"), MakeFragmentedCord({"ab", "d"}),
+      absl::Cord(big), MakeFragmentedCord(big_pieces), big,
+      MakeFragmentedCord({std::string(1024, 'k'), std::string(1024, 'k')}),
+      std::string(2048, 'k'), absl::Cord(std::string(1024, 'k')),
+      MakeFragmentedCord({std::string(1000, 'k'), std::string(24, 'k')}))));
+
+  EXPECT_EQ(absl::Hash<absl::Cord>()(MakeFragmentedCord(big_pieces)),
+            absl::Hash<std::string>()(big));
+}
+
+TEST(Cord, StrFormat) {
+  const absl::Cord cord = MakeFragmentedCord({"ab", "cd"});
+  EXPECT_EQ(absl::StrFormat("[%s]", cord), "[abcd]");
+  EXPECT_EQ(absl::StrFormat("[%6s]", cord), "[  abcd]");
+  EXPECT_EQ(absl::StrFormat("[%-6s]", cord), "[abcd  ]");
+  EXPECT_EQ(absl::StrFormat("[%.3s]", cord), "[abc]");
+
+  absl::Cord out("x=");
+  absl::Format(&out, "%d;%s", 42, cord);
+  EXPECT_EQ(out, "x=42;abcd");
+}
+
+TEST(Cord, StrAppend) {
+  absl::Cord cord("a");
+  absl::StrAppend(&cord);
+  absl::StrAppend(&cord, 1);
+  absl::StrAppend(&cord, "b", 2.5, absl::Hex(255), std::string("c"));
+  EXPECT_EQ(cord, "a1b2.5ffc");
+
+  std::stringstream out;
+  out << MakeFragmentedCord({"x", "yz"});
+  EXPECT_EQ(out.str(), "xyz");
+}
+
+TEST(Cord, StrSplit) {
+  const absl::Cord cord = MakeFragmentedCord({"a,b", "b,,c", "cc,"});
+  EXPECT_THAT(absl::StrSplit(cord, ','),
+              testing::ElementsAre("a", "bb", "", "ccc", ""));
+  EXPECT_THAT(absl::StrSplit(cord, ',', absl::SkipEmpty()),
+              testing::ElementsAre("a", "bb", "ccc"));
+  EXPECT_THAT(absl::StrSplit(cord, absl::ByString("b,")),
+              testing::ElementsAre("a,b", ",ccc,"));
+  EXPECT_THAT(absl::StrSplit(absl::Cord(), ','), testing::ElementsAre(""));
+  EXPECT_EQ(std::string(cord), "a,bb,,ccc,");
+}
+
+}  // namespace
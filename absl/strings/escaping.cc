@@ -26,6 +26,7 @@
 #include "absl/base/internal/raw_logging.h"
 #include "absl/base/internal/unaligned_access.h"
 #include "absl/strings/internal/char_map.h"
+#include "absl/strings/internal/escaping_simd.h"
 #include "absl/strings/internal/resize_uninitialized.h"
 #include "absl/strings/internal/utf8.h"
 #include "absl/strings/str_cat.h"
@@ -107,12 +108,17 @@ bool CUnescapeInternal(absl::string_view source, bool leave_nulls_escaped,
   const char* end = p + source.size();
   const char* last_byte = end - 1;
 
-  // Small optimization for case where source = dest and there's no escaping
-  while (p == d && p < end && *p != '\\') p++, d++;
-
   while (p < end) {
     if (*p != '\\') {
-      *d++ = *p++;
+      // Copy everything up to the next escape sequence in one go; memchr is
+      // typically vectorized, and most input has few escapes, if any.
+      const void* backslash = std::memchr(p, '\\', end - p);
+      const char* run_end =
+          backslash ? static_cast<const char*>(backslash) : end;
+      // 'source' and 'dest' may overlap, with 'd' never ahead of 'p'.
+      if (d != p) std::memmove(d, p, run_end - p);
+      d += run_end - p;
+      p = run_end;
     } else {
       if (++p > last_byte) {  // skip past the '\\'
         if (error) *error = "String cannot end with \\";
@@ -314,6 +320,19 @@ bool CUnescapeInternal(absl::string_view source, bool leave_nulls_escaped,
   return true;
 }
 
+// The escaping loops below alternate between copying a run of bytes that need
+// no escaping, found by a vectorized scan, and handling a block of bytes one at
+// a time. The blocks grow while the scans keep finding only short runs, so
+// heavily escaped input pays little for scanning.
+constexpr ptrdiff_t kMinEscapeBlock = 16;
+constexpr ptrdiff_t kMaxEscapeBlock = 512;
+constexpr size_t kShortCleanRun = 8;
+
+inline ptrdiff_t NextEscapeBlock(size_t run, ptrdiff_t block) {
+  return run < kShortCleanRun ? std::min(2 * block, kMaxEscapeBlock)
+                              : kMinEscapeBlock;
+}
+
 // ----------------------------------------------------------------------
 // CEscape()
 // CHexEscape()
@@ -328,41 +347,60 @@ bool CUnescapeInternal(absl::string_view source, bool leave_nulls_escaped,
 std::string CEscapeInternal(absl::string_view src, bool use_hex,
                             bool utf8_safe) {
   std::string dest;
+  dest.reserve(src.size());
+  const strings_internal::SimdLevel level = strings_internal::BestSimdLevel();
   bool last_hex_escape = false;  // true if last output char was \xNN.
 
-  for (unsigned char c : src) {
-    bool is_hex_escape = false;
-    switch (c) {
-      case '\n': dest.append("\\" "n"); break;
-      case '\r': dest.append("\\" "r"); break;
-      case '\t': dest.append("\\" "t"); break;
-      case '\"': dest.append("\\" "\""); break;
-      case '\'': dest.append("\\" "'"); break;
-      case '\\': dest.append("\\" "\\"); break;
-      default:
-        // Note that if we emit \xNN and the src character after that is a hex
-        // digit then that digit must be escaped too to prevent it being
-        // interpreted as part of the character code by C.
-        if ((!utf8_safe || c < 0x80) &&
-            (!absl::ascii_isprint(c) ||
-             (last_hex_escape && absl::ascii_isxdigit(c)))) {
-          if (use_hex) {
-            dest.append("\\" "x");
-            dest.push_back(kHexChar[c / 16]);
-            dest.push_back(kHexChar[c % 16]);
-            is_hex_escape = true;
+  const char* p = src.data();
+  const char* const end = p + src.size();
+  ptrdiff_t block = kMinEscapeBlock;
+  while (p < end) {
+    // Copy the run of bytes that need no escaping in one go, unless a hex
+    // escape was just emitted, and then take up to a block byte by byte.
+    if (!last_hex_escape) {
+      const size_t run =
+          strings_internal::CEscapeCleanPrefixSimd(level, p, end - p,
+                                                   utf8_safe);
+      if (run != 0) dest.append(p, run);
+      p += run;
+      block = NextEscapeBlock(run, block);
+    }
+    const char* const block_end = end - p > block ? p + block : end;
+    while (p < block_end) {
+      const unsigned char c = *p++;
+      bool is_hex_escape = false;
+      switch (c) {
+        case '\n': dest.append("\\" "n"); break;
+        case '\r': dest.append("\\" "r"); break;
+        case '\t': dest.append("\\" "t"); break;
+        case '\"': dest.append("\\" "\""); break;
+        case '\'': dest.append("\\" "'"); break;
+        case '\\': dest.append("\\" "\\"); break;
+        default:
+          // Note that if we emit \xNN and the src character after that is a hex
+          // digit then that digit must be escaped too to prevent it being
+          // interpreted as part of the character code by C.
+          if ((!utf8_safe || c < 0x80) &&
+              (!absl::ascii_isprint(c) ||
+               (last_hex_escape && absl::ascii_isxdigit(c)))) {
+            if (use_hex) {
+              const char escape[4] = {'\\', 'x', kHexTable[c * 2],
+                                      kHexTable[c * 2 + 1]};
+              dest.append(escape, sizeof(escape));
+              is_hex_escape = true;
+            } else {
+              dest.append("\\");
+              dest.push_back(kHexChar[c / 64]);
+              dest.push_back(kHexChar[(c % 64) / 8]);
+              dest.push_back(kHexChar[c % 8]);
+            }
           } else {
-            dest.append("\\");
-            dest.push_back(kHexChar[c / 64]);
-            dest.push_back(kHexChar[(c % 64) / 8]);
-            dest.push_back(kHexChar[c % 8]);
+            dest.push_back(c);
+            break;
           }
-        } else {
-          dest.push_back(c);
-          break;
-        }
+      }
+      last_hex_escape = is_hex_escape;
     }
-    last_hex_escape = is_hex_escape;
   }
 
   return dest;
@@ -392,14 +430,29 @@ constexpr char c_escaped_len[256] = {
 // Calculates the length of the C-style escaped version of 'src'.
 // Assumes that non-printable characters are escaped using octal sequences, and
 // that UTF-8 bytes are not handled specially.
-inline size_t CEscapedLength(absl::string_view src) {
+inline size_t CEscapedLength(absl::string_view src,
+                             strings_internal::SimdLevel level) {
   size_t escaped_len = 0;
-  for (unsigned char c : src) escaped_len += c_escaped_len[c];
+  const char* p = src.data();
+  const char* const end = p + src.size();
+  ptrdiff_t block = kMinEscapeBlock;
+  while (p < end) {
+    const size_t run =
+        strings_internal::CEscapeCleanPrefixSimd(level, p, end - p, false);
+    escaped_len += run;
+    p += run;
+    block = NextEscapeBlock(run, block);
+    const char* const block_end = end - p > block ? p + block : end;
+    for (; p < block_end; ++p) {
+      escaped_len += c_escaped_len[static_cast<unsigned char>(*p)];
+    }
+  }
   return escaped_len;
 }
 
 void CEscapeAndAppendInternal(absl::string_view src, std::string* dest) {
-  size_t escaped_len = CEscapedLength(src);
+  const strings_internal::SimdLevel level = strings_internal::BestSimdLevel();
+  size_t escaped_len = CEscapedLength(src, level);
   if (escaped_len == src.size()) {
     dest->append(src.data(), src.size());
     return;
@@ -410,42 +463,55 @@ void CEscapeAndAppendInternal(absl::string_view src, std::string* dest) {
                                                  cur_dest_len + escaped_len);
   char* append_ptr = &(*dest)[cur_dest_len];
 
-  for (unsigned char c : src) {
-    int char_len = c_escaped_len[c];
-    if (char_len == 1) {
-      *append_ptr++ = c;
-    } else if (char_len == 2) {
-      switch (c) {
-        case '\n':
-          *append_ptr++ = '\\';
-          *append_ptr++ = 'n';
-          break;
-        case '\r':
-          *append_ptr++ = '\\';
-          *append_ptr++ = 'r';
-          break;
-        case '\t':
-          *append_ptr++ = '\\';
-          *append_ptr++ = 't';
-          break;
-        case '\"':
-          *append_ptr++ = '\\';
-          *append_ptr++ = '\"';
-          break;
-        case '\'':
-          *append_ptr++ = '\\';
-          *append_ptr++ = '\'';
-          break;
-        case '\\':
-          *append_ptr++ = '\\';
-          *append_ptr++ = '\\';
-          break;
+  const char* p = src.data();
+  const char* const end = p + src.size();
+  ptrdiff_t block = kMinEscapeBlock;
+  while (p < end) {
+    const size_t run =
+        strings_internal::CEscapeCleanPrefixSimd(level, p, end - p, false);
+    if (run != 0) std::memcpy(append_ptr, p, run);
+    append_ptr += run;
+    p += run;
+    block = NextEscapeBlock(run, block);
+    const char* const block_end = end - p > block ? p + block : end;
+    while (p < block_end) {
+      const unsigned char c = *p++;
+      int char_len = c_escaped_len[c];
+      if (char_len == 1) {
+        *append_ptr++ = c;
+      } else if (char_len == 2) {
+        switch (c) {
+          case '\n':
+            *append_ptr++ = '\\';
+            *append_ptr++ = 'n';
+            break;
+          case '\r':
+            *append_ptr++ = '\\';
+            *append_ptr++ = 'r';
+            break;
+          case '\t':
+            *append_ptr++ = '\\';
+            *append_ptr++ = 't';
+            break;
+          case '\"':
+            *append_ptr++ = '\\';
+            *append_ptr++ = '\"';
+            break;
+          case '\'':
+            *append_ptr++ = '\\';
+            *append_ptr++ = '\'';
+            break;
+          case '\\':
+            *append_ptr++ = '\\';
+            *append_ptr++ = '\\';
+            break;
+        }
+      } else {
+        *append_ptr++ = '\\';
+        *append_ptr++ = '0' + c / 64;
+        *append_ptr++ = '0' + (c % 64) / 8;
+        *append_ptr++ = '0' + c % 8;
       }
-    } else {
-      *append_ptr++ = '\\';
-      *append_ptr++ = '0' + c / 64;
-      *append_ptr++ = '0' + (c % 64) / 8;
-      *append_ptr++ = '0' + c % 8;
     }
   }
 }
@@ -837,8 +903,12 @@ size_t Base64EscapeInternal(const unsigned char* src, size_t szsrc, char* dest,
 
   if (szsrc * 4 > szdest * 3) return 0;
 
-  char* cur_dest = dest;
-  const unsigned char* cur_src = src;
+  // Encode the bulk of the input with vector instructions where available.
+  const size_t vectorized = strings_internal::Base64EncodeSimd(
+      strings_internal::BestSimdLevel(), src, szsrc, dest, base64[62],
+      base64[63]);
+  char* cur_dest = dest + vectorized / 3 * 4;
+  const unsigned char* cur_src = src + vectorized;
 
   char* const limit_dest = dest + szdest;
   const unsigned char* const limit_src = src + szsrc;
@@ -956,7 +1026,8 @@ void Base64EscapeInternal(const unsigned char* src, size_t szsrc, String* dest,
 
 template <typename String>
 bool Base64UnescapeInternal(const char* src, size_t slen, String* dest,
-                            const signed char* unbase64) {
+                            const signed char* unbase64,
+                            const char* base64_chars) {
   // Determine the size of the output std::string.  Base64 encodes every 3 bytes into
   // 4 characters.  any leftover chars are added directly for good measure.
   // This is documented in the base64 RFC: http://tools.ietf.org/html/rfc3548
@@ -966,9 +1037,75 @@ bool Base64UnescapeInternal(const char* src, size_t slen, String* dest,
 
   // We are getting the destination buffer by getting the beginning of the
   // std::string and converting it into a char *.
+  // Decode the bulk of the input with vector instructions where available,
+  // leaving anything they do not handle (such as padding) to the scalar
+  // decoder.
+  char* const out = &(*dest)[0];
+  const strings_internal::SimdLevel level = strings_internal::BestSimdLevel();
+  size_t consumed = 0;
+  size_t decoded = 0;
+  while (level != strings_internal::SimdLevel::kNone) {
+    const size_t vectorized = strings_internal::Base64DecodeSimd(
+        level, src + consumed, slen - consumed, out + decoded,
+        dest_len - decoded, base64_chars[62], base64_chars[63]);
+    consumed += vectorized;
+    decoded += vectorized / 4 * 3;
+
+    // The kernel stops at the group holding the first character outside the
+    // alphabet, often a line break, or near the end of the input. Skip the
+    // whitespace between groups and resume it.
+    size_t next = consumed;
+    while (next < slen && absl::ascii_isspace(src[next])) ++next;
+    if (next != consumed) {
+      consumed = next;
+      continue;
+    }
+
+    // Otherwise decode the remaining groups here, and once a group has had
+    // whitespace skipped in it, resume the kernel after it. Anything else ends
+    // the loop.
+    bool resume = false;
+    while (!resume && decoded + 3 <= dest_len) {
+      const unsigned char* group_src =
+          reinterpret_cast<const unsigned char*>(src) + consumed;
+      unsigned int group;
+      if (consumed + 4 <= slen &&
+          !((group = (unsigned(unbase64[group_src[0]]) << 18) |
+                     (unsigned(unbase64[group_src[1]]) << 12) |
+                     (unsigned(unbase64[group_src[2]]) << 6) |
+                     unsigned(unbase64[group_src[3]])) &
+            0x80000000)) {
+        consumed += 4;
+      } else {
+        // The group holds whitespace, or worse.
+        next = consumed;
+        int chars = 0;
+        group = 0;
+        while (chars < 4 && next < slen) {
+          const unsigned char ch = static_cast<unsigned char>(src[next++]);
+          if (absl::ascii_isspace(ch)) continue;
+          const int value = unbase64[ch];
+          if (value < 0) break;
+          group = (group << 6) | value;
+          ++chars;
+        }
+        if (chars < 4) break;
+        consumed = next;
+        resume = true;
+      }
+      out[decoded] = static_cast<char>(group >> 16);
+      out[decoded + 1] = static_cast<char>(group >> 8);
+      out[decoded + 2] = static_cast<char>(group);
+      decoded += 3;
+    }
+    if (!resume) break;
+  }
+
   size_t len;
-  const bool ok =
-      Base64UnescapeInternal(src, slen, &(*dest)[0], dest_len, unbase64, &len);
+  const bool ok = Base64UnescapeInternal(
+      src + consumed, slen - consumed, out + decoded, dest_len - decoded,
+      unbase64, &len);
+  len += decoded;
   if (!ok) {
     dest->clear();
     return false;
@@ -1079,11 +1216,13 @@ std::string Utf8SafeCHexEscape(absl::string_view src) {
 // ----------------------------------------------------------------------
 
 bool Base64Unescape(absl::string_view src, std::string* dest) {
-  return Base64UnescapeInternal(src.data(), src.size(), dest, kUnBase64);
+  return Base64UnescapeInternal(src.data(), src.size(), dest, kUnBase64,
+                                kBase64Chars);
 }
 
 bool WebSafeBase64Unescape(absl::string_view src, std::string* dest) {
-  return Base64UnescapeInternal(src.data(), src.size(), dest, kUnWebSafeBase64);
+  return Base64UnescapeInternal(src.data(), src.size(), dest,
+                                kUnWebSafeBase64, kWebSafeBase64Chars);
 }
 
 void Base64Escape(absl::string_view src, std::string* dest) {
@@ -1112,18 +1251,42 @@ std::string WebSafeBase64Escape(absl::string_view src) {
 
 std::string HexStringToBytes(absl::string_view from) {
   std::string result;
-  const auto num = from.size() / 2;
-  strings_internal::STLStringResizeUninitialized(&result, num);
-  absl::HexStringToBytesInternal<std::string&>(from.data(), result, num);
+  strings_internal::STLStringResizeUninitialized(&result, from.size() / 2);
+  HexStringToBytes(from, absl::MakeSpan(&result[0], result.size()));
   return result;
 }
 
+size_t HexStringToBytes(absl::string_view from, absl::Span<char> to) {
+  const size_t num = std::min(from.size() / 2, to.size());
+  // Short inputs, such as a single id, are not worth dispatching.
+  const size_t vectorized =
+      num < 16 ? 0
+               : strings_internal::HexDecodeSimd(
+                     strings_internal::BestSimdLevel(), from.data(),
+                     to.data(), num);
+  absl::HexStringToBytesInternal<char*>(from.data() + 2 * vectorized,
+                                        to.data() + vectorized,
+                                        num - vectorized);
+  return num;
+}
+
 std::string BytesToHexString(absl::string_view from) {
   std::string result;
   strings_internal::STLStringResizeUninitialized(&result, 2 * from.size());
-  absl::BytesToHexStringInternal<std::string&>(
-      reinterpret_cast<const unsigned char*>(from.data()), result, from.size());
+  BytesToHexString(from, absl::MakeSpan(&result[0], result.size()));
   return result;
 }
 
+size_t BytesToHexString(absl::string_view from, absl::Span<char> to) {
+  const size_t num = std::min(from.size(), to.size() / 2);
+  const auto* src = reinterpret_cast<const unsigned char*>(from.data());
+  const size_t vectorized =
+      num < 16 ? 0
+               : strings_internal::HexEncodeSimd(
+                     strings_internal::BestSimdLevel(), src, num, to.data());
+  absl::BytesToHexStringInternal<char*>(
+      src + vectorized, to.data() + 2 * vectorized, num - vectorized);
+  return 2 * num;
+}
+
 }  // namespace absl
@@ -31,6 +31,7 @@
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace absl {
 
@@ -151,12 +152,35 @@ std::string WebSafeBase64Escape(absl::string_view src);
 // `from.size()/2`.
 std::string HexStringToBytes(absl::string_view from);
 
+// Converts an ASCII hex string into bytes written to the front of `to`,
+// without allocating. Returns the number of bytes written, which is
+// `from.size()/2` unless `to` is too small to hold them all, in which case
+// only the first `to.size()` bytes are converted.
+//
+// Example:
+//
+//   char id[16];
+//   absl::HexStringToBytes(hex_id, absl::MakeSpan(id));
+size_t HexStringToBytes(absl::string_view from, absl::Span<char> to);
+
 // BytesToHexString()
 //
 // Converts binary data into an ASCII text string, returning a string of size
 // `2*from.size()`.
 std::string BytesToHexString(absl::string_view from);
 
+// Converts binary data into lowercase hex written to the front of `to`,
+// without allocating. Returns the number of characters written, which is
+// `2*from.size()` unless `to` is too small to hold them all, in which case
+// only the first `to.size()/2` bytes are converted.
+//
+// Example:
+//
+//   char buf[64];
+//   size_t len = absl::BytesToHexString(digest, absl::MakeSpan(buf));
+//   LOG(INFO) << "digest " << absl::string_view(buf, len);
+size_t BytesToHexString(absl::string_view from, absl::Span<char> to);
+
 }  // namespace absl
 
 #endif  // ABSL_STRINGS_ESCAPING_H_
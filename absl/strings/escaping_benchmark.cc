@@ -17,6 +17,8 @@
 #include <cstdio>
 #include <cstring>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 #include "absl/base/internal/raw_logging.h"
@@ -59,6 +61,126 @@ void BM_WebSafeBase64Escape_string(benchmark::State& state) {
 }
 BENCHMARK(BM_WebSafeBase64Escape_string);
 
+std::string RandomBytes(size_t len) {
+  std::minstd_rand rng(len);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::string s(len, '\0');
+  for (char& c : s) c = static_cast<char>(byte(rng));
+  return s;
+}
+
+void BM_Base64Escape(benchmark::State& state) {
+  const std::string raw = RandomBytes(state.range(0));
+  std::string escaped;
+  for (auto _ : state) {
+    absl::Base64Escape(raw, &escaped);
+    benchmark::DoNotOptimize(escaped);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Base64Escape)->Range(16, 1 << 20);
+
+void BM_WebSafeBase64Escape(benchmark::State& state) {
+  const std::string raw = RandomBytes(state.range(0));
+  std::string escaped;
+  for (auto _ : state) {
+    absl::WebSafeBase64Escape(raw, &escaped);
+    benchmark::DoNotOptimize(escaped);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WebSafeBase64Escape)->Range(16, 1 << 20);
+
+void BM_Base64Unescape(benchmark::State& state) {
+  const std::string escaped = absl::Base64Escape(RandomBytes(state.range(0)));
+  std::string raw;
+  for (auto _ : state) {
+    ABSL_RAW_CHECK(absl::Base64Unescape(escaped, &raw), "");
+    benchmark::DoNotOptimize(raw);
+  }
+  state.SetBytesProcessed(state.iterations() * escaped.size());
+}
+BENCHMARK(BM_Base64Unescape)->Range(16, 1 << 20);
+
+// Base64 wrapped in MIME's 76-character lines.
+void BM_Base64UnescapeMime(benchmark::State& state) {
+  const std::string escaped = absl::Base64Escape(RandomBytes(state.range(0)));
+  std::string wrapped;
+  for (size_t i = 0; i < escaped.size(); i += 76) {
+    wrapped.append(escaped, i, 76);
+    wrapped.append("\r\n");
+  }
+  std::string raw;
+  for (auto _ : state) {
+    ABSL_RAW_CHECK(absl::Base64Unescape(wrapped, &raw), "");
+    benchmark::DoNotOptimize(raw);
+  }
+  state.SetBytesProcessed(state.iterations() * wrapped.size());
+}
+BENCHMARK(BM_Base64UnescapeMime)->Range(1 << 10, 1 << 20);
+
+void BM_WebSafeBase64Unescape(benchmark::State& state) {
+  const std::string escaped =
+      absl::WebSafeBase64Escape(RandomBytes(state.range(0)));
+  std::string raw;
+  for (auto _ : state) {
+    ABSL_RAW_CHECK(absl::WebSafeBase64Unescape(escaped, &raw), "");
+    benchmark::DoNotOptimize(raw);
+  }
+  state.SetBytesProcessed(state.iterations() * escaped.size());
+}
+BENCHMARK(BM_WebSafeBase64Unescape)->Range(16, 1 << 20);
+
+void BM_BytesToHexString(benchmark::State& state) {
+  const std::string raw = RandomBytes(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::BytesToHexString(raw));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BytesToHexString)->Range(8, 1 << 16);
+
+void BM_BytesToHexStringSpan(benchmark::State& state) {
+  const std::string raw = RandomBytes(state.range(0));
+  std::vector<char> buf(2 * raw.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::BytesToHexString(raw, absl::MakeSpan(buf)));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BytesToHexStringSpan)->Range(8, 1 << 16);
+
+void BM_HexStringToBytes(benchmark::State& state) {
+  const std::string hex = absl::BytesToHexString(RandomBytes(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::HexStringToBytes(hex));
+  }
+  state.SetBytesProcessed(state.iterations() * hex.size());
+}
+BENCHMARK(BM_HexStringToBytes)->Range(8, 1 << 16);
+
+void BM_HexStringToBytesSpan(benchmark::State& state) {
+  const std::string hex = absl::BytesToHexString(RandomBytes(state.range(0)));
+  std::vector<char> buf(hex.size() / 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::HexStringToBytes(hex, absl::MakeSpan(buf)));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * hex.size());
+}
+BENCHMARK(BM_HexStringToBytesSpan)->Range(8, 1 << 16);
+
+// Binary data, as in a hex dump of a hash.
+void BM_CHexEscape_Binary(benchmark::State& state) {
+  const std::string raw = RandomBytes(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::CHexEscape(raw));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CHexEscape_Binary)->Range(8, 1 << 14);
+
 // Used for the CEscape benchmarks
 const char kStringValueNoEscape[] = "1234567890";
 const char kStringValueSomeEscaped[] = "123\n56789\xA1";
@@ -91,4 +213,58 @@ void BM_CEscape_MostEscaped(benchmark::State& state) {
 }
 BENCHMARK(BM_CEscape_MostEscaped)->Range(1, 1 << 14);
 
+// Log-like text with an escapable byte every hundred or so characters.
+std::string MostlyCleanText(size_t len) {
+  const char kLine[] =
+      "GET /search?q=abseil+strings&lang=en HTTP/1.1 200 (1.23ms) "
+      "user-agent=\"Mozilla/5.0\" host=example.com\n";
+  std::string text;
+  while (text.size() < len) text.append(kLine);
+  text.resize(len);
+  return text;
+}
+
+void BM_CEscape_MostlyClean(benchmark::State& state) {
+  const std::string src = MostlyCleanText(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::CEscape(src));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CEscape_MostlyClean)->Range(16, 1 << 16);
+
+void BM_CHexEscape_MostlyClean(benchmark::State& state) {
+  const std::string src = MostlyCleanText(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::CHexEscape(src));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CHexEscape_MostlyClean)->Range(16, 1 << 16);
+
+void BM_Utf8SafeCEscape_MostlyClean(benchmark::State& state) {
+  std::string src = MostlyCleanText(state.range(0));
+  // Sprinkle in some two-byte UTF-8 sequences, which pass through.
+  for (size_t i = 0; i + 1 < src.size(); i += 37) {
+    src[i] = '\xc3';
+    src[i + 1] = '\xa9';
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Utf8SafeCEscape(src));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Utf8SafeCEscape_MostlyClean)->Range(16, 1 << 16);
+
+void BM_CUnescape_MostlyClean(benchmark::State& state) {
+  const std::string src = absl::CEscape(MostlyCleanText(state.range(0)));
+  std::string dest;
+  for (auto _ : state) {
+    ABSL_RAW_CHECK(absl::CUnescape(src, &dest), "");
+    benchmark::DoNotOptimize(dest);
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_CUnescape_MostlyClean)->Range(16, 1 << 16);
+
 }  // namespace
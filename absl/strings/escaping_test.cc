@@ -15,14 +15,19 @@
 #include "absl/strings/escaping.h"
 
 #include <array>
+#include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/container/fixed_array.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 
 #include "absl/strings/internal/escaping_test_common.h"
@@ -153,6 +158,70 @@ TEST(CEscape, BasicEscaping) {
   }
 }
 
+// A byte-at-a-time escaper to check the optimized ones against.
+std::string ReferenceCEscape(absl::string_view src, bool use_hex,
+                             bool utf8_safe) {
+  std::string dest;
+  bool last_hex_escape = false;
+  for (unsigned char c : src) {
+    bool is_hex_escape = false;
+    switch (c) {
+      case '\n': dest += "\\n"; break;
+      case '\r': dest += "\\r"; break;
+      case '\t': dest += "\\t"; break;
+      case '\"': dest += "\\\""; break;
+      case '\'': dest += "\\'"; break;
+      case '\\': dest += "\\\\"; break;
+      default:
+        if ((!utf8_safe || c < 0x80) &&
+            (c < 0x20 || c >= 0x7f || (last_hex_escape && isxdigit(c)))) {
+          char buf[5];
+          snprintf(buf, sizeof(buf), use_hex ? "\\x%02x" : "\\%03o", c);
+          dest += buf;
+          is_hex_escape = use_hex;
+        } else {
+          dest.push_back(c);
+        }
+    }
+    last_hex_escape = is_hex_escape;
+  }
+  return dest;
+}
+
+// Long, mostly clean inputs are scanned in bulk; check that every escapable
+// byte is found wherever it falls.
+TEST(CEscape, LongInputs) {
+  std::mt19937 rng(67890);
+  const char kSpecial[] = {'\n', '\t', '"', '\'', '\\', '\0', '\x7f',
+                           '\x80', '\xc3', '\xff', '\x1f'};
+  for (int trial = 0; trial < 500; ++trial) {
+    std::string s;
+    const size_t len = rng() % 200;
+    for (size_t i = 0; i < len; ++i) {
+      // Mostly printable text with the odd hex digit and special byte.
+      const int kind = rng() % 20;
+      if (kind == 0) {
+        s.push_back(kSpecial[rng() % sizeof(kSpecial)]);
+      } else if (kind == 1) {
+        s.push_back("0123456789abcdefABCDEF"[rng() % 22]);
+      } else {
+        s.push_back(static_cast<char>(' ' + rng() % 95));
+      }
+    }
+    ASSERT_EQ(absl::CEscape(s), ReferenceCEscape(s, false, false)) << s;
+    ASSERT_EQ(absl::CHexEscape(s), ReferenceCEscape(s, true, false)) << s;
+    ASSERT_EQ(absl::Utf8SafeCEscape(s), ReferenceCEscape(s, false, true)) << s;
+    ASSERT_EQ(absl::Utf8SafeCHexEscape(s), ReferenceCEscape(s, true, true))
+        << s;
+
+    std::string unescaped;
+    ASSERT_TRUE(absl::CUnescape(absl::CEscape(s), &unescaped));
+    EXPECT_EQ(unescaped, s);
+    ASSERT_TRUE(absl::CUnescape(absl::CHexEscape(s), &unescaped));
+    EXPECT_EQ(unescaped, s);
+  }
+}
+
 TEST(Unescape, BasicFunction) {
   epair tests[] =
     {{"", ""},
@@ -617,6 +686,130 @@ TEST(Base64, EscapeAndUnescape) {
   TestEscapeAndUnescape<std::string>();
 }
 
+// A straightforward encoder to check the optimized one against.
+std::string ReferenceBase64Escape(absl::string_view src, const char* alphabet,
+                                  bool do_padding) {
+  std::string out;
+  uint32_t bits = 0;
+  int nbits = 0;
+  for (unsigned char c : src) {
+    bits = (bits << 8) | c;
+    nbits += 8;
+    while (nbits >= 6) {
+      nbits -= 6;
+      out.push_back(alphabet[(bits >> nbits) & 0x3F]);
+    }
+  }
+  if (nbits > 0) out.push_back(alphabet[(bits << (6 - nbits)) & 0x3F]);
+  while (do_padding && out.size() % 4 != 0) out.push_back('=');
+  return out;
+}
+
+const char kBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+const char kWebSafeBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+std::string RandomBytes(std::mt19937* rng, size_t len) {
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::string s(len, '\0');
+  for (char& c : s) c = static_cast<char>(byte(*rng));
+  return s;
+}
+
+// The bulk of long inputs is converted by vectorized code; make sure every
+// length and alignment of the tail agrees with the scalar results.
+TEST(Base64, LongInputs) {
+  std::mt19937 rng(12345);
+  for (size_t len = 0; len < 600; ++len) {
+    const std::string raw = RandomBytes(&rng, len);
+    const std::string escaped = absl::Base64Escape(raw);
+    ASSERT_EQ(escaped, ReferenceBase64Escape(raw, kBase64Alphabet, true));
+    const std::string websafe = absl::WebSafeBase64Escape(raw);
+    ASSERT_EQ(websafe,
+              ReferenceBase64Escape(raw, kWebSafeBase64Alphabet, false));
+
+    std::string decoded;
+    ASSERT_TRUE(absl::Base64Unescape(escaped, &decoded));
+    EXPECT_EQ(decoded, raw);
+    ASSERT_TRUE(absl::WebSafeBase64Unescape(websafe, &decoded));
+    EXPECT_EQ(decoded, raw);
+
+    // The standard decoder accepts missing padding, and the web-safe one
+    // accepts padding.
+    ASSERT_TRUE(absl::Base64Unescape(
+        ReferenceBase64Escape(raw, kBase64Alphabet, false), &decoded));
+    EXPECT_EQ(decoded, raw);
+    ASSERT_TRUE(absl::WebSafeBase64Unescape(
+        ReferenceBase64Escape(raw, kWebSafeBase64Alphabet, true), &decoded));
+    EXPECT_EQ(decoded, raw);
+  }
+}
+
+TEST(Base64, LongInputsWithWhitespace) {
+  std::mt19937 rng(23456);
+  const std::string raw = RandomBytes(&rng, 3000);
+  const std::string escaped = absl::Base64Escape(raw);
+
+  // MIME-style line breaks, and lines that split the 4-character groups.
+  std::string decoded;
+  for (size_t line_length : {76, 64, 75, 77, 3}) {
+    for (const char* line_break : {"\r\n", "\n"}) {
+      std::string wrapped;
+      for (size_t i = 0; i < escaped.size(); i += line_length) {
+        wrapped.append(escaped, i, line_length);
+        wrapped.append(line_break);
+      }
+      ASSERT_TRUE(absl::Base64Unescape(wrapped, &decoded)) << line_length;
+      EXPECT_EQ(decoded, raw);
+
+      // An invalid character after a line break is still caught.
+      wrapped[wrapped.find('\n', wrapped.size() / 2) + 1] = '*';
+      EXPECT_FALSE(absl::Base64Unescape(wrapped, &decoded)) << line_length;
+    }
+  }
+
+  // Whitespace at arbitrary positions.
+  for (int trial = 0; trial < 100; ++trial) {
+    std::string spaced = escaped;
+    const size_t pos = rng() % (escaped.size() - 2);
+    spaced.insert(pos, trial % 2 == 0 ? " " : "\t\n");
+    ASSERT_TRUE(absl::Base64Unescape(spaced, &decoded)) << pos;
+    EXPECT_EQ(decoded, raw);
+  }
+}
+
+TEST(Base64, LongInputsWithInvalidCharacters) {
+  std::mt19937 rng(34567);
+  const std::string raw = RandomBytes(&rng, 3000);
+  const std::string escaped = absl::Base64Escape(raw);
+  const std::string websafe = absl::WebSafeBase64Escape(raw);
+  const char kInvalid[] = {'*', '\0', '\x80', '\xff', '=', '.', '-', '_'};
+  for (int trial = 0; trial < 400; ++trial) {
+    // Keep clear of the end, where padding is legitimate.
+    const size_t pos = rng() % (escaped.size() - 4);
+    const char bad = kInvalid[trial % sizeof(kInvalid)];
+    std::string buf = "this junk should be cleared";
+    std::string corrupted = escaped;
+    corrupted[pos] = bad;
+    EXPECT_FALSE(absl::Base64Unescape(corrupted, &buf)) << pos;
+    EXPECT_TRUE(buf.empty());
+
+    if (bad == '-' || bad == '_') continue;  // Valid in the web-safe alphabet.
+    corrupted = websafe;
+    corrupted[pos] = bad;
+    EXPECT_FALSE(absl::WebSafeBase64Unescape(corrupted, &buf)) << pos;
+    EXPECT_TRUE(buf.empty());
+  }
+  // The standard alphabet's characters are invalid in web-safe input.
+  std::string buf;
+  std::string corrupted = websafe;
+  corrupted[100] = '+';
+  EXPECT_FALSE(absl::WebSafeBase64Unescape(corrupted, &buf));
+  corrupted[100] = '/';
+  EXPECT_FALSE(absl::WebSafeBase64Unescape(corrupted, &buf));
+}
+
 TEST(Base64, DISABLED_HugeData) {
   const size_t kSize = size_t(3) * 1000 * 1000 * 1000;
   static_assert(kSize % 3 == 0, "kSize must be divisible by 3");
@@ -661,4 +854,73 @@ TEST(HexAndBack, HexStringToBytes_and_BytesToHexString) {
   EXPECT_EQ(hex_only_lower, hex_result);
 }
 
+TEST(HexAndBack, LongInputs) {
+  std::mt19937 rng(45678);
+  for (size_t len = 0; len < 300; ++len) {
+    const std::string bytes = RandomBytes(&rng, len);
+    std::string expected;
+    for (unsigned char c : bytes) {
+      expected.push_back("0123456789abcdef"[c >> 4]);
+      expected.push_back("0123456789abcdef"[c & 0xF]);
+    }
+    const std::string hex = absl::BytesToHexString(bytes);
+    ASSERT_EQ(hex, expected);
+    EXPECT_EQ(absl::HexStringToBytes(hex), bytes);
+    EXPECT_EQ(absl::HexStringToBytes(absl::AsciiStrToUpper(hex)), bytes);
+  }
+}
+
+TEST(HexAndBack, NonHexCharactersCountAsZero) {
+  std::string hex(200, '0');
+  std::string expected(100, '\0');
+  const char kNonHex[] = {'g', 'G', '/', ':', '@', '`', '\x80', '\xff', ' '};
+  for (size_t i = 0; i < hex.size(); i += 7) {
+    if (i % 2 == 0) {
+      hex[i] = kNonHex[i % sizeof(kNonHex)];
+      hex[i + 1] = 'a';
+      expected[i / 2] = '\x0a';
+    } else {
+      hex[i - 1] = 'B';
+      hex[i] = kNonHex[i % sizeof(kNonHex)];
+      expected[i / 2] = '\xb0';
+    }
+  }
+  EXPECT_EQ(absl::HexStringToBytes(hex), expected);
+}
+
+TEST(HexAndBack, Span) {
+  const std::string bytes = "\x01\x23\x45\x67\x89\xab\xcd\xef";
+  char buf[64];
+  EXPECT_EQ(absl::BytesToHexString(bytes, absl::MakeSpan(buf)), 16);
+  EXPECT_EQ(absl::string_view(buf, 16), "0123456789abcdef");
+
+  // Only whole bytes that fit are converted.
+  std::memset(buf, '*', sizeof(buf));
+  EXPECT_EQ(absl::BytesToHexString(bytes, absl::MakeSpan(buf, 7)), 6);
+  EXPECT_EQ(absl::string_view(buf, 8), "012345**");
+
+  std::memset(buf, '*', sizeof(buf));
+  EXPECT_EQ(absl::HexStringToBytes("0123456789abcdef", absl::MakeSpan(buf)),
+            8);
+  EXPECT_EQ(absl::string_view(buf, 8), bytes);
+  EXPECT_EQ(absl::HexStringToBytes("fedcba", absl::MakeSpan(buf, 2)), 2);
+  EXPECT_EQ(absl::string_view(buf, 3), "\xfe\xdc\x45");
+  EXPECT_EQ(absl::HexStringToBytes("abc", absl::MakeSpan(buf)), 1);
+  EXPECT_EQ(buf[0], '\xab');
+
+  // Long inputs, converted mostly by the vectorized code.
+  std::mt19937 rng(56789);
+  const std::string long_bytes = RandomBytes(&rng, 1000);
+  std::string hex(2000, '*');
+  EXPECT_EQ(absl::BytesToHexString(long_bytes, absl::MakeSpan(&hex[0], 1999)),
+            1998);
+  EXPECT_EQ(hex.substr(0, 1998), absl::BytesToHexString(long_bytes).substr(
+                                     0, 1998));
+  EXPECT_EQ(hex[1998], '*');
+  std::string round_trip(999, '*');
+  EXPECT_EQ(absl::HexStringToBytes(hex, absl::MakeSpan(&round_trip[0], 999)),
+            999);
+  EXPECT_EQ(round_trip, long_bytes.substr(0, 999));
+}
+
 }  // namespace
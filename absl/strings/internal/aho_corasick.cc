@@ -0,0 +1,219 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/aho_corasick.h"
+
+#include <cstring>
+
+#include "absl/base/internal/raw_logging.h"
+
+namespace absl {
+namespace strings_internal {
+
+namespace {
+
+// Marks transitions that are not in the trie while it is being built.
+constexpr uint32_t kNoTransition = ~uint32_t{0};
+
+// Set on transitions into states that end a pattern, so that the search only
+// looks at the state's details when it has to.
+constexpr uint32_t kMatchFlag = uint32_t{1} << 31;
+
+// Find() stops skipping ahead from the root after this many skips of fewer
+// than kShortSkip bytes.
+constexpr int kMaxShortSkips = 16;
+constexpr int kShortSkip = 4;
+
+}  // namespace
+
+AhoCorasick::AhoCorasick() : single_start_(-1), shift_(0) {
+  memset(classes_, 0, sizeof(classes_));
+  memset(starts_, 0, sizeof(starts_));
+}
+
+AhoCorasick::AhoCorasick(const std::vector<absl::string_view>& patterns)
+    : AhoCorasick() {
+  Build(patterns);
+}
+
+void AhoCorasick::Build(const std::vector<absl::string_view>& patterns) {
+  pattern_lengths_.reserve(patterns.size());
+  int num_classes = 1;
+  size_t total_length = 0;
+  for (absl::string_view pattern : patterns) {
+    pattern_lengths_.push_back(pattern.size());
+    total_length += pattern.size();
+    for (char c : pattern) {
+      uint16_t& cls = classes_[static_cast<unsigned char>(c)];
+      if (cls == 0) cls = static_cast<uint16_t>(num_classes++);
+    }
+  }
+  if (total_length == 0) return;
+
+  while ((1 << shift_) < num_classes) ++shift_;
+  const size_t stride = size_t{1} << shift_;
+
+  // Build the trie. The root is the state at offset 0. Shared prefixes make
+  // the trie much smaller than total_length states, so the table grows as
+  // states are added rather than being reserved for the worst case.
+  states_.reserve(total_length + 1);
+  transitions_.assign(stride, kNoTransition);
+  states_.push_back({0, 0});
+  int num_starts = 0;
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    absl::string_view pattern = patterns[i];
+    if (pattern.empty()) continue;
+    unsigned char first = static_cast<unsigned char>(pattern[0]);
+    if (!starts_[first]) {
+      starts_[first] = true;
+      single_start_ = num_starts++ == 0 ? first : -1;
+    }
+    uint32_t state = 0;
+    for (char c : pattern) {
+      uint32_t& next =
+          transitions_[state + classes_[static_cast<unsigned char>(c)]];
+      if (next == kNoTransition) {
+        // The top bit of a transition is kMatchFlag, so every offset has to
+        // fit in the remaining 31.
+        ABSL_RAW_CHECK(transitions_.size() + stride <= kMatchFlag,
+                       "AhoCorasick: too many patterns for 31-bit offsets");
+        next = static_cast<uint32_t>(transitions_.size());
+        states_.push_back({states_[state >> shift_].depth + 1, 0});
+        // `next` is invalidated by the resize.
+        uint32_t added = next;
+        transitions_.resize(transitions_.size() + stride, kNoTransition);
+        state = added;
+      } else {
+        state = next;
+      }
+    }
+    uint32_t& match = states_[state >> shift_].match;
+    if (match == 0) match = static_cast<uint32_t>(i + 1);
+  }
+  transitions_.shrink_to_fit();
+
+  // Fill in the missing transitions from the failure links, breadth first so
+  // that a state's failure state is always complete before it is needed.
+  std::vector<uint32_t> failure(states_.size(), 0);
+  std::vector<uint32_t> queue;
+  queue.reserve(states_.size());
+  for (size_t c = 0; c < stride; ++c) {
+    uint32_t& next = transitions_[c];
+    if (next == kNoTransition) {
+      next = 0;
+    } else {
+      queue.push_back(next);
+      if (states_[next >> shift_].match != 0) next |= kMatchFlag;
+    }
+  }
+  for (size_t head = 0; head < queue.size(); ++head) {
+    uint32_t state = queue[head];
+    uint32_t fail = failure[state >> shift_];
+    for (size_t c = 0; c < stride; ++c) {
+      uint32_t& next = transitions_[state + c];
+      uint32_t fallback = transitions_[fail + c];
+      if (next == kNoTransition) {
+        next = fallback;
+        continue;
+      }
+      failure[next >> shift_] = fallback & ~kMatchFlag;
+      StateInfo& info = states_[next >> shift_];
+      if (info.match == 0) {
+        info.match = states_[(fallback & ~kMatchFlag) >> shift_].match;
+      }
+      queue.push_back(next);
+      if (info.match != 0) next |= kMatchFlag;
+    }
+  }
+}
+
+bool AhoCorasick::Find(absl::string_view text, size_t pos, size_t* offset,
+                       size_t* pattern) const {
+  if (states_.empty() || pos >= text.size()) return false;
+  const unsigned char* const begin =
+      reinterpret_cast<const unsigned char*>(text.data());
+  const unsigned char* const end = begin + text.size();
+  const unsigned char* p = begin + pos;
+  const uint32_t* const transitions = transitions_.data();
+
+  // Run the automaton until it reaches a state that ends a pattern.
+  uint32_t state = 0;
+  if (single_start_ >= 0) {
+    for (;;) {
+      if (state == 0) {
+        // Nothing is in progress, so skip ahead to the byte that starts every
+        // pattern.
+        p = static_cast<const unsigned char*>(
+            memchr(p, single_start_, static_cast<size_t>(end - p)));
+        if (p == nullptr) return false;
+      }
+      state = transitions[state + classes_[*p++]];
+      if (state & kMatchFlag) break;
+      if (p == end) return false;
+    }
+  } else {
+    // Skipping ahead to a byte that starts a pattern pays off when they are
+    // rare in the text, but costs more in mispredicted branches than it saves
+    // when they are common, so give up on it if it keeps getting nowhere.
+    bool matched = false;
+    int short_skips = 0;
+    while (short_skips < kMaxShortSkips) {
+      if (state == 0) {
+        const unsigned char* from = p;
+        while (!starts_[*p]) {
+          if (++p == end) return false;
+        }
+        if (p - from < kShortSkip) ++short_skips;
+      }
+      state = transitions[state + classes_[*p++]];
+      if (state & kMatchFlag) {
+        matched = true;
+        break;
+      }
+      if (p == end) return false;
+    }
+    while (!matched) {
+      state = transitions[state + classes_[*p++]];
+      if (state & kMatchFlag) break;
+      if (p == end) return false;
+    }
+  }
+
+  // The longest pattern ending here starts earliest, but a match that ends
+  // later could start earlier still, or at the same place and be longer. Keep
+  // going while the state's prefix starts at or before the best match, since
+  // every later match is a suffix of a continuation of it.
+  state &= ~kMatchFlag;
+  const StateInfo* info = &states_[state >> shift_];
+  const unsigned char* best_start = p - pattern_lengths_[info->match - 1];
+  uint32_t best_match = info->match;
+  while (p != end) {
+    state = transitions[state + classes_[*p++]] & ~kMatchFlag;
+    info = &states_[state >> shift_];
+    if (p - info->depth > best_start) break;
+    if (info->match != 0) {
+      const unsigned char* start = p - pattern_lengths_[info->match - 1];
+      if (start <= best_start) {
+        best_start = start;
+        best_match = info->match;
+      }
+    }
+  }
+  *offset = static_cast<size_t>(best_start - begin);
+  *pattern = best_match - 1;
+  return true;
+}
+
+}  // namespace strings_internal
+}  // namespace absl
@@ -0,0 +1,84 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// An Aho-Corasick automaton that finds the leftmost-longest occurrence of any
+// of a set of patterns in a single pass over the text, independent of the
+// number of patterns. It backs absl::MultiMatcher and absl::StrReplacer, and
+// StrReplaceAll() when given many replacements.
+//
+// The automaton is a dense DFA over byte classes: each byte that occurs in
+// some pattern gets a class of its own, and all other bytes share class 0.
+// Each state's row of transitions is padded to a power of two, and states are
+// identified by the offset of their row, so that a step is a single lookup.
+// Offsets are 31 bits, which limits the patterns to a few tens of megabytes in
+// total; building an automaton past that limit is a fatal error.
+
+#ifndef ABSL_STRINGS_INTERNAL_AHO_CORASICK_H_
+#define ABSL_STRINGS_INTERNAL_AHO_CORASICK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace absl {
+namespace strings_internal {
+
+class AhoCorasick {
+ public:
+  // Matches nothing.
+  AhoCorasick();
+
+  // Builds an automaton for `patterns`. Empty patterns never match. If a
+  // pattern occurs more than once, matches report its first index. The
+  // automaton does not refer to `patterns` once built.
+  explicit AhoCorasick(const std::vector<absl::string_view>& patterns);
+
+  // Finds the occurrence of a pattern in `text` that starts earliest at or
+  // after `pos`, preferring the longest pattern among those starting at the
+  // same place. On success, stores its offset and the index of the pattern
+  // and returns true.
+  bool Find(absl::string_view text, size_t pos, size_t* offset,
+            size_t* pattern) const;
+
+  // Returns the length of pattern `pattern`.
+  size_t pattern_length(size_t pattern) const {
+    return pattern_lengths_[pattern];
+  }
+
+ private:
+  struct StateInfo {
+    uint32_t depth;  // length of the prefix this state represents
+    uint32_t match;  // 1 + index of its longest pattern suffix, or 0 if none
+  };
+
+  void Build(const std::vector<absl::string_view>& patterns);
+
+  uint16_t classes_[256];
+  // The bytes that start some pattern, which Find() skips ahead to from the
+  // root.
+  bool starts_[256];
+  // The only byte that starts a pattern, if there is just one, else -1.
+  int single_start_;
+  int shift_;
+  std::vector<uint32_t> transitions_;
+  std::vector<StateInfo> states_;
+  std::vector<size_t> pattern_lengths_;
+};
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_AHO_CORASICK_H_
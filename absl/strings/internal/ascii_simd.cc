@@ -0,0 +1,195 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/ascii_simd.h"
+
+#include <cstdint>
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace absl {
+namespace strings_internal {
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+namespace {
+
+// Flips the case of the bytes from `kFirst` to `kLast`, which are the letters
+// of one case: the cases differ only in bit 0x20. The comparisons are signed,
+// so bytes from 0x80 up, being negative, are never in range.
+
+template <char kFirst, char kLast>
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i FlipCase(__m128i in) {
+  const __m128i in_range =
+      _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(kFirst - 1)),
+                    _mm_cmplt_epi8(in, _mm_set1_epi8(kLast + 1)));
+  return _mm_xor_si128(in, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+}
+
+template <char kFirst, char kLast>
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i FlipCase(__m256i in) {
+  const __m256i in_range =
+      _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8(kFirst - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8(kLast + 1), in));
+  return _mm256_xor_si256(in,
+                          _mm256_and_si256(in_range, _mm256_set1_epi8(0x20)));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i Load16(const char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i Load32(const char* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+template <char kFirst, char kLast>
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t FlipCaseSsse3(const char* src,
+                                                        size_t szsrc,
+                                                        char* dest) {
+  size_t i = 0;
+  for (; i + 16 <= szsrc; i += 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     FlipCase<kFirst, kLast>(Load16(src + i)));
+  }
+  return i;
+}
+
+template <char kFirst, char kLast>
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t FlipCaseAvx2(const char* src,
+                                                      size_t szsrc,
+                                                      char* dest) {
+  size_t i = 0;
+  for (; i + 32 <= szsrc; i += 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                        FlipCase<kFirst, kLast>(Load32(src + i)));
+  }
+  // Short strings, such as the names of HTTP headers, are common, so take a
+  // half block as well.
+  if (i + 16 <= szsrc) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     FlipCase<kFirst, kLast>(Load16(src + i)));
+    i += 16;
+  }
+  return i;
+}
+
+// Returns a mask of the bytes of the blocks at `s1` and `s2` that differ when
+// converted to lowercase.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline uint32_t CaseDiffer16(
+    const char* s1, const char* s2) {
+  const __m128i equal = _mm_cmpeq_epi8(FlipCase<'A', 'Z'>(Load16(s1)),
+                                       FlipCase<'A', 'Z'>(Load16(s2)));
+  return static_cast<uint32_t>(_mm_movemask_epi8(equal)) ^ 0xffff;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline uint32_t CaseDiffer32(
+    const char* s1, const char* s2) {
+  const __m256i equal = _mm256_cmpeq_epi8(FlipCase<'A', 'Z'>(Load32(s1)),
+                                          FlipCase<'A', 'Z'>(Load32(s2)));
+  return ~static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t CaseEqualPrefixSsse3(
+    const char* s1, const char* s2, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const uint32_t differ = CaseDiffer16(s1 + i, s2 + i);
+    if (differ != 0) return i + static_cast<size_t>(__builtin_ctz(differ));
+  }
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t CaseEqualPrefixAvx2(const char* s1,
+                                                             const char* s2,
+                                                             size_t len) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const uint32_t differ = CaseDiffer32(s1 + i, s2 + i);
+    if (differ != 0) return i + static_cast<size_t>(__builtin_ctz(differ));
+  }
+  if (i + 16 <= len) {
+    const uint32_t differ = CaseDiffer16(s1 + i, s2 + i);
+    if (differ != 0) return i + static_cast<size_t>(__builtin_ctz(differ));
+    i += 16;
+  }
+  return i;
+}
+
+}  // namespace
+#endif  // ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+
+size_t AsciiToLowerSimd(SimdLevel level, const char* src, size_t szsrc,
+                        char* dest) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return FlipCaseAvx2<'A', 'Z'>(src, szsrc, dest);
+    case SimdLevel::kSsse3:
+      return FlipCaseSsse3<'A', 'Z'>(src, szsrc, dest);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+#endif
+  return 0;
+}
+
+size_t AsciiToUpperSimd(SimdLevel level, const char* src, size_t szsrc,
+                        char* dest) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return FlipCaseAvx2<'a', 'z'>(src, szsrc, dest);
+    case SimdLevel::kSsse3:
+      return FlipCaseSsse3<'a', 'z'>(src, szsrc, dest);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+#endif
+  return 0;
+}
+
+size_t AsciiCaseEqualPrefixSimd(SimdLevel level, const char* s1,
+                                const char* s2, size_t len) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return CaseEqualPrefixAvx2(s1, s2, len);
+    case SimdLevel::kSsse3:
+      return CaseEqualPrefixSsse3(s1, s2, len);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(s1);
+  static_cast<void>(s2);
+  static_cast<void>(len);
+#endif
+  return 0;
+}
+
+}  // namespace strings_internal
+}  // namespace absl
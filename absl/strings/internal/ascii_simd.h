@@ -0,0 +1,49 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Vectorized kernels for ASCII case conversion and case-insensitive
+// comparison, as used by ascii.cc and memcasecmp().
+//
+// Like the kernels in escaping_simd.h, each one works through whole blocks at
+// the front of its input and returns how far it got, leaving the rest to the
+// scalar code. At SimdLevel::kNone they consume nothing.
+
+#ifndef ABSL_STRINGS_INTERNAL_ASCII_SIMD_H_
+#define ABSL_STRINGS_INTERNAL_ASCII_SIMD_H_
+
+#include <cstddef>
+
+#include "absl/strings/internal/simd.h"
+
+namespace absl {
+namespace strings_internal {
+
+// Writes the bytes from the front of `src` to `dest`, with 'A' to 'Z'
+// converted to lowercase, or 'a' to 'z' to uppercase. `dest` may be `src`.
+// Returns the number of bytes converted.
+size_t AsciiToLowerSimd(SimdLevel level, const char* src, size_t szsrc,
+                        char* dest);
+size_t AsciiToUpperSimd(SimdLevel level, const char* src, size_t szsrc,
+                        char* dest);
+
+// Returns the length of the prefix in which the `len` bytes at `s1` and `s2`
+// are equal when converted to lowercase. The comparison stops at the first
+// difference, or at the final partial block.
+size_t AsciiCaseEqualPrefixSimd(SimdLevel level, const char* s1,
+                                const char* s2, size_t len);
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_ASCII_SIMD_H_
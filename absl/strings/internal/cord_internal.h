@@ -0,0 +1,212 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// The node types making up the tree behind an `absl::Cord`. Nothing here is
+// part of the public API; see absl/strings/cord.h.
+
+#ifndef ABSL_STRINGS_INTERNAL_CORD_INTERNAL_H_
+#define ABSL_STRINGS_INTERNAL_CORD_INTERNAL_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "absl/meta/type_traits.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+namespace cord_internal {
+
+// Wraps std::atomic for reference counting.
+class Refcount {
+ public:
+  Refcount() : count_{1} {}
+  ~Refcount() {}
+
+  // Increments the reference count.
+  void Increment() { count_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Decrements the reference count, returning false if it drops to zero.
+  bool Decrement() {
+    return count_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+  }
+
+  // Returns true if the calling thread holds the only reference. Used to
+  // decide when a node may be modified in place.
+  bool IsOne() { return count_.load(std::memory_order_acquire) == 1; }
+
+ private:
+  std::atomic<int32_t> count_;
+};
+
+// The overhead of a vtable is too much for Cord, so we roll our own subclasses
+// using only a single byte to differentiate classes from each other - the
+// "tag" byte.
+enum CordRepKind : uint8_t {
+  CONCAT = 0,
+  EXTERNAL = 1,
+  SUBSTRING = 2,
+  FLAT = 3,
+};
+
+struct CordRepConcat;
+struct CordRepSubstring;
+struct CordRepExternal;
+struct CordRepFlat;
+
+// A node in the tree. Leaves are FLAT (bytes stored right after the node) or
+// EXTERNAL (bytes owned by the user); SUBSTRING nodes select a range of a
+// single leaf; CONCAT nodes join two subtrees. Nodes are immutable once
+// shared, i.e. whenever `refcount.IsOne()` is false.
+struct CordRep {
+  // The total number of bytes below this node.
+  size_t length;
+  Refcount refcount;
+  CordRepKind tag;
+
+  inline CordRepConcat* concat();
+  inline const CordRepConcat* concat() const;
+  inline CordRepSubstring* substring();
+  inline const CordRepSubstring* substring() const;
+  inline CordRepExternal* external();
+  inline const CordRepExternal* external() const;
+  inline CordRepFlat* flat();
+  inline const CordRepFlat* flat() const;
+};
+
+struct CordRepConcat : public CordRep {
+  CordRep* left;
+  CordRep* right;
+  // The height of this node in the tree; leaves have depth 0.
+  uint8_t depth;
+};
+
+struct CordRepSubstring : public CordRep {
+  // The offset of the first byte within `child`.
+  size_t start;
+  // Always a FLAT or EXTERNAL node.
+  CordRep* child;
+};
+
+// Type for the function pointer that destroys a `CordRepExternal` and
+// releases the memory it refers to.
+using ExternalReleaserInvoker = void (*)(CordRepExternal*);
+
+struct CordRepExternal : public CordRep {
+  const char* base;
+  ExternalReleaserInvoker releaser_invoker;
+};
+
+// Releasers may accept the released data as an `absl::string_view`, or take
+// no arguments at all.
+struct Rank1 {};
+struct Rank0 : Rank1 {};
+
+template <typename Releaser, typename = ::absl::void_t<decltype(
+                                 std::declval<Releaser>()(string_view()))>>
+void InvokeReleaser(Rank0, Releaser&& releaser, string_view data) {
+  std::forward<Releaser>(releaser)(data);
+}
+
+template <typename Releaser,
+          typename = ::absl::void_t<decltype(std::declval<Releaser>()())>>
+void InvokeReleaser(Rank1, Releaser&& releaser, string_view) {
+  std::forward<Releaser>(releaser)();
+}
+
+// An EXTERNAL node that also stores the user's releaser, which is invoked
+// exactly once, when the last reference to the node goes away.
+template <typename Releaser>
+struct CordRepExternalImpl : public CordRepExternal {
+  explicit CordRepExternalImpl(Releaser&& r)
+      : releaser(std::forward<Releaser>(r)) {
+    this->releaser_invoker = &Release;
+  }
+
+  static void Release(CordRepExternal* rep) {
+    auto* impl = static_cast<CordRepExternalImpl*>(rep);
+    InvokeReleaser(Rank0{}, std::move(impl->releaser),
+                   string_view(rep->base, rep->length));
+    delete impl;
+  }
+
+  absl::decay_t<Releaser> releaser;
+};
+
+struct CordRepFlat : public CordRep {
+  // The number of bytes that fit after this header.
+  size_t capacity;
+
+  char* Data() { return reinterpret_cast<char*>(this + 1); }
+  const char* Data() const { return reinterpret_cast<const char*>(this + 1); }
+};
+
+inline CordRepConcat* CordRep::concat() {
+  assert(tag == CONCAT);
+  return static_cast<CordRepConcat*>(this);
+}
+inline const CordRepConcat* CordRep::concat() const {
+  assert(tag == CONCAT);
+  return static_cast<const CordRepConcat*>(this);
+}
+inline CordRepSubstring* CordRep::substring() {
+  assert(tag == SUBSTRING);
+  return static_cast<CordRepSubstring*>(this);
+}
+inline const CordRepSubstring* CordRep::substring() const {
+  assert(tag == SUBSTRING);
+  return static_cast<const CordRepSubstring*>(this);
+}
+inline CordRepExternal* CordRep::external() {
+  assert(tag == EXTERNAL);
+  return static_cast<CordRepExternal*>(this);
+}
+inline const CordRepExternal* CordRep::external() const {
+  assert(tag == EXTERNAL);
+  return static_cast<const CordRepExternal*>(this);
+}
+inline CordRepFlat* CordRep::flat() {
+  assert(tag == FLAT);
+  return static_cast<CordRepFlat*>(this);
+}
+inline const CordRepFlat* CordRep::flat() const {
+  assert(tag == FLAT);
+  return static_cast<const CordRepFlat*>(this);
+}
+
+// Returns the bytes of a leaf node, i.e. anything but a CONCAT.
+inline string_view LeafData(const CordRep* rep) {
+  switch (rep->tag) {
+    case FLAT:
+      return string_view(rep->flat()->Data(), rep->length);
+    case EXTERNAL:
+      return string_view(rep->external()->base, rep->length);
+    case SUBSTRING: {
+      const CordRepSubstring* sub = rep->substring();
+      return string_view(LeafData(sub->child).data() + sub->start,
+                         rep->length);
+    }
+    default:
+      assert(false);
+      return string_view();
+  }
+}
+
+}  // namespace cord_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_CORD_INTERNAL_H_
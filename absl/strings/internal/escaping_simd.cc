@@ -0,0 +1,522 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/escaping_simd.h"
+
+#include <cstdint>
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace absl {
+namespace strings_internal {
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+namespace {
+
+// The base64 kernels follow Wojciech Muła and Daniel Lemire, "Faster Base64
+// Encoding and Decoding Using AVX2 Instructions" (2018). Every step operates
+// within 128-bit lanes, so the AVX2 versions are the SSSE3 ones applied to two
+// lanes at once.
+
+// Spreads the 12 bytes at the front of each lane over four bytes per 3-byte
+// group, in the order the multiplications below expect.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i EncodeShuffle() {
+  return _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+}
+
+// Maps the value of each 6-bit index to a slot of the table built by
+// EncodeOffsets(), holding the offset from the index to its character:
+// 0..25 to slot 13, 26..51 to slot 0, 52..61 to slots 1..10, 62 and 63 to
+// slots 11 and 12.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i EncodeOffsets(char c62,
+                                                                char c63) {
+  return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                       '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                       '0' - 52, static_cast<char>(c62 - 62),
+                       static_cast<char>(c63 - 63), 'A', 0, 0);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i EncodeBlock(
+    __m128i in, __m128i offsets) {
+  in = _mm_shuffle_epi8(in, EncodeShuffle());
+  // Move each 6-bit field into its own byte.
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const __m128i indices = _mm_or_si128(t1, t3);
+  // Translate the indices to characters.
+  __m128i slot = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  slot = _mm_or_si128(slot, _mm_and_si128(less, _mm_set1_epi8(13)));
+  return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, slot));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t Base64EncodeSsse3(
+    const unsigned char* src, size_t szsrc, char* dest, char c62, char c63) {
+  const __m128i offsets = EncodeOffsets(c62, c63);
+  size_t i = 0;
+  // Each step consumes 12 bytes but loads 16.
+  for (; i + 16 <= szsrc; i += 12) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i / 3 * 4),
+                     EncodeBlock(in, offsets));
+  }
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i EncodeBlock(
+    __m256i in, __m256i offsets) {
+  in = _mm256_shuffle_epi8(in, _mm256_broadcastsi128_si256(EncodeShuffle()));
+  const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+  const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+  const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  const __m256i indices = _mm256_or_si256(t1, t3);
+  __m256i slot = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+  slot = _mm256_or_si256(slot, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, slot));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t Base64EncodeAvx2(
+    const unsigned char* src, size_t szsrc, char* dest, char c62, char c63) {
+  const __m256i offsets =
+      _mm256_broadcastsi128_si256(EncodeOffsets(c62, c63));
+  size_t i = 0;
+  // Each step consumes 24 bytes, loading 12 (plus 4 ignored) into each lane.
+  for (; i + 28 <= szsrc; i += 24) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    const __m256i in =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i / 3 * 4),
+                        EncodeBlock(in, offsets));
+  }
+  return i + Base64EncodeSsse3(src + i, szsrc - i, dest + i / 3 * 4, c62, c63);
+}
+
+// Decoding maps each character to its 6-bit value by adding an offset chosen
+// by range checks, which also validate the input. Bytes with the high bit set
+// compare as negative, so they fall outside every range.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i InRange(__m128i c, char lo,
+                                                          char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), c));
+}
+
+// Returns the movemask of the valid characters; the values of the others are
+// garbage.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline int DecodeValues(__m128i c, char c62,
+                                                           char c63,
+                                                           __m128i* values) {
+  const __m128i upper = InRange(c, 'A', 'Z');
+  const __m128i lower = InRange(c, 'a', 'z');
+  const __m128i digit = InRange(c, '0', '9');
+  const __m128i is_62 = _mm_cmpeq_epi8(c, _mm_set1_epi8(c62));
+  const __m128i is_63 = _mm_cmpeq_epi8(c, _mm_set1_epi8(c63));
+  const __m128i valid =
+      _mm_or_si128(_mm_or_si128(upper, lower),
+                   _mm_or_si128(digit, _mm_or_si128(is_62, is_63)));
+  const __m128i offset = _mm_or_si128(
+      _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                   _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+      _mm_or_si128(
+          _mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+          _mm_or_si128(
+              _mm_and_si128(is_62, _mm_set1_epi8(static_cast<char>(62 - c62))),
+              _mm_and_si128(is_63,
+                            _mm_set1_epi8(static_cast<char>(63 - c63))))));
+  *values = _mm_add_epi8(c, offset);
+  return _mm_movemask_epi8(valid);
+}
+
+// Packs the sixteen 6-bit values of each lane into the first 12 bytes.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i PackShuffle() {
+  return _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i PackValues(__m128i values) {
+  const __m128i pairs =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(quads, PackShuffle());
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t Base64DecodeSsse3(
+    const char* src, size_t szsrc, char* dest, size_t szdest, char c62,
+    char c63) {
+  size_t i = 0;
+  size_t out = 0;
+  // Each step consumes 16 characters and produces 12 bytes, but stores 16.
+  while (i + 16 <= szsrc && out + 16 <= szdest) {
+    __m128i values;
+    const int valid = DecodeValues(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), c62, c63,
+        &values);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + out),
+                     PackValues(values));
+    if (valid != 0xFFFF) {
+      // Keep the whole groups before the first invalid character, which is
+      // often the line break of wrapped input.
+      i += __builtin_ctz(~valid) / 4 * 4;
+      break;
+    }
+    i += 16;
+    out += 12;
+  }
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i InRange(__m256i c, char lo,
+                                                         char hi) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(lo - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), c));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline bool DecodeValues(__m256i c,
+                                                           char c62, char c63,
+                                                           __m256i* values) {
+  const __m256i upper = InRange(c, 'A', 'Z');
+  const __m256i lower = InRange(c, 'a', 'z');
+  const __m256i digit = InRange(c, '0', '9');
+  const __m256i is_62 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(c62));
+  const __m256i is_63 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(c63));
+  const __m256i valid =
+      _mm256_or_si256(_mm256_or_si256(upper, lower),
+                      _mm256_or_si256(digit, _mm256_or_si256(is_62, is_63)));
+  if (_mm256_movemask_epi8(valid) != -1) return false;
+  const __m256i offset = _mm256_or_si256(
+      _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')),
+                      _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+      _mm256_or_si256(
+          _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')),
+          _mm256_or_si256(
+              _mm256_and_si256(is_62,
+                               _mm256_set1_epi8(static_cast<char>(62 - c62))),
+              _mm256_and_si256(
+                  is_63, _mm256_set1_epi8(static_cast<char>(63 - c63))))));
+  *values = _mm256_add_epi8(c, offset);
+  return true;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i PackValues(__m256i values) {
+  const __m256i pairs =
+      _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+  const __m256i quads =
+      _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+  const __m256i lanes =
+      _mm256_shuffle_epi8(quads, _mm256_broadcastsi128_si256(PackShuffle()));
+  // Close the gap between the 12 bytes of each lane.
+  return _mm256_permutevar8x32_epi32(lanes,
+                                     _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t Base64DecodeAvx2(
+    const char* src, size_t szsrc, char* dest, size_t szdest, char c62,
+    char c63) {
+  size_t i = 0;
+  size_t out = 0;
+  // Each step consumes 32 characters and produces 24 bytes, but stores 32.
+  while (i + 32 <= szsrc && out + 32 <= szdest) {
+    __m256i values;
+    if (!DecodeValues(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), c62,
+            c63, &values)) {
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + out),
+                        PackValues(values));
+    i += 32;
+    out += 24;
+  }
+  return i + Base64DecodeSsse3(src + i, szsrc - i, dest + out, szdest - out,
+                               c62, c63);
+}
+
+// Hex encoding looks up each nibble in a 16-entry table, then interleaves the
+// high and low digits.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i HexDigits() {
+  return _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a',
+                       'b', 'c', 'd', 'e', 'f');
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t HexEncodeSsse3(
+    const unsigned char* src, size_t szsrc, char* dest) {
+  const __m128i digits = HexDigits();
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 16 <= szsrc; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi = _mm_shuffle_epi8(
+        digits, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, nibble));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i),
+                     _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i + 16),
+                     _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t HexEncodeAvx2(
+    const unsigned char* src, size_t szsrc, char* dest) {
+  const __m256i digits = _mm256_broadcastsi128_si256(HexDigits());
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= szsrc; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i hi = _mm256_shuffle_epi8(
+        digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+    const __m256i lo =
+        _mm256_shuffle_epi8(digits, _mm256_and_si256(in, nibble));
+    // The unpacks work within lanes, so put the lanes back in order.
+    const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + 2 * i),
+                        _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + 2 * i + 32),
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i + HexEncodeSsse3(src + i, szsrc - i, dest + 2 * i);
+}
+
+// Hex decoding maps each digit to its value with range checks, then combines
+// pairs of values with a multiply-add.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i HexValues(__m128i c) {
+  const __m128i digit = InRange(c, '0', '9');
+  const __m128i upper = InRange(c, 'A', 'F');
+  const __m128i lower = InRange(c, 'a', 'f');
+  const __m128i offset = _mm_or_si128(
+      _mm_and_si128(digit, _mm_set1_epi8(-'0')),
+      _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(10 - 'A')),
+                   _mm_and_si128(lower, _mm_set1_epi8(10 - 'a'))));
+  const __m128i valid = _mm_or_si128(digit, _mm_or_si128(upper, lower));
+  return _mm_and_si128(_mm_add_epi8(c, offset), valid);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t HexDecodeSsse3(const char* src,
+                                                         char* dest,
+                                                         size_t szdest) {
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  size_t i = 0;
+  // Each step consumes 32 characters and produces 16 bytes.
+  for (; i + 16 <= szdest; i += 16) {
+    const __m128i a = HexValues(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i)));
+    const __m128i b = HexValues(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i + 16)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_packus_epi16(_mm_maddubs_epi16(a, weights),
+                                      _mm_maddubs_epi16(b, weights)));
+  }
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i HexValues(__m256i c) {
+  const __m256i digit = InRange(c, '0', '9');
+  const __m256i upper = InRange(c, 'A', 'F');
+  const __m256i lower = InRange(c, 'a', 'f');
+  const __m256i offset = _mm256_or_si256(
+      _mm256_and_si256(digit, _mm256_set1_epi8(-'0')),
+      _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(10 - 'A')),
+                      _mm256_and_si256(lower, _mm256_set1_epi8(10 - 'a'))));
+  const __m256i valid = _mm256_or_si256(digit, _mm256_or_si256(upper, lower));
+  return _mm256_and_si256(_mm256_add_epi8(c, offset), valid);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t HexDecodeAvx2(const char* src,
+                                                       char* dest,
+                                                       size_t szdest) {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  // Each step consumes 64 characters and produces 32 bytes.
+  for (; i + 32 <= szdest; i += 32) {
+    const __m256i a = HexValues(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i)));
+    const __m256i b = HexValues(_mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(src + 2 * i + 32)));
+    // The pack works within lanes, so put the lanes back in order.
+    const __m256i packed = _mm256_packus_epi16(
+        _mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                        _mm256_permute4x64_epi64(packed, 0xd8));
+  }
+  return i + HexDecodeSsse3(src + 2 * i, dest + i, szdest - i);
+}
+
+// Returns a mask of the bytes that need no C escaping.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline int CleanMask(__m128i c,
+                                                        bool utf8_safe) {
+  const __m128i special =
+      _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('"')),
+                   _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\'')),
+                                _mm_cmpeq_epi8(c, _mm_set1_epi8('\\'))));
+  const int printable = _mm_movemask_epi8(InRange(c, ' ', '~'));
+  const int high = utf8_safe ? _mm_movemask_epi8(c) : 0;
+  return (printable | high) & ~_mm_movemask_epi8(special);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t CEscapeCleanPrefixSsse3(
+    const char* src, size_t szsrc, bool utf8_safe) {
+  size_t i = 0;
+  for (; i + 16 <= szsrc; i += 16) {
+    const int mask = CleanMask(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), utf8_safe);
+    if (mask != 0xFFFF) return i + __builtin_ctz(~mask);
+  }
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline uint32_t CleanMask(__m256i c,
+                                                           bool utf8_safe) {
+  const __m256i special = _mm256_or_si256(
+      _mm256_cmpeq_epi8(c, _mm256_set1_epi8('"')),
+      _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\'')),
+                      _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\\'))));
+  const uint32_t printable = _mm256_movemask_epi8(InRange(c, ' ', '~'));
+  const uint32_t high = utf8_safe ? _mm256_movemask_epi8(c) : 0;
+  return (printable | high) & ~static_cast<uint32_t>(
+                                  _mm256_movemask_epi8(special));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t CEscapeCleanPrefixAvx2(
+    const char* src, size_t szsrc, bool utf8_safe) {
+  size_t i = 0;
+  for (; i + 32 <= szsrc; i += 32) {
+    const uint32_t mask = CleanMask(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+        utf8_safe);
+    if (mask != 0xFFFFFFFF) return i + __builtin_ctz(~mask);
+  }
+  return i + CEscapeCleanPrefixSsse3(src + i, szsrc - i, utf8_safe);
+}
+
+}  // namespace
+#endif  // ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+
+size_t Base64EncodeSimd(SimdLevel level, const unsigned char* src,
+                        size_t szsrc, char* dest, char c62, char c63) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return Base64EncodeAvx2(src, szsrc, dest, c62, c63);
+    case SimdLevel::kSsse3:
+      return Base64EncodeSsse3(src, szsrc, dest, c62, c63);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+  static_cast<void>(c62);
+  static_cast<void>(c63);
+#endif
+  return 0;
+}
+
+size_t Base64DecodeSimd(SimdLevel level, const char* src, size_t szsrc,
+                        char* dest, size_t szdest, char c62, char c63) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return Base64DecodeAvx2(src, szsrc, dest, szdest, c62, c63);
+    case SimdLevel::kSsse3:
+      return Base64DecodeSsse3(src, szsrc, dest, szdest, c62, c63);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+  static_cast<void>(szdest);
+  static_cast<void>(c62);
+  static_cast<void>(c63);
+#endif
+  return 0;
+}
+
+size_t HexEncodeSimd(SimdLevel level, const unsigned char* src, size_t szsrc,
+                     char* dest) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return HexEncodeAvx2(src, szsrc, dest);
+    case SimdLevel::kSsse3:
+      return HexEncodeSsse3(src, szsrc, dest);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+#endif
+  return 0;
+}
+
+size_t HexDecodeSimd(SimdLevel level, const char* src, char* dest,
+                     size_t szdest) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return HexDecodeAvx2(src, dest, szdest);
+    case SimdLevel::kSsse3:
+      return HexDecodeSsse3(src, dest, szdest);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(dest);
+  static_cast<void>(szdest);
+#endif
+  return 0;
+}
+
+size_t CEscapeCleanPrefixSimd(SimdLevel level, const char* src, size_t szsrc,
+                              bool utf8_safe) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return CEscapeCleanPrefixAvx2(src, szsrc, utf8_safe);
+    case SimdLevel::kSsse3:
+      return CEscapeCleanPrefixSsse3(src, szsrc, utf8_safe);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(utf8_safe);
+#endif
+  return 0;
+}
+
+}  // namespace strings_internal
+}  // namespace absl
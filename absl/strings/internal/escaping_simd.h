@@ -0,0 +1,71 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Vectorized kernels for the bulk of the conversions in escaping.cc.
+//
+// Each kernel converts the longest prefix of its input that it can handle in
+// whole groups, and returns how much it consumed. The scalar code in
+// escaping.cc then finishes the remainder, including anything unusual (such
+// as whitespace, padding or invalid characters), so results and error
+// handling are identical to the scalar implementation by construction.
+//
+// The kernels run at the given SimdLevel (see simd.h). At kNone they consume
+// nothing.
+
+#ifndef ABSL_STRINGS_INTERNAL_ESCAPING_SIMD_H_
+#define ABSL_STRINGS_INTERNAL_ESCAPING_SIMD_H_
+
+#include <cstddef>
+
+#include "absl/strings/internal/simd.h"
+
+namespace absl {
+namespace strings_internal {
+
+// Encodes whole 3-byte groups from the front of `src` as base64, writing four
+// characters per group to `dest`. `c62` and `c63` are the characters for the
+// values 62 and 63, which differ between the standard and web-safe
+// alphabets. Returns the number of bytes consumed, a multiple of 3.
+size_t Base64EncodeSimd(SimdLevel level, const unsigned char* src,
+                        size_t szsrc, char* dest, char c62, char c63);
+
+// Decodes 4-character groups from the front of `src` for as long as they
+// consist only of characters of the alphabet given by `c62` and `c63`, writing
+// three bytes per group to `dest`, which has room for `szdest` bytes.
+// Returns the number of characters consumed, a multiple of 4.
+size_t Base64DecodeSimd(SimdLevel level, const char* src, size_t szsrc,
+                        char* dest, size_t szdest, char c62, char c63);
+
+// Writes the lowercase hex encoding of bytes from the front of `src` to
+// `dest`, two characters per byte. Returns the number of bytes consumed.
+size_t HexEncodeSimd(SimdLevel level, const unsigned char* src, size_t szsrc,
+                     char* dest);
+
+// Decodes pairs of hex digits from the front of `src` to `dest`, for up to
+// `szdest` bytes. Like HexStringToBytes(), characters that are not hex digits
+// count as zero. Returns the number of bytes written.
+size_t HexDecodeSimd(SimdLevel level, const char* src, char* dest,
+                     size_t szdest);
+
+// Returns the length of a prefix of `src` in which no byte needs C escaping:
+// printable ASCII other than '"', '\'' and '\\', plus any byte with the high
+// bit set if `utf8_safe`. The byte after the prefix, if any, either needs
+// escaping or is in the last 15 bytes of `src`, which are left to the caller.
+size_t CEscapeCleanPrefixSimd(SimdLevel level, const char* src, size_t szsrc,
+                              bool utf8_safe);
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_ESCAPING_SIMD_H_
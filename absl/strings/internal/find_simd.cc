@@ -0,0 +1,474 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/find_simd.h"
+
+#include <cstring>
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace absl {
+namespace strings_internal {
+
+bool MakeNibbleTables(absl::string_view chars, NibbleTables* tables) {
+  memset(tables, 0, sizeof(*tables));
+  int num_bits = 0;
+  for (char ch : chars) {
+    const unsigned char c = static_cast<unsigned char>(ch);
+    uint8_t& bit = tables->hi[c >> 4];
+    if (bit == 0) {
+      if (num_bits == 8) return false;
+      bit = static_cast<uint8_t>(1 << num_bits++);
+    }
+    tables->lo[c & 15] |= bit;
+  }
+  return true;
+}
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+namespace {
+
+// Matchers return a bitmask of the bytes of a block that are in the set.
+
+class SetMatcherSsse3 {
+ public:
+  ABSL_STRINGS_INTERNAL_TARGET_SSSE3 explicit SetMatcherSsse3(
+      const NibbleTables& tables)
+      : lo_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.lo))),
+        hi_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.hi))) {}
+
+  ABSL_STRINGS_INTERNAL_TARGET_SSSE3 uint32_t Match(const char* p) const {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i lo = _mm_shuffle_epi8(lo_, _mm_and_si128(in, nibble));
+    const __m128i hi = _mm_shuffle_epi8(
+        hi_, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+    const __m128i none =
+        _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+    return static_cast<uint32_t>(_mm_movemask_epi8(none)) ^ 0xffff;
+  }
+
+ private:
+  __m128i lo_;
+  __m128i hi_;
+};
+
+class CharMatcherSsse3 {
+ public:
+  ABSL_STRINGS_INTERNAL_TARGET_SSSE3 explicit CharMatcherSsse3(char c)
+      : c_(_mm_set1_epi8(c)) {}
+
+  ABSL_STRINGS_INTERNAL_TARGET_SSSE3 uint32_t Match(const char* p) const {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(in, c_)));
+  }
+
+ private:
+  __m128i c_;
+};
+
+class SetMatcherAvx2 {
+ public:
+  ABSL_STRINGS_INTERNAL_TARGET_AVX2 explicit SetMatcherAvx2(
+      const NibbleTables& tables)
+      : lo_(_mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.lo)))),
+        hi_(_mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.hi)))) {}
+
+  ABSL_STRINGS_INTERNAL_TARGET_AVX2 uint32_t Match(const char* p) const {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_shuffle_epi8(lo_, _mm256_and_si256(in, nibble));
+    const __m256i hi = _mm256_shuffle_epi8(
+        hi_, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+    const __m256i none =
+        _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+    return ~static_cast<uint32_t>(_mm256_movemask_epi8(none));
+  }
+
+ private:
+  __m256i lo_;
+  __m256i hi_;
+};
+
+class CharMatcherAvx2 {
+ public:
+  ABSL_STRINGS_INTERNAL_TARGET_AVX2 explicit CharMatcherAvx2(char c)
+      : c_(_mm256_set1_epi8(c)) {}
+
+  ABSL_STRINGS_INTERNAL_TARGET_AVX2 uint32_t Match(const char* p) const {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(in, c_)));
+  }
+
+ private:
+  __m256i c_;
+};
+
+// The loops are written once for all matchers, and inlined into functions
+// compiled for the matcher's instruction set. Those are flattened: the
+// compiler will not inline Match() into a loop compiled for no instruction set
+// in particular, so it has to inline the loop first.
+
+// All the bits of a block's mask.
+template <size_t kBlock>
+constexpr uint32_t FullMask() {
+  return static_cast<uint32_t>((uint64_t{1} << kBlock) - 1);
+}
+
+// The offset of the last bit set in `mask`, which must not be zero.
+inline size_t LastBit(uint32_t mask) {
+  return static_cast<size_t>(31 - __builtin_clz(mask));
+}
+
+// If `kNegate` is set, these look for bytes the matcher does not match.
+template <size_t kBlock, bool kNegate, typename Matcher>
+inline size_t FindFirstOfBlocks(const Matcher& matcher, const char* src,
+                                size_t szsrc) {
+  size_t i = 0;
+  for (; i + kBlock <= szsrc; i += kBlock) {
+    uint32_t mask = matcher.Match(src + i);
+    if (kNegate) mask ^= FullMask<kBlock>();
+    if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+  }
+  return i;
+}
+
+template <size_t kBlock, bool kNegate, typename Matcher>
+inline size_t FindLastOfBlocks(const Matcher& matcher, const char* src,
+                               size_t szsrc) {
+  size_t i = szsrc;
+  for (; i >= kBlock; i -= kBlock) {
+    uint32_t mask = matcher.Match(src + i - kBlock);
+    if (kNegate) mask ^= FullMask<kBlock>();
+    if (mask != 0) return i - kBlock + LastBit(mask) + 1;
+  }
+  return i;
+}
+
+// The substring searches only compare the needle where both its first and its
+// last bytes are in place, which rules out most false starts a block at a time.
+
+template <size_t kBlock, typename Matcher>
+inline size_t FindSubstrBlocks(const Matcher& first, const Matcher& last,
+                               const char* src, size_t szsrc,
+                               const char* needle, size_t szneedle) {
+  if (szneedle > szsrc) return 0;
+  const size_t num_starts = szsrc - szneedle + 1;
+  const char* const src_last = src + szneedle - 1;
+  size_t i = 0;
+  for (; i + kBlock <= num_starts; i += kBlock) {
+    for (uint32_t mask = first.Match(src + i) & last.Match(src_last + i);
+         mask != 0; mask &= mask - 1) {
+      const size_t start = i + static_cast<size_t>(__builtin_ctz(mask));
+      if (memcmp(src + start, needle, szneedle) == 0) return start;
+    }
+  }
+  return i;
+}
+
+template <size_t kBlock, typename Matcher>
+inline size_t RFindSubstrBlocks(const Matcher& first, const Matcher& last,
+                                const char* src, size_t szsrc,
+                                const char* needle, size_t szneedle) {
+  if (szneedle > szsrc) return 0;
+  const char* const src_last = src + szneedle - 1;
+  size_t i = szsrc - szneedle + 1;
+  for (; i >= kBlock; i -= kBlock) {
+    const size_t block = i - kBlock;
+    uint32_t mask = first.Match(src + block) & last.Match(src_last + block);
+    while (mask != 0) {
+      const size_t bit = LastBit(mask);
+      const size_t start = block + bit;
+      if (memcmp(src + start, needle, szneedle) == 0) return start + 1;
+      mask ^= uint32_t{1} << bit;
+    }
+  }
+  return i;
+}
+
+template <size_t kBlock, typename Matcher>
+inline size_t FindAllOfBlocks(const Matcher& matcher, const char* src,
+                              size_t szsrc, size_t* offsets,
+                              size_t max_offsets, size_t* num_offsets) {
+  size_t num = 0;
+  size_t i = 0;
+  for (; i + kBlock <= szsrc; i += kBlock) {
+    for (uint32_t mask = matcher.Match(src + i); mask != 0;
+         mask &= mask - 1) {
+      const size_t offset = i + static_cast<size_t>(__builtin_ctz(mask));
+      if (num == max_offsets) {
+        *num_offsets = num;
+        return offset;
+      }
+      offsets[num++] = offset;
+    }
+  }
+  *num_offsets = num;
+  return i;
+}
+
+template <bool kLast, bool kNegate>
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 __attribute__((flatten))
+size_t FindOfSsse3(const char* src, size_t szsrc, const NibbleTables& tables) {
+  const SetMatcherSsse3 matcher(tables);
+  return kLast ? FindLastOfBlocks<16, kNegate>(matcher, src, szsrc)
+               : FindFirstOfBlocks<16, kNegate>(matcher, src, szsrc);
+}
+
+template <bool kLast, bool kNegate>
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 __attribute__((flatten))
+size_t FindOfAvx2(const char* src, size_t szsrc, const NibbleTables& tables) {
+  const SetMatcherAvx2 matcher(tables);
+  return kLast ? FindLastOfBlocks<32, kNegate>(matcher, src, szsrc)
+               : FindFirstOfBlocks<32, kNegate>(matcher, src, szsrc);
+}
+
+template <bool kLast>
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 __attribute__((flatten))
+size_t FindSubstrSsse3(const char* src, size_t szsrc, const char* needle,
+                       size_t szneedle) {
+  const CharMatcherSsse3 first(needle[0]);
+  const CharMatcherSsse3 last(needle[szneedle - 1]);
+  return kLast ? RFindSubstrBlocks<16>(first, last, src, szsrc, needle,
+                                       szneedle)
+               : FindSubstrBlocks<16>(first, last, src, szsrc, needle,
+                                      szneedle);
+}
+
+template <bool kLast>
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 __attribute__((flatten))
+size_t FindSubstrAvx2(const char* src, size_t szsrc, const char* needle,
+                      size_t szneedle) {
+  const CharMatcherAvx2 first(needle[0]);
+  const CharMatcherAvx2 last(needle[szneedle - 1]);
+  return kLast ? RFindSubstrBlocks<32>(first, last, src, szsrc, needle,
+                                       szneedle)
+               : FindSubstrBlocks<32>(first, last, src, szsrc, needle,
+                                      szneedle);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 __attribute__((flatten))
+size_t FindAllOfSsse3(const char* src, size_t szsrc, const NibbleTables& tables,
+                      size_t* offsets, size_t max_offsets,
+                      size_t* num_offsets) {
+  return FindAllOfBlocks<16>(SetMatcherSsse3(tables), src, szsrc, offsets,
+                             max_offsets, num_offsets);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 __attribute__((flatten))
+size_t FindAllOfAvx2(const char* src, size_t szsrc, const NibbleTables& tables,
+                     size_t* offsets, size_t max_offsets, size_t* num_offsets) {
+  return FindAllOfBlocks<32>(SetMatcherAvx2(tables), src, szsrc, offsets,
+                             max_offsets, num_offsets);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 __attribute__((flatten))
+size_t FindAllOfCharSsse3(const char* src, size_t szsrc, char c,
+                          size_t* offsets, size_t max_offsets,
+                          size_t* num_offsets) {
+  return FindAllOfBlocks<16>(CharMatcherSsse3(c), src, szsrc, offsets,
+                             max_offsets, num_offsets);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 __attribute__((flatten))
+size_t FindAllOfCharAvx2(const char* src, size_t szsrc, char c, size_t* offsets,
+                         size_t max_offsets, size_t* num_offsets) {
+  return FindAllOfBlocks<32>(CharMatcherAvx2(c), src, szsrc, offsets,
+                             max_offsets, num_offsets);
+}
+
+}  // namespace
+#endif  // ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+
+namespace {
+
+template <bool kLast, bool kNegate>
+size_t FindOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                  const NibbleTables& tables) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return FindOfAvx2<kLast, kNegate>(src, szsrc, tables);
+    case SimdLevel::kSsse3:
+      return FindOfSsse3<kLast, kNegate>(src, szsrc, tables);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(tables);
+#endif
+  // Nothing examined, which for the backward searches is everything left.
+  return kLast ? szsrc : 0;
+}
+
+template <bool kLast>
+size_t SubstrSimd(SimdLevel level, const char* src, size_t szsrc,
+                  const char* needle, size_t szneedle) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return FindSubstrAvx2<kLast>(src, szsrc, needle, szneedle);
+    case SimdLevel::kSsse3:
+      return FindSubstrSsse3<kLast>(src, szsrc, needle, szneedle);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(needle);
+#endif
+  if (!kLast || szneedle > szsrc) return 0;
+  return szsrc - szneedle + 1;
+}
+
+// Finishes a forward search from `i` with scalar code.
+template <bool kNegate>
+size_t FinishFirstOf(const NibbleTables& tables, const char* src, size_t szsrc,
+                     size_t i) {
+  while (i < szsrc && tables.contains(src[i]) == kNegate) ++i;
+  return i;
+}
+
+// Finishes a backward search over the first `i` bytes with scalar code.
+template <bool kNegate>
+size_t FinishLastOf(const NibbleTables& tables, const char* src, size_t szsrc,
+                    size_t i) {
+  while (i > 0) {
+    if (tables.contains(src[--i]) != kNegate) return i;
+  }
+  return szsrc;
+}
+
+}  // namespace
+
+size_t FindFirstOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                       const NibbleTables& tables) {
+  return FindOfSimd<false, false>(level, src, szsrc, tables);
+}
+
+size_t FindFirstNotOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                          const NibbleTables& tables) {
+  return FindOfSimd<false, true>(level, src, szsrc, tables);
+}
+
+size_t FindLastOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                      const NibbleTables& tables) {
+  return FindOfSimd<true, false>(level, src, szsrc, tables);
+}
+
+size_t FindLastNotOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                         const NibbleTables& tables) {
+  return FindOfSimd<true, true>(level, src, szsrc, tables);
+}
+
+size_t FindSubstrSimd(SimdLevel level, const char* src, size_t szsrc,
+                      const char* needle, size_t szneedle) {
+  return SubstrSimd<false>(level, src, szsrc, needle, szneedle);
+}
+
+size_t RFindSubstrSimd(SimdLevel level, const char* src, size_t szsrc,
+                       const char* needle, size_t szneedle) {
+  return SubstrSimd<true>(level, src, szsrc, needle, szneedle);
+}
+
+size_t FindAllOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                     const NibbleTables& tables, size_t* offsets,
+                     size_t max_offsets, size_t* num_offsets) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return FindAllOfAvx2(src, szsrc, tables, offsets, max_offsets,
+                           num_offsets);
+    case SimdLevel::kSsse3:
+      return FindAllOfSsse3(src, szsrc, tables, offsets, max_offsets,
+                            num_offsets);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(tables);
+  static_cast<void>(offsets);
+  static_cast<void>(max_offsets);
+#endif
+  *num_offsets = 0;
+  return 0;
+}
+
+size_t FindAllOfCharSimd(SimdLevel level, const char* src, size_t szsrc,
+                         char c, size_t* offsets, size_t max_offsets,
+                         size_t* num_offsets) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return FindAllOfCharAvx2(src, szsrc, c, offsets, max_offsets,
+                               num_offsets);
+    case SimdLevel::kSsse3:
+      return FindAllOfCharSsse3(src, szsrc, c, offsets, max_offsets,
+                                num_offsets);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(c);
+  static_cast<void>(offsets);
+  static_cast<void>(max_offsets);
+#endif
+  *num_offsets = 0;
+  return 0;
+}
+
+size_t FindFirstOf(const NibbleTables& tables, const char* src,
+                   size_t szsrc) {
+  return FinishFirstOf<false>(
+      tables, src, szsrc,
+      FindFirstOfSimd(BestSimdLevel(), src, szsrc, tables));
+}
+
+size_t FindFirstNotOf(const NibbleTables& tables, const char* src,
+                      size_t szsrc) {
+  return FinishFirstOf<true>(
+      tables, src, szsrc,
+      FindFirstNotOfSimd(BestSimdLevel(), src, szsrc, tables));
+}
+
+size_t FindLastOf(const NibbleTables& tables, const char* src, size_t szsrc) {
+  return FinishLastOf<false>(
+      tables, src, szsrc, FindLastOfSimd(BestSimdLevel(), src, szsrc, tables));
+}
+
+size_t FindLastNotOf(const NibbleTables& tables, const char* src,
+                     size_t szsrc) {
+  return FinishLastOf<true>(
+      tables, src, szsrc,
+      FindLastNotOfSimd(BestSimdLevel(), src, szsrc, tables));
+}
+
+}  // namespace strings_internal
+}  // namespace absl
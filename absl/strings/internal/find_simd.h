@@ -0,0 +1,115 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Vectorized kernels for finding the bytes of a set, as used by delimiters
+// such as ByAnyChar and by absl::CharSet, and for finding substrings, as used
+// by absl::string_view.
+//
+// Like the kernels in escaping_simd.h, each one works through whole blocks of
+// its input and reports how far it got, leaving the rest to scalar code. The
+// forward searches work from the front and the backward ones from the back.
+// At SimdLevel::kNone they examine nothing.
+
+#ifndef ABSL_STRINGS_INTERNAL_FIND_SIMD_H_
+#define ABSL_STRINGS_INTERNAL_FIND_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/strings/internal/simd.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+namespace strings_internal {
+
+// A set of bytes in the form the kernels match against a block at a time:
+// byte `b` is in the set if and only if `lo[b & 15] & hi[b >> 4]` is nonzero.
+// Each bit stands for one value of the high nibble, so a set whose members
+// have more than eight distinct high nibbles cannot be represented.
+struct NibbleTables {
+  bool contains(char c) const {
+    const unsigned char b = static_cast<unsigned char>(c);
+    return (lo[b & 15] & hi[b >> 4]) != 0;
+  }
+
+  uint8_t lo[16];
+  uint8_t hi[16];
+};
+
+// Fills `*tables` for the set of the bytes in `chars` and returns true, or
+// returns false if the set cannot be represented.
+bool MakeNibbleTables(absl::string_view chars, NibbleTables* tables);
+
+// Returns the length of the prefix of `src` that contains no byte of the set.
+// The search stops at the first such byte, or at the final partial block,
+// which is left to the caller.
+size_t FindFirstOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                       const NibbleTables& tables);
+
+// Stores the offsets of the bytes of the set in whole blocks at the front of
+// `src` in `offsets`, in order and up to `max_offsets` of them, and sets
+// `*num_offsets` to how many there are. Returns the number of bytes examined:
+// every byte of the set before that offset has been reported. If `offsets`
+// fills up, the offset returned is that of the next byte of the set.
+size_t FindAllOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                     const NibbleTables& tables, size_t* offsets,
+                     size_t max_offsets, size_t* num_offsets);
+
+// As above, for the single byte `c`.
+size_t FindAllOfCharSimd(SimdLevel level, const char* src, size_t szsrc,
+                         char c, size_t* offsets, size_t max_offsets,
+                         size_t* num_offsets);
+
+// As FindFirstOfSimd(), for the first byte not in the set.
+size_t FindFirstNotOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                          const NibbleTables& tables);
+
+// Returns the length of the prefix of `src` that the search has left to the
+// caller: no byte after it is in the set. The search stops at the last byte
+// of the set, which is then the last byte of the prefix, or at the partial
+// block at the front.
+size_t FindLastOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                      const NibbleTables& tables);
+
+// As FindLastOfSimd(), for the last byte not in the set.
+size_t FindLastNotOfSimd(SimdLevel level, const char* src, size_t szsrc,
+                         const NibbleTables& tables);
+
+// Returns the number of offsets at the front of `src` at which the search has
+// found that the nonempty `needle` does not start. The search stops at the
+// first occurrence of `needle`, or where fewer than a block of offsets remain.
+size_t FindSubstrSimd(SimdLevel level, const char* src, size_t szsrc,
+                      const char* needle, size_t szneedle);
+
+// Returns the number of offsets at the front of `src` that the search has left
+// to the caller: the nonempty `needle` starts at none of the offsets after
+// them. The search stops at the last occurrence of `needle`, which then starts
+// at the last offset left, or where fewer than a block of offsets remain.
+size_t RFindSubstrSimd(SimdLevel level, const char* src, size_t szsrc,
+                       const char* needle, size_t szneedle);
+
+// Complete searches for the bytes of a set, which run the kernels at
+// BestSimdLevel() and finish with scalar code. Each returns the offset of the
+// byte found, or `szsrc` if there is none.
+size_t FindFirstOf(const NibbleTables& tables, const char* src, size_t szsrc);
+size_t FindFirstNotOf(const NibbleTables& tables, const char* src,
+                      size_t szsrc);
+size_t FindLastOf(const NibbleTables& tables, const char* src, size_t szsrc);
+size_t FindLastNotOf(const NibbleTables& tables, const char* src,
+                     size_t szsrc);
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_FIND_SIMD_H_
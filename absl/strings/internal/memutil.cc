@@ -16,6 +16,9 @@
 
 #include <cstdlib>
 
+#include "absl/strings/internal/ascii_simd.h"
+#include "absl/strings/internal/simd.h"
+
 namespace absl {
 namespace strings_internal {
 
@@ -23,7 +26,10 @@ int memcasecmp(const char* s1, const char* s2, size_t len) {
   const unsigned char* us1 = reinterpret_cast<const unsigned char*>(s1);
   const unsigned char* us2 = reinterpret_cast<const unsigned char*>(s2);
 
-  for (size_t i = 0; i < len; i++) {
+  // The vectorized comparison finds where the strings differ, if anywhere
+  // but near the end.
+  for (size_t i = AsciiCaseEqualPrefixSimd(BestSimdLevel(), s1, s2, len);
+       i < len; i++) {
     const int diff =
         int{static_cast<unsigned char>(absl::ascii_tolower(us1[i]))} -
         int{static_cast<unsigned char>(absl::ascii_tolower(us2[i]))};
@@ -13,15 +13,18 @@
 // limitations under the License.
 //
 // This file contains common things needed by numbers_test.cc,
-// numbers_legacy_test.cc and numbers_benchmark.cc.
+// numbers_legacy_test.cc, numbers_benchmark.cc and charconv_benchmark.cc.
 
 #ifndef ABSL_STRINGS_INTERNAL_NUMBERS_TEST_COMMON_H_
 #define ABSL_STRINGS_INTERNAL_NUMBERS_TEST_COMMON_H_
 
 #include <array>
 #include <cstdint>
+#include <cstdio>
 #include <limits>
+#include <random>
 #include <string>
+#include <vector>
 
 namespace absl {
 namespace strings_internal {
@@ -173,6 +176,46 @@ inline const std::array<uint64_test_case, 34>& strtouint64_test_cases() {
   return test_cases;
 }
 
+// Returns decimal numbers shaped like the ones found in JSON and CSV data
+// sets, interleaved in equal parts:
+//
+//   * GeoJSON coordinates printed with full precision ("-65.61361699999998"),
+//   * prices and measurements with two decimals ("1289.75"),
+//   * scientific values with seven significant digits ("6.022141e+23"),
+//   * integers ("48213").
+inline std::vector<std::string> RealWorldNumberStrings(int num_strings) {
+  // We don't actually need random properties, so use a fixed seed.
+  std::minstd_rand0 rng(1);
+  std::uniform_real_distribution<double> coordinate(-180, 180);
+  std::uniform_real_distribution<double> price(0, 10000);
+  std::uniform_real_distribution<double> mantissa(1, 10);
+  std::uniform_int_distribution<int> exponent(-30, 30);
+  std::uniform_int_distribution<int> integer(0, 1000000);
+
+  std::vector<std::string> strings;
+  strings.reserve(num_strings);
+  char buffer[32];
+  for (int i = 0; i < num_strings; ++i) {
+    switch (i % 4) {
+      case 0:
+        snprintf(buffer, sizeof(buffer), "%.16g", coordinate(rng));
+        break;
+      case 1:
+        snprintf(buffer, sizeof(buffer), "%.2f", price(rng));
+        break;
+      case 2:
+        snprintf(buffer, sizeof(buffer), "%.6fe%+03d", mantissa(rng),
+                 exponent(rng));
+        break;
+      default:
+        snprintf(buffer, sizeof(buffer), "%d", integer(rng));
+        break;
+    }
+    strings.push_back(buffer);
+  }
+  return strings;
+}
+
 }  // namespace strings_internal
 }  // namespace absl
 
@@ -0,0 +1,43 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/simd.h"
+
+namespace absl {
+namespace strings_internal {
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+namespace {
+
+SimdLevel DetectSimdLevel() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+  if (__builtin_cpu_supports("ssse3")) return SimdLevel::kSsse3;
+  return SimdLevel::kNone;
+}
+
+}  // namespace
+#endif  // ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+
+SimdLevel BestSimdLevel() {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  static const SimdLevel level = DetectSimdLevel();
+  return level;
+#else
+  return SimdLevel::kNone;
+#endif
+}
+
+}  // namespace strings_internal
+}  // namespace absl
@@ -0,0 +1,50 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Run-time selection of the instruction sets used by the vectorized string
+// kernels.
+//
+// Kernels are compiled for specific instruction sets with function-level
+// target attributes, so they need no special build flags, and are selected by
+// the level BestSimdLevel() reports. Kernel translation units test
+// ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD and mark their functions with
+// ABSL_STRINGS_INTERNAL_TARGET_SSSE3 or ABSL_STRINGS_INTERNAL_TARGET_AVX2. On
+// other compilers and architectures the level is always kNone.
+
+#ifndef ABSL_STRINGS_INTERNAL_SIMD_H_
+#define ABSL_STRINGS_INTERNAL_SIMD_H_
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD 1
+#define ABSL_STRINGS_INTERNAL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define ABSL_STRINGS_INTERNAL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace absl {
+namespace strings_internal {
+
+// The instruction sets the kernels may use, in increasing order.
+enum class SimdLevel {
+  kNone,
+  kSsse3,
+  kAvx2,
+};
+
+// Returns the best level supported by both the build and the CPU.
+SimdLevel BestSimdLevel();
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_SIMD_H_
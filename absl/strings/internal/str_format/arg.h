@@ -18,11 +18,9 @@
 #include "absl/strings/internal/str_format/extension.h"
 #include "absl/strings/string_view.h"
 
-class Cord;
-class CordReader;
-
 namespace absl {
 
+class Cord;
 class FormatCountCapture;
 class FormatSink;
 
@@ -67,8 +65,7 @@ ConvertResult<Conv::s | Conv::p> FormatConvertImpl(const char* v,
                                                    FormatSinkImpl* sink);
 template <class AbslCord,
           typename std::enable_if<
-              std::is_same<AbslCord, ::Cord>::value>::type* = nullptr,
-          class AbslCordReader = ::CordReader>
+              std::is_same<AbslCord, absl::Cord>::value>::type* = nullptr>
 ConvertResult<Conv::s> FormatConvertImpl(const AbslCord& value,
                                          ConversionSpec conv,
                                          FormatSinkImpl* sink) {
@@ -90,11 +87,11 @@ ConvertResult<Conv::s> FormatConvertImpl(const AbslCord& value,
 
   if (space_remaining > 0 && !is_left) sink->Append(space_remaining, ' ');
 
-  string_view piece;
-  for (AbslCordReader reader(value);
-       to_write > 0 && reader.ReadFragment(&piece); to_write -= piece.size()) {
+  for (string_view piece : value.Chunks()) {
+    if (to_write == 0) break;
     if (piece.size() > to_write) piece.remove_suffix(piece.size() - to_write);
     sink->Append(piece);
+    to_write -= piece.size();
   }
 
   if (space_remaining > 0 && is_left) sink->Append(space_remaining, ' ');
@@ -209,6 +206,15 @@ struct FormatArgImplFriend {
     return arg.dispatcher_(arg.data_, conv, out);
   }
 
+  // Converts `value` without erasing its type first, for callers that know
+  // the argument types at compile time.
+  template <typename Arg, typename T>
+  static bool ConvertValue(const T& value,
+                           str_format_internal::ConversionSpec conv,
+                           FormatSinkImpl* out) {
+    return Arg::ConvertValue(value, conv, out);
+  }
+
   template <typename Arg>
   static typename Arg::Dispatcher GetVTablePtrForTest(Arg arg) {
     return arg.dispatcher_;
@@ -382,6 +388,15 @@ class FormatArgImpl {
         .value;
   }
 
+  template <typename T>
+  static bool ConvertValue(const T& value, ConversionSpec spec,
+                           FormatSinkImpl* out) {
+    using D = typename DecayType<T>::type;
+    return str_format_internal::FormatConvertImpl(static_cast<D>(value), spec,
+                                                  out)
+        .value;
+  }
+
   Data data_;
   Dispatcher dispatcher_;
 };
@@ -5,6 +5,8 @@
 #include <sstream>
 #include <string>
 
+#include "absl/strings/string_builder.h"
+
 namespace absl {
 namespace str_format_internal {
 
@@ -196,6 +198,16 @@ std::string& AppendPack(std::string* out, const UntypedFormatSpecImpl format,
   return *out;
 }
 
+StringBuilder& AppendPack(StringBuilder* out,
+                          const UntypedFormatSpecImpl format,
+                          absl::Span<const FormatArgImpl> args) {
+  size_t orig = out->size();
+  if (ABSL_PREDICT_FALSE(!FormatUntyped(out, format, args))) {
+    out->Truncate(orig);
+  }
+  return *out;
+}
+
 int FprintF(std::FILE* output, const UntypedFormatSpecImpl format,
             absl::Span<const FormatArgImpl> args) {
   FILERawSink sink(output);
@@ -14,6 +14,7 @@
 
 namespace absl {
 
+class StringBuilder;
 class UntypedFormatSpec;
 
 namespace str_format_internal {
@@ -177,6 +178,8 @@ bool FormatUntyped(FormatRawSinkImpl raw_sink,
 
 std::string& AppendPack(std::string* out, UntypedFormatSpecImpl format,
                         absl::Span<const FormatArgImpl> args);
+StringBuilder& AppendPack(StringBuilder* out, UntypedFormatSpecImpl format,
+                          absl::Span<const FormatArgImpl> args);
 
 inline std::string FormatPack(const UntypedFormatSpecImpl format,
                               absl::Span<const FormatArgImpl> args) {
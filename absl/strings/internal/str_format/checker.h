@@ -31,12 +31,18 @@ constexpr Conv ArgumentToConv() {
       std::declval<FormatSinkImpl*>()))::kConv;
 }
 
-#if ABSL_INTERNAL_ENABLE_FORMAT_CHECKER
-
 constexpr bool ContainsChar(const char* chars, char c) {
   return *chars == c || (*chars && ContainsChar(chars + 1, c));
 }
 
+constexpr char GetChar(string_view str, size_t index) {
+  return index < str.size() ? str[index] : char{};
+}
+
+constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+#if ABSL_INTERNAL_ENABLE_FORMAT_CHECKER
+
 // A constexpr compatible list of Convs.
 struct ConvList {
   const Conv* array;
@@ -60,10 +66,6 @@ struct ConvListT {
   Conv list[count ? count : 1];
 };
 
-constexpr char GetChar(string_view str, size_t index) {
-  return index < str.size() ? str[index] : char{};
-}
-
 constexpr string_view ConsumeFront(string_view str, size_t len = 1) {
   return len <= str.size() ? string_view(str.data() + len, str.size() - len)
                            : string_view();
@@ -75,8 +77,6 @@ constexpr string_view ConsumeAnyOf(string_view format, const char* chars) {
              : format;
 }
 
-constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
-
 // Helper class for the ParseDigits function.
 // It encapsulates the two return values we need there.
 struct Integer {
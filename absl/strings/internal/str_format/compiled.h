@@ -0,0 +1,422 @@
+#ifndef ABSL_STRINGS_INTERNAL_STR_FORMAT_COMPILED_H_
+#define ABSL_STRINGS_INTERNAL_STR_FORMAT_COMPILED_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "absl/strings/internal/str_format/arg.h"
+#include "absl/strings/internal/str_format/checker.h"
+#include "absl/strings/internal/str_format/extension.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/string_view.h"
+
+// Support for formats that are expanded at compile time.
+//
+// A compiled format is a type whose `static constexpr string_view Get()`
+// returns the format string.  The format is walked at compile time, one
+// template instantiation per literal chunk or conversion, so formatting a
+// call site becomes a sequence of appends and statically dispatched
+// conversions, with no parsing and no type erasure of the arguments.  The
+// format is also checked against the arguments with `static_assert`, on every
+// compiler.
+
+namespace absl {
+namespace str_format_internal {
+
+// The value returned by ABSL_COMPILED_FORMAT().  `Format` provides the format
+// string through its static `Get()` function.
+template <typename Format>
+class CompiledFormat {};
+
+// Returns the position of the first '%' at or after `pos`, or the size of
+// `format` if there is none.  The inner function consumes up to `limit`
+// characters per run to raise the recursion limit, as in
+// FormatParser::ConsumeNonPercent().
+constexpr size_t FindPercentInner(string_view format, size_t pos,
+                                  int limit = 20) {
+  return pos >= format.size() || format[pos] == '%' || !limit
+             ? pos
+             : FindPercentInner(format, pos + 1, limit - 1);
+}
+
+constexpr size_t FindPercent(string_view format, size_t pos) {
+  return pos >= format.size() || format[pos] == '%'
+             ? pos
+             : FindPercent(format, FindPercentInner(format, pos));
+}
+
+constexpr size_t SkipDigits(string_view format, size_t pos) {
+  return IsDigit(GetChar(format, pos)) ? SkipDigits(format, pos + 1) : pos;
+}
+
+constexpr int DigitsValue(string_view format, size_t pos, int value = 0) {
+  return IsDigit(GetChar(format, pos))
+             ? DigitsValue(format, pos + 1, 10 * value + GetChar(format, pos) -
+                                                '0')
+             : value;
+}
+
+constexpr size_t SkipAnyOf(string_view format, size_t pos, const char* chars) {
+  return GetChar(format, pos) != '\0' && ContainsChar(chars, format[pos])
+             ? SkipAnyOf(format, pos + 1, chars)
+             : pos;
+}
+
+// Returns whether `format` has a "N$" argument position at `pos`.
+constexpr bool HasPositionAt(string_view format, size_t pos) {
+  return SkipDigits(format, pos) != pos &&
+         GetChar(format, SkipDigits(format, pos)) == '$';
+}
+
+// Returns the position of the '%' of the first conversion in `format` at or
+// after `pos`, skipping "%%".
+constexpr size_t FindConversion(string_view format, size_t pos = 0) {
+  return GetChar(format, FindPercent(format, pos) + 1) == '%'
+             ? FindConversion(format, FindPercent(format, pos) + 2)
+             : FindPercent(format, pos);
+}
+
+// Like the runtime parser, the first conversion decides whether all of them
+// use explicit argument positions.
+constexpr bool IsPositionalFormat(string_view format) {
+  return HasPositionAt(format, FindConversion(format) + 1);
+}
+
+enum : int {
+  kCompiledFlagLeft = 1,
+  kCompiledFlagShowPos = 2,
+  kCompiledFlagSignCol = 4,
+  kCompiledFlagAlt = 8,
+  kCompiledFlagZero = 16,
+};
+
+constexpr int FlagBits(string_view format, size_t pos, size_t end) {
+  return pos >= end ? 0
+                    : (format[pos] == '-'
+                           ? kCompiledFlagLeft
+                           : format[pos] == '+'
+                                 ? kCompiledFlagShowPos
+                                 : format[pos] == ' '
+                                       ? kCompiledFlagSignCol
+                                       : format[pos] == '#'
+                                             ? kCompiledFlagAlt
+                                             : kCompiledFlagZero) |
+                          FlagBits(format, pos + 1, end);
+}
+
+// Returns the position after a '*' width or precision at `pos`, including
+// its "N$" argument position in positional mode.
+constexpr size_t SkipStar(string_view format, size_t pos, bool positional) {
+  return positional ? SkipDigits(format, pos + 1) + 1 : pos + 1;
+}
+
+// The fields of the conversion whose '%' is at `kPos`.  `kNextArg` is the
+// 0-based index of the next argument in sequential mode.  Argument indices
+// of the result are 0-based too.
+template <typename Format, size_t kPos, int kNextArg, bool kPositional>
+struct CompiledConversion {
+  static constexpr size_t kFlagsBegin =
+      kPositional ? SkipDigits(Format::Get(), kPos + 1) + 1 : kPos + 1;
+  static constexpr size_t kFlagsEnd =
+      SkipAnyOf(Format::Get(), kFlagsBegin, "-+ #0");
+  static constexpr int kFlags =
+      FlagBits(Format::Get(), kFlagsBegin, kFlagsEnd);
+
+  static constexpr bool kWidthFromArg =
+      GetChar(Format::Get(), kFlagsEnd) == '*';
+  static constexpr int kWidth = DigitsValue(Format::Get(), kFlagsEnd);
+  static constexpr bool kHasWidth =
+      kWidthFromArg || IsDigit(GetChar(Format::Get(), kFlagsEnd));
+  static constexpr size_t kWidthEnd =
+      kWidthFromArg ? SkipStar(Format::Get(), kFlagsEnd, kPositional)
+                    : SkipDigits(Format::Get(), kFlagsEnd);
+  static constexpr int kWidthArg =
+      kPositional ? DigitsValue(Format::Get(), kFlagsEnd + 1) - 1 : kNextArg;
+  static constexpr int kArgAfterWidth =
+      kNextArg + (kWidthFromArg && !kPositional ? 1 : 0);
+
+  static constexpr bool kHasPrecision =
+      GetChar(Format::Get(), kWidthEnd) == '.';
+  static constexpr bool kPrecisionFromArg =
+      kHasPrecision && GetChar(Format::Get(), kWidthEnd + 1) == '*';
+  static constexpr int kPrecision = DigitsValue(Format::Get(), kWidthEnd + 1);
+  static constexpr size_t kPrecisionEnd =
+      !kHasPrecision ? kWidthEnd
+                     : kPrecisionFromArg
+                           ? SkipStar(Format::Get(), kWidthEnd + 1, kPositional)
+                           : SkipDigits(Format::Get(), kWidthEnd + 1);
+  static constexpr int kPrecisionArg =
+      kPositional ? DigitsValue(Format::Get(), kWidthEnd + 2) - 1
+                  : kArgAfterWidth;
+  static constexpr int kArgAfterPrecision =
+      kArgAfterWidth + (kPrecisionFromArg && !kPositional ? 1 : 0);
+
+  static constexpr size_t kConvPos =
+      SkipAnyOf(Format::Get(), kPrecisionEnd, "lLhjztq");
+  static constexpr char kConv = GetChar(Format::Get(), kConvPos);
+  static constexpr size_t kEnd = kConvPos + 1;
+
+  static constexpr int kArg = kPositional
+                                  ? DigitsValue(Format::Get(), kPos + 1) - 1
+                                  : kArgAfterPrecision;
+  static constexpr int kNextArgAfter = kPositional ? 0 : kArg + 1;
+
+  // No flags, width or precision.
+  static constexpr bool kBasic = kFlags == 0 && !kHasWidth && !kHasPrecision;
+
+  static constexpr bool kValid =
+      (!kPositional || HasPositionAt(Format::Get(), kPos + 1)) &&
+      (!kPositional || !kWidthFromArg ||
+       HasPositionAt(Format::Get(), kFlagsEnd + 1)) &&
+      (!kPositional || !kPrecisionFromArg ||
+       HasPositionAt(Format::Get(), kWidthEnd + 2)) &&
+      kConv != '*' && ConversionCharToConvValue(kConv) != 0;
+};
+
+// How a conversion is performed.  Basic conversions of the most common
+// argument types are written directly to the sink; everything else goes
+// through FormatConvertImpl(), still without type erasure.
+enum class CompiledConvKind { kGeneric, kString, kCString, kInt, kChar };
+
+template <typename T>
+constexpr CompiledConvKind GetCompiledConvKind(char conv, bool basic) {
+  return !basic || HasUserDefinedConvert<T>::value
+             ? CompiledConvKind::kGeneric
+             : conv == 's' ? (std::is_same<T, std::string>::value ||
+                                      std::is_same<T, string_view>::value
+                                  ? CompiledConvKind::kString
+                                  : std::is_convertible<T, const char*>::value
+                                        ? CompiledConvKind::kCString
+                                        : CompiledConvKind::kGeneric)
+                           : !std::is_integral<T>::value ||
+                                     std::is_same<T, bool>::value
+                                 ? CompiledConvKind::kGeneric
+                                 : conv == 'd' || conv == 'i' || conv == 'u'
+                                       ? CompiledConvKind::kInt
+                                       : conv == 'c'
+                                             ? CompiledConvKind::kChar
+                                             : CompiledConvKind::kGeneric;
+}
+
+template <typename T>
+using CompiledIntType = typename std::conditional<
+    std::is_signed<T>::value,
+    typename std::conditional<sizeof(T) <= 4, int32_t, int64_t>::type,
+    typename std::conditional<sizeof(T) <= 4, uint32_t, uint64_t>::type>::type;
+
+template <typename Conv, typename T>
+bool ConvertCompiled(
+    const T& v, int, int, FormatSinkImpl* sink,
+    std::integral_constant<CompiledConvKind, CompiledConvKind::kString>) {
+  sink->Append(v);
+  return true;
+}
+
+template <typename Conv, typename T>
+bool ConvertCompiled(
+    const T& v, int, int, FormatSinkImpl* sink,
+    std::integral_constant<CompiledConvKind, CompiledConvKind::kCString>) {
+  const char* s = v;
+  // A null pointer prints as an empty string, as in FormatConvertImpl().
+  if (s != nullptr) sink->Append(s);
+  return true;
+}
+
+template <typename Conv, typename T>
+bool ConvertCompiled(
+    const T& v, int, int, FormatSinkImpl* sink,
+    std::integral_constant<CompiledConvKind, CompiledConvKind::kInt>) {
+  // '%u' prints signed values as their unsigned counterpart.
+  using U = typename std::conditional<Conv::kConv == 'u',
+                                      typename std::make_unsigned<T>::type,
+                                      T>::type;
+  char buf[numbers_internal::kFastToBufferSize];
+  const char* end = numbers_internal::FastIntToBuffer(
+      static_cast<CompiledIntType<U>>(static_cast<U>(v)), buf);
+  sink->Append(string_view(buf, end - buf));
+  return true;
+}
+
+template <typename Conv, typename T>
+bool ConvertCompiled(
+    const T& v, int, int, FormatSinkImpl* sink,
+    std::integral_constant<CompiledConvKind, CompiledConvKind::kChar>) {
+  sink->Append(1, static_cast<char>(static_cast<unsigned char>(v)));
+  return true;
+}
+
+template <typename Conv, typename T>
+bool ConvertCompiled(
+    const T& v, int width, int precision, FormatSinkImpl* sink,
+    std::integral_constant<CompiledConvKind, CompiledConvKind::kGeneric>) {
+  Flags flags;
+  flags.basic = Conv::kBasic;
+  flags.left = (Conv::kFlags & kCompiledFlagLeft) != 0;
+  flags.show_pos = (Conv::kFlags & kCompiledFlagShowPos) != 0;
+  flags.sign_col = (Conv::kFlags & kCompiledFlagSignCol) != 0;
+  flags.alt = (Conv::kFlags & kCompiledFlagAlt) != 0;
+  flags.zero = (Conv::kFlags & kCompiledFlagZero) != 0;
+  if (width < 0 && Conv::kWidthFromArg) {
+    // "A negative field width is taken as a '-' flag followed by a positive
+    // field width."
+    flags.left = true;
+    // Make sure we don't overflow the width when negating it.
+    width = -std::max(width, -std::numeric_limits<int>::max());
+  }
+  ConversionSpec spec;
+  spec.set_flags(flags);
+  spec.set_width(width);
+  spec.set_precision(precision);
+  spec.set_conv(ConversionChar::FromChar(Conv::kConv));
+  return FormatArgImplFriend::ConvertValue<FormatArgImpl>(v, spec, sink);
+}
+
+// Returns the '*' width or precision taken from argument `kIndex`.
+template <int kIndex, typename... Args>
+int CompiledStarArg(const std::tuple<const Args&...>& args, std::true_type) {
+  constexpr int kNumArgs = sizeof...(Args);
+  static_assert(kIndex >= 0 && kIndex < kNumArgs,
+                "Format specified does not match the arguments passed.");
+  constexpr int kClampedIndex = kIndex >= 0 && kIndex < kNumArgs ? kIndex : 0;
+  using Arg = typename std::decay<typename std::tuple_element<
+      kClampedIndex, std::tuple<Args..., int>>::type>::type;
+  static_assert(Contains(ArgumentToConv<Arg>(), '*'),
+                "Format specified does not match the arguments passed.");
+  int value;
+  FormatArgImplFriend::ToInt(FormatArgImpl(std::get<kClampedIndex>(args)),
+                             &value);
+  return value;
+}
+
+// The width or precision is not taken from an argument.
+template <int kIndex, typename... Args>
+int CompiledStarArg(const std::tuple<const Args&...>&, std::false_type) {
+  return -1;
+}
+
+enum class CompiledStep { kEnd, kLiteral, kPercent, kConversion };
+
+constexpr CompiledStep GetCompiledStep(string_view format, size_t pos) {
+  return pos >= format.size()
+             ? CompiledStep::kEnd
+             : format[pos] != '%' ? CompiledStep::kLiteral
+                                  : GetChar(format, pos + 1) == '%'
+                                        ? CompiledStep::kPercent
+                                        : CompiledStep::kConversion;
+}
+
+// Formats the part of the format that starts at `kPos`.
+template <typename Format, size_t kPos, int kNextArg, bool kPositional,
+          CompiledStep = GetCompiledStep(Format::Get(), kPos)>
+struct CompiledSteps;
+
+template <typename Format, size_t kPos, int kNextArg, bool kPositional>
+struct CompiledSteps<Format, kPos, kNextArg, kPositional, CompiledStep::kEnd> {
+  template <typename... Args>
+  static bool Run(FormatSinkImpl*, const std::tuple<const Args&...>&) {
+    // In non-positional mode all the arguments must be consumed.
+    static_assert(kPositional || kNextArg == sizeof...(Args),
+                  "Format specified does not match the arguments passed.");
+    return true;
+  }
+};
+
+template <typename Format, size_t kPos, int kNextArg, bool kPositional>
+struct CompiledSteps<Format, kPos, kNextArg, kPositional,
+                     CompiledStep::kLiteral> {
+  static constexpr size_t kEnd = FindPercent(Format::Get(), kPos);
+
+  template <typename... Args>
+  static bool Run(FormatSinkImpl* sink,
+                  const std::tuple<const Args&...>& args) {
+    sink->Append(string_view(Format::Get().data() + kPos, kEnd - kPos));
+    return CompiledSteps<Format, kEnd, kNextArg, kPositional>::Run(sink, args);
+  }
+};
+
+template <typename Format, size_t kPos, int kNextArg, bool kPositional>
+struct CompiledSteps<Format, kPos, kNextArg, kPositional,
+                     CompiledStep::kPercent> {
+  template <typename... Args>
+  static bool Run(FormatSinkImpl* sink,
+                  const std::tuple<const Args&...>& args) {
+    sink->Append(1, '%');
+    return CompiledSteps<Format, kPos + 2, kNextArg, kPositional>::Run(sink,
+                                                                       args);
+  }
+};
+
+template <typename Format, size_t kPos, int kNextArg, bool kPositional>
+struct CompiledSteps<Format, kPos, kNextArg, kPositional,
+                     CompiledStep::kConversion> {
+  using Conv = CompiledConversion<Format, kPos, kNextArg, kPositional>;
+
+  template <typename... Args>
+  static bool Run(FormatSinkImpl* sink,
+                  const std::tuple<const Args&...>& args) {
+    constexpr int kNumArgs = sizeof...(Args);
+    static_assert(Conv::kValid && Conv::kArg >= 0 && Conv::kArg < kNumArgs,
+                  "Format specified does not match the arguments passed.");
+    // Clamp the index so that a bad format only reports the error above.
+    constexpr int kArg =
+        Conv::kArg >= 0 && Conv::kArg < kNumArgs ? Conv::kArg : 0;
+    using Arg = typename std::decay<typename std::tuple_element<
+        kArg, std::tuple<Args..., int>>::type>::type;
+    static_assert(Contains(ArgumentToConv<Arg>(), Conv::kConv),
+                  "Format specified does not match the arguments passed.");
+    constexpr CompiledConvKind kKind =
+        GetCompiledConvKind<Arg>(Conv::kConv, Conv::kBasic);
+    constexpr int kWidth = Conv::kHasWidth ? Conv::kWidth : -1;
+    constexpr int kPrecision = Conv::kHasPrecision ? Conv::kPrecision : -1;
+    const int width =
+        Conv::kWidthFromArg
+            ? CompiledStarArg<Conv::kWidthArg>(
+                  args, std::integral_constant<bool, Conv::kWidthFromArg>())
+            : kWidth;
+    const int precision =
+        Conv::kPrecisionFromArg
+            ? CompiledStarArg<Conv::kPrecisionArg>(
+                  args, std::integral_constant<bool, Conv::kPrecisionFromArg>())
+            : kPrecision;
+    return ConvertCompiled<Conv>(
+               std::get<kArg>(args), width, precision, sink,
+               std::integral_constant<CompiledConvKind, kKind>()) &&
+           CompiledSteps<Format, Conv::kEnd, Conv::kNextArgAfter,
+                         kPositional>::Run(sink, args);
+  }
+};
+
+// Formats `args` according to the compiled format `Format` into `sink`.
+// Returns false if any conversion fails at runtime.
+template <typename Format, typename... Args>
+bool FormatCompiled(FormatSinkImpl* sink, const Args&... args) {
+  return CompiledSteps<Format, 0, 0, IsPositionalFormat(Format::Get())>::Run(
+      sink, std::tuple<const Args&...>(args...));
+}
+
+// Appends `args` formatted according to `Format` to `out`.  Like AppendPack(),
+// appends nothing in case of error.
+template <typename Format, typename... Args>
+std::string& AppendCompiled(std::string* out, const Args&... args) {
+  // An empty format has no pieces and appends nothing. Skipping the sink also
+  // keeps GCC from warning about its unwritten buffer being flushed.
+  if (Format::Get().empty()) return *out;
+  const size_t orig = out->size();
+  bool ok;
+  {
+    FormatSinkImpl sink(out);
+    ok = FormatCompiled<Format>(&sink, args...);
+  }
+  if (ABSL_PREDICT_FALSE(!ok)) out->erase(orig);
+  return *out;
+}
+
+}  // namespace str_format_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_STR_FORMAT_COMPILED_H_
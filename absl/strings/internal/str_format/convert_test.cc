@@ -3,7 +3,10 @@
 #include <stdio.h>
 #include <cctype>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -541,6 +544,56 @@ TEST_F(FormatConvertTest, LongDouble) {
   }
 }
 
+TEST_F(FormatConvertTest, FloatAcrossExponentRange) {
+#ifdef _MSC_VER
+  // MSVC has a different rounding policy than us so we can't test our
+  // implementation against the native one there.
+  return;
+#endif  // _MSC_VER
+
+  const char *const kFormats[] = {"%.17g",  "%#.3g", "%.0e",    "%.40e",
+                                  "%.0f",   "%.20f", "%.1100f", "%a",
+                                  "%#.0a",  "%.2a",  "%015.4A"};
+
+  // Pseudo-random mantissas, scaled to cover all the exponents, including the
+  // subnormal ones.
+  std::vector<double> doubles;
+  uint64_t bits = 0x9e3779b97f4a7c15;
+  for (int exp = -1074; exp <= 1023; exp += 7) {
+    bits = bits * 6364136223846793005u + 1442695040888963407u;
+    doubles.push_back(std::ldexp(static_cast<double>(bits >> 12), exp - 52));
+  }
+
+  for (const char *fmt : kFormats) {
+    for (double d : doubles) {
+      FormatArgImpl arg(d);
+      UntypedFormatSpecImpl format(fmt);
+      ASSERT_EQ(StrPrint(fmt, d), FormatPack(format, {&arg, 1}))
+          << fmt << " " << StrPrint("%a", d);
+    }
+  }
+
+  const char *const kLongDoubleFormats[] = {"%.25Lg", "%.0Le", "%.30Lf",
+                                            "%La", "%.3La"};
+  std::vector<long double> long_doubles;
+  for (int exp = std::numeric_limits<long double>::min_exponent -
+                 std::numeric_limits<long double>::digits;
+       exp < std::numeric_limits<long double>::max_exponent; exp += 997) {
+    bits = bits * 6364136223846793005u + 1442695040888963407u;
+    long_doubles.push_back(
+        std::ldexp(static_cast<long double>(bits >> 12), exp - 52));
+  }
+
+  for (const char *fmt : kLongDoubleFormats) {
+    for (long double d : long_doubles) {
+      FormatArgImpl arg(d);
+      UntypedFormatSpecImpl format(fmt);
+      ASSERT_EQ(StrPrint(fmt, d), FormatPack(format, {&arg, 1}))
+          << fmt << " " << StrPrint("%La", d);
+    }
+  }
+}
+
 TEST_F(FormatConvertTest, IntAsFloat) {
   const int kMin = std::numeric_limits<int>::min();
   const int kMax = std::numeric_limits<int>::max();
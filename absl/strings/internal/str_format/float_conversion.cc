@@ -4,53 +4,18 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <string>
 
 #include "absl/base/config.h"
+#include "absl/numeric/int128.h"
 
 namespace absl {
 namespace str_format_internal {
 
 namespace {
 
-char *CopyStringTo(string_view v, char *out) {
-  std::memcpy(out, v.data(), v.size());
-  return out + v.size();
-}
-
-template <typename Float>
-bool FallbackToSnprintf(const Float v, const ConversionSpec &conv,
-                        FormatSinkImpl *sink) {
-  int w = conv.width() >= 0 ? conv.width() : 0;
-  int p = conv.precision() >= 0 ? conv.precision() : -1;
-  char fmt[32];
-  {
-    char *fp = fmt;
-    *fp++ = '%';
-    fp = CopyStringTo(conv.flags().ToString(), fp);
-    fp = CopyStringTo("*.*", fp);
-    if (std::is_same<long double, Float>()) {
-      *fp++ = 'L';
-    }
-    *fp++ = conv.conv().Char();
-    *fp = 0;
-    assert(fp < fmt + sizeof(fmt));
-  }
-  std::string space(512, '\0');
-  string_view result;
-  while (true) {
-    int n = snprintf(&space[0], space.size(), fmt, w, p, v);
-    if (n < 0) return false;
-    if (static_cast<size_t>(n) < space.size()) {
-      result = string_view(space.data(), n);
-      break;
-    }
-    space.resize(n + 1);
-  }
-  sink->Append(result);
-  return true;
-}
-
 // 128-bits in decimal: ceil(128*log(2)/log(10))
 //   or std::numeric_limits<__uint128_t>::digits10
 constexpr int kMaxFixedPrecision = 39;
@@ -134,23 +99,32 @@ void RoundUp(Buffer *buffer, int *exp) {
   }
 }
 
-void PrintExponent(int exp, char e, Buffer *out) {
-  out->push_back(e);
+// Prints the exponent with at least two digits, e.g. e+05, and returns the end
+// of the output. The exponents of long double can have up to four digits.
+char *PrintExponent(int exp, char e, char *out) {
+  *out++ = e;
   if (exp < 0) {
-    out->push_back('-');
+    *out++ = '-';
     exp = -exp;
   } else {
-    out->push_back('+');
+    *out++ = '+';
   }
   // Exponent digits.
-  if (exp > 99) {
-    out->push_back(exp / 100 + '0');
-    out->push_back(exp / 10 % 10 + '0');
-    out->push_back(exp % 10 + '0');
-  } else {
-    out->push_back(exp / 10 + '0');
-    out->push_back(exp % 10 + '0');
-  }
+  if (exp > 999) *out++ = exp / 1000 + '0';
+  if (exp > 99) *out++ = exp / 100 % 10 + '0';
+  *out++ = exp / 10 % 10 + '0';
+  *out++ = exp % 10 + '0';
+  return out;
+}
+
+void PrintExponent(int exp, char e, Buffer *out) {
+  assert(exp > -1000 && exp < 1000);
+  out->end = PrintExponent(exp, e, out->end);
+}
+
+void PrintExponent(int exp, char e, std::string *out) {
+  char buf[8];
+  out->append(buf, PrintExponent(exp, e, buf) - buf);
 }
 
 template <typename Float, typename Int>
@@ -347,14 +321,371 @@ bool FloatToBuffer(Decomposed<Float> decomposed, int precision, Buffer *out,
   return false;
 }
 
-void WriteBufferToSink(char sign_char, string_view str,
+// The rest of the conversions handle the values and precisions that do not fit
+// the fixed width integers above, e.g. 1e300 or %.100f. They generate the
+// exact decimal expansion of the value using arbitrary precision arithmetic.
+
+// Returns the integral value `m`, which must fit in 128 bits.
+template <typename Float>
+uint128 MantissaToUint128(Float m) {
+  if (CanFitMantissa<Float, uint64_t>()) return static_cast<uint64_t>(m);
+
+  // Split the value into 32-bit words, which is exact for any Float.
+  const Float kWordBase = 4294967296.0;
+  uint128 result = 0;
+  for (int shift = 0; m > 0; shift += 32) {
+    Float word = std::fmod(m, kWordBase);
+    result |= uint128(static_cast<uint32_t>(word)) << shift;
+    m = (m - word) / kWordBase;
+  }
+  return result;
+}
+
+// Generates the decimal digits of the value `mantissa * 2^exponent`, most
+// significant first. The integral part is converted upfront into base 10^9
+// limbs, the fractional digits are computed on demand, 19 at a time. All the
+// storage is on the stack, sized for the largest and smallest Float.
+template <typename Float>
+class DecimalDigits {
+ public:
+  explicit DecimalDigits(Decomposed<Float> decomposed);
+
+  // The number of digits of the integral part, without leading zeros.
+  int integral_size() const { return integral_size_; }
+
+  // Returns the next digit: the digits of the integral part come first,
+  // followed by the digits of the fractional part.
+  int NextDigit() {
+    if (chunk_pos_ == chunk_end_) NextChunk();
+    return chunk_[chunk_pos_++];
+  }
+
+  // Skips the zero digits up to the next nonzero one and returns their number.
+  // The value must not be zero.
+  int SkipZeros() {
+    int skipped = 0;
+    for (;; ++chunk_pos_, ++skipped) {
+      if (chunk_pos_ == chunk_end_) NextChunk();
+      if (chunk_[chunk_pos_] != 0) return skipped;
+    }
+  }
+
+  // Returns true if all the digits after the ones returned so far are zero.
+  bool RestIsZero() const;
+
+ private:
+  static constexpr uint32_t kIntegralBase = 1000000000;
+  static constexpr int kIntegralBaseDigits = 9;
+  static constexpr uint64_t kFractionalBase = 10000000000000000000u;
+  static constexpr int kFractionalBaseDigits = 19;
+  // Largest number of limbs ever needed, with some slack.
+  static constexpr int kMaxIntegralLimbs =
+      std::numeric_limits<Float>::max_exponent * 30103 / 100000 /
+          kIntegralBaseDigits +
+      2;
+  static constexpr int kMaxFractionalLimbs =
+      (std::numeric_limits<Float>::digits -
+       std::numeric_limits<Float>::min_exponent) /
+          64 +
+      2;
+
+  // Fills chunk_ with the next limb of the integral part or the next digits of
+  // the fractional part.
+  void NextChunk();
+
+  // The integral part in little endian base 10^9 limbs. The limbs at
+  // next_integral_limb_ and below have not been moved to chunk_ yet.
+  uint32_t integral_[kMaxIntegralLimbs];
+  int integral_limbs_ = 0;
+  int integral_size_ = 0;
+  int next_integral_limb_;
+
+  // The fractional part is fractional_ / 2^(64 * fractional_limbs_), stored in
+  // little endian limbs. The limbs below fractional_begin_ are zero.
+  uint64_t fractional_[kMaxFractionalLimbs];
+  int fractional_limbs_ = 0;
+  int fractional_begin_ = 0;
+
+  // Digits returned by NextDigit(), values 0 to 9.
+  char chunk_[kFractionalBaseDigits];
+  int chunk_pos_ = 0;
+  int chunk_end_ = 0;
+};
+
+template <typename Float>
+DecimalDigits<Float>::DecimalDigits(Decomposed<Float> decomposed) {
+  const uint128 mantissa = MantissaToUint128(decomposed.mantissa);
+  int exp = decomposed.exponent;
+
+  uint128 integral = mantissa;
+  if (exp < 0) {
+    // Left align the fractional bits in fractional_limbs_ limbs.
+    const int fractional_bits = -exp;
+    fractional_limbs_ = (fractional_bits + 63) / 64;
+    const int shift = 64 * fractional_limbs_ - fractional_bits;
+    uint128 fraction = mantissa;
+    if (fractional_bits < 128) {
+      integral = mantissa >> fractional_bits;
+      fraction &= (uint128(1) << fractional_bits) - 1;
+    } else {
+      integral = 0;
+    }
+    std::fill_n(fractional_, fractional_limbs_, 0);
+    const uint64_t halves[2] = {Uint128Low64(fraction),
+                                Uint128High64(fraction)};
+    for (int i = 0; i < 2 && i < fractional_limbs_; ++i) {
+      fractional_[i] |= halves[i] << shift;
+      if (shift != 0 && i + 1 < fractional_limbs_) {
+        fractional_[i + 1] |= halves[i] >> (64 - shift);
+      }
+    }
+    while (fractional_begin_ < fractional_limbs_ &&
+           fractional_[fractional_begin_] == 0) {
+      ++fractional_begin_;
+    }
+    exp = 0;
+  }
+
+  for (; integral != 0; integral /= kIntegralBase) {
+    integral_[integral_limbs_++] =
+        static_cast<uint32_t>(integral % kIntegralBase);
+  }
+
+  // Multiply by 2^exp, 29 bits at a time. With limbs below 2^30 the carries
+  // stay below kIntegralBase, so the divisions do not depend on each other.
+  while (exp > 0 && integral_limbs_ > 0) {
+    const int shift = std::min(exp, 29);
+    exp -= shift;
+    uint32_t carry = 0;
+    for (int i = 0; i < integral_limbs_; ++i) {
+      const uint64_t shifted = uint64_t{integral_[i]} << shift;
+      const uint32_t limb =
+          static_cast<uint32_t>(shifted % kIntegralBase) + carry;
+      // Branchless, the comparison is unpredictable.
+      const uint32_t overflow = limb >= kIntegralBase;
+      integral_[i] = limb - overflow * kIntegralBase;
+      carry = static_cast<uint32_t>(shifted / kIntegralBase) + overflow;
+    }
+    if (carry != 0) integral_[integral_limbs_++] = carry;
+  }
+
+  next_integral_limb_ = integral_limbs_ - 1;
+  if (integral_limbs_ > 0) {
+    integral_size_ = kIntegralBaseDigits * (integral_limbs_ - 1);
+    for (uint32_t top = integral_[integral_limbs_ - 1]; top != 0; top /= 10) {
+      ++integral_size_;
+    }
+  }
+}
+
+template <typename Float>
+void DecimalDigits<Float>::NextChunk() {
+  chunk_pos_ = 0;
+  if (next_integral_limb_ >= 0) {
+    uint32_t limb = integral_[next_integral_limb_];
+    // The top limb has no leading zeros.
+    chunk_end_ = next_integral_limb_ == integral_limbs_ - 1
+                     ? integral_size_ - kIntegralBaseDigits *
+                                            (integral_limbs_ - 1)
+                     : kIntegralBaseDigits;
+    for (int i = chunk_end_; i-- > 0; limb /= 10) {
+      chunk_[i] = static_cast<char>(limb % 10);
+    }
+    --next_integral_limb_;
+    return;
+  }
+
+  // Multiplying the fraction by kFractionalBase carries the next digits out of
+  // the top limb.
+  uint64_t carry = 0;
+  for (int i = fractional_begin_; i < fractional_limbs_; ++i) {
+    const uint128 product = uint128(fractional_[i]) * kFractionalBase + carry;
+    fractional_[i] = Uint128Low64(product);
+    carry = Uint128High64(product);
+  }
+  while (fractional_begin_ < fractional_limbs_ &&
+         fractional_[fractional_begin_] == 0) {
+    ++fractional_begin_;
+  }
+
+  chunk_end_ = kFractionalBaseDigits;
+  if (carry == 0) {
+    // Common while skipping the leading zeros of small values.
+    std::fill_n(chunk_, chunk_end_, 0);
+    return;
+  }
+  // Split the chunk in two to shorten the dependency chains of the divisions.
+  uint64_t high = carry / kIntegralBase;
+  uint32_t low = static_cast<uint32_t>(carry % kIntegralBase);
+  for (int i = chunk_end_; i-- > kFractionalBaseDigits - kIntegralBaseDigits;
+       low /= 10) {
+    chunk_[i] = static_cast<char>(low % 10);
+  }
+  for (int i = kFractionalBaseDigits - kIntegralBaseDigits; i-- > 0;
+       high /= 10) {
+    chunk_[i] = static_cast<char>(high % 10);
+  }
+}
+
+template <typename Float>
+bool DecimalDigits<Float>::RestIsZero() const {
+  return std::all_of(chunk_ + chunk_pos_, chunk_ + chunk_end_,
+                     [](char digit) { return digit == 0; }) &&
+         std::all_of(integral_, integral_ + next_integral_limb_ + 1,
+                     [](uint32_t limb) { return limb == 0; }) &&
+         fractional_begin_ == fractional_limbs_;
+}
+
+// Whether digits ending in `last_digit` and followed by `next_digit` and more
+// digits, which are all zero iff `rest_is_zero`, have to be rounded up. Ties
+// are rounded to even.
+bool ShouldRoundUp(char last_digit, int next_digit, bool rest_is_zero) {
+  if (next_digit != 5) return next_digit > 5;
+  return !rest_is_zero || (last_digit - '0') % 2 == 1;
+}
+
+// Adds one to the last of the decimal `digits`. Returns true if that carries
+// out of the first digit, which leaves all the digits zero.
+bool RoundUpDigits(std::string *digits) {
+  for (size_t i = digits->size(); i-- > 0;) {
+    if ((*digits)[i] != '9') {
+      ++(*digits)[i];
+      return false;
+    }
+    (*digits)[i] = '0';
+  }
+  return true;
+}
+
+// Prints the value with `precision` fractional digits, as %f does.
+template <typename Float>
+void FormatFixedExact(DecimalDigits<Float> *decimal, int precision, bool alt,
+                      std::string *out) {
+  int integral_size = std::max(decimal->integral_size(), 1);
+  out->clear();
+  if (decimal->integral_size() == 0) out->push_back('0');
+  for (int i = out->size(); i < integral_size + precision; ++i) {
+    out->push_back(decimal->NextDigit() + '0');
+  }
+
+  int next_digit = decimal->NextDigit();
+  if (ShouldRoundUp(out->back(), next_digit, decimal->RestIsZero()) &&
+      RoundUpDigits(out)) {
+    out->insert(out->begin(), '1');
+    ++integral_size;
+  }
+
+  if (precision > 0 || alt) out->insert(integral_size, 1, '.');
+}
+
+// Computes the first `num_digits` significant digits of the value, rounded,
+// and the decimal exponent of the first one.
+template <typename Float>
+void SignificantDigitsExact(DecimalDigits<Float> *decimal, int num_digits,
+                            std::string *digits, int *exp) {
+  if (decimal->RestIsZero()) {
+    // The value is zero.
+    digits->assign(num_digits, '0');
+    *exp = 0;
+    return;
+  }
+
+  // Skip the leading zeros of the fractional part.
+  *exp = decimal->integral_size() - 1 - decimal->SkipZeros();
+
+  digits->clear();
+  for (int i = 0; i < num_digits; ++i) {
+    digits->push_back(decimal->NextDigit() + '0');
+  }
+
+  int next_digit = decimal->NextDigit();
+  if (ShouldRoundUp(digits->back(), next_digit, decimal->RestIsZero()) &&
+      RoundUpDigits(digits)) {
+    (*digits)[0] = '1';
+    ++*exp;
+  }
+}
+
+// Removes the trailing zeros of the fractional part and the point, if nothing
+// is left after it. `str` must have a point.
+void RemoveTrailingZeros(std::string *str) {
+  while (str->back() == '0') str->pop_back();
+  if (str->back() == '.') str->pop_back();
+}
+
+// Prints the significant `digits` in the scientific notation, as %e does.
+void FormatScientificDigits(const std::string &digits, int exp, bool alt,
+                            bool trim_zeros, char e, std::string *out) {
+  out->assign(1, digits[0]);
+  if (digits.size() > 1 || alt) {
+    out->push_back('.');
+    out->append(digits, 1, std::string::npos);
+    if (trim_zeros && !alt) RemoveTrailingZeros(out);
+  }
+  PrintExponent(exp, e, out);
+}
+
+template <typename Float>
+void FormatExact(Decomposed<Float> decomposed, int precision,
+                 const ConversionSpec &conv, std::string *out) {
+  DecimalDigits<Float> decimal(decomposed);
+  const char e = conv.conv().upper() ? 'E' : 'e';
+  const bool alt = conv.flags().alt;
+
+  switch (conv.conv().id()) {
+    case ConversionChar::f:
+    case ConversionChar::F:
+      FormatFixedExact(&decimal, precision, alt, out);
+      break;
+
+    case ConversionChar::e:
+    case ConversionChar::E: {
+      std::string digits;
+      int exp;
+      SignificantDigitsExact(&decimal, precision + 1, &digits, &exp);
+      FormatScientificDigits(digits, exp, alt, false, e, out);
+      break;
+    }
+
+    default: {
+      // %g: `precision` significant digits, in the fixed notation if the
+      // exponent is in [-4, precision).
+      precision = std::max(1, precision);
+      std::string digits;
+      int exp;
+      SignificantDigitsExact(&decimal, precision, &digits, &exp);
+      if (exp >= precision || exp < -4) {
+        FormatScientificDigits(digits, exp, alt, true, e, out);
+        break;
+      }
+
+      if (exp >= 0) {
+        out->assign(digits, 0, exp + 1);
+        out->push_back('.');
+        out->append(digits, exp + 1, std::string::npos);
+      } else {
+        out->assign("0.");
+        out->append(-exp - 1, '0');
+        out->append(digits);
+      }
+      if (!alt) RemoveTrailingZeros(out);
+      break;
+    }
+  }
+}
+
+// Prints the sign, the `prefix` (e.g. 0x) and `str`, padded to the width of the
+// conversion. Zero padding goes after the prefix.
+void WriteBufferToSink(char sign_char, string_view prefix, string_view str,
                        const ConversionSpec &conv, FormatSinkImpl *sink) {
   int left_spaces = 0, zeros = 0, right_spaces = 0;
   int missing_chars =
-      conv.width() >= 0 ? std::max(conv.width() - static_cast<int>(str.size()) -
-                                       static_cast<int>(sign_char != 0),
-                                   0)
-                        : 0;
+      conv.width() >= 0
+          ? std::max(conv.width() - static_cast<int>(str.size()) -
+                         static_cast<int>(prefix.size()) -
+                         static_cast<int>(sign_char != 0),
+                     0)
+          : 0;
   if (conv.flags().left) {
     right_spaces = missing_chars;
   } else if (conv.flags().zero) {
@@ -365,11 +696,101 @@ void WriteBufferToSink(char sign_char, string_view str,
 
   sink->Append(left_spaces, ' ');
   if (sign_char) sink->Append(1, sign_char);
+  sink->Append(prefix);
   sink->Append(zeros, '0');
   sink->Append(str);
   sink->Append(right_spaces, ' ');
 }
 
+// Prints the value as %a does. Like glibc, the leading hex digit holds the bits
+// of the mantissa that do not fill a whole hex digit after the point, e.g.
+// 0x1.8p+0 for double but 0xcp-3 for the 64-bit mantissa of x87 long double.
+// Subnormals are printed with the exponent of the smallest normal value.
+template <typename Float>
+void HexFloatToSink(char sign_char, Float v, const ConversionSpec &conv,
+                    FormatSinkImpl *sink) {
+  const int precision = conv.precision();
+  constexpr int kDigits = std::numeric_limits<Float>::digits;
+  constexpr int kFractionalHexDigits = (kDigits - 1) / 4;
+  constexpr int kFractionalBits = 4 * kFractionalHexDigits;
+  static_assert(kDigits <= 128, "mantissa does not fit uint128");
+
+  int exp = 0;
+  uint128 mantissa = 0;
+  if (v != 0) {
+    mantissa = MantissaToUint128(std::ldexp(std::frexp(v, &exp), kDigits));
+
+    if (exp < std::numeric_limits<Float>::min_exponent) {
+      mantissa >>= std::numeric_limits<Float>::min_exponent - exp;
+      exp = std::numeric_limits<Float>::min_exponent;
+    }
+    exp -= kDigits - kFractionalBits;
+  }
+
+  int leading = static_cast<int>(mantissa >> kFractionalBits);
+  uint128 fraction = mantissa & ((uint128(1) << kFractionalBits) - 1);
+  int fractional_digits = kFractionalHexDigits;
+  if (precision >= 0 && precision < kFractionalHexDigits) {
+    const int dropped_bits = 4 * (kFractionalHexDigits - precision);
+    const uint128 dropped = fraction & ((uint128(1) << dropped_bits) - 1);
+    const uint128 half = uint128(1) << (dropped_bits - 1);
+    fraction >>= dropped_bits;
+    fractional_digits = precision;
+
+    // Round to nearest, ties to even.
+    const bool odd = precision > 0 ? (fraction & 1) != 0 : leading % 2 == 1;
+    if (dropped > half || (dropped == half && odd)) {
+      ++fraction;
+      if (fraction >> (4 * precision) != 0) {
+        // Carry into the leading digit.
+        fraction = 0;
+        if (++leading == 16) {
+          leading = 1;
+          exp += 4;
+        }
+      }
+    }
+  }
+
+  const char *const digits =
+      conv.conv().upper() ? "0123456789ABCDEF" : "0123456789abcdef";
+  // Leading digit, point, fractional digits and up to 8 exponent chars.
+  char buf[2 + kFractionalHexDigits + 8];
+  char *out = buf;
+  *out++ = digits[leading];
+  *out++ = '.';
+  for (int i = fractional_digits; i-- > 0;) {
+    *out++ = digits[static_cast<int>(fraction >> (4 * i)) & 0xf];
+  }
+  if (precision < 0) {
+    while (out[-1] == '0') --out;
+  }
+  const int padding_zeros = std::max(0, precision - fractional_digits);
+  if (out[-1] == '.' && padding_zeros == 0 && !conv.flags().alt) --out;
+  const size_t mantissa_size = out - buf;
+
+  *out++ = conv.conv().upper() ? 'P' : 'p';
+  *out++ = exp < 0 ? '-' : '+';
+  char *const exp_begin = out;
+  for (unsigned abs_exp = exp < 0 ? -exp : exp; out == exp_begin || abs_exp;
+       abs_exp /= 10) {
+    *out++ = abs_exp % 10 + '0';
+  }
+  std::reverse(exp_begin, out);
+
+  string_view str(buf, out - buf);
+  std::string padded;
+  if (padding_zeros > 0) {
+    // Precisions beyond the mantissa are rare, use a temporary string.
+    padded.assign(buf, mantissa_size);
+    padded.append(padding_zeros, '0');
+    padded.append(buf + mantissa_size, out);
+    str = padded;
+  }
+  WriteBufferToSink(sign_char, conv.conv().upper() ? "0X" : "0x", str, conv,
+                    sink);
+}
+
 template <typename Float>
 bool FloatToSink(const Float v, const ConversionSpec &conv,
                  FormatSinkImpl *sink) {
@@ -390,6 +811,24 @@ bool FloatToSink(const Float v, const ConversionSpec &conv,
     return true;
   }
 
+  switch (conv.conv().id()) {
+    case ConversionChar::f:
+    case ConversionChar::F:
+    case ConversionChar::e:
+    case ConversionChar::E:
+    case ConversionChar::g:
+    case ConversionChar::G:
+      break;
+
+    case ConversionChar::a:
+    case ConversionChar::A:
+      HexFloatToSink(sign_char, abs_v, conv, sink);
+      return true;
+
+    default:
+      return false;
+  }
+
   int precision = conv.precision() < 0 ? 6 : conv.precision();
 
   int exp = 0;
@@ -398,12 +837,18 @@ bool FloatToSink(const Float v, const ConversionSpec &conv,
 
   Buffer buffer;
 
+  // Most values are printed using fixed width integer arithmetic. The rest
+  // (very large or small values, or high precisions) are printed exactly into
+  // `exact` instead.
+  std::string exact;
+
   switch (conv.conv().id()) {
     case ConversionChar::f:
     case ConversionChar::F:
       if (!FloatToBuffer<FormatStyle::Fixed>(decomposed, precision, &buffer,
                                              nullptr)) {
-        return FallbackToSnprintf(v, conv, sink);
+        FormatExact(decomposed, precision, conv, &exact);
+        break;
       }
       if (!conv.flags().alt && buffer.back() == '.') buffer.pop_back();
       break;
@@ -412,19 +857,20 @@ bool FloatToSink(const Float v, const ConversionSpec &conv,
     case ConversionChar::E:
       if (!FloatToBuffer<FormatStyle::Precision>(decomposed, precision, &buffer,
                                                  &exp)) {
-        return FallbackToSnprintf(v, conv, sink);
+        FormatExact(decomposed, precision, conv, &exact);
+        break;
       }
       if (!conv.flags().alt && buffer.back() == '.') buffer.pop_back();
       PrintExponent(exp, conv.conv().upper() ? 'E' : 'e', &buffer);
       break;
 
-    case ConversionChar::g:
-    case ConversionChar::G:
-      precision = std::max(0, precision - 1);
-      if (!FloatToBuffer<FormatStyle::Precision>(decomposed, precision, &buffer,
-                                                 &exp)) {
-        return FallbackToSnprintf(v, conv, sink);
+    default:
+      if (!FloatToBuffer<FormatStyle::Precision>(
+              decomposed, std::max(0, precision - 1), &buffer, &exp)) {
+        FormatExact(decomposed, precision, conv, &exact);
+        break;
       }
+      precision = std::max(0, precision - 1);
       if (precision + 1 > exp && exp >= -4) {
         if (exp < 0) {
           // Have 1.23456, needs 0.00123456
@@ -448,18 +894,15 @@ bool FloatToSink(const Float v, const ConversionSpec &conv,
       }
       if (exp) PrintExponent(exp, conv.conv().upper() ? 'E' : 'e', &buffer);
       break;
-
-    case ConversionChar::a:
-    case ConversionChar::A:
-      return FallbackToSnprintf(v, conv, sink);
-
-    default:
-      return false;
   }
 
-  WriteBufferToSink(sign_char,
-                    string_view(buffer.begin, buffer.end - buffer.begin), conv,
-                    sink);
+  if (!exact.empty()) {
+    WriteBufferToSink(sign_char, "", exact, conv, sink);
+  } else {
+    WriteBufferToSink(sign_char, "",
+                      string_view(buffer.begin, buffer.end - buffer.begin),
+                      conv, sink);
+  }
 
   return true;
 }
@@ -473,7 +916,8 @@ bool ConvertFloatImpl(long double v, const ConversionSpec &conv,
 
 bool ConvertFloatImpl(float v, const ConversionSpec &conv,
                       FormatSinkImpl *sink) {
-  return FloatToSink(v, conv, sink);
+  // Like printf, print floats as doubles, which matters for %a.
+  return FloatToSink(static_cast<double>(v), conv, sink);
 }
 
 bool ConvertFloatImpl(double v, const ConversionSpec &conv,
@@ -31,6 +31,8 @@
 #ifndef ABSL_STRINGS_INTERNAL_STR_JOIN_INTERNAL_H_
 #define ABSL_STRINGS_INTERNAL_STR_JOIN_INTERNAL_H_
 
+#include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <memory>
@@ -40,6 +42,7 @@
 
 #include "absl/strings/internal/ostringstream.h"
 #include "absl/strings/internal/resize_uninitialized.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 
 namespace absl {
@@ -73,6 +76,51 @@ struct AlphaNumFormatterImpl {
 
 struct NoFormatter : public AlphaNumFormatterImpl {};
 
+// A type that's used to overload the JoinAlgorithm() function (defined below)
+// for ranges of integers, which it formats exactly as AlphaNumFormatterImpl
+// does. The static members compute and write the text of one value.
+struct IntegerFormatter : public AlphaNumFormatterImpl {
+  template <typename T>
+  using Wide = typename std::conditional<std::is_signed<T>::value, int64_t,
+                                         uint64_t>::type;
+
+  static uint64_t Magnitude(uint64_t v) { return v; }
+  static uint64_t Magnitude(int64_t v) {
+    // Negate in unsigned arithmetic so that the minimum value is handled.
+    return v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+  }
+  static bool IsNegative(uint64_t) { return false; }
+  static bool IsNegative(int64_t v) { return v < 0; }
+
+  template <typename T>
+  static size_t FormattedSize(T t) {
+    const Wide<T> v = static_cast<Wide<T>>(t);
+    return IsNegative(v) + numbers_internal::Base10Digits(Magnitude(v));
+  }
+
+  template <typename T>
+  static char* Format(T t, char* out) {
+    const Wide<T> v = static_cast<Wide<T>>(t);
+    if (IsNegative(v)) *out++ = '-';
+    const uint64_t u = Magnitude(v);
+    return numbers_internal::FastDigitsToBuffer(
+        u, numbers_internal::Base10Digits(u), out);
+  }
+};
+
+// Whether DefaultFormatter<T> should select IntegerFormatter: integers other
+// than bool and the character types, which AlphaNum does not format as
+// numbers.
+template <typename T>
+struct IsJoinedAsInteger
+    : std::integral_constant<
+          bool, std::is_integral<T>::value && sizeof(T) <= 8 &&
+                    !std::is_same<T, bool>::value &&
+                    !std::is_same<T, char>::value &&
+                    !std::is_same<T, wchar_t>::value &&
+                    !std::is_same<T, char16_t>::value &&
+                    !std::is_same<T, char32_t>::value> {};
+
 // Formats types to strings using the << operator.
 class StreamFormatterImpl {
  public:
@@ -154,10 +202,16 @@ class DereferenceFormatterImpl {
 //
 // AlphaNumFormatterImpl is the default in the base template, followed by
 // specializations for other types.
-template <typename ValueType>
+template <typename ValueType, typename = void>
 struct DefaultFormatter {
   typedef AlphaNumFormatterImpl Type;
 };
+template <typename ValueType>
+struct DefaultFormatter<
+    ValueType,
+    typename std::enable_if<IsJoinedAsInteger<ValueType>::value>::type> {
+  typedef IntegerFormatter Type;
+};
 template <>
 struct DefaultFormatter<const char*> {
   typedef AlphaNumFormatterImpl Type;
@@ -253,6 +307,47 @@ std::string JoinAlgorithm(Iterator start, Iterator end, absl::string_view s,
   return result;
 }
 
+// A joining algorithm for a forward iterator range of integers formatted by
+// default, such as a std::vector<int64_t>. As with NoFormatter above, the
+// range is traversed twice: once to add up the number of characters in each
+// value, and again to write the digits straight into the sized result,
+// instead of building an AlphaNum and appending it for every element.
+template <typename Iterator,
+          typename = typename std::enable_if<std::is_convertible<
+              typename std::iterator_traits<Iterator>::iterator_category,
+              std::forward_iterator_tag>::value>::type>
+std::string JoinAlgorithm(Iterator start, Iterator end, absl::string_view s,
+                          IntegerFormatter) {
+  typedef typename std::iterator_traits<Iterator>::value_type ValueType;
+  std::string result;
+  if (start != end) {
+    // Sums size
+    size_t result_size =
+        IntegerFormatter::FormattedSize(static_cast<ValueType>(*start));
+    for (Iterator it = start; ++it != end;) {
+      result_size += s.size();
+      result_size +=
+          IntegerFormatter::FormattedSize(static_cast<ValueType>(*it));
+    }
+
+    STLStringResizeUninitialized(&result, result_size);
+
+    // Formats integers
+    char* result_buf = &*result.begin();
+    result_buf =
+        IntegerFormatter::Format(static_cast<ValueType>(*start), result_buf);
+    for (Iterator it = start; ++it != end;) {
+      memcpy(result_buf, s.data(), s.size());
+      result_buf += s.size();
+      result_buf =
+          IntegerFormatter::Format(static_cast<ValueType>(*it), result_buf);
+    }
+    assert(result_buf == result.data() + result.size());
+  }
+
+  return result;
+}
+
 // JoinTupleLoop implements a loop over the elements of a std::tuple, which
 // are heterogeneous. The primary template matches the tuple interior case. It
 // continues the iteration after appending a separator (for nonzero indices)
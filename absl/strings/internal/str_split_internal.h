@@ -41,6 +41,7 @@
 #include "absl/base/port.h"
 #include "absl/meta/type_traits.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 #ifdef _GLIBCXX_DEBUG
 #include "absl/strings/internal/stl_type_traits.h"
@@ -189,6 +190,26 @@ class SplitIterator {
   typename Splitter::PredicateType predicate_;
 };
 
+// Implements absl::StrSplitInto() for any delimiter, stepping through `text`
+// the way SplitIterator does. str_split.h declares faster overloads for
+// ByChar and ByAnyChar.
+template <typename Delimiter>
+size_t SplitInto(absl::string_view text, Delimiter delimiter,
+                 absl::Span<absl::string_view> out) {
+  if (text.data() == nullptr || out.empty()) return 0;
+  size_t n = 0;
+  size_t pos = 0;
+  while (n + 1 < out.size()) {
+    const absl::string_view d = delimiter.Find(text, pos);
+    if (d.data() == text.data() + text.size()) break;
+    out[n] = text.substr(pos, d.data() - (text.data() + pos));
+    pos += out[n].size() + d.size();
+    ++n;
+  }
+  out[n++] = text.substr(pos);
+  return n;
+}
+
 // HasMappedType<T>::value is true iff there exists a type T::mapped_type.
 template <typename T, typename = void>
 struct HasMappedType : std::false_type {};
@@ -0,0 +1,829 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/utf8_simd.h"
+
+#include <cstdint>
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace absl {
+namespace strings_internal {
+
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+namespace {
+
+// Validation follows John Keiser and Daniel Lemire, "Validating UTF-8 In Less
+// Than One Instruction Per Byte" (2020). Three table lookups, indexed by the
+// high and low nibbles of each byte's predecessor and the high nibble of the
+// byte itself, classify every pair of adjacent bytes; each bit of the result
+// flags one kind of error. Continuation bytes required by three- and
+// four-byte sequences are checked separately by looking two and three bytes
+// back.
+constexpr char kTooShort = 1 << 0;   // 11______ 0_______ or 11______ 11______
+constexpr char kTooLong = 1 << 1;    // 0_______ 10______
+constexpr char kOverlong3 = 1 << 2;  // 11100000 100_____
+constexpr char kTooLarge = 1 << 3;   // 11110100 1001____, 11110101 and above
+constexpr char kSurrogate = 1 << 4;  // 11101101 101_____
+constexpr char kOverlong2 = 1 << 5;  // 1100000_ 10______
+constexpr char kTooLarge1000 = 1 << 6;  // 11110101 1000____ and above
+constexpr char kOverlong4 = 1 << 6;     // 11110000 1000____
+constexpr char kTwoConts = static_cast<char>(1 << 7);  // 10______ 10______
+// Errors that depend only on the high nibbles.
+constexpr char kCarry = kTooShort | kTooLong | kTwoConts;
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i Byte1HighTable() {
+  return _mm_setr_epi8(
+      // 0_______: ASCII
+      kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+      kTooLong,
+      // 10______: continuation
+      kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+      // 1100____, 1101____: two-byte lead
+      kTooShort | kOverlong2, kTooShort,
+      // 1110____: three-byte lead
+      kTooShort | kOverlong3 | kSurrogate,
+      // 1111____: four-byte lead
+      kTooShort | kTooLarge | kTooLarge1000 | kOverlong4);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i Byte1LowTable() {
+  return _mm_setr_epi8(
+      // ____0000
+      kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+      // ____0001
+      kCarry | kOverlong2,
+      // ____001_
+      kCarry, kCarry,
+      // ____0100
+      kCarry | kTooLarge,
+      // ____0101 through ____1100
+      kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+      // ____1101
+      kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+      // ____111_
+      kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i Byte2HighTable() {
+  return _mm_setr_epi8(
+      // 0_______: ASCII
+      kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+      kTooShort, kTooShort,
+      // 1000____
+      kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 |
+          kOverlong4,
+      // 1001____
+      kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+      // 101_____
+      kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+      kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+      // 11______: lead
+      kTooShort, kTooShort, kTooShort, kTooShort);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i HighNibbles(__m128i v) {
+  return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+}
+
+// Returns nonzero bytes where `input`, preceded by `prev`, is not UTF-8.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i Utf8Errors(__m128i input,
+                                                             __m128i prev) {
+  const __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+  const __m128i low1 = _mm_and_si128(prev1, _mm_set1_epi8(0x0f));
+  const __m128i special = _mm_and_si128(
+      _mm_and_si128(_mm_shuffle_epi8(Byte1HighTable(), HighNibbles(prev1)),
+                    _mm_shuffle_epi8(Byte1LowTable(), low1)),
+      _mm_shuffle_epi8(Byte2HighTable(), HighNibbles(input)));
+  // Bytes two after a three- or four-byte lead, or three after a four-byte
+  // lead, must be continuations; those are exactly the ones flagged
+  // kTwoConts, so the flag cancels out.
+  const __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+  const __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+  const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80));
+  const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0xf0 - 0x80));
+  const __m128i must_be_continuation =
+      _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(kTwoConts));
+  return _mm_xor_si128(must_be_continuation, special);
+}
+
+// Returns nonzero bytes if `input` ends in the middle of a sequence.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i Utf8Incomplete(
+    __m128i input) {
+  return _mm_subs_epu8(
+      input, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                           static_cast<char>(0xf0 - 1),
+                           static_cast<char>(0xe0 - 1),
+                           static_cast<char>(0xc0 - 1)));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline bool IsZero(__m128i v) {
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xFFFF;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t Utf8ValidBlocksSsse3(
+    const char* src, size_t szsrc, bool* incomplete) {
+  __m128i prev = _mm_setzero_si128();
+  __m128i prev_incomplete = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= szsrc; i += 16) {
+    const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(input) == 0) {
+      // All ASCII: valid unless it cuts short a sequence.
+      if (!IsZero(prev_incomplete)) break;
+    } else {
+      if (!IsZero(Utf8Errors(input, prev))) break;
+      prev_incomplete = Utf8Incomplete(input);
+    }
+    prev = input;
+  }
+  *incomplete = !IsZero(prev_incomplete);
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i Broadcast(__m128i v) {
+  return _mm256_broadcastsi128_si256(v);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i HighNibbles(__m256i v) {
+  return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i Utf8Errors(__m256i input,
+                                                            __m256i prev) {
+  // Lines up the last 16 bytes of `prev` with the first 16 of `input`, so that
+  // alignr can shift across the lane boundary.
+  const __m256i straddle = _mm256_permute2x128_si256(prev, input, 0x21);
+  const __m256i prev1 = _mm256_alignr_epi8(input, straddle, 15);
+  const __m256i special = _mm256_and_si256(
+      _mm256_and_si256(
+          _mm256_shuffle_epi8(Broadcast(Byte1HighTable()), HighNibbles(prev1)),
+          _mm256_shuffle_epi8(Broadcast(Byte1LowTable()),
+                              _mm256_and_si256(prev1, _mm256_set1_epi8(0x0f)))),
+      _mm256_shuffle_epi8(Broadcast(Byte2HighTable()), HighNibbles(input)));
+  const __m256i prev2 = _mm256_alignr_epi8(input, straddle, 14);
+  const __m256i prev3 = _mm256_alignr_epi8(input, straddle, 13);
+  const __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80));
+  const __m256i fourth =
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xf0 - 0x80));
+  const __m256i must_be_continuation = _mm256_and_si256(
+      _mm256_or_si256(third, fourth), _mm256_set1_epi8(kTwoConts));
+  return _mm256_xor_si256(must_be_continuation, special);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline __m256i Utf8Incomplete(
+    __m256i input) {
+  return _mm256_subs_epu8(
+      input,
+      _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                       -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                       -1, static_cast<char>(0xf0 - 1),
+                       static_cast<char>(0xe0 - 1),
+                       static_cast<char>(0xc0 - 1)));
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 inline bool IsZero(__m256i v) {
+  return _mm256_testz_si256(v, v) != 0;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t Utf8ValidBlocksAvx2(
+    const char* src, size_t szsrc, bool* incomplete) {
+  __m256i prev = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= szsrc; i += 32) {
+    const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    if (_mm256_movemask_epi8(input) == 0) {
+      if (!IsZero(prev_incomplete)) break;
+    } else {
+      if (!IsZero(Utf8Errors(input, prev))) break;
+      prev_incomplete = Utf8Incomplete(input);
+    }
+    prev = input;
+  }
+  *incomplete = !IsZero(prev_incomplete);
+  return i;
+}
+
+// Counting accumulates per-byte counts, which are flushed into 64-bit sums
+// before they can overflow.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t CountUtf8LeadBytesSsse3(
+    const char* src, size_t szsrc, size_t* count) {
+  const __m128i continuation_max = _mm_set1_epi8(static_cast<char>(0xbf));
+  __m128i sums = _mm_setzero_si128();
+  size_t i = 0;
+  while (i + 16 <= szsrc) {
+    __m128i counts = _mm_setzero_si128();
+    for (int n = 0; n < 255 && i + 16 <= szsrc; ++n, i += 16) {
+      const __m128i input =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      // Continuation bytes are -128 to -65 as signed values.
+      counts = _mm_sub_epi8(counts, _mm_cmpgt_epi8(input, continuation_max));
+    }
+    sums = _mm_add_epi64(sums, _mm_sad_epu8(counts, _mm_setzero_si128()));
+  }
+  *count += static_cast<size_t>(_mm_cvtsi128_si64(sums)) +
+            static_cast<size_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums,
+                                                                     sums)));
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_AVX2 size_t CountUtf8LeadBytesAvx2(
+    const char* src, size_t szsrc, size_t* count) {
+  const __m256i continuation_max =
+      _mm256_set1_epi8(static_cast<char>(0xbf));
+  __m256i sums = _mm256_setzero_si256();
+  size_t i = 0;
+  while (i + 32 <= szsrc) {
+    __m256i counts = _mm256_setzero_si256();
+    for (int n = 0; n < 255 && i + 32 <= szsrc; ++n, i += 32) {
+      const __m256i input =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+      counts = _mm256_sub_epi8(counts,
+                               _mm256_cmpgt_epi8(input, continuation_max));
+    }
+    sums = _mm256_add_epi64(sums,
+                            _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+  const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums),
+                                       _mm256_extracti128_si256(sums, 1));
+  *count += static_cast<size_t>(_mm_cvtsi128_si64(halves)) +
+            static_cast<size_t>(
+                _mm_cvtsi128_si64(_mm_unpackhi_epi64(halves, halves)));
+  return i + CountUtf8LeadBytesSsse3(src + i, szsrc - i, count);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t CountUtf8FourByteLeadsSsse3(
+    const char* src, size_t szsrc, size_t* count) {
+  const __m128i four_byte_min = _mm_set1_epi8(static_cast<char>(0xf0));
+  __m128i sums = _mm_setzero_si128();
+  size_t i = 0;
+  while (i + 16 <= szsrc) {
+    __m128i counts = _mm_setzero_si128();
+    for (int n = 0; n < 255 && i + 16 <= szsrc; ++n, i += 16) {
+      const __m128i input =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      counts = _mm_sub_epi8(
+          counts,
+          _mm_cmpeq_epi8(_mm_max_epu8(input, four_byte_min), input));
+    }
+    sums = _mm_add_epi64(sums, _mm_sad_epu8(counts, _mm_setzero_si128()));
+  }
+  *count += static_cast<size_t>(_mm_cvtsi128_si64(sums)) +
+            static_cast<size_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums,
+                                                                     sums)));
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t Utf16ToUtf8LengthSsse3(
+    const char16_t* src, size_t szsrc, size_t* length) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  // Every code unit takes three bytes, less one if it is below 0x800 and
+  // another if it is below 0x80.
+  size_t savings = 0;
+  bool surrogate = false;
+  while (szsrc - i >= 8 && !surrogate) {
+    // 16-bit counts, which are flushed before they can overflow.
+    __m128i counts = zero;
+    for (int n = 0; n < 8192 && szsrc - i >= 8; ++n, i += 8) {
+      const __m128i units =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      const __m128i high5 =
+          _mm_and_si128(units, _mm_set1_epi16(static_cast<int16_t>(0xf800)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(
+              high5, _mm_set1_epi16(static_cast<int16_t>(0xd800)))) != 0) {
+        surrogate = true;
+        break;
+      }
+      const __m128i high9 =
+          _mm_and_si128(units, _mm_set1_epi16(static_cast<int16_t>(0xff80)));
+      counts = _mm_sub_epi16(counts, _mm_cmpeq_epi16(high5, zero));
+      counts = _mm_sub_epi16(counts, _mm_cmpeq_epi16(high9, zero));
+    }
+    alignas(16) int32_t sums[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(sums),
+                    _mm_madd_epi16(counts, _mm_set1_epi16(1)));
+    savings += static_cast<size_t>(sums[0]) + static_cast<size_t>(sums[1]) +
+               static_cast<size_t>(sums[2]) + static_cast<size_t>(sums[3]);
+  }
+  *length += 3 * i - savings;
+  return i;
+}
+
+// Transcoding works on 16-byte blocks at every level. A block of UTF-8 that
+// starts on a character boundary and holds only ASCII, only two-byte
+// sequences, only four-byte sequences, or (in its first 15 bytes) only
+// three-byte sequences has a fixed layout, so it can be decoded with fixed
+// shuffles. Blocks that mix ASCII and
+// two-byte sequences, common in European languages, are decoded eight bytes
+// at a time with a shuffle looked up from where the characters start.
+// Conversion from UTF-16 handles the same shapes the other way round.
+enum class Utf8Shape {
+  kAscii,
+  kTwoByte,
+  kUpToTwoBytes,
+  kThreeByte,
+  kFourByte,
+  kOther,
+};
+
+// A table of 256 shuffles, indexed by an 8-bit mask, and the number of units
+// each produces.
+struct ShuffleTable {
+  alignas(16) char shuffles[256][16];
+  unsigned char lengths[256];
+};
+
+// For each mask of which of the first eight bytes of a block start a
+// character, gathers each such byte into the high half of a 16-bit lane and
+// the byte after it into the low half.
+const ShuffleTable* Utf8GatherTable() {
+  static const ShuffleTable* const table = [] {
+    auto* t = new ShuffleTable;
+    for (int mask = 0; mask < 256; ++mask) {
+      char* shuffle = t->shuffles[mask];
+      int lane = 0;
+      for (int pos = 0; pos < 8; ++pos) {
+        if ((mask & (1 << pos)) == 0) continue;
+        shuffle[2 * lane] = static_cast<char>(pos + 1);
+        shuffle[2 * lane + 1] = static_cast<char>(pos);
+        ++lane;
+      }
+      for (int i = 2 * lane; i < 16; ++i) shuffle[i] = -1;
+      t->lengths[mask] = static_cast<unsigned char>(lane);
+    }
+    return t;
+  }();
+  return table;
+}
+
+// For each mask of which of eight UTF-16 code units need two UTF-8 bytes
+// rather than one, packs the low byte of each 16-bit lane, and the high byte
+// of the lanes in the mask.
+const ShuffleTable* Utf8PackTable() {
+  static const ShuffleTable* const table = [] {
+    auto* t = new ShuffleTable;
+    for (int mask = 0; mask < 256; ++mask) {
+      char* shuffle = t->shuffles[mask];
+      int out = 0;
+      for (int unit = 0; unit < 8; ++unit) {
+        shuffle[out++] = static_cast<char>(2 * unit);
+        if (mask & (1 << unit)) {
+          shuffle[out++] = static_cast<char>(2 * unit + 1);
+        }
+      }
+      t->lengths[mask] = static_cast<unsigned char>(out);
+      while (out < 16) shuffle[out++] = -1;
+    }
+    return t;
+  }();
+  return table;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline Utf8Shape ClassifyUtf8Block(
+    __m128i input) {
+  if (_mm_movemask_epi8(input) == 0) return Utf8Shape::kAscii;
+  // 110_____ 10______, eight times.
+  const __m128i two_byte = _mm_cmpeq_epi8(
+      _mm_and_si128(input, _mm_set1_epi16(static_cast<int16_t>(0xc0e0))),
+      _mm_set1_epi16(static_cast<int16_t>(0x80c0)));
+  if (_mm_movemask_epi8(two_byte) == 0xFFFF) return Utf8Shape::kTwoByte;
+  // No lead bytes of longer sequences.
+  const __m128i two_byte_max = _mm_set1_epi8(static_cast<char>(0xdf));
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(input, two_byte_max),
+                                       two_byte_max)) == 0xFFFF) {
+    return Utf8Shape::kUpToTwoBytes;
+  }
+  // 1110____ 10______ 10______, five times, then any byte.
+  const char f0 = static_cast<char>(0xf0);
+  const char e0 = static_cast<char>(0xe0);
+  const char c0 = static_cast<char>(0xc0);
+  const char x80 = static_cast<char>(0x80);
+  const __m128i three_byte = _mm_cmpeq_epi8(
+      _mm_and_si128(input, _mm_setr_epi8(f0, c0, c0, f0, c0, c0, f0, c0, c0,
+                                         f0, c0, c0, f0, c0, c0, 0)),
+      _mm_setr_epi8(e0, x80, x80, e0, x80, x80, e0, x80, x80, e0, x80, x80,
+                    e0, x80, x80, 0));
+  if (_mm_movemask_epi8(three_byte) == 0xFFFF) return Utf8Shape::kThreeByte;
+  // 11110___ 10______ 10______ 10______, four times.
+  const __m128i four_byte = _mm_cmpeq_epi32(
+      _mm_and_si128(input, _mm_set1_epi32(static_cast<int32_t>(0xc0c0c0f8))),
+      _mm_set1_epi32(static_cast<int32_t>(0x808080f0)));
+  if (_mm_movemask_epi8(four_byte) == 0xFFFF) return Utf8Shape::kFourByte;
+  return Utf8Shape::kOther;
+}
+
+// Decodes a kTwoByte block to eight UTF-16 code units.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i DecodeTwoByteBlock(
+    __m128i input) {
+  // Each 16-bit lane holds one sequence, lead byte low.
+  const __m128i lead =
+      _mm_slli_epi16(_mm_and_si128(input, _mm_set1_epi16(0x1f)), 6);
+  const __m128i cont =
+      _mm_and_si128(_mm_srli_epi16(input, 8), _mm_set1_epi16(0x3f));
+  return _mm_or_si128(lead, cont);
+}
+
+// Decodes a kThreeByte block to five UTF-16 code units, in the low lanes.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i DecodeThreeByteBlock(
+    __m128i input) {
+  // Gathers each sequence's continuation bytes, second byte high, and its
+  // lead byte into 16-bit lanes.
+  const __m128i conts = _mm_shuffle_epi8(
+      input, _mm_setr_epi8(2, 1, 5, 4, 8, 7, 11, 10, 14, 13, -1, -1, -1, -1,
+                           -1, -1));
+  const __m128i leads = _mm_shuffle_epi8(
+      input, _mm_setr_epi8(0, -1, 3, -1, 6, -1, 9, -1, 12, -1, -1, -1, -1, -1,
+                           -1, -1));
+  // Shifting the lead left by 12 keeps just its low four bits.
+  return _mm_or_si128(
+      _mm_or_si128(_mm_slli_epi16(leads, 12),
+                   _mm_srli_epi16(
+                       _mm_and_si128(conts, _mm_set1_epi16(0x3f00)), 2)),
+      _mm_and_si128(conts, _mm_set1_epi16(0x3f)));
+}
+
+// Decodes the characters of a kUpToTwoBytes block whose first bytes are
+// marked in the 8-bit mask `starts` to UTF-16 code units.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i DecodeUpToTwoByteHalf(
+    const ShuffleTable* gather, __m128i input, int starts) {
+  const __m128i gathered = _mm_shuffle_epi8(
+      input, _mm_load_si128(
+                 reinterpret_cast<const __m128i*>(gather->shuffles[starts])));
+  const __m128i lead = _mm_srli_epi16(gathered, 8);
+  const __m128i two_byte = _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(lead, _mm_set1_epi16(0x1f)), 6),
+      _mm_and_si128(gathered, _mm_set1_epi16(0x3f)));
+  const __m128i ascii = _mm_cmplt_epi16(lead, _mm_set1_epi16(0x80));
+  return _mm_or_si128(_mm_and_si128(ascii, lead),
+                      _mm_andnot_si128(ascii, two_byte));
+}
+
+// Decodes a kFourByte block to four code points in 32-bit lanes.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline __m128i DecodeFourByteBlock(
+    __m128i input) {
+  const __m128i low6 = _mm_set1_epi32(0x3f);
+  return _mm_or_si128(
+      _mm_or_si128(
+          _mm_slli_epi32(_mm_and_si128(input, _mm_set1_epi32(0x07)), 18),
+          _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(input, 8), low6), 12)),
+      _mm_or_si128(
+          _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(input, 16), low6), 6),
+          _mm_and_si128(_mm_srli_epi32(input, 24), low6)));
+}
+
+// Stores four code points above U+FFFF, given as 32-bit lanes, in UTF-16 or
+// UTF-32. Returns the number of code units stored.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline size_t StoreSupplementary(
+    __m128i code_points, char16_t* dest) {
+  // Surrogate pairs, high surrogate first.
+  const __m128i offset =
+      _mm_sub_epi32(code_points, _mm_set1_epi32(0x10000));
+  const __m128i high =
+      _mm_or_si128(_mm_srli_epi32(offset, 10), _mm_set1_epi32(0xd800));
+  const __m128i low = _mm_or_si128(
+      _mm_and_si128(offset, _mm_set1_epi32(0x3ff)), _mm_set1_epi32(0xdc00));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest),
+                   _mm_or_si128(high, _mm_slli_epi32(low, 16)));
+  return 8;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline size_t StoreSupplementary(
+    __m128i code_points, char32_t* dest) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), code_points);
+  return 4;
+}
+
+// Stores eight code units, given as 16-bit lanes, in UTF-16 or UTF-32.
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline void StoreUnits(__m128i units,
+                                                          char16_t* dest) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), units);
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 inline void StoreUnits(__m128i units,
+                                                          char32_t* dest) {
+  const __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest),
+                   _mm_unpacklo_epi16(units, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 4),
+                   _mm_unpackhi_epi16(units, zero));
+}
+
+template <typename CharT>
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t Utf8ToUtfNSsse3(const char* src,
+                                                          size_t szsrc,
+                                                          CharT* dest,
+                                                          size_t szdest,
+                                                          size_t* written) {
+  const __m128i zero = _mm_setzero_si128();
+  const ShuffleTable* gather = Utf8GatherTable();
+  size_t i = 0;
+  size_t w = 0;
+  while (szsrc - i >= 16 && szdest - w >= 32) {
+    const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const Utf8Shape shape = ClassifyUtf8Block(input);
+    if (shape == Utf8Shape::kAscii) {
+      StoreUnits(_mm_unpacklo_epi8(input, zero), dest + w);
+      StoreUnits(_mm_unpackhi_epi8(input, zero), dest + w + 8);
+      i += 16;
+      w += 16;
+    } else if (shape == Utf8Shape::kTwoByte) {
+      StoreUnits(DecodeTwoByteBlock(input), dest + w);
+      i += 16;
+      w += 8;
+    } else if (shape == Utf8Shape::kUpToTwoBytes) {
+      // Continuation bytes are -128 to -65 as signed values.
+      int starts =
+          ~_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-64), input)) &
+          0xFFFF;
+      // A two-byte sequence starting at the last byte is left for the next
+      // block. Each half is decoded separately; a sequence starting at byte 7
+      // needs nothing from the second half but its continuation byte.
+      if ((starts & _mm_movemask_epi8(input) & 0x8000) != 0) {
+        starts &= 0x7FFF;
+        i += 15;
+      } else {
+        i += 16;
+      }
+      const int low = starts & 0xFF;
+      const int high = starts >> 8;
+      StoreUnits(DecodeUpToTwoByteHalf(gather, input, low), dest + w);
+      w += gather->lengths[low];
+      StoreUnits(
+          DecodeUpToTwoByteHalf(gather, _mm_srli_si128(input, 8), high),
+          dest + w);
+      w += gather->lengths[high];
+    } else if (shape == Utf8Shape::kThreeByte) {
+      StoreUnits(DecodeThreeByteBlock(input), dest + w);
+      i += 15;
+      w += 5;
+    } else if (shape == Utf8Shape::kFourByte) {
+      w += StoreSupplementary(DecodeFourByteBlock(input), dest + w);
+      i += 16;
+    } else {
+      break;
+    }
+  }
+  *written = w;
+  return i;
+}
+
+ABSL_STRINGS_INTERNAL_TARGET_SSSE3 size_t Utf16ToUtf8Ssse3(
+    const char16_t* src, size_t szsrc, char* dest, size_t szdest,
+    size_t* written) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i low6 = _mm_set1_epi16(0x3f);
+  size_t i = 0;
+  size_t w = 0;
+  while (szsrc - i >= 8 && szdest - w >= 32) {
+    const __m128i units =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    // Which units are below 0x80, below 0x800, or surrogates.
+    const __m128i is_one_byte = _mm_cmpeq_epi16(
+        _mm_and_si128(units, _mm_set1_epi16(static_cast<int16_t>(0xff80))),
+        zero);
+    const int one_byte = _mm_movemask_epi8(is_one_byte);
+    const __m128i high5 =
+        _mm_and_si128(units, _mm_set1_epi16(static_cast<int16_t>(0xf800)));
+    const int up_to_two_bytes = _mm_movemask_epi8(_mm_cmpeq_epi16(high5, zero));
+    const int surrogate = _mm_movemask_epi8(
+        _mm_cmpeq_epi16(high5, _mm_set1_epi16(static_cast<int16_t>(0xd800))));
+    if (one_byte == 0xFFFF) {
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + w),
+                       _mm_packus_epi16(units, units));
+      w += 8;
+    } else if (up_to_two_bytes == 0xFFFF) {
+      // 110xxxxx 10xxxxxx, lead byte low.
+      const __m128i out = _mm_or_si128(
+          _mm_or_si128(_mm_srli_epi16(units, 6),
+                       _mm_set1_epi16(static_cast<int16_t>(0x80c0))),
+          _mm_slli_epi16(_mm_and_si128(units, low6), 8));
+      if (one_byte == 0) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + w), out);
+        w += 16;
+      } else {
+        // Put ASCII in the low byte of its lane, then drop the high bytes of
+        // those lanes.
+        const __m128i mixed = _mm_or_si128(_mm_and_si128(is_one_byte, units),
+                                           _mm_andnot_si128(is_one_byte, out));
+        const int two_byte =
+            ~_mm_movemask_epi8(_mm_packs_epi16(is_one_byte, zero)) & 0xFF;
+        const ShuffleTable* table = Utf8PackTable();
+        const __m128i pack = _mm_load_si128(
+            reinterpret_cast<const __m128i*>(table->shuffles[two_byte]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + w),
+                         _mm_shuffle_epi8(mixed, pack));
+        w += table->lengths[two_byte];
+      }
+    } else if (up_to_two_bytes == 0 && surrogate == 0) {
+      // The first two bytes of each sequence in 16-bit lanes, and the third
+      // byte in another vector.
+      const __m128i first = _mm_or_si128(
+          _mm_or_si128(_mm_srli_epi16(units, 12),
+                       _mm_set1_epi16(static_cast<int16_t>(0x80e0))),
+          _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(units, 6), low6), 8));
+      const __m128i third =
+          _mm_or_si128(_mm_and_si128(units, low6), _mm_set1_epi16(0x80));
+      // Interleaving gives four bytes per sequence; drop every fourth.
+      const __m128i compact = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13,
+                                            14, -1, -1, -1, -1);
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(dest + w),
+          _mm_shuffle_epi8(_mm_unpacklo_epi16(first, third), compact));
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(dest + w + 12),
+          _mm_shuffle_epi8(_mm_unpackhi_epi16(first, third), compact));
+      w += 24;
+    } else if (surrogate == 0xFFFF &&
+               _mm_movemask_epi8(_mm_cmpeq_epi32(
+                   _mm_and_si128(units, _mm_set1_epi32(static_cast<int32_t>(
+                                            0xfc00fc00))),
+                   _mm_set1_epi32(static_cast<int32_t>(0xdc00d800)))) ==
+                   0xFFFF) {
+      // Four surrogate pairs, each in a 32-bit lane with the high surrogate
+      // low.
+      const __m128i ten_bits = _mm_set1_epi32(0x3ff);
+      const __m128i code_points = _mm_add_epi32(
+          _mm_or_si128(_mm_slli_epi32(_mm_and_si128(units, ten_bits), 10),
+                       _mm_and_si128(_mm_srli_epi32(units, 16), ten_bits)),
+          _mm_set1_epi32(0x10000));
+      const __m128i low6 = _mm_set1_epi32(0x3f);
+      const __m128i out = _mm_or_si128(
+          _mm_or_si128(
+              _mm_srli_epi32(code_points, 18),
+              _mm_slli_epi32(
+                  _mm_and_si128(_mm_srli_epi32(code_points, 12), low6), 8)),
+          _mm_or_si128(
+              _mm_slli_epi32(
+                  _mm_and_si128(_mm_srli_epi32(code_points, 6), low6), 16),
+              _mm_slli_epi32(_mm_and_si128(code_points, low6), 24)));
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(dest + w),
+          _mm_or_si128(out, _mm_set1_epi32(static_cast<int32_t>(0x808080f0))));
+      w += 16;
+    } else {
+      break;
+    }
+    i += 8;
+  }
+  *written = w;
+  return i;
+}
+
+}  // namespace
+#endif  // ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+
+size_t Utf8ValidPrefixSimd(SimdLevel level, const char* src, size_t szsrc) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  bool incomplete = false;
+  size_t valid;
+  switch (level) {
+    case SimdLevel::kAvx2:
+      valid = Utf8ValidBlocksAvx2(src, szsrc, &incomplete);
+      break;
+    case SimdLevel::kSsse3:
+      valid = Utf8ValidBlocksSsse3(src, szsrc, &incomplete);
+      break;
+    default:
+      return 0;
+  }
+  // The blocks validated so far may end partway through a sequence; back up
+  // to its lead byte, which is at most three bytes back.
+  if (incomplete) {
+    while ((static_cast<unsigned char>(src[valid - 1]) & 0xc0) == 0x80) {
+      --valid;
+    }
+    --valid;
+  }
+  return valid;
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  return 0;
+#endif
+}
+
+size_t CountUtf8LeadBytesSimd(SimdLevel level, const char* src, size_t szsrc,
+                              size_t* count) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return CountUtf8LeadBytesAvx2(src, szsrc, count);
+    case SimdLevel::kSsse3:
+      return CountUtf8LeadBytesSsse3(src, szsrc, count);
+    case SimdLevel::kNone:
+      break;
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(count);
+#endif
+  return 0;
+}
+
+size_t CountUtf8FourByteLeadsSimd(SimdLevel level, const char* src,
+                                  size_t szsrc, size_t* count) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  if (level != SimdLevel::kNone) {
+    return CountUtf8FourByteLeadsSsse3(src, szsrc, count);
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(count);
+#endif
+  return 0;
+}
+
+size_t Utf8ToUtf16Simd(SimdLevel level, const char* src, size_t szsrc,
+                       char16_t* dest, size_t szdest, size_t* written) {
+  *written = 0;
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  if (level != SimdLevel::kNone) {
+    return Utf8ToUtfNSsse3(src, szsrc, dest, szdest, written);
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+  static_cast<void>(szdest);
+#endif
+  return 0;
+}
+
+size_t Utf8ToUtf32Simd(SimdLevel level, const char* src, size_t szsrc,
+                       char32_t* dest, size_t szdest, size_t* written) {
+  *written = 0;
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  if (level != SimdLevel::kNone) {
+    return Utf8ToUtfNSsse3(src, szsrc, dest, szdest, written);
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+  static_cast<void>(szdest);
+#endif
+  return 0;
+}
+
+size_t Utf16ToUtf8Simd(SimdLevel level, const char16_t* src, size_t szsrc,
+                       char* dest, size_t szdest, size_t* written) {
+  *written = 0;
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  if (level != SimdLevel::kNone) {
+    return Utf16ToUtf8Ssse3(src, szsrc, dest, szdest, written);
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(dest);
+  static_cast<void>(szdest);
+#endif
+  return 0;
+}
+
+size_t Utf16ToUtf8LengthSimd(SimdLevel level, const char16_t* src,
+                             size_t szsrc, size_t* length) {
+#ifdef ABSL_STRINGS_INTERNAL_HAVE_X86_SIMD
+  if (level != SimdLevel::kNone) {
+    return Utf16ToUtf8LengthSsse3(src, szsrc, length);
+  }
+#else
+  static_cast<void>(level);
+  static_cast<void>(src);
+  static_cast<void>(szsrc);
+  static_cast<void>(length);
+#endif
+  return 0;
+}
+
+}  // namespace strings_internal
+}  // namespace absl
@@ -0,0 +1,78 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Vectorized kernels for the UTF-8 functions in utf8.h.
+//
+// Like the kernels in escaping_simd.h, each one handles the longest prefix of
+// its input it can in whole blocks and reports how far it got, leaving the
+// rest, including the exact location of any error, to scalar code. At
+// SimdLevel::kNone they consume nothing.
+
+#ifndef ABSL_STRINGS_INTERNAL_UTF8_SIMD_H_
+#define ABSL_STRINGS_INTERNAL_UTF8_SIMD_H_
+
+#include <cstddef>
+
+#include "absl/strings/internal/simd.h"
+
+namespace absl {
+namespace strings_internal {
+
+// Returns the length of a prefix of `src` that is well-formed UTF-8 and ends
+// on a character boundary. Validation stops before the first block that
+// contains an error, or at the final partial block.
+size_t Utf8ValidPrefixSimd(SimdLevel level, const char* src, size_t szsrc);
+
+// Counts the bytes that are not UTF-8 continuation bytes (10xxxxxx) in whole
+// blocks at the front of `src`, adding them to `*count`. Returns the number
+// of bytes examined.
+size_t CountUtf8LeadBytesSimd(SimdLevel level, const char* src, size_t szsrc,
+                              size_t* count);
+
+// Counts the four-byte lead bytes (11110xxx and above) in whole blocks at the
+// front of `src`, adding them to `*count`. Returns the number of bytes
+// examined.
+size_t CountUtf8FourByteLeadsSimd(SimdLevel level, const char* src,
+                                  size_t szsrc, size_t* count);
+
+// Adds the number of UTF-8 bytes needed to encode whole blocks at the front
+// of `src` to `*length`, stopping at the first block that contains a
+// surrogate. Returns the number of code units examined.
+size_t Utf16ToUtf8LengthSimd(SimdLevel level, const char16_t* src,
+                             size_t szsrc, size_t* length);
+
+// The transcoding kernels convert blocks of a few common shapes (all ASCII,
+// all sequences of the same length, or a mix of ASCII and two-byte
+// sequences) from the front of `src` to `dest`, which has room for `szdest`
+// code units, and set `*written` to the number of code units written. They
+// return the number of code units of `src` consumed, always ending on a
+// character boundary. They may scribble on `dest` past what they report as
+// written, but never past `dest + szdest`; the public Span overloads in
+// utf8.h document this.
+
+// `src` must be well-formed UTF-8.
+size_t Utf8ToUtf16Simd(SimdLevel level, const char* src, size_t szsrc,
+                       char16_t* dest, size_t szdest, size_t* written);
+size_t Utf8ToUtf32Simd(SimdLevel level, const char* src, size_t szsrc,
+                       char32_t* dest, size_t szdest, size_t* written);
+
+// Only converts surrogates that are paired within a block, so `src` may be
+// ill-formed.
+size_t Utf16ToUtf8Simd(SimdLevel level, const char16_t* src, size_t szsrc,
+                       char* dest, size_t szdest, size_t* written);
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_UTF8_SIMD_H_
@@ -0,0 +1,131 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/line_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/strings/str_split.h"
+
+namespace absl {
+
+constexpr size_t LineReader::kBatchSize;
+constexpr size_t LineReader::kLongLine;
+
+bool LineReader::Refill() {
+  if (done_) return false;
+  const size_t size = rest_.size();
+  size_t n = 0;
+  // The number of lines that end with '\n', which excludes a final line that
+  // does not.
+  size_t terminated = 0;
+  if (long_lines_) {
+    // Long lines leave the batched scan little to share between line ends, so
+    // one memchr() per line is faster.
+    while (n < kBatchSize) {
+      const void* newline = memchr(rest_.data(), '\n', rest_.size());
+      if (newline == nullptr) break;
+      const size_t length =
+          static_cast<size_t>(static_cast<const char*>(newline) - rest_.data());
+      lines_[n++] = rest_.substr(0, length);
+      rest_.remove_prefix(length + 1);
+    }
+    terminated = n;
+    if (n < kBatchSize) {
+      done_ = true;
+      if (!rest_.empty()) lines_[n++] = rest_;
+    }
+  } else {
+    // StrSplitInto() leaves whatever follows the first kBatchSize lines in the
+    // last element, unsplit.
+    n = absl::StrSplitInto(rest_, '\n', absl::MakeSpan(lines_));
+    if (n == kBatchSize + 1) {
+      rest_ = lines_[kBatchSize];
+      n = kBatchSize;
+      terminated = n;
+    } else {
+      done_ = true;
+      // The piece after the final '\n' is a line without one, unless it is
+      // empty.
+      terminated = n > 0 ? n - 1 : 0;
+      if (n > 0 && lines_[n - 1].empty()) --n;
+    }
+  }
+  // Each batch picks the scan for the next one.
+  long_lines_ = size - rest_.size() >= kLongLine * n;
+  for (size_t i = 0; i < terminated; ++i) {
+    if (!lines_[i].empty() && lines_[i].back() == '\r') {
+      lines_[i].remove_suffix(1);
+    }
+  }
+  next_ = 0;
+  end_ = n;
+  return n > 0;
+}
+
+bool RecordReader::Next(absl::Span<const absl::string_view>* fields) {
+  absl::string_view line;
+  if (!lines_.Next(&line)) return false;
+  size_t n = absl::StrSplitInto(line, delimiter_, absl::MakeSpan(fields_));
+  // A full span may have left the rest of the line in its last field. Make
+  // room for more fields and split again; fields_ only ever grows, so long
+  // records cost this once.
+  while (n == fields_.size() &&
+         memchr(fields_.back().data(), delimiter_, fields_.back().size())) {
+    fields_.resize(2 * fields_.size());
+    n = absl::StrSplitInto(line, delimiter_, absl::MakeSpan(fields_));
+  }
+  *fields = absl::MakeConstSpan(fields_.data(), n);
+  return true;
+}
+
+std::vector<absl::string_view> SplitIntoLineChunks(absl::string_view text,
+                                                   size_t max_chunks) {
+  std::vector<absl::string_view> chunks;
+  if (text.empty() || max_chunks == 0) return chunks;
+  chunks.reserve(max_chunks);
+  size_t start = 0;
+  for (size_t i = 1; i < max_chunks; ++i) {
+    // Each chunk ends at the first line end at or after its share of the text.
+    const size_t target = std::max(start, text.size() * i / max_chunks);
+    const size_t newline = text.find('\n', target);
+    if (newline == absl::string_view::npos) break;
+    const size_t end = newline + 1;
+    if (end == text.size()) break;
+    chunks.push_back(text.substr(start, end - start));
+    start = end;
+  }
+  chunks.push_back(text.substr(start));
+  return chunks;
+}
+
+size_t ParallelForEachLineChunk(
+    absl::string_view text, int num_threads,
+    const std::function<void(size_t, absl::string_view)>& fn) {
+  const std::vector<absl::string_view> chunks =
+      SplitIntoLineChunks(text, std::max(num_threads, 1));
+  if (chunks.empty()) return 0;
+  std::vector<std::thread> threads;
+  threads.reserve(chunks.size() - 1);
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    threads.emplace_back([&fn, &chunks, i] { fn(i, chunks[i]); });
+  }
+  fn(0, chunks[0]);
+  for (std::thread& thread : threads) thread.join();
+  return chunks.size();
+}
+
+}  // namespace absl
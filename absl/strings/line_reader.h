@@ -0,0 +1,175 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: line_reader.h
+// -----------------------------------------------------------------------------
+//
+// This file defines readers for line-oriented text held in memory, such as
+// the contents of an `absl::MappedFile`:
+//
+//   * `absl::LineReader` returns the lines of a buffer one at a time;
+//   * `absl::RecordReader` also splits each line into delimited fields;
+//   * `absl::SplitIntoLineChunks()` and `absl::ParallelForEachLineChunk()`
+//     divide a buffer between threads without splitting any line.
+//
+// Lines and fields are `absl::string_view`s into the buffer; nothing is
+// copied. Line ends are found a batch of lines at a time, with the vectorized
+// scan of `absl::StrSplitInto()` for short lines and `memchr()` for long ones.
+//
+// Example:
+//
+//   absl::MappedFile file;
+//   if (!file.Open(path)) return false;
+//   absl::RecordReader records(file.contents(), '\t');
+//   for (absl::Span<const absl::string_view> fields; records.Next(&fields);) {
+//     if (fields.size() != 3) {
+//       ABSL_RAW_LOG(ERROR, "line %zu: bad record", records.line_number());
+//       continue;
+//     }
+//     ...
+//   }
+
+#ifndef ABSL_STRINGS_LINE_READER_H_
+#define ABSL_STRINGS_LINE_READER_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "absl/base/optimization.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace absl {
+
+// LineReader
+//
+// Returns the lines of a buffer in order. Lines end with '\n', which is not
+// part of the line, nor is a '\r' just before it. A final line need not end
+// with '\n', but a final '\n' does not start an empty line: "a\nb" and
+// "a\nb\n" both hold the lines "a" and "b", and "" holds none.
+//
+// The buffer must outlive the reader and the lines it returns.
+class LineReader {
+ public:
+  explicit LineReader(absl::string_view text) : rest_(text) {}
+  LineReader(const LineReader&) = delete;
+  LineReader& operator=(const LineReader&) = delete;
+
+  // LineReader::Next()
+  //
+  // Sets `*line` to the next line and returns true, or returns false if there
+  // are no more lines.
+  bool Next(absl::string_view* line) {
+    if (ABSL_PREDICT_FALSE(next_ == end_) && !Refill()) return false;
+    *line = lines_[next_++];
+    ++line_number_;
+    return true;
+  }
+
+  // LineReader::line_number()
+  //
+  // The number of lines returned so far, which is also the 1-based number of
+  // the last one.
+  size_t line_number() const { return line_number_; }
+
+ private:
+  // The number of lines found per scan.
+  static constexpr size_t kBatchSize = 64;
+  // Batches averaging at least this many bytes per line are followed by
+  // batches found with memchr().
+  static constexpr size_t kLongLine = 128;
+
+  // Finds the next batch of lines. Returns false if there are none.
+  bool Refill();
+
+  absl::string_view rest_;   // The text after the current batch.
+  bool done_ = false;        // Whether the current batch is the last.
+  bool long_lines_ = false;  // Whether to find the next batch with memchr().
+  size_t next_ = 0;
+  size_t end_ = 0;
+  size_t line_number_ = 0;
+  absl::string_view lines_[kBatchSize + 1];
+};
+
+// RecordReader
+//
+// Returns the lines of a buffer, as `LineReader` does, split into fields at
+// each occurrence of a delimiter, as `absl::StrSplit()` does with the default
+// `absl::AllowEmpty()`: an empty line is a single empty field. There is no
+// quoting or escaping.
+//
+// The buffer must outlive the reader and the fields it returns.
+class RecordReader {
+ public:
+  RecordReader(absl::string_view text, char delimiter)
+      : lines_(text), delimiter_(delimiter), fields_(16) {}
+
+  // RecordReader::Next()
+  //
+  // Sets `*fields` to the fields of the next line and returns true, or returns
+  // false if there are no more lines. `*fields` is valid until the next call.
+  bool Next(absl::Span<const absl::string_view>* fields);
+
+  // RecordReader::line_number()
+  //
+  // The 1-based number of the line last returned.
+  size_t line_number() const { return lines_.line_number(); }
+
+ private:
+  LineReader lines_;
+  char delimiter_;
+  std::vector<absl::string_view> fields_;
+};
+
+// SplitIntoLineChunks()
+//
+// Divides `text` into at most `max_chunks` consecutive, nonempty pieces of
+// roughly equal size that each end with '\n', except perhaps the last, so
+// that no line spans two pieces. Each piece can then be read on a different
+// thread. A piece may hold many more lines than the others if some lines are
+// very long, and there may be fewer pieces than asked for if there are too
+// few lines.
+std::vector<absl::string_view> SplitIntoLineChunks(absl::string_view text,
+                                                   size_t max_chunks);
+
+// ParallelForEachLineChunk()
+//
+// Calls `fn(i, chunk)` for each chunk of `SplitIntoLineChunks(text,
+// num_threads)`, where `i` is its index, on up to `num_threads` threads at
+// once, one of which is the calling thread. Returns the number of chunks once
+// every call has returned. Indexing lets each call write its results to a
+// slot of its own, sized for `num_threads` chunks, and the caller combine
+// them in order afterwards.
+//
+// Example:
+//
+//   std::vector<int64_t> sums(num_threads);
+//   absl::ParallelForEachLineChunk(
+//       file.contents(), num_threads,
+//       [&sums](size_t i, absl::string_view chunk) {
+//         absl::LineReader lines(chunk);
+//         for (absl::string_view line; lines.Next(&line);) {
+//           int64_t value;
+//           if (absl::SimpleAtoi(line, &value)) sums[i] += value;
+//         }
+//       });
+size_t ParallelForEachLineChunk(
+    absl::string_view text, int num_threads,
+    const std::function<void(size_t, absl::string_view)>& fn);
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_LINE_READER_H_
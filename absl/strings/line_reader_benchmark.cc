@@ -0,0 +1,176 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/line_reader.h"
+#include "absl/strings/mapped_file.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+
+namespace {
+
+constexpr size_t kTextSize = 8 << 20;
+
+// About kTextSize bytes of comma-separated records, with lines averaging
+// `line_length` bytes.
+std::string MakeText(int line_length) {
+  std::string text;
+  text.reserve(kTextSize + line_length * 2);
+  uint32_t x = 12345;
+  while (text.size() < kTextSize) {
+    x = x * 1103515245 + 12345;
+    const int length = 1 + (x >> 8) % (2 * line_length - 1);
+    const size_t start = text.size();
+    absl::StrAppend(&text, x % 100000, ",");
+    while (text.size() - start < static_cast<size_t>(length)) {
+      absl::StrAppend(&text, "field,");
+    }
+    text.back() = '\n';
+  }
+  return text;
+}
+
+const std::string& Text(int line_length) {
+  static auto* texts = new std::vector<std::string>(1024);
+  std::string& text = (*texts)[line_length];
+  if (text.empty()) text = MakeText(line_length);
+  return text;
+}
+
+void BM_LineReader(benchmark::State& state) {
+  const std::string& text = Text(state.range(0));
+  for (auto _ : state) {
+    absl::LineReader lines(text);
+    size_t bytes = 0;
+    for (absl::string_view line; lines.Next(&line);) bytes += line.size();
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_LineReader)->Arg(16)->Arg(64)->Arg(256)->Arg(1000);
+
+// The loops LineReader replaces.
+void BM_StrSplitLines(benchmark::State& state) {
+  const std::string& text = Text(state.range(0));
+  for (auto _ : state) {
+    size_t bytes = 0;
+    for (absl::string_view line : absl::StrSplit(text, '\n')) {
+      bytes += line.size();
+    }
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_StrSplitLines)->Arg(16)->Arg(64)->Arg(256)->Arg(1000);
+
+void BM_FindLines(benchmark::State& state) {
+  const absl::string_view text = Text(state.range(0));
+  for (auto _ : state) {
+    size_t bytes = 0;
+    size_t start = 0;
+    while (start < text.size()) {
+      size_t end = text.find('\n', start);
+      if (end == absl::string_view::npos) end = text.size();
+      bytes += end - start;
+      start = end + 1;
+    }
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_FindLines)->Arg(16)->Arg(64)->Arg(256)->Arg(1000);
+
+void BM_RecordReader(benchmark::State& state) {
+  const std::string& text = Text(state.range(0));
+  for (auto _ : state) {
+    absl::RecordReader records(text, ',');
+    size_t fields = 0;
+    for (absl::Span<const absl::string_view> record; records.Next(&record);) {
+      fields += record.size();
+    }
+    benchmark::DoNotOptimize(fields);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_RecordReader)->Arg(16)->Arg(64)->Arg(256);
+
+void BM_StrSplitRecords(benchmark::State& state) {
+  const std::string& text = Text(state.range(0));
+  for (auto _ : state) {
+    size_t fields = 0;
+    for (absl::string_view line : absl::StrSplit(text, '\n')) {
+      std::vector<absl::string_view> record = absl::StrSplit(line, ',');
+      fields += record.size();
+    }
+    benchmark::DoNotOptimize(fields);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_StrSplitRecords)->Arg(16)->Arg(64)->Arg(256);
+
+// Arg is the number of threads.
+void BM_ParallelForEachLineChunk(benchmark::State& state) {
+  const std::string& text = Text(64);
+  const int threads = state.range(0);
+  std::vector<size_t> counts(threads);
+  for (auto _ : state) {
+    absl::ParallelForEachLineChunk(
+        text, threads, [&counts](size_t i, absl::string_view chunk) {
+          absl::LineReader lines(chunk);
+          size_t count = 0;
+          for (absl::string_view line; lines.Next(&line);) ++count;
+          counts[i] = count;
+        });
+    benchmark::DoNotOptimize(counts.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ParallelForEachLineChunk)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+// Opens, maps and reads a file of Text(64) each iteration, so the cost of
+// faulting the pages in from the page cache counts. Arg is whether to map the
+// file with MappedFileOptions::populate.
+void BM_MappedFileLines(benchmark::State& state) {
+  const std::string& text = Text(64);
+  const char* tmp_dir = std::getenv("TEST_TMPDIR");
+  const std::string path =
+      absl::StrCat(tmp_dir ? tmp_dir : "/tmp", "/line_reader_benchmark.txt");
+  std::ofstream(path, std::ios::out | std::ios::binary) << text;
+
+  absl::MappedFileOptions options;
+  options.populate = state.range(0) != 0;
+  for (auto _ : state) {
+    absl::MappedFile file;
+    if (!file.Open(path, nullptr, options)) {
+      state.SkipWithError("failed to open file");
+      break;
+    }
+    absl::LineReader lines(file.contents());
+    size_t bytes = 0;
+    for (absl::string_view line; lines.Next(&line);) bytes += line.size();
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_MappedFileLines)->Arg(0)->Arg(1);
+
+}  // namespace
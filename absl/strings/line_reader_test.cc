@@ -0,0 +1,205 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/line_reader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<std::string> ReadLines(absl::string_view text) {
+  std::vector<std::string> lines;
+  absl::LineReader reader(text);
+  for (absl::string_view line; reader.Next(&line);) {
+    lines.emplace_back(line);
+    EXPECT_EQ(lines.size(), reader.line_number());
+  }
+  // Stays at the end.
+  absl::string_view line;
+  EXPECT_FALSE(reader.Next(&line));
+  return lines;
+}
+
+TEST(LineReader, Basic) {
+  EXPECT_THAT(ReadLines(absl::string_view()), IsEmpty());
+  EXPECT_THAT(ReadLines(""), IsEmpty());
+  EXPECT_THAT(ReadLines("\n"), ElementsAre(""));
+  EXPECT_THAT(ReadLines("\n\n"), ElementsAre("", ""));
+  EXPECT_THAT(ReadLines("a"), ElementsAre("a"));
+  EXPECT_THAT(ReadLines("a\n"), ElementsAre("a"));
+  EXPECT_THAT(ReadLines("a\nbc"), ElementsAre("a", "bc"));
+  EXPECT_THAT(ReadLines("a\n\nbc\n"), ElementsAre("a", "", "bc"));
+  EXPECT_THAT(ReadLines("a\r\nb\r\n\r\nc\rd"),
+              ElementsAre("a", "b", "", "c\rd"));
+  // Only a '\r' before a '\n' is removed.
+  EXPECT_THAT(ReadLines("a\nb\r"), ElementsAre("a", "b\r"));
+  EXPECT_THAT(ReadLines("\r"), ElementsAre("\r"));
+}
+
+TEST(LineReader, ManyLines) {
+  // Line counts around multiples of the batch size, with and without a final
+  // line end.
+  for (int count : {63, 64, 65, 127, 128, 129, 1000}) {
+    std::vector<std::string> expected;
+    for (int i = 0; i < count; ++i) {
+      expected.push_back(std::string(i % 7, 'x') + absl::StrCat(i));
+    }
+    const std::string joined = absl::StrJoin(expected, "\n");
+    EXPECT_EQ(expected, ReadLines(joined)) << count;
+    EXPECT_EQ(expected, ReadLines(joined + "\n")) << count;
+  }
+}
+
+TEST(LineReader, MatchesStrSplit) {
+  std::string text;
+  for (int i = 0; i < 5000; ++i) {
+    absl::StrAppend(&text, std::string(i * 37 % 301, 'a' + i % 26), "\n");
+  }
+  std::vector<std::string> expected = absl::StrSplit(text, '\n');
+  expected.pop_back();
+  EXPECT_EQ(expected, ReadLines(text));
+}
+
+TEST(LineReader, LongLines) {
+  // Runs of long lines switch to finding line ends with memchr() and back,
+  // including at the end of the text.
+  for (size_t length : {1, 127, 128, 129, 1000}) {
+    for (int count : {1, 63, 64, 65, 200}) {
+      for (int short_count : {0, 100}) {
+        std::vector<std::string> expected;
+        std::string text;
+        for (int i = 0; i < count; ++i) {
+          expected.push_back(
+              std::string(i % 3 == 0 ? 2 : length, 'a' + i % 26));
+          absl::StrAppend(&text, expected.back(), i % 2 ? "\r\n" : "\n");
+        }
+        for (int i = 0; i < short_count; ++i) {
+          expected.push_back(absl::StrCat(i));
+          absl::StrAppend(&text, expected.back(), "\n");
+        }
+        // The '\r' stays on the final line unless a '\n' follows.
+        absl::StrAppend(&text, std::string(length, 'z'), "\r");
+        expected.push_back(std::string(length, 'z'));
+        EXPECT_EQ(expected, ReadLines(text + "\n")) << length << " " << count;
+        expected.back().push_back('\r');
+        EXPECT_EQ(expected, ReadLines(text)) << length << " " << count;
+      }
+    }
+  }
+}
+
+TEST(RecordReader, Basic) {
+  absl::RecordReader reader("a\tb\tc\n\nd\n\t\n", '\t');
+  absl::Span<const absl::string_view> fields;
+  ASSERT_TRUE(reader.Next(&fields));
+  EXPECT_THAT(fields, ElementsAre("a", "b", "c"));
+  EXPECT_EQ(1, reader.line_number());
+  ASSERT_TRUE(reader.Next(&fields));
+  EXPECT_THAT(fields, ElementsAre(""));
+  ASSERT_TRUE(reader.Next(&fields));
+  EXPECT_THAT(fields, ElementsAre("d"));
+  ASSERT_TRUE(reader.Next(&fields));
+  EXPECT_THAT(fields, ElementsAre("", ""));
+  EXPECT_EQ(4, reader.line_number());
+  EXPECT_FALSE(reader.Next(&fields));
+}
+
+TEST(RecordReader, ManyFields) {
+  std::string text;
+  std::vector<std::vector<std::string>> expected;
+  for (int fields : {1, 15, 16, 17, 100, 2, 33}) {
+    std::vector<std::string> record;
+    for (int i = 0; i < fields; ++i) record.push_back(absl::StrCat(i));
+    absl::StrAppend(&text, absl::StrJoin(record, ","), "\r\n");
+    expected.push_back(record);
+  }
+  absl::RecordReader reader(text, ',');
+  std::vector<std::vector<std::string>> records;
+  for (absl::Span<const absl::string_view> fields; reader.Next(&fields);) {
+    records.emplace_back(fields.begin(), fields.end());
+  }
+  EXPECT_EQ(expected, records);
+}
+
+TEST(SplitIntoLineChunks, Basic) {
+  EXPECT_THAT(absl::SplitIntoLineChunks("", 4), IsEmpty());
+  EXPECT_THAT(absl::SplitIntoLineChunks("abc\n", 0), IsEmpty());
+  EXPECT_THAT(absl::SplitIntoLineChunks("abc\n", 4), ElementsAre("abc\n"));
+  EXPECT_THAT(absl::SplitIntoLineChunks("abcdef", 4), ElementsAre("abcdef"));
+  EXPECT_THAT(absl::SplitIntoLineChunks("a\nb\nc\nd\n", 2),
+              ElementsAre("a\nb\nc\n", "d\n"));
+  EXPECT_THAT(absl::SplitIntoLineChunks("a\nb\nc\nd", 4),
+              ElementsAre("a\n", "b\n", "c\n", "d"));
+  EXPECT_THAT(absl::SplitIntoLineChunks("aaaaaaaaaaaaaa\nb\nc\n", 3),
+              ElementsAre("aaaaaaaaaaaaaa\n", "b\n", "c\n"));
+  // A long line leaves too few line ends to go around.
+  EXPECT_THAT(absl::SplitIntoLineChunks("a\nbbbbbbbbbbbbbbbbbbbbbb\nc\n", 4),
+              ElementsAre("a\nbbbbbbbbbbbbbbbbbbbbbb\n", "c\n"));
+}
+
+TEST(SplitIntoLineChunks, CoversText) {
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    absl::StrAppend(&text, std::string(i % 50, '.'), i, "\n");
+  }
+  for (size_t n : {1, 2, 3, 7, 16, 999, 1000, 5000}) {
+    const std::vector<absl::string_view> chunks =
+        absl::SplitIntoLineChunks(text, n);
+    ASSERT_FALSE(chunks.empty());
+    EXPECT_LE(chunks.size(), n);
+    const char* next = text.data();
+    for (absl::string_view chunk : chunks) {
+      EXPECT_EQ(next, chunk.data());
+      ASSERT_FALSE(chunk.empty());
+      EXPECT_EQ('\n', chunk.back());
+      next = chunk.data() + chunk.size();
+    }
+    EXPECT_EQ(text.data() + text.size(), next);
+  }
+}
+
+TEST(ParallelForEachLineChunk, CountsLines) {
+  std::string text;
+  for (int i = 0; i < 10000; ++i) absl::StrAppend(&text, i, "\n");
+  for (int threads : {0, 1, 2, 8}) {
+    std::vector<size_t> counts(std::max(threads, 1));
+    std::atomic<size_t> calls(0);
+    const size_t chunks = absl::ParallelForEachLineChunk(
+        text, threads, [&counts, &calls](size_t i, absl::string_view chunk) {
+          absl::LineReader lines(chunk);
+          for (absl::string_view line; lines.Next(&line);) ++counts[i];
+          ++calls;
+        });
+    EXPECT_EQ(chunks, calls.load());
+    size_t total = 0;
+    for (size_t count : counts) total += count;
+    EXPECT_EQ(10000, total) << threads;
+  }
+  EXPECT_EQ(0, absl::ParallelForEachLineChunk(
+                   "", 4, [](size_t, absl::string_view) { FAIL(); }));
+}
+
+}  // namespace
@@ -0,0 +1,154 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/mapped_file.h"
+
+#include <cerrno>
+#include <system_error>  // NOLINT(build/c++11)
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "absl/strings/str_cat.h"
+
+namespace absl {
+namespace {
+
+// Sets `*error`, if `error` is not null, to a description of the failure of
+// `operation` on `path` with `errno_value`, and returns false.
+bool Fail(const std::string& path, absl::string_view operation,
+          int errno_value, std::string* error) {
+  if (error != nullptr) {
+    *error = absl::StrCat(operation, "(\"", path, "\") failed: ",
+                          std::generic_category().message(errno_value));
+  }
+  return false;
+}
+
+}  // namespace
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this == &other) return *this;
+  Close();
+  mapped_ = other.mapped_;
+  if (mapped_) {
+    contents_ = other.contents_;
+  } else {
+    // Moving a short string moves its characters, so point at the new copy.
+    buffer_ = std::move(other.buffer_);
+    contents_ = buffer_;
+  }
+  other.contents_ = absl::string_view();
+  other.mapped_ = false;
+  other.buffer_.clear();
+  return *this;
+}
+
+void MappedFile::Close() {
+#ifndef _WIN32
+  if (mapped_) {
+    munmap(const_cast<char*>(contents_.data()), contents_.size());
+  }
+#endif
+  contents_ = absl::string_view();
+  mapped_ = false;
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+}
+
+bool MappedFile::Open(const std::string& path, std::string* error,
+                      const MappedFileOptions& options) {
+  Close();
+#ifndef _WIN32
+  int fd;
+  do {
+    fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) return Fail(path, "open", errno, error);
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    const int fstat_errno = errno;
+    close(fd);
+    return Fail(path, "fstat", fstat_errno, error);
+  }
+
+  // Empty files can't be mapped, while pipes and such do not report their
+  // size. Both are read below instead, as is a file that fails to map.
+  const size_t file_size = static_cast<size_t>(file_stat.st_size);
+  if (S_ISREG(file_stat.st_mode) && file_size > 0) {
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (options.populate) flags |= MAP_POPULATE;
+#endif
+    void* addr = mmap(nullptr, file_size, PROT_READ, flags, fd, 0);
+    if (addr != MAP_FAILED) {
+      close(fd);
+#ifdef MADV_SEQUENTIAL
+      // Only a hint, so failure is harmless.
+      if (options.sequential) madvise(addr, file_size, MADV_SEQUENTIAL);
+#endif
+      contents_ = absl::string_view(static_cast<const char*>(addr), file_size);
+      mapped_ = true;
+      return true;
+    }
+  }
+
+  // Read in chunks that double in size, starting with the size reported.
+  size_t size = 0;
+  buffer_.resize(file_size > 0 ? file_size : 4096);
+  for (;;) {
+    if (size == buffer_.size()) buffer_.resize(2 * size);
+    const ssize_t n = read(fd, &buffer_[size], buffer_.size() - size);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      const int read_errno = errno;
+      close(fd);
+      Close();
+      return Fail(path, "read", read_errno, error);
+    }
+    if (n == 0) break;
+    size += static_cast<size_t>(n);
+  }
+  close(fd);
+  buffer_.resize(size);
+#else
+  static_cast<void>(options);
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file) return Fail(path, "open", errno, error);
+  buffer_.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  if (file.bad()) {
+    const int read_errno = errno;
+    Close();
+    return Fail(path, "read", read_errno, error);
+  }
+#endif
+  contents_ = buffer_;
+  return true;
+}
+
+}  // namespace absl
@@ -0,0 +1,120 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: mapped_file.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `absl::MappedFile`, the read-only contents of a file as an
+// `absl::string_view`. Regular files are memory mapped where the platform
+// allows it, so that reading even a large file does not copy it; other files,
+// such as pipes, and all files on platforms without `mmap()`, are read into
+// memory instead.
+//
+// Paired with `absl::LineReader` (see line_reader.h), a `MappedFile` makes
+// reading a text file line by line a matter of scanning memory.
+//
+// Example:
+//
+//   absl::MappedFile file;
+//   std::string error;
+//   if (!file.Open("/var/log/app.log", &error)) {
+//     ABSL_RAW_LOG(ERROR, "%s", error.c_str());
+//     return;
+//   }
+//   absl::LineReader lines(file.contents());
+//   for (absl::string_view line; lines.Next(&line);) {
+//     ...
+//   }
+
+#ifndef ABSL_STRINGS_MAPPED_FILE_H_
+#define ABSL_STRINGS_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace absl {
+
+// MappedFileOptions
+//
+// How a file is mapped. The hints are ignored where the platform lacks them
+// and for files that are read rather than mapped.
+struct MappedFileOptions {
+  // Whether to fault in the whole file while opening it (`MAP_POPULATE` on
+  // Linux), which is faster than faulting it in page by page when all of it
+  // will be read, but makes `Open()` take as long as reading the file.
+  bool populate = false;
+
+  // Whether to tell the kernel that the file will be read from front to back
+  // (`madvise(MADV_SEQUENTIAL)`), so that it reads ahead aggressively and
+  // drops pages soon after they have been read.
+  bool sequential = true;
+};
+
+// MappedFile
+//
+// The read-only contents of a file. A `MappedFile` can be moved but not
+// copied; views into `contents()` stay valid until the `MappedFile` is closed,
+// destroyed or moved from.
+//
+// The contents of a mapped file reflect any later changes to the file made by
+// other processes, and a process that truncates the file while it is mapped
+// makes reading the truncated part fail with `SIGBUS`. Map only files that are
+// not being modified.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() { Close(); }
+
+  // MappedFile::Open()
+  //
+  // Closes the current file, if any, and opens the file at `path`. Returns
+  // true on success. On failure, returns false, leaves the `MappedFile`
+  // empty, and sets `*error`, if `error` is not null, to a description of
+  // the failure.
+  bool Open(const std::string& path, std::string* error = nullptr,
+            const MappedFileOptions& options = MappedFileOptions());
+
+  // MappedFile::Close()
+  //
+  // Unmaps or frees the contents, leaving the `MappedFile` empty.
+  void Close();
+
+  // MappedFile::contents()
+  // MappedFile::size()
+  //
+  // The contents of the file, which are empty if no file is open.
+  absl::string_view contents() const { return contents_; }
+  size_t size() const { return contents_.size(); }
+
+  // MappedFile::is_mapped()
+  //
+  // Whether the contents are memory mapped, as opposed to read into memory.
+  bool is_mapped() const { return mapped_; }
+
+ private:
+  absl::string_view contents_;
+  bool mapped_ = false;
+  std::string buffer_;  // Holds the contents if the file is not mapped.
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_MAPPED_FILE_H_
@@ -0,0 +1,156 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/mapped_file.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+
+namespace {
+
+std::string GetTmpDir() {
+  // TEST_TMPDIR is set by Bazel. Try the others when not running under Bazel.
+  static const char* const kTmpEnvVars[] = {"TEST_TMPDIR", "TMPDIR", "TEMP",
+                                            "TEMPDIR", "TMP"};
+  for (const char* const var : kTmpEnvVars) {
+    const char* tmp_dir = std::getenv(var);
+    if (tmp_dir != nullptr) {
+      return tmp_dir;
+    }
+  }
+
+  // Try something reasonable.
+  return "/tmp";
+}
+
+// Writes `contents` to a file named after `name` and returns its path.
+std::string WriteFile(const std::string& name, const std::string& contents) {
+  const std::string path = absl::StrCat(GetTmpDir(), "/mapped_file_test_",
+                                        name);
+  std::ofstream file(path, std::ios::out | std::ios::binary);
+  file << contents;
+  return path;
+}
+
+TEST(MappedFile, Empty) {
+  absl::MappedFile file;
+  EXPECT_EQ("", file.contents());
+  EXPECT_EQ(0, file.size());
+  EXPECT_FALSE(file.is_mapped());
+}
+
+TEST(MappedFile, Open) {
+  std::string contents;
+  for (int i = 0; i < 10000; ++i) absl::StrAppend(&contents, "line ", i, "\n");
+  const std::string path = WriteFile("open", contents);
+
+  absl::MappedFile file;
+  std::string error;
+  ASSERT_TRUE(file.Open(path, &error)) << error;
+  EXPECT_EQ(contents, file.contents());
+  EXPECT_EQ(contents.size(), file.size());
+#ifndef _WIN32
+  EXPECT_TRUE(file.is_mapped());
+#endif
+
+  absl::MappedFileOptions options;
+  options.populate = true;
+  options.sequential = false;
+  ASSERT_TRUE(file.Open(path, &error, options)) << error;
+  EXPECT_EQ(contents, file.contents());
+
+  file.Close();
+  EXPECT_EQ("", file.contents());
+  EXPECT_FALSE(file.is_mapped());
+  std::remove(path.c_str());
+}
+
+TEST(MappedFile, EmptyFile) {
+  const std::string path = WriteFile("empty", "");
+  absl::MappedFile file;
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_EQ("", file.contents());
+  EXPECT_FALSE(file.is_mapped());
+  std::remove(path.c_str());
+}
+
+TEST(MappedFile, Missing) {
+  const std::string existing = WriteFile("missing", "contents");
+  absl::MappedFile file;
+  ASSERT_TRUE(file.Open(existing));
+  std::remove(existing.c_str());
+
+  // A failed Open() leaves the file empty.
+  std::string error;
+  const std::string path = absl::StrCat(GetTmpDir(), "/no/such/file");
+  EXPECT_FALSE(file.Open(path, &error));
+  EXPECT_TRUE(absl::StrContains(error, path)) << error;
+  EXPECT_EQ("", file.contents());
+  EXPECT_FALSE(file.Open(path));
+}
+
+#ifndef _WIN32
+TEST(MappedFile, NotRegular) {
+  // /dev/null can be opened but not mapped, and reports no size.
+  absl::MappedFile file;
+  std::string error;
+  ASSERT_TRUE(file.Open("/dev/null", &error)) << error;
+  EXPECT_EQ("", file.contents());
+  EXPECT_FALSE(file.is_mapped());
+
+#ifdef __linux__
+  // Files under /proc have contents but report a size of zero.
+  ASSERT_TRUE(file.Open("/proc/self/status", &error)) << error;
+  EXPECT_TRUE(absl::StrContains(file.contents(), "Pid:"));
+  EXPECT_FALSE(file.is_mapped());
+#endif
+}
+#endif
+
+TEST(MappedFile, Move) {
+  const std::string path = WriteFile("move", "mapped contents");
+  absl::MappedFile mapped;
+  ASSERT_TRUE(mapped.Open(path));
+  const char* data = mapped.contents().data();
+
+  absl::MappedFile moved(std::move(mapped));
+  EXPECT_EQ("mapped contents", moved.contents());
+  EXPECT_EQ(data, moved.contents().data());
+  EXPECT_EQ("", mapped.contents());  // NOLINT(bugprone-use-after-move)
+
+  absl::MappedFile assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ("mapped contents", assigned.contents());
+  EXPECT_EQ("", moved.contents());  // NOLINT(bugprone-use-after-move)
+  std::remove(path.c_str());
+
+#ifdef __linux__
+  // Contents read into memory, rather than mapped, move with the file.
+  absl::MappedFile read;
+  ASSERT_TRUE(read.Open("/proc/self/status"));
+  const std::string expected(read.contents());
+  absl::MappedFile moved_read(std::move(read));
+  EXPECT_EQ(expected, moved_read.contents());
+  EXPECT_EQ("", read.contents());  // NOLINT(bugprone-use-after-move)
+#endif
+}
+
+}  // namespace
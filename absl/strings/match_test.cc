@@ -14,6 +14,8 @@
 
 #include "absl/strings/match.h"
 
+#include <string>
+
 #include "gtest/gtest.h"
 
 namespace {
@@ -91,6 +93,28 @@ TEST(MatchTest, EqualsIgnoreCase) {
   EXPECT_FALSE(absl::EqualsIgnoreCase(data, "then"));
 }
 
+TEST(MatchTest, EqualsIgnoreCaseLong) {
+  const std::string lower = "content-type: text/html; charset=utf-8 ~[]{}@`";
+  std::string upper = lower;
+  for (char& c : upper) {
+    if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+  }
+  EXPECT_TRUE(absl::EqualsIgnoreCase(lower, upper));
+  for (size_t i = 0; i < lower.size(); ++i) {
+    // Flipping bit 0x20 makes a difference unless it is a letter's case bit.
+    std::string changed = upper;
+    changed[i] ^= 0x20;
+    const bool letter = (lower[i] >= 'a' && lower[i] <= 'z');
+    EXPECT_EQ(letter, absl::EqualsIgnoreCase(lower, changed)) << i;
+    // '@' and '`' differ from 'A' and 'a' in the same bit, but are not
+    // letters.
+    changed = upper;
+    changed[i] = lower[i] == '@' ? '`' : '@';
+    EXPECT_FALSE(absl::EqualsIgnoreCase(lower, changed)) << i;
+  }
+  EXPECT_FALSE(absl::EqualsIgnoreCase(lower, upper.substr(1)));
+}
+
 TEST(MatchTest, StartsWithIgnoreCase) {
   EXPECT_TRUE(absl::StartsWithIgnoreCase("foo", "foo"));
   EXPECT_TRUE(absl::StartsWithIgnoreCase("foo", "Fo"));
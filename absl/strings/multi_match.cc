@@ -0,0 +1,33 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/multi_match.h"
+
+namespace absl {
+
+MultiMatcher::MultiMatcher(std::initializer_list<absl::string_view> patterns)
+    : searcher_(std::vector<absl::string_view>(patterns)) {}
+
+size_t MultiMatcher::FindAny(absl::string_view text, size_t pos,
+                             size_t* pattern) const {
+  size_t offset;
+  size_t index;
+  if (!searcher_.Find(text, pos, &offset, &index)) {
+    return absl::string_view::npos;
+  }
+  if (pattern != nullptr) *pattern = index;
+  return offset;
+}
+
+}  // namespace absl
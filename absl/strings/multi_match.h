@@ -0,0 +1,82 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: multi_match.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `absl::MultiMatcher`, which searches text for any of a
+// fixed set of patterns at once. The patterns are compiled when the matcher is
+// constructed, after which a search takes time proportional to the length of
+// the text, however many patterns there are. Use it in place of calling
+// `absl::string_view::find()` once per pattern.
+//
+// Example:
+//
+//   static const absl::MultiMatcher* const kKeywords =
+//       new absl::MultiMatcher({"if", "else", "while", "return"});
+//   size_t which;
+//   size_t pos = kKeywords->FindAny(line, 0, &which);
+//   if (pos != absl::string_view::npos) { ... }
+#ifndef ABSL_STRINGS_MULTI_MATCH_H_
+#define ABSL_STRINGS_MULTI_MATCH_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include "absl/strings/internal/aho_corasick.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+
+// MultiMatcher
+//
+// A compiled set of patterns. The matcher does not refer to the patterns once
+// it is constructed. It is thread-compatible: concurrent calls to its const
+// methods are safe.
+class MultiMatcher {
+ public:
+  explicit MultiMatcher(std::initializer_list<absl::string_view> patterns);
+
+  // Accepts any container of string-like patterns.
+  template <typename Container>
+  explicit MultiMatcher(const Container& patterns)
+      : searcher_(std::vector<absl::string_view>(patterns.begin(),
+                                                 patterns.end())) {}
+
+  // MultiMatcher::FindAny()
+  //
+  // Returns the offset of the earliest occurrence of any pattern in `text` at
+  // or after `pos`, or `absl::string_view::npos` if there is none. Of the
+  // patterns occurring at that offset, the longest is chosen, and if `pattern`
+  // is not null its index is stored there. (A pattern listed more than once
+  // reports its first index.) Empty patterns never match.
+  size_t FindAny(absl::string_view text, size_t pos = 0,
+                 size_t* pattern = nullptr) const;
+
+  // MultiMatcher::ContainsAny()
+  //
+  // Returns whether any pattern occurs in `text`.
+  bool ContainsAny(absl::string_view text) const {
+    return FindAny(text) != absl::string_view::npos;
+  }
+
+ private:
+  strings_internal::AhoCorasick searcher_;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_MULTI_MATCH_H_
@@ -0,0 +1,93 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/multi_match.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+// Lowercase words of 4 to 10 letters.
+std::vector<std::string> RandomWords(int n, unsigned seed) {
+  std::minstd_rand rng(seed);
+  std::uniform_int_distribution<int> length(4, 10);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::vector<std::string> words(n);
+  for (std::string& word : words) {
+    word.resize(length(rng));
+    for (char& c : word) c = static_cast<char>(letter(rng));
+  }
+  return words;
+}
+
+// About a megabyte of text made of words from a different seed, so that the
+// patterns rarely occur and the search covers the whole text.
+std::string MakeText() {
+  std::string text;
+  for (const std::string& word : RandomWords(150000, 1)) {
+    text += word;
+    text += ' ';
+  }
+  return text;
+}
+
+void BM_FindAny(benchmark::State& state) {
+  const std::string text = MakeText();
+  const absl::MultiMatcher matcher(RandomWords(state.range(0), 2));
+  for (auto _ : state) {
+    size_t matches = 0;
+    for (size_t pos = 0;
+         (pos = matcher.FindAny(text, pos)) != absl::string_view::npos;
+         ++pos) {
+      ++matches;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_FindAny)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+// The alternative: one search per pattern.
+void BM_FindEachPattern(benchmark::State& state) {
+  const std::string text = MakeText();
+  const std::vector<std::string> patterns = RandomWords(state.range(0), 2);
+  for (auto _ : state) {
+    size_t matches = 0;
+    for (const std::string& pattern : patterns) {
+      for (size_t pos = 0; (pos = text.find(pattern, pos)) != text.npos;
+           ++pos) {
+        ++matches;
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_FindEachPattern)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_BuildMultiMatcher(benchmark::State& state) {
+  const std::vector<std::string> patterns = RandomWords(state.range(0), 2);
+  for (auto _ : state) {
+    absl::MultiMatcher matcher(patterns);
+    benchmark::DoNotOptimize(&matcher);
+  }
+}
+BENCHMARK(BM_BuildMultiMatcher)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+}  // namespace
@@ -0,0 +1,137 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/multi_match.h"
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/match.h"
+
+namespace {
+
+constexpr size_t npos = absl::string_view::npos;
+
+TEST(MultiMatcher, FindAny) {
+  const absl::MultiMatcher matcher({"he", "she", "his", "hers"});
+  size_t pattern = 99;
+  EXPECT_EQ(1, matcher.FindAny("ushers", 0, &pattern));
+  EXPECT_EQ(1, pattern);  // "she" starts before "he" and "hers"
+  EXPECT_EQ(2, matcher.FindAny("ushers", 2, &pattern));
+  EXPECT_EQ(3, pattern);  // "hers" is longer than "he"
+  EXPECT_EQ(0, matcher.FindAny("his", 0, &pattern));
+  EXPECT_EQ(2, pattern);
+  EXPECT_EQ(npos, matcher.FindAny("ushers", 3));
+  EXPECT_EQ(npos, matcher.FindAny("ushers", 100));
+  EXPECT_EQ(npos, matcher.FindAny(""));
+  EXPECT_EQ(npos, matcher.FindAny("hi sh"));
+  EXPECT_EQ(4, matcher.FindAny("xxxxhe"));
+}
+
+TEST(MultiMatcher, ContainsAny) {
+  const absl::MultiMatcher matcher({"cat", "dog"});
+  EXPECT_TRUE(matcher.ContainsAny("hotdog"));
+  EXPECT_TRUE(matcher.ContainsAny("cat"));
+  EXPECT_FALSE(matcher.ContainsAny("ca do"));
+  EXPECT_FALSE(matcher.ContainsAny(""));
+}
+
+TEST(MultiMatcher, EdgeCases) {
+  EXPECT_EQ(npos, absl::MultiMatcher({}).FindAny("abc"));
+  EXPECT_EQ(npos, absl::MultiMatcher({""}).FindAny("abc"));
+
+  size_t pattern = 99;
+  const absl::MultiMatcher duplicates({"", "ab", "b", "ab"});
+  EXPECT_EQ(1, duplicates.FindAny("xabc", 0, &pattern));
+  EXPECT_EQ(1, pattern);
+
+  // Patterns may contain any bytes, including NUL and the high half.
+  const std::string nul("\0\xff", 2);
+  const absl::MultiMatcher binary({nul, "\x80"});
+  EXPECT_EQ(3, binary.FindAny(std::string("abc\0\xff", 5), 0, &pattern));
+  EXPECT_EQ(0, pattern);
+  EXPECT_EQ(1, binary.FindAny("a\x80", 0, &pattern));
+  EXPECT_EQ(1, pattern);
+  EXPECT_EQ(npos, binary.FindAny(std::string("\0\0", 2)));
+
+  // Every byte value in use.
+  std::vector<std::string> bytes;
+  for (int c = 0; c < 256; ++c) bytes.push_back(std::string(1, c) + "!");
+  const absl::MultiMatcher all_bytes(bytes);
+  EXPECT_EQ(npos, all_bytes.FindAny("abc"));
+  EXPECT_EQ(2, all_bytes.FindAny("ab\xff!", 0, &pattern));
+  EXPECT_EQ(255, pattern);
+  EXPECT_EQ(0, all_bytes.FindAny(std::string("\0!", 2), 0, &pattern));
+  EXPECT_EQ(0, pattern);
+}
+
+TEST(MultiMatcher, Containers) {
+  std::vector<std::string> words = {"alpha", "beta"};
+  absl::MultiMatcher from_vector(words);
+  words.clear();  // The matcher does not refer to the patterns.
+  EXPECT_EQ(4, from_vector.FindAny("the beta"));
+
+  std::set<absl::string_view> set = {"x", "y"};
+  absl::MultiMatcher from_set(set);
+  absl::MultiMatcher copy = from_set;
+  EXPECT_EQ(2, copy.FindAny("abyx"));
+}
+
+TEST(MultiMatcher, MatchesReference) {
+  std::mt19937 rng(1234);
+  auto random_string = [&rng](size_t max_length) {
+    std::uniform_int_distribution<size_t> length(0, max_length);
+    std::uniform_int_distribution<int> byte('a', 'd');
+    std::string s(length(rng), '\0');
+    for (char& c : s) c = static_cast<char>(byte(rng));
+    return s;
+  };
+  for (int iter = 0; iter < 300; ++iter) {
+    std::vector<std::string> patterns(1 + iter % 50);
+    for (std::string& pattern : patterns) pattern = random_string(6);
+    const absl::MultiMatcher matcher(patterns);
+    const std::string text = random_string(100);
+
+    for (size_t pos = 0; pos <= text.size(); ++pos) {
+      // The earliest offset, then the longest pattern, then the first index.
+      size_t expected = npos;
+      size_t expected_pattern = 0;
+      for (size_t start = pos; start < text.size() && expected == npos;
+           ++start) {
+        for (size_t i = 0; i < patterns.size(); ++i) {
+          const std::string& p = patterns[i];
+          if (p.empty() ||
+              !absl::StartsWith(absl::string_view(text).substr(start), p)) {
+            continue;
+          }
+          if (expected == npos ||
+              p.size() > patterns[expected_pattern].size()) {
+            expected = start;
+            expected_pattern = i;
+          }
+        }
+      }
+      size_t pattern = 99;
+      ASSERT_EQ(expected, matcher.FindAny(text, pos, &pattern));
+      if (expected != npos) {
+        EXPECT_EQ(expected_pattern, pattern);
+      }
+    }
+  }
+}
+
+}  // namespace
@@ -31,6 +31,7 @@
 #include <utility>
 
 #include "absl/base/internal/bits.h"
+#include "absl/base/internal/endian.h"
 #include "absl/base/internal/raw_logging.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/charconv.h"
@@ -300,6 +301,42 @@ char* numbers_internal::FastIntToBuffer(int64_t i, char* buffer) {
   return numbers_internal::FastIntToBuffer(u, buffer);
 }
 
+char* numbers_internal::FastDigitsToBuffer(uint64_t i, int digits,
+                                           char* buffer) {
+  assert(digits == Base10Digits(i));
+  char* const end = buffer + digits;
+  // Knowing the length, we can fill in the digits from the right, two at a
+  // time. Above 32 bits, one 64-bit division splits off eight digits, which
+  // are then written with 32-bit arithmetic.
+  char* p = end;
+  while (i > std::numeric_limits<uint32_t>::max()) {
+    uint64_t top = i / 100000000;
+    uint32_t low = static_cast<uint32_t>(i - top * 100000000);
+    for (int k = 0; k < 4; ++k) {
+      uint32_t next = low / 100;
+      p -= 2;
+      PutTwoDigits(low - next * 100, p);
+      low = next;
+    }
+    i = top;
+  }
+  uint32_t u32 = static_cast<uint32_t>(i);
+  while (u32 >= 100) {
+    uint32_t top = u32 / 100;
+    p -= 2;
+    PutTwoDigits(u32 - top * 100, p);
+    u32 = top;
+  }
+  if (u32 >= 10) {
+    p -= 2;
+    PutTwoDigits(u32, p);
+  } else {
+    *--p = static_cast<char>('0' + u32);
+  }
+  assert(p == buffer);
+  return end;
+}
+
 // Given a 128-bit number expressed as a pair of uint64_t, high half first,
 // return that number multiplied by the given 32-bit value.  If the result is
 // too large to fit in a 128-bit number, divide it by 2 until it fits.
@@ -633,6 +670,11 @@ size_t numbers_internal::SixDigitsToBuffer(double d, char* const buffer) {
   return out - buffer;
 }
 
+size_t numbers_internal::RoundTripToBuffer(double d, char* const buffer) {
+  return absl::to_chars(buffer, buffer + kRoundTripToBufferSize, d).ptr -
+         buffer;
+}
+
 namespace {
 // Represents integer values of digits.
 // Uses 36 to indicate an invalid character since we support
@@ -780,6 +822,32 @@ const IntType LookupTables<IntType>::kVminOverBase[] =
 
 #undef X_OVER_BASE_INITIALIZER
 
+// Decimal digits are consumed 8 at a time ("SWAR", SIMD within a register)
+// while the value is small enough that this cannot overflow.  The byte-wise
+// loops below then handle the remaining digits, and produce the exact same
+// results as they would on their own for invalid digits and overflow.
+
+// Returns true if the 8 characters packed in little-endian order in `chunk`
+// are all decimal digits.
+inline bool IsEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+
+// Returns the value of the 8 decimal digits packed in little-endian order in
+// `chunk`.
+inline uint32_t ParseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (uint64_t{1000000} << 32);
+  constexpr uint64_t kMul2 = 1 + (uint64_t{10000} << 32);
+  chunk -= 0x3030303030303030;
+  // Combine adjacent digits into pairs, then pairs into the final value.
+  chunk = (chunk * 10) + (chunk >> 8);
+  return static_cast<uint32_t>(
+      (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32);
+}
+
 template <typename IntType>
 inline bool safe_parse_positive_int(absl::string_view text, int base,
                                     IntType* value_p) {
@@ -791,6 +859,15 @@ inline bool safe_parse_positive_int(absl::string_view text, int base,
   const IntType vmax_over_base = LookupTables<IntType>::kVmaxOverBase[base];
   const char* start = text.data();
   const char* end = start + text.size();
+  if (base == 10) {
+    const IntType vmax_over_1e8 = (vmax - 99999999) / 100000000;
+    while (end - start >= 8 && value <= vmax_over_1e8) {
+      const uint64_t chunk = little_endian::Load64(start);
+      if (!IsEightDigits(chunk)) break;
+      value = value * 100000000 + static_cast<IntType>(ParseEightDigits(chunk));
+      start += 8;
+    }
+  }
   // loop over digits
   for (; start < end; ++start) {
     unsigned char c = static_cast<unsigned char>(start[0]);
@@ -832,6 +909,16 @@ inline bool safe_parse_negative_int(absl::string_view text, int base,
   }
   const char* start = text.data();
   const char* end = start + text.size();
+  if (base == 10) {
+    // Division truncates towards zero.
+    const IntType vmin_over_1e8 = (vmin + 99999999) / 100000000;
+    while (end - start >= 8 && value >= vmin_over_1e8) {
+      const uint64_t chunk = little_endian::Load64(start);
+      if (!IsEightDigits(chunk)) break;
+      value = value * 100000000 - static_cast<IntType>(ParseEightDigits(chunk));
+      start += 8;
+    }
+  }
   // loop over digits
   for (; start < end; ++start) {
     unsigned char c = static_cast<unsigned char>(start[0]);
@@ -902,4 +989,29 @@ bool safe_strtou64_base(absl::string_view text, uint64_t* value, int base) {
 }
 }  // namespace numbers_internal
 
+bool ParseIntegers(absl::string_view text, char delimiter,
+                   absl::Span<int64_t> out) {
+  if (text.empty()) return false;
+  const char* start = text.data();
+  const char* const end = start + text.size();
+  for (int64_t& value : out) {
+    const char* field_end = static_cast<const char*>(
+        memchr(start, delimiter, static_cast<size_t>(end - start)));
+    if (field_end == nullptr) {
+      // This is the last field, it must fill the last element of `out`.
+      if (&value != &out.back()) return false;
+      field_end = end;
+    }
+    if (!safe_int_internal<int64_t>(
+            absl::string_view(start, static_cast<size_t>(field_end - start)),
+            &value, 10)) {
+      return false;
+    }
+    if (field_end == end) return true;
+    start = field_end + 1;
+  }
+  // Either `out` is empty, or `text` has more fields than `out` can hold.
+  return false;
+}
+
 }  // namespace absl
@@ -20,7 +20,11 @@
 
 #include "benchmark/benchmark.h"
 #include "absl/base/internal/raw_logging.h"
+#include "absl/strings/internal/numbers_test_common.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+#include "absl/types/span.h"
 
 namespace {
 
@@ -260,4 +264,71 @@ BENCHMARK_TEMPLATE(BM_SimpleAtod, std::string)
     ->ArgPair(10, 4)
     ->ArgPair(10, 8);
 
+void BM_SimpleAtod_RealWorld(benchmark::State& state) {
+  const std::vector<std::string> corpus =
+      absl::strings_internal::RealWorldNumberStrings(1024);
+  double value;
+  for (auto _ : state) {
+    for (const std::string& number : corpus) {
+      benchmark::DoNotOptimize(absl::SimpleAtod(number, &value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_SimpleAtod_RealWorld);
+
+void BM_SimpleAtof_RealWorld(benchmark::State& state) {
+  const std::vector<std::string> corpus =
+      absl::strings_internal::RealWorldNumberStrings(1024);
+  float value;
+  for (auto _ : state) {
+    for (const std::string& number : corpus) {
+      benchmark::DoNotOptimize(absl::SimpleAtof(number, &value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_SimpleAtof_RealWorld);
+
+// Returns `count` comma-separated integers whose width is spread evenly between
+// 1 and 19 digits, as in typical CSV id, count and timestamp columns.
+std::string MakeIntegerList(int count) {
+  std::minstd_rand0 rng(1);
+  std::vector<int64_t> values;
+  for (int i = 0; i < count; ++i) {
+    int64_t value = 0;
+    for (int digits = 1 + i % 19; digits > 0; --digits) {
+      value = value * 10 + static_cast<int64_t>(rng() % 10);
+    }
+    values.push_back(i % 2 ? -value : value);
+  }
+  return absl::StrJoin(values, ",");
+}
+
+void BM_ParseIntegers(benchmark::State& state) {
+  const std::string text = MakeIntegerList(state.range(0));
+  std::vector<int64_t> values(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::ParseIntegers(text, ',', absl::MakeSpan(values)));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_ParseIntegers)->Arg(16)->Arg(1024);
+
+void BM_SplitAndSimpleAtoi(benchmark::State& state) {
+  const std::string text = MakeIntegerList(state.range(0));
+  std::vector<int64_t> values(state.range(0));
+  for (auto _ : state) {
+    size_t i = 0;
+    for (absl::string_view field : absl::StrSplit(text, ',')) {
+      benchmark::DoNotOptimize(absl::SimpleAtoi(field, &values[i++]));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_SplitAndSimpleAtoi)->Arg(16)->Arg(1024);
+
 }  // namespace
@@ -245,6 +245,36 @@ TEST(Numbers, TestFastPrints) {
   CheckHex64(uint64_t{0x123456789abcdef0});
 }
 
+void CheckDigits(uint64_t x) {
+  const std::string expected = std::to_string(x);
+  const int digits = absl::numbers_internal::Base10Digits(x);
+  ASSERT_EQ(expected.size(), digits) << " Input " << x;
+  char buffer[22];
+  buffer[0] = '*';
+  buffer[digits + 1] = '*';
+  char* actual =
+      absl::numbers_internal::FastDigitsToBuffer(x, digits, &buffer[1]);
+  EXPECT_EQ(expected, std::string(&buffer[1], actual)) << " Input " << x;
+  EXPECT_EQ(buffer[0], '*');
+  EXPECT_EQ(buffer[digits + 1], '*');
+}
+
+TEST(Numbers, FastDigitsToBuffer) {
+  for (int i = 0; i <= 1000; i++) CheckDigits(i);
+  // Both sides of every power of ten.
+  uint64_t p = 1;
+  for (int n = 1; n <= 19; n++) {
+    p *= 10;
+    CheckDigits(p - 1);
+    CheckDigits(p);
+    CheckDigits(p + 1);
+  }
+  CheckDigits(std::numeric_limits<uint32_t>::max());
+  CheckDigits(uint64_t{std::numeric_limits<uint32_t>::max()} + 1);
+  CheckDigits(uint64_t{1199999999999999999});
+  CheckDigits(std::numeric_limits<uint64_t>::max());
+}
+
 template <typename int_type, typename in_val_type>
 void VerifySimpleAtoiGood(in_val_type in_value, int_type exp_value) {
   std::string s = absl::StrCat(in_value);
@@ -335,6 +365,37 @@ TEST(NumbersTest, Atoi) {
   VerifySimpleAtoiGood<std::string::size_type>(42, 42);
 }
 
+TEST(NumbersTest, ParseIntegers) {
+  int64_t values[4];
+  EXPECT_TRUE(absl::ParseIntegers("1,-2,30,400", ',', absl::MakeSpan(values)));
+  EXPECT_THAT(values, testing::ElementsAre(1, -2, 30, 400));
+
+  EXPECT_TRUE(absl::ParseIntegers(" 9223372036854775807\t|-9223372036854775808 "
+                                  "|0012345678901234567|+7",
+                                  '|', absl::MakeSpan(values)));
+  EXPECT_THAT(values, testing::ElementsAre(
+                          std::numeric_limits<int64_t>::max(),
+                          std::numeric_limits<int64_t>::min(),
+                          int64_t{12345678901234567}, 7));
+
+  EXPECT_TRUE(absl::ParseIntegers("42", ',', absl::MakeSpan(values, 1)));
+  EXPECT_EQ(values[0], 42);
+
+  // Wrong number of fields.
+  EXPECT_FALSE(absl::ParseIntegers("1,2,3", ',', absl::MakeSpan(values)));
+  EXPECT_FALSE(absl::ParseIntegers("1,2,3,4,5", ',', absl::MakeSpan(values)));
+  EXPECT_FALSE(absl::ParseIntegers("1,2,3,4,", ',', absl::MakeSpan(values)));
+  EXPECT_FALSE(absl::ParseIntegers("", ',', absl::MakeSpan(values, 0)));
+  EXPECT_FALSE(absl::ParseIntegers("1", ',', absl::MakeSpan(values, 0)));
+
+  // Invalid fields.
+  EXPECT_FALSE(absl::ParseIntegers("", ',', absl::MakeSpan(values, 1)));
+  EXPECT_FALSE(absl::ParseIntegers("1,,3,4", ',', absl::MakeSpan(values)));
+  EXPECT_FALSE(absl::ParseIntegers("1,2,3,4x", ',', absl::MakeSpan(values)));
+  EXPECT_FALSE(absl::ParseIntegers("1,2,3,9223372036854775808", ',',
+                                   absl::MakeSpan(values)));
+}
+
 TEST(NumbersTest, Atoenum) {
   enum E01 {
     E01_zero = 0,
@@ -656,6 +717,114 @@ TEST(stringtest, safe_strtou64_random) {
   test_random_integer_parse_base<uint64_t>(&safe_strtou64_base);
 }
 
+// Parses decimal digit strings one character at a time, with the same results
+// (including the partial value on failure) as safe_strto*_base().
+template <typename IntType>
+bool ReferenceDecimalParse(absl::string_view text, IntType* value) {
+  bool negative = false;
+  if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+    negative = text[0] == '-';
+    text.remove_prefix(1);
+  }
+  if (text.empty()) {
+    *value = 0;
+    return false;
+  }
+  if (negative && std::numeric_limits<IntType>::min() == 0) {
+    *value = 0;
+    return false;
+  }
+  const uint64_t limit =
+      negative
+          ? uint64_t{0} -
+                static_cast<uint64_t>(std::numeric_limits<IntType>::min())
+          : static_cast<uint64_t>(std::numeric_limits<IntType>::max());
+  absl::uint128 magnitude = 0;
+  for (char c : text) {
+    if (c < '0' || c > '9') {
+      *value = negative ? static_cast<IntType>(0 - magnitude)
+                        : static_cast<IntType>(magnitude);
+      return false;
+    }
+    magnitude = magnitude * 10 + static_cast<uint64_t>(c - '0');
+    if (magnitude > limit) {
+      *value = negative ? std::numeric_limits<IntType>::min()
+                        : std::numeric_limits<IntType>::max();
+      return false;
+    }
+  }
+  *value = negative ? static_cast<IntType>(0 - magnitude)
+                    : static_cast<IntType>(magnitude);
+  return true;
+}
+
+// Decimal parsing consumes 8 digits at a time; check long inputs, inputs near
+// the overflow boundary, and invalid characters at every position.
+template <typename IntType>
+void test_random_decimal_parse(bool (*parse_func)(absl::string_view,
+                                                  IntType* value, int base)) {
+  std::minstd_rand0 rng(std::random_device{}());
+  std::uniform_int_distribution<int> random_digit('0', '9');
+  const std::string max_str = absl::StrCat(std::numeric_limits<IntType>::max());
+  const std::string min_str = absl::StrCat(std::numeric_limits<IntType>::min());
+  for (size_t i = 0; i < kNumRandomTests; i++) {
+    std::string str;
+    switch (rng() % 4) {
+      case 0:
+        str = max_str;
+        break;
+      case 1:
+        str = min_str;
+        break;
+      default:
+        if (rng() % 2) str = "-";
+        str.append(rng() % 26, '0');
+        for (size_t len = 1 + rng() % 24; len > 0; --len) {
+          str.push_back(static_cast<char>(random_digit(rng)));
+        }
+    }
+    // Perturb a digit near the boundary values, or corrupt one character.
+    if (!str.empty()) {
+      size_t pos = rng() % str.size();
+      switch (rng() % 4) {
+        case 0:
+          if (str[pos] >= '0' && str[pos] <= '9') {
+            str[pos] = static_cast<char>(random_digit(rng));
+          }
+          break;
+        case 1:
+          str[pos] = "/:a.\0"[rng() % 5];
+          break;
+        case 2:
+          str.push_back(static_cast<char>(random_digit(rng)));
+          break;
+      }
+    }
+    IntType expected_value;
+    bool expected = ReferenceDecimalParse(str, &expected_value);
+    IntType value;
+    EXPECT_EQ(expected, parse_func(str, &value, 10)) << str;
+    EXPECT_EQ(expected_value, value) << str;
+    EXPECT_EQ(expected, absl::SimpleAtoi(str, &value)) << str;
+    if (expected) {
+      EXPECT_EQ(expected_value, value) << str;
+    }
+  }
+}
+
+TEST(stringtest, safe_strto32_random_decimal) {
+  test_random_decimal_parse<int32_t>(&safe_strto32_base);
+}
+TEST(stringtest, safe_strto64_random_decimal) {
+  test_random_decimal_parse<int64_t>(&safe_strto64_base);
+}
+TEST(stringtest, safe_strtou32_random_decimal) {
+  test_random_decimal_parse<uint32_t>(&safe_strtou32_base);
+}
+TEST(stringtest, safe_strtou64_random_decimal) {
+  test_random_decimal_parse<uint64_t>(&safe_strtou64_base);
+}
+
 TEST(stringtest, safe_strtou32_base) {
   for (int i = 0; strtouint32_test_cases()[i].str != nullptr; ++i) {
     const auto& e = strtouint32_test_cases()[i];
@@ -42,6 +42,8 @@
 //
 // Floating point numbers are formatted with six-digit precision, which is
 // the default for "std::cout <<" or printf "%g" (the same as "%.6g").
+// Use `RoundTrip()` to format them with the fewest digits that preserve the
+// exact value instead.
 //
 // You can convert to hexadecimal output rather than decimal output using the
 // `Hex` type contained here. To do so, pass `Hex(my_int)` as a parameter to
@@ -400,6 +402,19 @@ SixDigits(double d) {
   return result;
 }
 
+// Helper function for formatting a floating-point value with the fewest
+// digits that read back as exactly the same value, unlike the default
+// six-digit precision.  For example, `StrCat(RoundTrip(0.1 + 0.2))` returns
+// "0.30000000000000004", and `StrCat(RoundTrip(1e100))` returns "1e+100".
+inline strings_internal::AlphaNumBuffer<
+    numbers_internal::kRoundTripToBufferSize>
+RoundTrip(double d) {
+  strings_internal::AlphaNumBuffer<numbers_internal::kRoundTripToBufferSize>
+      result;
+  result.size = numbers_internal::RoundTripToBuffer(d, &result.data[0]);
+  return result;
+}
+
 }  // namespace absl
 
 #endif  // ABSL_STRINGS_STR_CAT_H_
@@ -190,6 +190,15 @@ TEST(StrCat, Basics) {
       absl::StrCat("A hundred K and a half squared is ", absl::SixDigits(d));
   EXPECT_EQ(result, "A hundred K and a half squared is 1.00001e+10");
 
+  result = absl::StrCat("A hundred K and a half squared is ",
+                        absl::RoundTrip(d));
+  EXPECT_EQ(result, "A hundred K and a half squared is 10000100000.25");
+
+  result = absl::StrCat(absl::RoundTrip(0.1 + 0.2), " ",
+                        absl::RoundTrip(-1e100), " ",
+                        absl::RoundTrip(-2.2250738585072014e-308));
+  EXPECT_EQ(result, "0.30000000000000004 -1e+100 -2.2250738585072014e-308");
+
   result = absl::StrCat(1, 2, 333, 4444, 55555, 666666, 7777777, 88888888,
                         999999999);
   EXPECT_EQ(result, "12333444455555666666777777788888888999999999");
@@ -78,8 +78,10 @@
 #include "absl/strings/internal/str_format/arg.h"  // IWYU pragma: export
 #include "absl/strings/internal/str_format/bind.h"  // IWYU pragma: export
 #include "absl/strings/internal/str_format/checker.h"  // IWYU pragma: export
+#include "absl/strings/internal/str_format/compiled.h"  // IWYU pragma: export
 #include "absl/strings/internal/str_format/extension.h"  // IWYU pragma: export
 #include "absl/strings/internal/str_format/parser.h"  // IWYU pragma: export
+#include "absl/strings/string_builder.h"
 
 namespace absl {
 
@@ -335,6 +337,61 @@ std::string& StrAppendFormat(std::string* dst,
       {str_format_internal::FormatArgImpl(args)...});
 }
 
+// Appends to an `absl::StringBuilder` in the same way. Appends nothing in case
+// of error.
+template <typename... Args>
+StringBuilder& StrAppendFormat(StringBuilder* dst,
+                               const FormatSpec<Args...>& format,
+                               const Args&... args) {
+  return str_format_internal::AppendPack(
+      dst, str_format_internal::UntypedFormatSpecImpl::Extract(format),
+      {str_format_internal::FormatArgImpl(args)...});
+}
+
+// ABSL_COMPILED_FORMAT()
+//
+// Wraps a string literal format so that `StrFormat()` and `StrAppendFormat()`
+// expand it at compile time into code specialized for that call site: literal
+// text is appended directly and each conversion is dispatched statically on
+// its argument type, without parsing the format or type-erasing the arguments
+// at runtime. Basic `%s`, `%d`, `%i`, `%u` and `%c` conversions of strings and
+// integers are nearly as fast as `absl::StrCat()`.
+//
+// The format is checked against the arguments at compile time on all
+// compilers, and supports the same syntax as a `FormatSpec`, including
+// positional arguments and `*` widths and precisions. The output is identical
+// to that of the corresponding `FormatSpec` call.
+//
+// Each use instantiates its own code, so reserve this for formatting in hot
+// loops; a `ParsedFormat` is a better fit when code size matters.
+//
+// Example:
+//
+//   std::string s = absl::StrFormat(ABSL_COMPILED_FORMAT("%s:%d"), host, port);
+#define ABSL_COMPILED_FORMAT(format)                                    \
+  ([] {                                                                 \
+    struct AbslCompiledFormat {                                         \
+      static constexpr ::absl::string_view Get() { return format; }     \
+    };                                                                  \
+    return ::absl::str_format_internal::CompiledFormat<                 \
+        AbslCompiledFormat>();                                          \
+  }())
+
+template <typename Format, typename... Args>
+ABSL_MUST_USE_RESULT std::string StrFormat(
+    const str_format_internal::CompiledFormat<Format>&, const Args&... args) {
+  std::string out;
+  str_format_internal::AppendCompiled<Format>(&out, args...);
+  return out;
+}
+
+template <typename Format, typename... Args>
+std::string& StrAppendFormat(std::string* dst,
+                             const str_format_internal::CompiledFormat<Format>&,
+                             const Args&... args) {
+  return str_format_internal::AppendCompiled<Format>(dst, args...);
+}
+
 // StreamFormat()
 //
 // Writes to an output stream given a format string and zero or more arguments,
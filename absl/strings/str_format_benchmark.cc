@@ -0,0 +1,162 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/str_format.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+// Doubles of the magnitudes typical for metrics, with full mantissas.
+const std::vector<double>& MetricValues() {
+  static const std::vector<double>* values = [] {
+    auto* v = new std::vector<double>;
+    uint64_t bits = 0x9e3779b97f4a7c15;
+    for (int i = 0; i < 1024; ++i) {
+      bits = bits * 6364136223846793005u + 1442695040888963407u;
+      v->push_back(std::ldexp(static_cast<double>(bits >> 11),
+                              static_cast<int>(bits % 80) - 90));
+    }
+    return v;
+  }();
+  return *values;
+}
+
+// Doubles across the whole exponent range, most of which do not fit the fixed
+// width integer arithmetic.
+const std::vector<double>& ExtremeValues() {
+  static const std::vector<double>* values = [] {
+    auto* v = new std::vector<double>;
+    uint64_t bits = 0x9e3779b97f4a7c15;
+    for (int i = 0; i < 1024; ++i) {
+      bits = bits * 6364136223846793005u + 1442695040888963407u;
+      v->push_back(std::ldexp(static_cast<double>(bits >> 12),
+                              static_cast<int>(bits % 2000) - 1000));
+    }
+    return v;
+  }();
+  return *values;
+}
+
+using ValuesFn = const std::vector<double>& (*)();
+
+void BM_StrFormatDouble(benchmark::State& state, const char* fmt,
+                        ValuesFn values_fn) {
+  const std::vector<double>& values = values_fn();
+  const absl::UntypedFormatSpec format(fmt);
+  std::string out;
+  size_t i = 0;
+  for (auto _ : state) {
+    out.clear();
+    benchmark::DoNotOptimize(absl::FormatUntyped(
+        &out, format, {absl::FormatArg(values[i++ % values.size()])}));
+    benchmark::DoNotOptimize(out);
+  }
+}
+
+void BM_SnprintfDouble(benchmark::State& state, const char* fmt,
+                       ValuesFn values_fn) {
+  const std::vector<double>& values = values_fn();
+  char buf[2048];
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        snprintf(buf, sizeof(buf), fmt, values[i++ % values.size()]));
+  }
+}
+
+#define FLOAT_FORMAT_BENCHMARKS(name, fmt, values)              \
+  BENCHMARK_CAPTURE(BM_StrFormatDouble, name, fmt, values);    \
+  BENCHMARK_CAPTURE(BM_SnprintfDouble, name, fmt, values)
+
+FLOAT_FORMAT_BENCHMARKS(g, "%g", MetricValues);
+FLOAT_FORMAT_BENCHMARKS(g17, "%.17g", MetricValues);
+FLOAT_FORMAT_BENCHMARKS(e, "%e", MetricValues);
+FLOAT_FORMAT_BENCHMARKS(f, "%f", MetricValues);
+FLOAT_FORMAT_BENCHMARKS(a, "%a", MetricValues);
+FLOAT_FORMAT_BENCHMARKS(extreme_g, "%g", ExtremeValues);
+FLOAT_FORMAT_BENCHMARKS(extreme_g17, "%.17g", ExtremeValues);
+FLOAT_FORMAT_BENCHMARKS(extreme_f, "%f", ExtremeValues);
+
+// A typical log line: mostly literal text, strings and small integers.
+constexpr absl::string_view kFile = "server/handler.cc";
+constexpr absl::string_view kMethod = "GetUserProfile";
+
+void BM_LogLine_StrFormat(benchmark::State& state) {
+  int line = 0;
+  for (auto _ : state) {
+    ++line;
+    benchmark::DoNotOptimize(
+        absl::StrFormat("%s:%d: %s took %dus (status %d)", kFile, line,
+                        kMethod, line * 7, 200));
+  }
+}
+BENCHMARK(BM_LogLine_StrFormat);
+
+void BM_LogLine_CompiledFormat(benchmark::State& state) {
+  int line = 0;
+  for (auto _ : state) {
+    ++line;
+    benchmark::DoNotOptimize(absl::StrFormat(
+        ABSL_COMPILED_FORMAT("%s:%d: %s took %dus (status %d)"), kFile, line,
+        kMethod, line * 7, 200));
+  }
+}
+BENCHMARK(BM_LogLine_CompiledFormat);
+
+void BM_LogLine_StrCat(benchmark::State& state) {
+  int line = 0;
+  for (auto _ : state) {
+    ++line;
+    benchmark::DoNotOptimize(absl::StrCat(kFile, ":", line, ": ", kMethod,
+                                          " took ", line * 7, "us (status ",
+                                          200, ")"));
+  }
+}
+BENCHMARK(BM_LogLine_StrCat);
+
+// Padded columns and a float, which still go through FormatConvertImpl() but
+// skip parsing and type erasure.
+void BM_Table_StrFormat(benchmark::State& state) {
+  const std::vector<double>& values = MetricValues();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::StrFormat("%-20s|%8d|%10.3f", kMethod, i,
+                                             values[i % values.size()]));
+    ++i;
+  }
+}
+BENCHMARK(BM_Table_StrFormat);
+
+void BM_Table_CompiledFormat(benchmark::State& state) {
+  const std::vector<double>& values = MetricValues();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::StrFormat(ABSL_COMPILED_FORMAT("%-20s|%8d|%10.3f"), kMethod, i,
+                        values[i % values.size()]));
+    ++i;
+  }
+}
+BENCHMARK(BM_Table_CompiledFormat);
+
+}  // namespace
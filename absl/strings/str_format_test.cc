@@ -2,6 +2,7 @@
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
+#include <limits>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -232,6 +233,82 @@ TEST_F(FormatEntryPointTest, FormatStreamed) {
   EXPECT_EQ("123", StrFormat("%s", FormatStreamed(StreamFormat("%d", 123))));
 }
 
+// Checks that a compiled format gives the same result as the runtime one.
+#define EXPECT_COMPILED_FORMAT_EQ(format, ...)                        \
+  EXPECT_EQ(StrFormat(format, __VA_ARGS__),                            \
+            StrFormat(ABSL_COMPILED_FORMAT(format), __VA_ARGS__))
+
+TEST_F(FormatEntryPointTest, CompiledFormat) {
+  EXPECT_EQ("", StrFormat(ABSL_COMPILED_FORMAT("")));
+  EXPECT_EQ("no args 100%", StrFormat(ABSL_COMPILED_FORMAT("no args 100%%")));
+  EXPECT_EQ("example.com:8080",
+            StrFormat(ABSL_COMPILED_FORMAT("%s:%d"), "example.com", 8080));
+
+  const std::string str = "string";
+  const absl::string_view view = "view";
+  const char* null_str = nullptr;
+  EXPECT_COMPILED_FORMAT_EQ("%s %s %s %s|", str, view, "literal", null_str);
+  EXPECT_COMPILED_FORMAT_EQ("%d %i %u %c", 1, -2, 3u, 'x');
+  EXPECT_COMPILED_FORMAT_EQ("%d %u %c %d", 'a', -1, 65, true);
+  EXPECT_COMPILED_FORMAT_EQ("%hhd %hu %ld %llu", static_cast<signed char>(-5),
+                            static_cast<short>(-1),  // NOLINT
+                            std::numeric_limits<int64_t>::min(),
+                            std::numeric_limits<uint64_t>::max());
+  EXPECT_COMPILED_FORMAT_EQ("%i %u", std::numeric_limits<uint64_t>::max(),
+                            std::numeric_limits<int32_t>::min());
+  EXPECT_COMPILED_FORMAT_EQ("[%5d] [%-5d] [%05d] [%+d] [% d] [%.3d]", 42, 42,
+                            42, 42, 42, 42);
+  EXPECT_COMPILED_FORMAT_EQ("[%10s] [%-10s] [%.2s] [%3c]", str, view, "abc",
+                            'z');
+  EXPECT_COMPILED_FORMAT_EQ("%x %X %#o %#x %p", 255, 255u, 8, 0,
+                            static_cast<const void*>(&str));
+  EXPECT_COMPILED_FORMAT_EQ("%f %.3e %g %a %10.4F", 1.5, 12345.678, 0.0001,
+                            1.0, -2.25f);
+  EXPECT_COMPILED_FORMAT_EQ("%s %d", FormatStreamed(streamed_test::X()),
+                            uint128(1) << 100);
+
+  // '*' width and precision, including a negative width.
+  EXPECT_COMPILED_FORMAT_EQ("[%*d] [%*d] [%.*f] [%*.*s]", 6, 1, -6, 2, 2, 0.5,
+                            5, 2, "abcdef");
+
+  // Positional arguments.
+  EXPECT_COMPILED_FORMAT_EQ("%2$s %1$d %2$s", 7, "x");
+  EXPECT_COMPILED_FORMAT_EQ("%1$*2$.*3$f|%2$d", 3.14159, 10, 2);
+  EXPECT_COMPILED_FORMAT_EQ("%3$d", 1, 2, 3);
+
+  int n = 0;
+  EXPECT_EQ("hello123",
+            StrFormat(ABSL_COMPILED_FORMAT("%s%d%n"), "hello", 123,
+                      FormatCountCapture(&n)));
+  EXPECT_EQ(8, n);
+}
+
+struct FailingStreamable {};
+std::ostream& operator<<(std::ostream& os, const FailingStreamable&) {
+  os.setstate(std::ios_base::failbit);
+  return os;
+}
+
+TEST_F(FormatEntryPointTest, CompiledAppendFormat) {
+  std::string s = "orig";
+  std::string& r = StrAppendFormat(&s, ABSL_COMPILED_FORMAT(" %d %s"), 1, "a");
+  EXPECT_EQ(&s, &r);
+  EXPECT_EQ("orig 1 a", s);
+
+  // Appends nothing in case of error.
+  StrAppendFormat(&s, ABSL_COMPILED_FORMAT(" more %s"),
+                  FormatStreamed(FailingStreamable()));
+  EXPECT_EQ("orig 1 a", s);
+  EXPECT_EQ("", StrFormat(ABSL_COMPILED_FORMAT("%d%s"), 1,
+                          FormatStreamed(FailingStreamable())));
+
+  // Longer than the sink's internal buffer.
+  const std::string long_str(3000, 'x');
+  EXPECT_COMPILED_FORMAT_EQ("%s|%s|%d", long_str, long_str, 1);
+}
+
+#undef EXPECT_COMPILED_FORMAT_EQ
+
 // Helper class that creates a temporary file and exposes a FILE* to it.
 // It will close the file on destruction.
 class TempFile {
@@ -15,6 +15,7 @@
 
 #include "absl/strings/str_join.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <utility>
@@ -54,6 +55,46 @@ void BM_Join2_Ints(benchmark::State& state) {
 }
 BENCHMARK(BM_Join2_Ints)->Range(0, 1 << 13);
 
+// Values spread over all magnitudes, as in a column of ids or timestamps.
+std::vector<int64_t> MixedInt64s(int n) {
+  std::vector<int64_t> v;
+  v.reserve(n);
+  uint64_t x = 0x9e3779b97f4a7c15;
+  for (int i = 0; i < n; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    v.push_back(static_cast<int64_t>(x) >> (x % 64));
+  }
+  return v;
+}
+
+void BM_Join2_Int64s(benchmark::State& state) {
+  const std::vector<int64_t> v = MixedInt64s(state.range(0));
+  size_t bytes = 0;
+  for (auto _ : state) {
+    std::string s = absl::StrJoin(v, ",");
+    bytes = s.size();
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_Join2_Int64s)->Range(1, 1 << 13);
+
+// The same range joined through AlphaNum, as StrJoin did before ranges of
+// integers got their own path.
+void BM_Join2_Int64sAlphaNum(benchmark::State& state) {
+  const std::vector<int64_t> v = MixedInt64s(state.range(0));
+  size_t bytes = 0;
+  for (auto _ : state) {
+    std::string s = absl::StrJoin(v, ",", absl::AlphaNumFormatter());
+    bytes = s.size();
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_Join2_Int64sAlphaNum)->Range(1, 1 << 13);
+
 void BM_Join2_KeysAndValues(benchmark::State& state) {
   const int string_len = state.range(0);
   const int num_pairs = state.range(1);
@@ -21,9 +21,13 @@
 #include <cstdio>
 #include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <set>
+#include <sstream>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -425,6 +429,54 @@ TEST(StrJoin, InitializerList) {
   }
 }
 
+TEST(StrJoin, Integers) {
+  // Ranges of integers are formatted without going through AlphaNum, so check
+  // them against it.
+  const std::vector<int64_t> v64 = {0,
+                                    -1,
+                                    9,
+                                    10,
+                                    -99,
+                                    100,
+                                    std::numeric_limits<int64_t>::min(),
+                                    std::numeric_limits<int64_t>::max(),
+                                    int64_t{4294967296},
+                                    int64_t{-4294967295}};
+  std::string expected;
+  for (int64_t i : v64) {
+    absl::StrAppend(&expected, expected.empty() ? "" : ", ", i);
+  }
+  EXPECT_EQ(expected, absl::StrJoin(v64, ", "));
+
+  const std::vector<uint64_t> u64 = {0, 42,
+                                     std::numeric_limits<uint64_t>::max()};
+  EXPECT_EQ("0,42,18446744073709551615", absl::StrJoin(u64, ","));
+
+  const std::vector<int> empty;
+  EXPECT_EQ("", absl::StrJoin(empty, ","));
+  EXPECT_EQ("-7", absl::StrJoin(std::vector<int>{-7}, ","));
+  EXPECT_EQ("1234", absl::StrJoin(std::vector<int>{1, 2, 3, 4}, ""));
+
+  const std::vector<int8_t> small = {-128, 0, 127};
+  EXPECT_EQ("-128 0 127", absl::StrJoin(small, " "));
+  const std::vector<uint8_t> bytes = {0, 255};
+  EXPECT_EQ("0 255", absl::StrJoin(bytes, " "));
+  const std::vector<int16_t> shorts = {std::numeric_limits<int16_t>::min()};
+  EXPECT_EQ("-32768", absl::StrJoin(shorts, " "));
+
+  // Non-forward ranges take the generic path.
+  std::istringstream in("1 -2 3");
+  EXPECT_EQ("1|-2|3",
+            absl::StrJoin(std::istream_iterator<int>(in),
+                          std::istream_iterator<int>(), "|"));
+
+  // Other forward ranges, such as a std::set and an array.
+  const std::set<long> s = {3, -1, 2};  // NOLINT(runtime/int)
+  EXPECT_EQ("-1,2,3", absl::StrJoin(s, ","));
+  const unsigned a[] = {7, 8, 9};
+  EXPECT_EQ("7.8.9", absl::StrJoin(a, "."));
+}
+
 TEST(StrJoin, Tuple) {
   EXPECT_EQ("", absl::StrJoin(std::make_tuple(), "-"));
   EXPECT_EQ("hello", absl::StrJoin(std::make_tuple("hello"), "-"));
@@ -14,6 +14,7 @@
 
 #include "absl/strings/str_replace.h"
 
+#include "absl/strings/internal/aho_corasick.h"
 #include "absl/strings/str_cat.h"
 
 namespace absl {
@@ -57,8 +58,78 @@ int ApplySubstitutions(
   return substitutions;
 }
 
+namespace {
+
+// Applies the replacements found by `searcher` to `s`, appending the result to
+// *result_ptr. `replacements[i].second` is the replacement for the searcher's
+// i'th pattern. Returns the number of substitutions that occurred.
+template <typename Replacements>
+int ApplySearcher(absl::string_view s, const AhoCorasick& searcher,
+                  const Replacements& replacements, std::string* result_ptr) {
+  int substitutions = 0;
+  size_t pos = 0;
+  size_t offset;
+  size_t pattern;
+  while (searcher.Find(s, pos, &offset, &pattern)) {
+    StrAppend(result_ptr, s.substr(pos, offset - pos),
+              replacements[pattern].second);
+    pos = offset + searcher.pattern_length(pattern);
+    substitutions += 1;
+  }
+  result_ptr->append(s.data() + pos, s.size() - pos);
+  return substitutions;
+}
+
+template <typename Replacements>
+std::vector<absl::string_view> Keys(const Replacements& replacements) {
+  std::vector<absl::string_view> keys;
+  keys.reserve(replacements.size());
+  for (const auto& rep : replacements) keys.emplace_back(rep.first);
+  return keys;
+}
+
+}  // namespace
+
+int ApplyReplacementsInOnePass(
+    absl::string_view s,
+    const std::vector<std::pair<absl::string_view, absl::string_view>>&
+        replacements,
+    std::string* result_ptr) {
+  AhoCorasick searcher(Keys(replacements));
+  return ApplySearcher(s, searcher, replacements, result_ptr);
+}
+
 }  // namespace strings_internal
 
+StrReplacer::StrReplacer(strings_internal::FixedMapping replacements) {
+  for (const auto& rep : replacements) {
+    replacements_.emplace_back(std::string(rep.first),
+                               std::string(rep.second));
+  }
+  Build();
+}
+
+void StrReplacer::Build() {
+  searcher_ =
+      strings_internal::AhoCorasick(strings_internal::Keys(replacements_));
+}
+
+std::string StrReplacer::Replace(absl::string_view s) const {
+  std::string result;
+  result.reserve(s.size());
+  strings_internal::ApplySearcher(s, searcher_, replacements_, &result);
+  return result;
+}
+
+int StrReplacer::Replace(std::string* target) const {
+  std::string result;
+  result.reserve(target->size());
+  int substitutions = strings_internal::ApplySearcher(*target, searcher_,
+                                                      replacements_, &result);
+  if (substitutions != 0) target->swap(result);
+  return substitutions;
+}
+
 // We can implement this in terms of the generic StrReplaceAll, but
 // we must specify the template overload because C++ cannot deduce the type
 // of an initializer_list parameter to a function, and also if we don't specify
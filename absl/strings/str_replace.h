@@ -25,7 +25,8 @@
 // one substitution is being performed, or when substitution is rare.
 //
 // If the string being modified is known at compile-time, and the substitutions
-// vary, `absl::Substitute()` may be a better choice.
+// vary, `absl::Substitute()` may be a better choice. If the same replacements
+// are applied to many strings, `absl::StrReplacer` prepares them once.
 //
 // Example:
 //
@@ -38,11 +39,14 @@
 #ifndef ABSL_STRINGS_STR_REPLACE_H_
 #define ABSL_STRINGS_STR_REPLACE_H_
 
+#include <cstddef>
+#include <initializer_list>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/strings/internal/aho_corasick.h"
 #include "absl/strings/string_view.h"
 
 namespace absl {
@@ -54,7 +58,12 @@ namespace absl {
 // considered in order as they occur within the string, with earlier matches
 // taking precedence, and longer matches taking precedence for candidates
 // starting at the same position in the string. Once a substitution is made, the
-// replaced text is not considered for any further substitutions.
+// replaced text is not considered for any further substitutions. If the same
+// key is given more than once, which of its replacements is used is
+// unspecified.
+//
+// The cost is roughly proportional to the length of the string for any number
+// of replacements, so long lists of replacements are fine.
 //
 // Example:
 //
@@ -129,6 +138,57 @@ int StrReplaceAll(
 template <typename StrToStrMapping>
 int StrReplaceAll(const StrToStrMapping& replacements, std::string* target);
 
+// StrReplacer
+//
+// A set of replacements prepared once to be applied to many strings, with the
+// same semantics as `StrReplaceAll()`. Each call costs time proportional to the
+// length of the string, independent of the number of replacements. If the same
+// key is given more than once, its first replacement is used.
+//
+// A `StrReplacer` keeps its own copies of the keys and replacements, and is
+// thread-compatible: concurrent calls to its const methods are safe.
+//
+// Example:
+//
+//   static const absl::StrReplacer* const kHtmlEscaper =
+//       new absl::StrReplacer({{"&", "&amp;"},
+//                              {"<", "&lt;"},
+//                              {">", "&gt;"},
+//                              {"\"", "&quot;"},
+//                              {"'", "&#39;"}});
+//   std::string html_escaped = kHtmlEscaper->Replace(user_input);
+class StrReplacer {
+ public:
+  explicit StrReplacer(
+      std::initializer_list<std::pair<absl::string_view, absl::string_view>>
+          replacements);
+
+  // Accepts a container of key/value pairs, like `StrReplaceAll()`.
+  template <typename StrToStrMapping>
+  explicit StrReplacer(const StrToStrMapping& replacements) {
+    for (const auto& rep : replacements) {
+      using std::get;
+      absl::string_view old(get<0>(rep));
+      absl::string_view replacement(get<1>(rep));
+      replacements_.emplace_back(std::string(old), std::string(replacement));
+    }
+    Build();
+  }
+
+  // Returns a copy of `s` with the replacements applied.
+  ABSL_MUST_USE_RESULT std::string Replace(absl::string_view s) const;
+
+  // Applies the replacements to `*target` in place, returning the number of
+  // substitutions that occurred.
+  int Replace(std::string* target) const;
+
+ private:
+  void Build();
+
+  std::vector<std::pair<std::string, std::string>> replacements_;
+  strings_internal::AhoCorasick searcher_;
+};
+
 // Implementation details only, past this point.
 namespace strings_internal {
 
@@ -187,13 +247,48 @@ int ApplySubstitutions(absl::string_view s,
                        std::vector<ViableSubstitution>* subs_ptr,
                        std::string* result_ptr);
 
+// Whether StrReplaceAll() should build an automaton that finds all of the
+// replacements in a single pass, rather than searching for each one
+// separately. Building it only pays off for more than a handful of
+// replacements in a string that is not too short.
+inline bool FindReplacementsInOnePass(size_t num_replacements, size_t length) {
+  return num_replacements > 8 && length >= 256;
+}
+
+// Applies `replacements` to `s` with an AhoCorasick automaton, appending the
+// result to `*result_ptr`. Returns the number of substitutions that occurred.
+int ApplyReplacementsInOnePass(
+    absl::string_view s,
+    const std::vector<std::pair<absl::string_view, absl::string_view>>&
+        replacements,
+    std::string* result_ptr);
+
+template <typename StrToStrMapping>
+std::vector<std::pair<absl::string_view, absl::string_view>> ReplacementViews(
+    const StrToStrMapping& replacements) {
+  std::vector<std::pair<absl::string_view, absl::string_view>> views;
+  views.reserve(replacements.size());
+  for (const auto& rep : replacements) {
+    using std::get;
+    views.emplace_back(get<0>(rep), get<1>(rep));
+  }
+  return views;
+}
+
 }  // namespace strings_internal
 
 template <typename StrToStrMapping>
 std::string StrReplaceAll(absl::string_view s,
                           const StrToStrMapping& replacements) {
-  auto subs = strings_internal::FindSubstitutions(s, replacements);
   std::string result;
+  if (strings_internal::FindReplacementsInOnePass(replacements.size(),
+                                                  s.size())) {
+    result.reserve(s.size());
+    strings_internal::ApplyReplacementsInOnePass(
+        s, strings_internal::ReplacementViews(replacements), &result);
+    return result;
+  }
+  auto subs = strings_internal::FindSubstitutions(s, replacements);
   result.reserve(s.size());
   strings_internal::ApplySubstitutions(s, &subs, &result);
   return result;
@@ -201,6 +296,15 @@ std::string StrReplaceAll(absl::string_view s,
 
 template <typename StrToStrMapping>
 int StrReplaceAll(const StrToStrMapping& replacements, std::string* target) {
+  if (strings_internal::FindReplacementsInOnePass(replacements.size(),
+                                                  target->size())) {
+    std::string result;
+    result.reserve(target->size());
+    int substitutions = strings_internal::ApplyReplacementsInOnePass(
+        *target, strings_internal::ReplacementViews(replacements), &result);
+    if (substitutions != 0) target->swap(result);
+    return substitutions;
+  }
   auto subs = strings_internal::FindSubstitutions(*target, replacements);
   if (subs.empty()) return 0;
 
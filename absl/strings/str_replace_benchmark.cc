@@ -15,7 +15,10 @@
 #include "absl/strings/str_replace.h"
 
 #include <cstring>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 #include "absl/base/internal/raw_logging.h"
@@ -119,4 +122,52 @@ void BM_StrReplaceAll(benchmark::State& state) {
 }
 BENCHMARK(BM_StrReplaceAll);
 
+// The six replacements above, followed by made-up words, for a total of `n`.
+// Few of the made-up words occur in big_string.
+std::vector<std::pair<std::string, std::string>> ManyReplacements(int n) {
+  std::vector<std::pair<std::string, std::string>> result;
+  for (const auto& r : replacements) {
+    result.push_back({r.needle, r.replacement});
+  }
+  std::minstd_rand rng(17);
+  std::uniform_int_distribution<int> length(4, 10);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  while (result.size() < static_cast<size_t>(n)) {
+    std::string word(length(rng), ' ');
+    for (char& c : word) c = static_cast<char>(letter(rng));
+    result.push_back({word, "?"});
+  }
+  return result;
+}
+
+void BM_StrReplaceAllManyPatterns(benchmark::State& state) {
+  SetUpStrings();
+  std::string src = *big_string;
+  const auto many = ManyReplacements(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::StrReplaceAll(src, many));
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_StrReplaceAllManyPatterns)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000);
+
+void BM_StrReplacerManyPatterns(benchmark::State& state) {
+  SetUpStrings();
+  std::string src = big_string->substr(0, state.range(1));
+  const absl::StrReplacer replacer(ManyReplacements(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(replacer.Replace(src));
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_StrReplacerManyPatterns)
+    ->ArgPair(10, 1000)
+    ->ArgPair(10, 1000 * 1000)
+    ->ArgPair(10000, 1000)
+    ->ArgPair(10000, 1000 * 1000);
+
 }  // namespace
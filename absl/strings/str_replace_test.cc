@@ -16,9 +16,14 @@
 
 #include <list>
 #include <map>
+#include <random>
+#include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 
@@ -339,3 +344,124 @@ TEST(StrReplaceAll, Inplace) {
   EXPECT_EQ(reps, 8);
   EXPECT_EQ(s, "pack my box with five dozen liquor jugs");
 }
+
+TEST(StrReplaceAll, ManyReplacementsInOnePass) {
+  // Enough replacements, and long enough strings, that all of them are found
+  // in a single pass.
+  std::vector<std::pair<std::string, std::string>> replacements;
+  for (char c = 'a'; c <= 'z'; ++c) {
+    replacements.push_back({std::string(1, c), std::string(1, c - 'a' + 'A')});
+  }
+  replacements.push_back({"the", "***"});
+  replacements.push_back({"", "empty"});
+
+  std::string s, expected;
+  for (int i = 0; i < 20; ++i) {
+    s += "the quick brown fox! ";
+    expected += "*** QUICK BROWN FOX! ";
+  }
+  EXPECT_EQ(expected, absl::StrReplaceAll(s, replacements));
+  EXPECT_EQ(20 * 14, absl::StrReplaceAll(replacements, &s));
+  EXPECT_EQ(expected, s);
+
+  s = std::string(300, '.');
+  EXPECT_EQ(0, absl::StrReplaceAll(replacements, &s));
+  EXPECT_EQ(std::string(300, '.'), s);
+}
+
+TEST(StrReplacer, Basic) {
+  const absl::StrReplacer replacer({{"$count", "5"},
+                                    {"$who", "Bob"},
+                                    {"#Noun", "Apples"},
+                                    {"", "never"}});
+  EXPECT_EQ("Bob bought 5 Apples. Thanks Bob!",
+            replacer.Replace("$who bought $count #Noun. Thanks $who!"));
+  EXPECT_EQ("", replacer.Replace(""));
+  EXPECT_EQ("$wh", replacer.Replace("$wh"));
+
+  std::string s = "#Noun for $who";
+  EXPECT_EQ(2, replacer.Replace(&s));
+  EXPECT_EQ("Apples for Bob", s);
+  EXPECT_EQ(0, replacer.Replace(&s));
+  EXPECT_EQ("Apples for Bob", s);
+}
+
+TEST(StrReplacer, LongestMatchWins) {
+  const absl::StrReplacer replacer(
+      {{"a", "x"}, {"ab", "xy"}, {"b", "y"}, {"bc!", "yz?"}, {"c!", "z;"}});
+  EXPECT_EQ("Ayz?", replacer.Replace("Abc!"));
+  EXPECT_EQ("xyz;", replacer.Replace("abc!"));
+
+  const absl::StrReplacer greedy({{"a", "X"}, {"aa", "x"}});
+  EXPECT_EQ("xX", greedy.Replace("aaa"));
+  EXPECT_EQ("xxX", greedy.Replace("aaaaa"));
+}
+
+TEST(StrReplacer, Containers) {
+  std::map<std::string, std::string> map = {{"aa", "x"}, {"a", "X"}};
+  absl::StrReplacer from_map(map);
+  map.clear();  // The replacer keeps its own copies.
+  EXPECT_EQ("xxX", from_map.Replace("aaaaa"));
+
+  std::vector<std::tuple<absl::string_view, std::string, int>> tuples = {
+      std::make_tuple("a", "x", 1), std::make_tuple("b", "y", 0)};
+  absl::StrReplacer from_tuples(tuples);
+  absl::StrReplacer copy = from_tuples;
+  EXPECT_EQ("xyc", copy.Replace("abc"));
+}
+
+TEST(StrReplacer, DuplicateKeysUseFirstReplacement) {
+  const absl::StrReplacer replacer({{"a", "1"}, {"a", "2"}, {"a", "3"}});
+  EXPECT_EQ("1 1 1", replacer.Replace("a a a"));
+}
+
+// Replaces the longest key at the earliest position, one at a time.
+std::string ReferenceReplaceAll(
+    absl::string_view s,
+    const std::vector<std::pair<std::string, std::string>>& replacements) {
+  std::string result;
+  size_t pos = 0;
+  while (pos < s.size()) {
+    const std::pair<std::string, std::string>* best = nullptr;
+    for (const auto& rep : replacements) {
+      if (!rep.first.empty() && absl::StartsWith(s.substr(pos), rep.first) &&
+          (best == nullptr || rep.first.size() > best->first.size())) {
+        best = &rep;
+      }
+    }
+    if (best == nullptr) {
+      result.push_back(s[pos++]);
+    } else {
+      result.append(best->second);
+      pos += best->first.size();
+    }
+  }
+  return result;
+}
+
+TEST(StrReplacer, MatchesReference) {
+  std::mt19937 rng(1234);
+  auto random_string = [&rng](size_t max_length) {
+    std::uniform_int_distribution<size_t> length(0, max_length);
+    std::uniform_int_distribution<int> byte('a', 'd');
+    std::string s(length(rng), '\0');
+    for (char& c : s) c = static_cast<char>(byte(rng));
+    return s;
+  };
+  for (int iter = 0; iter < 300; ++iter) {
+    std::vector<std::pair<std::string, std::string>> replacements;
+    std::map<std::string, bool> seen;
+    size_t num = 1 + iter % 40;
+    while (replacements.size() < num) {
+      std::string key = random_string(5);
+      if (!seen[key]) {
+        seen[key] = true;
+        replacements.push_back({key, "<" + key + ">"});
+      }
+    }
+    std::string text = random_string(600);
+    std::string expected = ReferenceReplaceAll(text, replacements);
+    EXPECT_EQ(expected, absl::StrReplaceAll(text, replacements));
+    EXPECT_EQ(expected, absl::StrReplacer(replacements).Replace(text));
+  }
+}
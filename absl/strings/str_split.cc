@@ -25,6 +25,8 @@
 
 #include "absl/base/internal/raw_logging.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/internal/find_simd.h"
+#include "absl/strings/internal/simd.h"
 
 namespace absl {
 
@@ -74,6 +76,44 @@ struct AnyOfPolicy {
   size_t Length(absl::string_view /* delimiter */) { return 1; }
 };
 
+// Splits `text` into `out` at single-byte delimiters, as SplitInto() does.
+// `find_all` is a kernel like strings_internal::FindAllOfSimd() bound to the
+// delimiters, and `find_next(p, n)` returns the offset of the first delimiter
+// among the `n` bytes at `p`, or `n`.
+template <typename FindAll, typename FindNext>
+size_t SplitAtBytes(absl::string_view text, absl::Span<absl::string_view> out,
+                    FindAll find_all, FindNext find_next) {
+  if (text.data() == nullptr || out.empty()) return 0;
+  const char* const data = text.data();
+  const size_t size = text.size();
+  const size_t last = out.size() - 1;
+  size_t n = 0;
+  size_t start = 0;  // of the current piece
+  size_t pos = 0;    // of the first byte the search has not examined
+  size_t offsets[64];
+  while (n < last) {
+    size_t num_offsets;
+    const size_t examined =
+        find_all(data + pos, size - pos, offsets,
+                 std::min(last - n, ABSL_ARRAYSIZE(offsets)), &num_offsets);
+    for (size_t i = 0; i < num_offsets; ++i) {
+      const size_t end = pos + offsets[i];
+      out[n++] = absl::string_view(data + start, end - start);
+      start = end + 1;
+    }
+    if (examined == 0) break;
+    pos += examined;
+  }
+  while (n < last) {
+    const size_t end = pos + find_next(data + pos, size - pos);
+    if (end == size) break;
+    out[n++] = absl::string_view(data + start, end - start);
+    start = pos = end + 1;
+  }
+  out[n++] = absl::string_view(data + start, size - start);
+  return n;
+}
+
 }  // namespace
 
 //
@@ -109,10 +149,21 @@ absl::string_view ByChar::Find(absl::string_view text, size_t pos) const {
 // ByAnyChar
 //
 
-ByAnyChar::ByAnyChar(absl::string_view sp) : delimiters_(sp) {}
+ByAnyChar::ByAnyChar(absl::string_view sp) : delimiters_(sp), set_(sp) {}
+
+size_t ByAnyChar::FindFirst(absl::string_view text) const {
+  const size_t found = set_.FindFirstOf(text);
+  return found != absl::string_view::npos ? found : text.size();
+}
 
 absl::string_view ByAnyChar::Find(absl::string_view text, size_t pos) const {
-  return GenericFind(text, delimiters_, pos, AnyOfPolicy());
+  if (delimiters_.size() <= 1 || pos >= text.size()) {
+    return GenericFind(text, delimiters_, pos, AnyOfPolicy());
+  }
+  const size_t found = pos + FindFirst(text.substr(pos));
+  if (found == text.size())
+    return absl::string_view(text.data() + text.size(), 0);
+  return text.substr(found, 1);
 }
 
 //
@@ -134,4 +185,54 @@ absl::string_view ByLength::Find(absl::string_view text,
   return absl::string_view(substr.data() + length_, 0);
 }
 
+namespace strings_internal {
+
+size_t SplitInto(absl::string_view text, const ByChar& delimiter,
+                 absl::Span<absl::string_view> out) {
+  const SimdLevel level = BestSimdLevel();
+  const char c = delimiter.c_;
+  return SplitAtBytes(
+      text, out,
+      [level, c](const char* p, size_t n, size_t* offsets, size_t max,
+                 size_t* num) {
+        return FindAllOfCharSimd(level, p, n, c, offsets, max, num);
+      },
+      [c](const char* p, size_t n) {
+        const void* found = memchr(p, c, n);
+        return found == nullptr
+                   ? n
+                   : static_cast<size_t>(static_cast<const char*>(found) - p);
+      });
+}
+
+size_t SplitInto(absl::string_view text, const ByAnyChar& delimiter,
+                 absl::Span<absl::string_view> out) {
+  if (delimiter.delimiters_.size() <= 1) {
+    // An empty set splits between every byte, and a single byte is better
+    // handled as one.
+    if (delimiter.delimiters_.empty()) {
+      return SplitInto<const ByAnyChar&>(text, delimiter, out);
+    }
+    return SplitInto(text, ByChar(delimiter.delimiters_[0]), out);
+  }
+  // Sets the tables cannot represent are searched a byte at a time.
+  const NibbleTables* tables = VectorizedTables(delimiter.set_);
+  const SimdLevel level = BestSimdLevel();
+  return SplitAtBytes(
+      text, out,
+      [level, tables](const char* p, size_t n, size_t* offsets, size_t max,
+                      size_t* num) {
+        if (tables == nullptr) {
+          *num = 0;
+          return size_t{0};
+        }
+        return FindAllOfSimd(level, p, n, *tables, offsets, max, num);
+      },
+      [&delimiter](const char* p, size_t n) {
+        return delimiter.FindFirst(absl::string_view(p, n));
+      });
+}
+
+}  // namespace strings_internal
+
 }  // namespace absl
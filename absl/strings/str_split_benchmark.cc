@@ -14,6 +14,7 @@
 
 #include "absl/strings/str_split.h"
 
+#include <cstdint>
 #include <iterator>
 #include <string>
 #include <unordered_map>
@@ -67,6 +68,71 @@ void BM_Split2StringViewByAnyChar(benchmark::State& state) {
 }
 BENCHMARK_RANGE(BM_Split2StringViewByAnyChar, 0, 1 << 20);
 
+void BM_SplitIntoByChar(benchmark::State& state) {
+  std::string test = MakeTestString(state.range(0));
+  std::vector<absl::string_view> pieces(test.size() + 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::StrSplitInto(test, ';', absl::MakeSpan(pieces)));
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK_RANGE(BM_SplitIntoByChar, 0, 1 << 20);
+
+void BM_SplitIntoByAnyChar(benchmark::State& state) {
+  std::string test = MakeMultiDelimiterTestString(state.range(0));
+  std::vector<absl::string_view> pieces(test.size() + 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::StrSplitInto(
+        test, absl::ByAnyChar(kDelimiters), absl::MakeSpan(pieces)));
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK_RANGE(BM_SplitIntoByAnyChar, 0, 1 << 20);
+
+// Lines of a tab-separated file with ten fields of 1 to 16 characters.
+std::vector<std::string> MakeTsvLines() {
+  std::vector<std::string> lines(1000);
+  uint32_t r = 1;
+  for (std::string& line : lines) {
+    for (int field = 0; field < 10; ++field) {
+      r = r * 1103515245 + 12345;
+      if (field > 0) line += '\t';
+      line.append(1 + (r >> 16) % 16, 'x');
+    }
+  }
+  return lines;
+}
+
+void BM_SplitTsvLines(benchmark::State& state) {
+  const std::vector<std::string> lines = MakeTsvLines();
+  size_t bytes = 0;
+  for (const std::string& line : lines) bytes += line.size();
+  for (auto _ : state) {
+    for (const std::string& line : lines) {
+      std::vector<absl::string_view> fields = absl::StrSplit(line, '\t');
+      benchmark::DoNotOptimize(fields);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_SplitTsvLines);
+
+void BM_SplitIntoTsvLines(benchmark::State& state) {
+  const std::vector<std::string> lines = MakeTsvLines();
+  size_t bytes = 0;
+  for (const std::string& line : lines) bytes += line.size();
+  absl::string_view fields[10];
+  for (auto _ : state) {
+    for (const std::string& line : lines) {
+      benchmark::DoNotOptimize(
+          absl::StrSplitInto(line, '\t', absl::MakeSpan(fields)));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_SplitIntoTsvLines);
+
 void BM_Split2StringViewLifted(benchmark::State& state) {
   std::string test = MakeTestString(state.range(0));
   std::vector<absl::string_view> result;
@@ -14,6 +14,7 @@
 
 #include "absl/strings/str_split.h"
 
+#include <algorithm>
 #include <deque>
 #include <initializer_list>
 #include <list>
@@ -885,6 +886,22 @@ TEST(Delimiter, ByAnyChar) {
   EXPECT_TRUE(IsFoundAt("abc", empty, 1));
 }
 
+TEST(Delimiter, ByAnyCharLongText) {
+  using absl::ByAnyChar;
+  // Long enough that most of the text is searched many bytes at a time, with
+  // sets that can and cannot be searched that way.
+  const std::string padding(100, 'x');
+  for (const char* set : {",;", " \t\n\r", "\x80\xff.",
+                          "\x01\x11\x21\x31\x41\x51\x61\x71\x81"}) {
+    ByAnyChar delim(set);
+    for (size_t pos = 0; pos < 70; pos += 7) {
+      std::string text = padding.substr(0, pos) + set[1] + padding;
+      EXPECT_TRUE(IsFoundAt(text, delim, pos)) << pos;
+      EXPECT_FALSE(IsFoundAt(padding.substr(0, pos), delim, -1));
+    }
+  }
+}
+
 //
 // Tests for ByLength
 //
@@ -921,6 +938,99 @@ TEST(Split, WorksWithLargeStrings) {
   }
 }
 
+//
+// Tests for StrSplitInto
+//
+
+TEST(StrSplitInto, Basics) {
+  absl::string_view fields[3];
+  auto out = absl::MakeSpan(fields);
+  EXPECT_EQ(3, absl::StrSplitInto("a\tb\tc\td", '\t', out));
+  EXPECT_EQ("a", fields[0]);
+  EXPECT_EQ("b", fields[1]);
+  EXPECT_EQ("c\td", fields[2]);
+
+  EXPECT_EQ(2, absl::StrSplitInto("a,,b", absl::ByAnyChar(",;"),
+                                  out.subspan(0, 2)));
+  EXPECT_EQ("a", fields[0]);
+  EXPECT_EQ(",b", fields[1]);
+
+  EXPECT_EQ(3, absl::StrSplitInto("a, b, c", ", ", out));
+  EXPECT_EQ("a", fields[0]);
+  EXPECT_EQ("b", fields[1]);
+  EXPECT_EQ("c", fields[2]);
+
+  EXPECT_EQ(1, absl::StrSplitInto("abc", '-', out));
+  EXPECT_EQ("abc", fields[0]);
+  EXPECT_EQ(2, absl::StrSplitInto("12345", absl::ByLength(3), out));
+  EXPECT_EQ("123", fields[0]);
+  EXPECT_EQ("45", fields[1]);
+}
+
+TEST(StrSplitInto, EdgeCases) {
+  absl::string_view fields[4];
+  auto out = absl::MakeSpan(fields);
+  EXPECT_EQ(1, absl::StrSplitInto("", ',', out));
+  EXPECT_EQ("", fields[0]);
+  EXPECT_EQ(0, absl::StrSplitInto(absl::string_view(), ',', out));
+  EXPECT_EQ(0, absl::StrSplitInto("a,b", ',', out.subspan(0, 0)));
+  EXPECT_EQ(1, absl::StrSplitInto("a,b", ',', out.subspan(0, 1)));
+  EXPECT_EQ("a,b", fields[0]);
+
+  EXPECT_EQ(4, absl::StrSplitInto(",,,", ',', out));
+  for (absl::string_view field : fields) EXPECT_EQ("", field);
+  EXPECT_EQ(4, absl::StrSplitInto(",,,,", absl::ByAnyChar(",;"), out));
+  EXPECT_EQ(",", fields[3]);
+
+  EXPECT_EQ(3, absl::StrSplitInto("abc", absl::ByAnyChar(""), out));
+  EXPECT_EQ("a", fields[0]);
+  EXPECT_EQ("b", fields[1]);
+  EXPECT_EQ("c", fields[2]);
+  EXPECT_EQ(2, absl::StrSplitInto("a-b", absl::ByAnyChar("-"), out));
+  EXPECT_EQ(1, absl::StrSplitInto("a,b", absl::MaxSplits(',', 0), out));
+  EXPECT_EQ("a,b", fields[0]);
+}
+
+TEST(StrSplitInto, MatchesStrSplit) {
+  // Texts of various lengths with delimiters at various densities, split with
+  // room for all the pieces, and with room for fewer.
+  const char* const kSets[] = {
+      ",", ",\t", "\x01\x11\x21\x31\x41\x51\x61\x71\x81"};
+  uint32_t seed = 17;
+  auto random = [&seed](uint32_t n) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % n;
+  };
+  std::vector<absl::string_view> pieces(1000);
+  for (int iter = 0; iter < 300; ++iter) {
+    const absl::string_view set = kSets[iter % 3];
+    std::string text(random(600), 'x');
+    const uint32_t density = 1 + random(20);
+    for (char& c : text) {
+      if (random(density) == 0) c = set[random(set.size())];
+    }
+    std::vector<absl::string_view> expected;
+    if (set.size() == 1) {
+      expected = absl::StrSplit(text, set[0]);
+    } else {
+      expected = absl::StrSplit(text, absl::ByAnyChar(set));
+    }
+    for (size_t room : {expected.size(), expected.size() / 2 + 1,
+                        size_t{pieces.size()}}) {
+      auto out = absl::MakeSpan(pieces).subspan(0, room);
+      size_t n = set.size() == 1
+                     ? absl::StrSplitInto(text, set[0], out)
+                     : absl::StrSplitInto(text, absl::ByAnyChar(set), out);
+      ASSERT_EQ(std::min(room, expected.size()), n);
+      for (size_t i = 0; i + 1 < n; ++i) EXPECT_EQ(expected[i], pieces[i]);
+      // The last piece extends to the end of the text.
+      EXPECT_EQ(expected[n - 1].data(), pieces[n - 1].data());
+      EXPECT_EQ(text.data() + text.size(),
+                pieces[n - 1].data() + pieces[n - 1].size());
+    }
+  }
+}
+
 TEST(SplitInternalTest, TypeTraits) {
   EXPECT_FALSE(absl::strings_internal::HasMappedType<int>::value);
   EXPECT_TRUE(
@@ -0,0 +1,112 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_builder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/internal/resize_uninitialized.h"
+
+namespace absl {
+
+constexpr size_t StringBuilder::kInlineCapacity;
+
+StringBuilder::StringBuilder(StringBuilder&& other) noexcept
+    : StringBuilder() {
+  *this = std::move(other);
+}
+
+StringBuilder& StringBuilder::operator=(StringBuilder&& other) noexcept {
+  if (this == &other) return *this;
+  size_ = other.size_;
+  if (other.data_ == other.inline_) {
+    memcpy(inline_, other.inline_, other.size_);
+    data_ = inline_;
+    capacity_ = kInlineCapacity;
+  } else {
+    heap_ = std::move(other.heap_);
+    data_ = &heap_[0];
+    capacity_ = heap_.size();
+  }
+  other.heap_.clear();
+  other.data_ = other.inline_;
+  other.size_ = 0;
+  other.capacity_ = kInlineCapacity;
+  return *this;
+}
+
+std::string StringBuilder::Release() {
+  std::string result;
+  if (data_ == inline_) {
+    result.assign(data_, size_);
+  } else {
+    heap_.resize(size_);
+    result = std::move(heap_);
+    heap_.clear();
+    data_ = inline_;
+    capacity_ = kInlineCapacity;
+  }
+  size_ = 0;
+  return result;
+}
+
+char* StringBuilder::StartGrowth(std::string* next,
+                                 size_t min_capacity) const {
+  // Double at least, so that appending n bytes one piece at a time copies
+  // O(n) bytes in all.
+  strings_internal::STLStringResizeUninitialized(
+      next, std::max(min_capacity, 2 * capacity_));
+  char* begin = &(*next)[0];
+  memcpy(begin, data_, size_);
+  return begin + size_;
+}
+
+void StringBuilder::FinishGrowth(std::string* next) {
+  heap_.swap(*next);
+  data_ = &heap_[0];
+  capacity_ = heap_.size();
+}
+
+void StringBuilder::Grow(size_t min_capacity) {
+  std::string next;
+  StartGrowth(&next, min_capacity);
+  FinishGrowth(&next);
+}
+
+namespace strings_internal {
+
+void AppendPieces(StringBuilder* dest,
+                  std::initializer_list<absl::string_view> pieces) {
+  size_t total = 0;
+  for (absl::string_view piece : pieces) total += piece.size();
+
+  // When growing, the pieces are copied before the old storage, which they
+  // may point into, is released.
+  std::string next;
+  const bool grow = total > dest->capacity_ - dest->size_;
+  char* out = grow ? dest->StartGrowth(&next, dest->size_ + total)
+                   : dest->data_ + dest->size_;
+  for (absl::string_view piece : pieces) {
+    if (!piece.empty()) {
+      memcpy(out, piece.data(), piece.size());
+      out += piece.size();
+    }
+  }
+  if (grow) dest->FinishGrowth(&next);
+  dest->size_ += total;
+}
+
+}  // namespace strings_internal
+}  // namespace absl
@@ -0,0 +1,208 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: string_builder.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `absl::StringBuilder`, a buffer for assembling a string
+// piece by piece. Compared with appending to a `std::string`:
+//
+//   * short results are built in an inline buffer without allocating;
+//   * the buffer grows geometrically into fresh storage, copying only the
+//     bytes written so far, and is not zero-filled where `std::string`
+//     supports uninitialized resizing (as `libc++` does);
+//   * writers such as `absl::numbers_internal::FastIntToBuffer()` can write
+//     straight into the buffer through `ReserveAppend()`;
+//   * `Release()` hands the result over as a `std::string` without copying
+//     it, once it has outgrown the inline buffer.
+//
+// `absl::StrAppend()`, `absl::StrAppendFormat()` and `absl::Format()` all
+// accept a `StringBuilder*`.
+//
+// Example:
+//
+//   absl::StringBuilder out;
+//   for (const Row& row : rows) {
+//     absl::StrAppend(&out, row.name, "\t", row.count, "\n");
+//   }
+//   std::string tsv = out.Release();
+
+#ifndef ABSL_STRINGS_STRING_BUILDER_H_
+#define ABSL_STRINGS_STRING_BUILDER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+#include "absl/base/port.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+
+class StringBuilder;
+
+namespace strings_internal {
+
+// Appends the concatenation of `pieces` to `dest`. The pieces may refer into
+// `dest`.
+void AppendPieces(StringBuilder* dest,
+                  std::initializer_list<absl::string_view> pieces);
+
+}  // namespace strings_internal
+
+// StringBuilder
+//
+// A growable character buffer with an inline buffer of `kInlineCapacity`
+// bytes. A StringBuilder can be moved but not copied.
+class StringBuilder {
+ public:
+  static constexpr size_t kInlineCapacity = 120;
+
+  StringBuilder() : data_(inline_), size_(0), capacity_(kInlineCapacity) {}
+  StringBuilder(StringBuilder&& other) noexcept;
+  StringBuilder& operator=(StringBuilder&& other) noexcept;
+  StringBuilder(const StringBuilder&) = delete;
+  StringBuilder& operator=(const StringBuilder&) = delete;
+
+  // StringBuilder::size()
+  // StringBuilder::empty()
+  // StringBuilder::capacity()
+  // StringBuilder::data()
+  // StringBuilder::view()
+  //
+  // The contents so far. The pointer returned by `data()` and the view
+  // returned by `view()` are invalidated by any call that adds to the
+  // contents.
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return capacity_; }
+  const char* data() const { return data_; }
+  absl::string_view view() const { return absl::string_view(data_, size_); }
+
+  // StringBuilder::reserve()
+  //
+  // Ensures that the builder can hold `n` bytes without growing.
+  void reserve(size_t n) {
+    if (n > capacity_) Grow(n);
+  }
+
+  // StringBuilder::clear()
+  //
+  // Empties the builder, keeping its capacity.
+  void clear() { size_ = 0; }
+
+  // StringBuilder::Truncate()
+  //
+  // Shortens the contents to their first `n` bytes. `n` must not exceed
+  // `size()`.
+  void Truncate(size_t n) {
+    assert(n <= size_);
+    size_ = n;
+  }
+
+  // StringBuilder::Append()
+  // StringBuilder::push_back()
+  //
+  // Appends `s`, `n` copies of `c`, or `c`. `s` may refer into the builder.
+  StringBuilder& Append(absl::string_view s) {
+    if (ABSL_PREDICT_FALSE(s.size() > capacity_ - size_)) {
+      strings_internal::AppendPieces(this, {s});
+    } else if (!s.empty()) {
+      memcpy(data_ + size_, s.data(), s.size());
+      size_ += s.size();
+    }
+    return *this;
+  }
+  StringBuilder& Append(size_t n, char c) {
+    memset(ReserveAppend(n), c, n);
+    size_ += n;
+    return *this;
+  }
+  void push_back(char c) {
+    if (ABSL_PREDICT_FALSE(size_ == capacity_)) Grow(size_ + 1);
+    data_[size_++] = c;
+  }
+
+  // StringBuilder::ReserveAppend()
+  // StringBuilder::CommitAppend()
+  //
+  // `ReserveAppend(n)` returns a pointer to room for at least `n` more bytes
+  // after the contents, for the caller to write into directly.
+  // `CommitAppend(m)` then adds the first `m` of the bytes written, where `m`
+  // is at most `n`. Nothing else may be appended in between.
+  //
+  // Example:
+  //
+  //   char* p = builder.ReserveAppend(numbers_internal::kFastToBufferSize);
+  //   builder.CommitAppend(numbers_internal::FastIntToBuffer(i, p) - p);
+  char* ReserveAppend(size_t n) {
+    if (ABSL_PREDICT_FALSE(n > capacity_ - size_)) Grow(size_ + n);
+    return data_ + size_;
+  }
+  void CommitAppend(size_t n) {
+    assert(n <= capacity_ - size_);
+    size_ += n;
+  }
+
+  // StringBuilder::Release()
+  //
+  // Returns the contents and empties the builder. Contents that have outgrown
+  // the inline buffer are moved into the result rather than copied, and the
+  // builder goes back to its inline buffer.
+  std::string Release();
+
+ private:
+  friend void strings_internal::AppendPieces(
+      StringBuilder* dest, std::initializer_list<absl::string_view> pieces);
+
+  // Moves the contents into fresh storage with room for at least
+  // `min_capacity` bytes.
+  void Grow(size_t min_capacity);
+
+  // Allocates storage for `next` with room for at least `min_capacity` bytes
+  // and copies the contents into it, leaving the current storage untouched.
+  // Returns a pointer to the end of the copied contents.
+  char* StartGrowth(std::string* next, size_t min_capacity) const;
+
+  // Switches to the storage allocated by `StartGrowth()`.
+  void FinishGrowth(std::string* next);
+
+  // `data_` points to `inline_` or into `heap_`, whose size is the capacity.
+  char* data_;
+  size_t size_;
+  size_t capacity_;
+  std::string heap_;
+  char inline_[kInlineCapacity];
+};
+
+// StrAppend()
+//
+// Appends to a `StringBuilder` as `absl::StrAppend()` does to a string. Unlike
+// the `std::string` overloads, the arguments may refer into `dest`.
+inline void StrAppend(StringBuilder*) {}
+
+template <typename... AV>
+inline void StrAppend(StringBuilder* dest, const AlphaNum& a,
+                      const AV&... args) {
+  strings_internal::AppendPieces(
+      dest, {a.Piece(), static_cast<const AlphaNum&>(args).Piece()...});
+}
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_STRING_BUILDER_H_
@@ -0,0 +1,113 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_builder.h"
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+namespace {
+
+// Each benchmark builds a tab-separated table of `state.range(0)` rows and
+// hands it back as a std::string.
+
+void BM_TableStdString(benchmark::State& state) {
+  const int rows = state.range(0);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    std::string out;
+    for (int i = 0; i < rows; ++i) {
+      absl::StrAppend(&out, "row", i, "\t", i * 7, "\t", "some value\n");
+    }
+    bytes = out.size();
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_TableStdString)->Range(1, 1 << 16);
+
+void BM_TableStringBuilder(benchmark::State& state) {
+  const int rows = state.range(0);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    absl::StringBuilder builder;
+    for (int i = 0; i < rows; ++i) {
+      absl::StrAppend(&builder, "row", i, "\t", i * 7, "\t", "some value\n");
+    }
+    std::string out = builder.Release();
+    bytes = out.size();
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_TableStringBuilder)->Range(1, 1 << 16);
+
+// Many small appends, the case that suffers most from per-append overhead.
+void BM_TableStringBuilderPieces(benchmark::State& state) {
+  const int rows = state.range(0);
+  size_t bytes = 0;
+  constexpr size_t kIntSize = absl::numbers_internal::kFastToBufferSize;
+  for (auto _ : state) {
+    absl::StringBuilder builder;
+    for (int i = 0; i < rows; ++i) {
+      builder.Append("row");
+      char* p = builder.ReserveAppend(kIntSize);
+      builder.CommitAppend(absl::numbers_internal::FastIntToBuffer(i, p) - p);
+      builder.push_back('\t');
+      p = builder.ReserveAppend(kIntSize);
+      builder.CommitAppend(
+          absl::numbers_internal::FastIntToBuffer(i * 7, p) - p);
+      builder.push_back('\t');
+      builder.Append("some value\n");
+    }
+    std::string out = builder.Release();
+    bytes = out.size();
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_TableStringBuilderPieces)->Range(1, 1 << 16);
+
+void BM_FormatStdString(benchmark::State& state) {
+  const int rows = state.range(0);
+  for (auto _ : state) {
+    std::string out;
+    for (int i = 0; i < rows; ++i) {
+      absl::StrAppendFormat(&out, "row%d\t%08x\t%s\n", i, i * 7, "value");
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_FormatStdString)->Range(1, 1 << 14);
+
+void BM_FormatStringBuilder(benchmark::State& state) {
+  const int rows = state.range(0);
+  for (auto _ : state) {
+    absl::StringBuilder builder;
+    for (int i = 0; i < rows; ++i) {
+      absl::StrAppendFormat(&builder, "row%d\t%08x\t%s\n", i, i * 7, "value");
+    }
+    std::string out = builder.Release();
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_FormatStringBuilder)->Range(1, 1 << 14);
+
+}  // namespace
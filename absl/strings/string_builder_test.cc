@@ -0,0 +1,192 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_builder.h"
+
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+namespace {
+
+TEST(StringBuilder, Empty) {
+  absl::StringBuilder b;
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(0, b.size());
+  EXPECT_EQ(absl::StringBuilder::kInlineCapacity, b.capacity());
+  EXPECT_EQ("", b.view());
+  EXPECT_EQ("", b.Release());
+}
+
+TEST(StringBuilder, Append) {
+  absl::StringBuilder b;
+  b.Append("abc").Append(3, 'x').Append("");
+  b.push_back('!');
+  EXPECT_EQ("abcxxx!", b.view());
+  EXPECT_EQ(7, b.size());
+  EXPECT_EQ(b.data(), b.view().data());
+
+  b.Truncate(3);
+  EXPECT_EQ("abc", b.view());
+  b.clear();
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(absl::StringBuilder::kInlineCapacity, b.capacity());
+}
+
+TEST(StringBuilder, Growth) {
+  absl::StringBuilder b;
+  std::string expected;
+  for (int i = 0; i < 10000; ++i) {
+    const std::string piece = absl::StrCat(i, ",");
+    b.Append(piece);
+    expected += piece;
+    if (i % 7 == 0) {
+      b.push_back(';');
+      expected.push_back(';');
+    }
+    ASSERT_GE(b.capacity(), b.size());
+  }
+  EXPECT_EQ(expected, b.view());
+
+  // Growth is geometric.
+  absl::StringBuilder c;
+  int reallocations = 0;
+  const char* data = c.data();
+  for (int i = 0; i < 1 << 20; ++i) {
+    c.push_back('x');
+    if (c.data() != data) {
+      ++reallocations;
+      data = c.data();
+    }
+  }
+  EXPECT_LT(reallocations, 20);
+}
+
+TEST(StringBuilder, Reserve) {
+  absl::StringBuilder b;
+  b.Append("prefix");
+  b.reserve(1000);
+  EXPECT_GE(b.capacity(), 1000);
+  const char* data = b.data();
+  for (int i = 0; i < 99; ++i) b.Append("0123456789");
+  EXPECT_EQ(data, b.data());
+  EXPECT_EQ(996, b.size());
+  EXPECT_EQ("prefix0123", b.view().substr(0, 10));
+}
+
+TEST(StringBuilder, ReserveAppend) {
+  absl::StringBuilder b;
+  std::string expected;
+  for (int i = -1000; i < 100000; i += 37) {
+    char* p = b.ReserveAppend(absl::numbers_internal::kFastToBufferSize);
+    b.CommitAppend(absl::numbers_internal::FastIntToBuffer(i, p) - p);
+    b.push_back(' ');
+    absl::StrAppend(&expected, i, " ");
+  }
+  EXPECT_EQ(expected, b.view());
+}
+
+TEST(StringBuilder, SelfAppend) {
+  absl::StringBuilder b;
+  b.Append("ab");
+  for (int i = 0; i < 12; ++i) b.Append(b.view());
+  EXPECT_EQ(2 << 12, b.size());
+  for (size_t i = 0; i < b.size(); i += 2) {
+    ASSERT_EQ("ab", b.view().substr(i, 2));
+  }
+
+  absl::StringBuilder c;
+  std::string expected = "xy";
+  c.Append(expected);
+  for (int i = 0; i < 8; ++i) {
+    absl::StrAppend(&c, c.view(), "-", c.view());
+    expected += expected + "-" + expected;
+  }
+  EXPECT_EQ(expected, c.view());
+}
+
+TEST(StringBuilder, Release) {
+  absl::StringBuilder small;
+  small.Append("short");
+  EXPECT_EQ("short", small.Release());
+  EXPECT_TRUE(small.empty());
+
+  // Contents that have outgrown the inline buffer are moved out.
+  absl::StringBuilder large;
+  large.Append(std::string(1000, 'z'));
+  const char* data = large.data();
+  std::string released = large.Release();
+  EXPECT_EQ(std::string(1000, 'z'), released);
+  EXPECT_EQ(data, released.data());
+  EXPECT_TRUE(large.empty());
+  EXPECT_EQ(absl::StringBuilder::kInlineCapacity, large.capacity());
+
+  // The builder is reusable.
+  large.Append("again");
+  EXPECT_EQ("again", large.Release());
+}
+
+TEST(StringBuilder, Move) {
+  absl::StringBuilder small;
+  small.Append("inline");
+  absl::StringBuilder moved_small(std::move(small));
+  EXPECT_EQ("inline", moved_small.view());
+  EXPECT_TRUE(small.empty());  // NOLINT(bugprone-use-after-move)
+
+  absl::StringBuilder large;
+  large.Append(std::string(500, 'q'));
+  const char* data = large.data();
+  absl::StringBuilder moved_large;
+  moved_large.Append("overwritten");
+  moved_large = std::move(large);
+  EXPECT_EQ(std::string(500, 'q'), moved_large.view());
+  EXPECT_EQ(data, moved_large.data());
+  EXPECT_TRUE(large.empty());  // NOLINT(bugprone-use-after-move)
+  large.Append("reused");
+  EXPECT_EQ("reused", large.view());
+
+  moved_small = std::move(moved_large);
+  moved_small.Append("!");
+  EXPECT_EQ(std::string(500, 'q') + "!", moved_small.view());
+}
+
+TEST(StringBuilder, StrAppend) {
+  absl::StringBuilder b;
+  absl::StrAppend(&b);
+  absl::StrAppend(&b, "a");
+  absl::StrAppend(&b, 1, 2.5, absl::Hex(255), true, std::string("s"));
+  absl::StrAppend(&b, "1", "2", "3", "4", "5", "6", "7");
+  EXPECT_EQ("a12.5ff1s1234567", b.view());
+}
+
+TEST(StringBuilder, StrAppendFormat) {
+  absl::StringBuilder b;
+  b.Append("pi=");
+  absl::StrAppendFormat(&b, "%.2f, %s=%05d", 3.14159, "n", 42);
+  EXPECT_EQ("pi=3.14, n=00042", b.view());
+
+  absl::Format(&b, "%c", '!');
+  EXPECT_EQ("pi=3.14, n=00042!", b.view());
+
+  // Output larger than the formatter's own buffer.
+  absl::StrAppendFormat(&b, "%s", std::string(2000, 'x'));
+  EXPECT_EQ(2017, b.size());
+  EXPECT_EQ(std::string(2000, 'x'), b.view().substr(17));
+}
+
+}  // namespace
@@ -0,0 +1,276 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "absl/base/internal/raw_logging.h"
+#include "absl/hash/hash.h"
+
+namespace absl {
+
+namespace {
+
+// Arena blocks start small, so that small pools (and the shards of a sharded
+// pool) stay small, and double up to `kMaxBlockSize`.
+constexpr size_t kFirstBlockSize = 1024;
+constexpr size_t kMaxBlockSize = 256 * 1024;
+
+// Strings at least this fraction of a block get a block of their own, so that
+// they do not strand the free space at the end of the current block.
+constexpr size_t kLargeStringDivisor = 4;
+
+// How many strings InternAll() hashes and prefetches ahead of inserting.
+constexpr size_t kBatchSize = 16;
+
+}  // namespace
+
+StringPool::StringPool()
+    : index_(0, HandleHash{&entries_}, HandleEq{&entries_}),
+      next_block_size_(kFirstBlockSize) {}
+
+StringPool::~StringPool() = default;
+
+size_t StringPool::HashOf(absl::string_view s) {
+  return absl::Hash<absl::string_view>{}(s);
+}
+
+StringPool::Handle StringPool::InternHandle(absl::string_view s) {
+  return InternHashed(s, HashOf(s));
+}
+
+StringPool::Handle StringPool::InternHashed(absl::string_view s, size_t hash) {
+  auto it = index_.lazy_emplace(
+      Key{s, hash}, [&](const Index::constructor& ctor) {
+        ABSL_RAW_CHECK(entries_.size() <= std::numeric_limits<Handle>::max(),
+                       "StringPool is full");
+        const Handle handle = static_cast<Handle>(entries_.size());
+        entries_.push_back(Entry{Store(s), hash});
+        ctor(handle);
+      });
+  return *it;
+}
+
+void StringPool::InternAll(absl::Span<const absl::string_view> strings,
+                           absl::Span<Handle> out) {
+  assert(out.size() >= strings.size());
+  size_t hashes[kBatchSize];
+  for (size_t i = 0; i < strings.size(); i += kBatchSize) {
+    const size_t n = std::min(kBatchSize, strings.size() - i);
+    for (size_t j = 0; j < n; ++j) {
+      hashes[j] = HashOf(strings[i + j]);
+      index_.prefetch(Key{strings[i + j], hashes[j]});
+    }
+    for (size_t j = 0; j < n; ++j) {
+      out[i + j] = InternHashed(strings[i + j], hashes[j]);
+    }
+  }
+}
+
+void StringPool::InternAll(absl::Span<const absl::string_view> strings,
+                           absl::Span<absl::string_view> out) {
+  assert(out.size() >= strings.size());
+  Handle handles[kBatchSize];
+  for (size_t i = 0; i < strings.size(); i += kBatchSize) {
+    const size_t n = std::min(kBatchSize, strings.size() - i);
+    InternAll(strings.subspan(i, n), absl::Span<Handle>(handles, n));
+    for (size_t j = 0; j < n; ++j) out[i + j] = Get(handles[j]);
+  }
+}
+
+absl::optional<StringPool::Handle> StringPool::Find(
+    absl::string_view s) const {
+  return FindHashed(s, HashOf(s));
+}
+
+absl::optional<StringPool::Handle> StringPool::FindHashed(
+    absl::string_view s, size_t hash) const {
+  auto it = index_.find(Key{s, hash});
+  if (it == index_.end()) return absl::nullopt;
+  return *it;
+}
+
+absl::string_view StringPool::Store(absl::string_view s) {
+  if (s.empty()) return absl::string_view();
+  bytes_used_ += s.size();
+  if (s.size() > remaining_) {
+    if (s.size() >= next_block_size_ / kLargeStringDivisor) {
+      // Leave the current block open for the strings that follow.
+      blocks_.emplace_back(new char[s.size()]);
+      arena_bytes_ += s.size();
+      memcpy(blocks_.back().get(), s.data(), s.size());
+      return absl::string_view(blocks_.back().get(), s.size());
+    }
+    blocks_.emplace_back(new char[next_block_size_]);
+    arena_bytes_ += next_block_size_;
+    next_ = blocks_.back().get();
+    remaining_ = next_block_size_;
+    next_block_size_ = std::min(2 * next_block_size_, kMaxBlockSize);
+  }
+  memcpy(next_, s.data(), s.size());
+  absl::string_view copy(next_, s.size());
+  next_ += s.size();
+  remaining_ -= s.size();
+  return copy;
+}
+
+size_t StringPool::MemoryUsage() const {
+  return arena_bytes_ + blocks_.capacity() * sizeof(blocks_[0]) +
+         entries_.capacity() * sizeof(Entry) +
+         index_.capacity() * (sizeof(Handle) + 1);
+}
+
+constexpr int ShardedStringPool::kShardBits;
+constexpr size_t ShardedStringPool::kNumShards;
+
+ShardedStringPool::Handle ShardedStringPool::MakeHandle(size_t shard,
+                                                        Handle local) {
+  ABSL_RAW_CHECK(local <= std::numeric_limits<Handle>::max() >> kShardBits,
+                 "ShardedStringPool shard is full");
+  return (local << kShardBits) | static_cast<Handle>(shard);
+}
+
+ShardedStringPool::Handle ShardedStringPool::InternInShard(
+    Shard* shard, absl::string_view s, size_t hash, absl::string_view* text) {
+  // Most strings are interned many times, so look under a shared lock first
+  // and only take the exclusive one to add a string.
+  {
+    absl::ReaderMutexLock lock(&shard->mu);
+    absl::optional<Handle> local = shard->pool.FindHashed(s, hash);
+    if (local) {
+      *text = shard->pool.Get(*local);
+      return *local;
+    }
+  }
+  absl::MutexLock lock(&shard->mu);
+  const Handle local = shard->pool.InternHashed(s, hash);
+  *text = shard->pool.Get(local);
+  return local;
+}
+
+absl::string_view ShardedStringPool::Intern(absl::string_view s) {
+  const size_t hash = StringPool::HashOf(s);
+  absl::string_view text;
+  InternInShard(&shards_[ShardOf(hash)], s, hash, &text);
+  return text;
+}
+
+ShardedStringPool::Handle ShardedStringPool::InternHandle(
+    absl::string_view s) {
+  const size_t hash = StringPool::HashOf(s);
+  const size_t shard_index = ShardOf(hash);
+  absl::string_view text;
+  return MakeHandle(shard_index,
+                    InternInShard(&shards_[shard_index], s, hash, &text));
+}
+
+template <typename Emit>
+void ShardedStringPool::InternAllImpl(
+    absl::Span<const absl::string_view> strings, Emit emit) {
+  // Hash everything up front, then visit the strings grouped by shard with a
+  // counting sort so that each lock is taken once.
+  std::vector<size_t> hashes(strings.size());
+  size_t starts[kNumShards + 1] = {};
+  for (size_t i = 0; i < strings.size(); ++i) {
+    hashes[i] = StringPool::HashOf(strings[i]);
+    ++starts[ShardOf(hashes[i]) + 1];
+  }
+  for (size_t shard = 0; shard < kNumShards; ++shard) {
+    starts[shard + 1] += starts[shard];
+  }
+  std::vector<size_t> order(strings.size());
+  size_t fill[kNumShards];
+  std::copy(starts, starts + kNumShards, fill);
+  for (size_t i = 0; i < strings.size(); ++i) {
+    order[fill[ShardOf(hashes[i])]++] = i;
+  }
+
+  for (size_t shard_index = 0; shard_index < kNumShards; ++shard_index) {
+    if (starts[shard_index] == starts[shard_index + 1]) continue;
+    Shard& shard = shards_[shard_index];
+    absl::MutexLock lock(&shard.mu);
+    for (size_t k = starts[shard_index]; k < starts[shard_index + 1]; ++k) {
+      const size_t i = order[k];
+      emit(i, shard_index, shard.pool,
+           shard.pool.InternHashed(strings[i], hashes[i]));
+    }
+  }
+}
+
+void ShardedStringPool::InternAll(absl::Span<const absl::string_view> strings,
+                                  absl::Span<absl::string_view> out) {
+  assert(out.size() >= strings.size());
+  InternAllImpl(strings, [out](size_t i, size_t, const StringPool& pool,
+                               Handle local) { out[i] = pool.Get(local); });
+}
+
+void ShardedStringPool::InternAll(absl::Span<const absl::string_view> strings,
+                                  absl::Span<Handle> out) {
+  assert(out.size() >= strings.size());
+  InternAllImpl(strings, [out](size_t i, size_t shard_index, const StringPool&,
+                               Handle local) {
+    out[i] = MakeHandle(shard_index, local);
+  });
+}
+
+absl::optional<ShardedStringPool::Handle> ShardedStringPool::Find(
+    absl::string_view s) const {
+  const size_t hash = StringPool::HashOf(s);
+  const size_t shard_index = ShardOf(hash);
+  const Shard& shard = shards_[shard_index];
+  absl::ReaderMutexLock lock(&shard.mu);
+  absl::optional<Handle> local = shard.pool.FindHashed(s, hash);
+  if (!local) return absl::nullopt;
+  return MakeHandle(shard_index, *local);
+}
+
+absl::string_view ShardedStringPool::Get(Handle handle) const {
+  const Shard& shard = shards_[handle & (kNumShards - 1)];
+  absl::ReaderMutexLock lock(&shard.mu);
+  return shard.pool.Get(handle >> kShardBits);
+}
+
+size_t ShardedStringPool::size() const {
+  size_t total = 0;
+  for (const Shard& shard : shards_) {
+    absl::ReaderMutexLock lock(&shard.mu);
+    total += shard.pool.size();
+  }
+  return total;
+}
+
+size_t ShardedStringPool::bytes_used() const {
+  size_t total = 0;
+  for (const Shard& shard : shards_) {
+    absl::ReaderMutexLock lock(&shard.mu);
+    total += shard.pool.bytes_used();
+  }
+  return total;
+}
+
+size_t ShardedStringPool::MemoryUsage() const {
+  size_t total = 0;
+  for (const Shard& shard : shards_) {
+    absl::ReaderMutexLock lock(&shard.mu);
+    total += shard.pool.MemoryUsage();
+  }
+  return total;
+}
+
+}  // namespace absl
@@ -0,0 +1,262 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: string_pool.h
+// -----------------------------------------------------------------------------
+//
+// This file defines `absl::StringPool` and `absl::ShardedStringPool`, which
+// intern strings: each distinct string is stored once, and every request to
+// intern it returns the same copy. Programs holding many repeated strings,
+// such as host names or metric label values, can keep one `absl::string_view`
+// or a 4-byte handle per occurrence in place of a `std::string`.
+//
+// Interned bytes live in blocks of an append-only arena and are never moved
+// or freed before the pool is destroyed, so the views returned stay valid for
+// the lifetime of the pool.
+//
+// Example:
+//
+//   absl::StringPool pool;
+//   absl::string_view a = pool.Intern(std::string("example.com"));
+//   absl::string_view b = pool.Intern("example.com");
+//   assert(a.data() == b.data());
+//
+//   absl::StringPool::Handle h = pool.InternHandle("example.com");
+//   assert(pool.Get(h) == "example.com");
+//
+// `absl::StringPool` is thread-compatible. `absl::ShardedStringPool` is
+// thread-safe, and spreads its strings over independently locked shards so
+// that threads interning different strings rarely contend.
+
+#ifndef ABSL_STRINGS_STRING_POOL_H_
+#define ABSL_STRINGS_STRING_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace absl {
+
+class ShardedStringPool;
+
+// StringPool
+//
+// A set of interned strings. Each distinct string added with `Intern()` or
+// `InternHandle()` is copied into the pool once and numbered with a dense
+// `Handle`, starting from 0 in order of first insertion.
+//
+// A pool holds at most 2^32 distinct strings. It can be neither copied nor
+// moved, since its index refers back to the pool.
+class StringPool {
+ public:
+  using Handle = uint32_t;
+
+  StringPool();
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+  ~StringPool();
+
+  // StringPool::Intern()
+  //
+  // Returns the pooled copy of `s`, adding it to the pool if it is not there
+  // yet.
+  absl::string_view Intern(absl::string_view s) { return Get(InternHandle(s)); }
+
+  // StringPool::InternHandle()
+  //
+  // Like `Intern()`, but returns the handle of the pooled copy.
+  Handle InternHandle(absl::string_view s);
+
+  // StringPool::InternAll()
+  //
+  // Interns each of `strings`, storing the results in the corresponding
+  // element of `out`, which must be at least as long as `strings`. Hashing
+  // ahead of the lookups lets the memory accesses of neighbouring strings
+  // overlap, so this is faster than calling `Intern()` in a loop.
+  void InternAll(absl::Span<const absl::string_view> strings,
+                 absl::Span<absl::string_view> out);
+  void InternAll(absl::Span<const absl::string_view> strings,
+                 absl::Span<Handle> out);
+
+  // StringPool::Find()
+  //
+  // Returns the handle of `s` if it is in the pool, without adding it.
+  absl::optional<Handle> Find(absl::string_view s) const;
+
+  // StringPool::Get()
+  //
+  // Returns the string that `handle` refers to. `handle` must have been
+  // returned by this pool.
+  absl::string_view Get(Handle handle) const { return entries_[handle].text; }
+
+  // StringPool::size()
+  //
+  // Returns the number of distinct strings in the pool.
+  size_t size() const { return entries_.size(); }
+
+  // StringPool::bytes_used()
+  //
+  // Returns the total length of the distinct strings in the pool.
+  size_t bytes_used() const { return bytes_used_; }
+
+  // StringPool::MemoryUsage()
+  //
+  // Returns an estimate of the heap memory held by the pool: its arena blocks
+  // and index.
+  size_t MemoryUsage() const;
+
+ private:
+  friend class ShardedStringPool;
+
+  struct Entry {
+    absl::string_view text;
+    size_t hash;
+  };
+
+  // A string to look up, with its hash computed once up front.
+  struct Key {
+    absl::string_view text;
+    size_t hash;
+  };
+
+  // The index is a set of handles, hashed and compared through `entries_` so
+  // that each slot costs only a handle. Rehashing reuses the stored hashes.
+  struct HandleHash {
+    using is_transparent = void;
+
+    size_t operator()(Handle h) const { return (*entries)[h].hash; }
+    size_t operator()(const Key& key) const { return key.hash; }
+
+    const std::vector<Entry>* entries;
+  };
+
+  struct HandleEq {
+    using is_transparent = void;
+
+    bool operator()(Handle a, Handle b) const { return a == b; }
+    bool operator()(Handle h, const Key& key) const {
+      const Entry& entry = (*entries)[h];
+      return entry.hash == key.hash && entry.text == key.text;
+    }
+    bool operator()(const Key& key, Handle h) const { return (*this)(h, key); }
+
+    const std::vector<Entry>* entries;
+  };
+
+  static size_t HashOf(absl::string_view s);
+
+  Handle InternHashed(absl::string_view s, size_t hash);
+  absl::optional<Handle> FindHashed(absl::string_view s, size_t hash) const;
+
+  // Copies `s` into the arena and returns the copy.
+  absl::string_view Store(absl::string_view s);
+
+  using Index = absl::flat_hash_set<Handle, HandleHash, HandleEq>;
+
+  std::vector<Entry> entries_;
+  Index index_;
+
+  // The arena. `next_` points into the last block of `blocks_`, with
+  // `remaining_` bytes free after it.
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* next_ = nullptr;
+  size_t remaining_ = 0;
+  size_t next_block_size_;
+  size_t arena_bytes_ = 0;
+  size_t bytes_used_ = 0;
+};
+
+// ShardedStringPool
+//
+// A thread-safe string pool. Strings are assigned to one of `kNumShards`
+// shards by hash, and each shard is a `StringPool` behind its own mutex.
+//
+// Handles encode the shard in their low bits, so they are unique across the
+// pool but not dense. A sharded pool holds at most 2^28 distinct strings per
+// shard.
+class ShardedStringPool {
+ public:
+  using Handle = StringPool::Handle;
+
+  static constexpr int kShardBits = 4;
+  static constexpr size_t kNumShards = size_t{1} << kShardBits;
+
+  ShardedStringPool() = default;
+  ShardedStringPool(const ShardedStringPool&) = delete;
+  ShardedStringPool& operator=(const ShardedStringPool&) = delete;
+
+  // ShardedStringPool::Intern()
+  // ShardedStringPool::InternHandle()
+  // ShardedStringPool::InternAll()
+  // ShardedStringPool::Find()
+  // ShardedStringPool::Get()
+  //
+  // As for `StringPool`. `InternAll()` takes each shard's lock once for all
+  // the strings that belong to it.
+  absl::string_view Intern(absl::string_view s);
+  Handle InternHandle(absl::string_view s);
+  void InternAll(absl::Span<const absl::string_view> strings,
+                 absl::Span<absl::string_view> out);
+  void InternAll(absl::Span<const absl::string_view> strings,
+                 absl::Span<Handle> out);
+  absl::optional<Handle> Find(absl::string_view s) const;
+  absl::string_view Get(Handle handle) const;
+
+  // ShardedStringPool::size()
+  // ShardedStringPool::bytes_used()
+  // ShardedStringPool::MemoryUsage()
+  //
+  // As for `StringPool`, summed over the shards. The totals are not a
+  // consistent snapshot while other threads are interning.
+  size_t size() const;
+  size_t bytes_used() const;
+  size_t MemoryUsage() const;
+
+ private:
+  struct Shard {
+    mutable absl::Mutex mu;
+    StringPool pool ABSL_GUARDED_BY(mu);
+  };
+
+  static size_t ShardOf(size_t hash) {
+    return hash >> (sizeof(size_t) * 8 - kShardBits);
+  }
+  static Handle MakeHandle(size_t shard, Handle local);
+
+  // Interns `s`, whose hash is `hash`, in `shard`. Returns its handle within
+  // the shard and stores its pooled copy in `*text`.
+  static Handle InternInShard(Shard* shard, absl::string_view s, size_t hash,
+                              absl::string_view* text);
+
+  // Interns `strings` one shard at a time, calling
+  // `emit(i, shard_index, shard_pool, local_handle)` under the shard's lock
+  // for each `strings[i]`.
+  template <typename Emit>
+  void InternAllImpl(absl::Span<const absl::string_view> strings, Emit emit);
+
+  Shard shards_[kNumShards];
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_STRING_POOL_H_
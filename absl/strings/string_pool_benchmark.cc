@@ -0,0 +1,134 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_pool.h"
+
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/str_cat.h"
+
+namespace {
+
+constexpr int kOccurrences = 1 << 16;
+
+// Returns `kOccurrences` host names drawn from `distinct` different ones,
+// skewed so that a few are very common, as host names and label values
+// usually are.
+std::vector<std::string> MakeHostNames(int distinct) {
+  std::mt19937 rng(42);
+  std::geometric_distribution<int> skew(8.0 / distinct);
+  std::vector<std::string> names;
+  names.reserve(kOccurrences);
+  for (int i = 0; i < kOccurrences; ++i) {
+    names.push_back(absl::StrCat("server-", skew(rng) % distinct,
+                                 ".rack-17.cluster.example.com"));
+  }
+  return names;
+}
+
+// Compares the heap memory used to keep each occurrence as a `std::string`
+// with that of keeping a handle into a pool.
+void BM_MemorySavings(benchmark::State& state) {
+  const std::vector<std::string> names = MakeHostNames(state.range(0));
+  size_t string_bytes = 0;
+  for (const std::string& name : names) {
+    string_bytes += sizeof(std::string) + name.capacity() + 1;
+  }
+  size_t pool_bytes = 0;
+  for (auto _ : state) {
+    absl::StringPool pool;
+    std::vector<absl::StringPool::Handle> handles;
+    handles.reserve(names.size());
+    for (const std::string& name : names) {
+      handles.push_back(pool.InternHandle(name));
+    }
+    pool_bytes = pool.MemoryUsage() +
+                 handles.capacity() * sizeof(absl::StringPool::Handle);
+    benchmark::DoNotOptimize(handles.data());
+  }
+  state.counters["string_bytes"] = string_bytes;
+  state.counters["pool_bytes"] = pool_bytes;
+}
+BENCHMARK(BM_MemorySavings)->Arg(100)->Arg(10000);
+
+void BM_Intern(benchmark::State& state) {
+  const std::vector<std::string> names = MakeHostNames(state.range(0));
+  for (auto _ : state) {
+    absl::StringPool pool;
+    for (const std::string& name : names) {
+      benchmark::DoNotOptimize(pool.Intern(name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_Intern)->Arg(100)->Arg(10000)->Arg(kOccurrences);
+
+// The obvious alternative to a pool: an unordered_set of owned strings.
+void BM_InternUnorderedSet(benchmark::State& state) {
+  const std::vector<std::string> names = MakeHostNames(state.range(0));
+  for (auto _ : state) {
+    std::unordered_set<std::string> pool;
+    for (const std::string& name : names) {
+      benchmark::DoNotOptimize(*pool.insert(name).first);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_InternUnorderedSet)->Arg(100)->Arg(10000)->Arg(kOccurrences);
+
+void BM_InternAll(benchmark::State& state) {
+  const std::vector<std::string> names = MakeHostNames(state.range(0));
+  const std::vector<absl::string_view> input(names.begin(), names.end());
+  std::vector<absl::StringPool::Handle> handles(input.size());
+  for (auto _ : state) {
+    absl::StringPool pool;
+    pool.InternAll(input, absl::MakeSpan(handles));
+    benchmark::DoNotOptimize(handles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_InternAll)->Arg(100)->Arg(10000)->Arg(kOccurrences);
+
+// Threads interning the same names into a shared pool. After the first pass
+// nearly every call finds its string already there.
+void BM_ShardedIntern(benchmark::State& state) {
+  static absl::ShardedStringPool* pool = new absl::ShardedStringPool;
+  const std::vector<std::string> names = MakeHostNames(10000);
+  for (auto _ : state) {
+    for (const std::string& name : names) {
+      benchmark::DoNotOptimize(pool->Intern(name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_ShardedIntern)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_ShardedInternAll(benchmark::State& state) {
+  const std::vector<std::string> names = MakeHostNames(10000);
+  const std::vector<absl::string_view> input(names.begin(), names.end());
+  std::vector<absl::ShardedStringPool::Handle> handles(input.size());
+  for (auto _ : state) {
+    absl::ShardedStringPool pool;
+    pool.InternAll(input, absl::MakeSpan(handles));
+    benchmark::DoNotOptimize(handles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_ShardedInternAll);
+
+}  // namespace
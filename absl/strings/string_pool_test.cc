@@ -0,0 +1,160 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_pool.h"
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+
+namespace {
+
+TEST(StringPool, Intern) {
+  absl::StringPool pool;
+  EXPECT_EQ(0, pool.size());
+
+  std::string host = "example.com";
+  absl::string_view a = pool.Intern(host);
+  host.assign("overwritten");
+  absl::string_view b = pool.Intern("example.com");
+  EXPECT_EQ("example.com", a);
+  EXPECT_EQ(a.data(), b.data());
+  EXPECT_EQ(1, pool.size());
+  EXPECT_EQ(11, pool.bytes_used());
+
+  absl::string_view c = pool.Intern("example.org");
+  EXPECT_EQ("example.org", c);
+  EXPECT_NE(a.data(), c.data());
+  EXPECT_EQ(2, pool.size());
+  EXPECT_EQ(22, pool.bytes_used());
+
+  EXPECT_EQ("", pool.Intern(""));
+  EXPECT_EQ(3, pool.size());
+  EXPECT_EQ("", pool.Intern(absl::string_view()));
+  EXPECT_EQ(3, pool.size());
+}
+
+TEST(StringPool, Handles) {
+  absl::StringPool pool;
+  EXPECT_EQ(0, pool.InternHandle("a"));
+  EXPECT_EQ(1, pool.InternHandle("b"));
+  EXPECT_EQ(0, pool.InternHandle("a"));
+  EXPECT_EQ(2, pool.InternHandle(""));
+  EXPECT_EQ("a", pool.Get(0));
+  EXPECT_EQ("b", pool.Get(1));
+  EXPECT_EQ("", pool.Get(2));
+
+  EXPECT_EQ(absl::optional<absl::StringPool::Handle>(1), pool.Find("b"));
+  EXPECT_EQ(absl::nullopt, pool.Find("c"));
+  EXPECT_EQ(3, pool.size());
+}
+
+TEST(StringPool, ViewsStayValid) {
+  // Enough strings to fill several arena blocks and grow the index a few
+  // times, including ones large enough to get blocks of their own.
+  absl::StringPool pool;
+  std::vector<absl::string_view> views;
+  std::vector<std::string> strings;
+  for (int i = 0; i < 20000; ++i) {
+    strings.push_back(i % 1000 == 0 ? std::string(100000 + i, 'x')
+                                    : absl::StrCat("label-", i));
+    views.push_back(pool.Intern(strings.back()));
+  }
+  EXPECT_EQ(strings.size(), pool.size());
+  for (size_t i = 0; i < strings.size(); ++i) {
+    EXPECT_EQ(strings[i], views[i]);
+    EXPECT_EQ(views[i].data(), pool.Intern(strings[i]).data());
+    EXPECT_EQ(views[i].data(), pool.Get(i).data());
+  }
+  EXPECT_GE(pool.MemoryUsage(), pool.bytes_used());
+}
+
+TEST(StringPool, InternAll) {
+  std::vector<std::string> strings;
+  for (int i = 0; i < 100; ++i) strings.push_back(absl::StrCat("k", i % 37));
+  std::vector<absl::string_view> input(strings.begin(), strings.end());
+
+  absl::StringPool pool;
+  pool.Intern("k5");
+  std::vector<absl::StringPool::Handle> handles(input.size());
+  pool.InternAll(input, absl::MakeSpan(handles));
+  EXPECT_EQ(37, pool.size());
+  EXPECT_EQ(0, handles[5]);
+  std::vector<absl::string_view> views(input.size());
+  pool.InternAll(input, absl::MakeSpan(views));
+  EXPECT_EQ(37, pool.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(input[i], pool.Get(handles[i]));
+    EXPECT_EQ(pool.Get(handles[i]).data(), views[i].data());
+  }
+}
+
+TEST(ShardedStringPool, Basic) {
+  absl::ShardedStringPool pool;
+  absl::string_view a = pool.Intern("example.com");
+  EXPECT_EQ(a.data(), pool.Intern(std::string("example.com")).data());
+  absl::ShardedStringPool::Handle h = pool.InternHandle("example.com");
+  EXPECT_EQ(a.data(), pool.Get(h).data());
+  EXPECT_EQ(absl::optional<absl::ShardedStringPool::Handle>(h),
+            pool.Find("example.com"));
+  EXPECT_EQ(absl::nullopt, pool.Find("example.org"));
+  EXPECT_EQ(1, pool.size());
+  EXPECT_EQ(11, pool.bytes_used());
+
+  std::vector<std::string> strings;
+  for (int i = 0; i < 1000; ++i) strings.push_back(absl::StrCat("v", i % 300));
+  std::vector<absl::string_view> input(strings.begin(), strings.end());
+  std::vector<absl::ShardedStringPool::Handle> handles(input.size());
+  std::vector<absl::string_view> views(input.size());
+  pool.InternAll(input, absl::MakeSpan(handles));
+  pool.InternAll(input, absl::MakeSpan(views));
+  EXPECT_EQ(301, pool.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(input[i], pool.Get(handles[i]));
+    EXPECT_EQ(pool.Get(handles[i]).data(), views[i].data());
+    EXPECT_EQ(handles[i], pool.InternHandle(input[i]));
+  }
+}
+
+TEST(ShardedStringPool, Concurrent) {
+  constexpr int kThreads = 8;
+  constexpr int kStrings = 2000;
+  absl::ShardedStringPool pool;
+  std::vector<std::vector<absl::string_view>> results(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&pool, &results, t] {
+      for (int i = 0; i < kStrings; ++i) {
+        // Each thread walks the strings in a different order.
+        const int n = (i * (2 * t + 1)) % kStrings;
+        results[t].push_back(pool.Intern(absl::StrCat("name-", n)));
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  EXPECT_EQ(kStrings, pool.size());
+  for (int t = 0; t < kThreads; ++t) {
+    for (int i = 0; i < kStrings; ++i) {
+      const int n = (i * (2 * t + 1)) % kStrings;
+      EXPECT_EQ(absl::StrCat("name-", n), results[t][i]);
+      EXPECT_EQ(pool.Intern(results[t][i]).data(), results[t][i].data());
+    }
+  }
+}
+
+}  // namespace
@@ -21,7 +21,9 @@
 #include <cstring>
 #include <ostream>
 
+#include "absl/strings/internal/find_simd.h"
 #include "absl/strings/internal/memutil.h"
+#include "absl/strings/internal/simd.h"
 
 namespace absl {
 
@@ -54,6 +56,45 @@ class LookupTable {
   bool table_[UCHAR_MAX + 1] = {};
 };
 
+// memmatch() for needles of at least two bytes. memchr() finds the places a
+// match could start quickly while the needle's first byte is rare in the
+// haystack, but each one that comes to nothing costs a call. After a few of
+// those, switch to the vectorized search, which also checks the needle's last
+// byte before comparing.
+constexpr int kMaxFalseStarts = 8;
+
+const char* FindSubstr(const char* haystack, size_t haylen, const char* needle,
+                       size_t neelen) {
+  if (haylen < neelen) return nullptr;
+  const char* const last_start = haystack + haylen - neelen;
+  for (int false_starts = 0; false_starts < kMaxFalseStarts; ++false_starts) {
+    const char* match = static_cast<const char*>(
+        memchr(haystack, needle[0], last_start - haystack + 1));
+    if (match == nullptr) return nullptr;
+    if (memcmp(match, needle, neelen) == 0) return match;
+    haystack = match + 1;
+    if (haystack > last_start) return nullptr;
+  }
+  haylen = last_start - haystack + neelen;
+  const size_t skipped = strings_internal::FindSubstrSimd(
+      strings_internal::BestSimdLevel(), haystack, haylen, needle, neelen);
+  return strings_internal::memmatch(haystack + skipped, haylen - skipped,
+                                    needle, neelen);
+}
+
+// The searches for bytes use the vectorized set searches from this length on;
+// below it, preparing those costs more than it saves. rfind() and
+// find_*_not_of() for a single byte, which have no library function to call,
+// use them with a set of one byte.
+constexpr size_t kMinVectorLength = 32;
+
+// The set of the single byte `c`.
+strings_internal::NibbleTables CharTables(char c) {
+  strings_internal::NibbleTables tables;
+  strings_internal::MakeNibbleTables(string_view(&c, 1), &tables);
+  return tables;
+}
+
 }  // namespace
 
 std::ostream& operator<<(std::ostream& o, string_view piece) {
@@ -84,7 +125,10 @@ string_view::size_type string_view::find(string_view s, size_type pos) const
     return npos;
   }
   const char* result =
-      strings_internal::memmatch(ptr_ + pos, length_ - pos, s.ptr_, s.length_);
+      s.length_ > 1
+          ? FindSubstr(ptr_ + pos, length_ - pos, s.ptr_, s.length_)
+          : strings_internal::memmatch(ptr_ + pos, length_ - pos, s.ptr_,
+                                       s.length_);
   return result ? result - ptr_ : npos;
 }
 
@@ -101,9 +145,16 @@ string_view::size_type string_view::rfind(string_view s, size_type pos) const
     noexcept {
   if (length_ < s.length_) return npos;
   if (s.empty()) return std::min(length_, pos);
-  const char* last = ptr_ + std::min(length_ - s.length_, pos) + s.length_;
-  const char* result = std::find_end(ptr_, last, s.ptr_, s.ptr_ + s.length_);
-  return result != last ? result - ptr_ : npos;
+  const size_type searched = std::min(length_ - s.length_, pos) + s.length_;
+  size_type i = strings_internal::RFindSubstrSimd(
+      strings_internal::BestSimdLevel(), ptr_, searched, s.ptr_, s.length_);
+  while (i > 0) {
+    --i;
+    if (ptr_[i] == s.ptr_[0] && memcmp(ptr_ + i, s.ptr_, s.length_) == 0) {
+      return i;
+    }
+  }
+  return npos;
 }
 
 // Search range is [0..pos] inclusive.  If pos == npos, search everything.
@@ -111,7 +162,13 @@ string_view::size_type string_view::rfind(char c, size_type pos) const
     noexcept {
   // Note: memrchr() is not available on Windows.
   if (empty()) return npos;
-  for (size_type i = std::min(pos, length_ - 1);; --i) {
+  const size_type searched = std::min(pos, length_ - 1) + 1;
+  if (searched >= kMinVectorLength) {
+    const size_type i =
+        strings_internal::FindLastOf(CharTables(c), ptr_, searched);
+    return i != searched ? i : npos;
+  }
+  for (size_type i = searched - 1;; --i) {
     if (ptr_[i] == c) {
       return i;
     }
@@ -128,6 +185,13 @@ string_view::size_type string_view::find_first_of(string_view s,
   }
   // Avoid the cost of LookupTable() for a single-character search.
   if (s.length_ == 1) return find_first_of(s.ptr_[0], pos);
+  strings_internal::NibbleTables tables;
+  if (pos < length_ && length_ - pos >= kMinVectorLength &&
+      strings_internal::MakeNibbleTables(s, &tables)) {
+    const size_type i =
+        pos + strings_internal::FindFirstOf(tables, ptr_ + pos, length_ - pos);
+    return i != length_ ? i : npos;
+  }
   LookupTable tbl(s);
   for (size_type i = pos; i < length_; ++i) {
     if (tbl[ptr_[i]]) {
@@ -143,6 +207,13 @@ string_view::size_type string_view::find_first_not_of(string_view s,
   if (empty()) return npos;
   // Avoid the cost of LookupTable() for a single-character search.
   if (s.length_ == 1) return find_first_not_of(s.ptr_[0], pos);
+  strings_internal::NibbleTables tables;
+  if (pos < length_ && length_ - pos >= kMinVectorLength &&
+      strings_internal::MakeNibbleTables(s, &tables)) {
+    const size_type i = pos + strings_internal::FindFirstNotOf(
+                                  tables, ptr_ + pos, length_ - pos);
+    return i != length_ ? i : npos;
+  }
   LookupTable tbl(s);
   for (size_type i = pos; i < length_; ++i) {
     if (!tbl[ptr_[i]]) {
@@ -156,6 +227,11 @@ string_view::size_type string_view::find_first_not_of(char c,
                                                       size_type pos) const
     noexcept {
   if (empty()) return npos;
+  if (pos < length_ && length_ - pos >= kMinVectorLength) {
+    const size_type i = pos + strings_internal::FindFirstNotOf(
+                                  CharTables(c), ptr_ + pos, length_ - pos);
+    return i != length_ ? i : npos;
+  }
   for (; pos < length_; ++pos) {
     if (ptr_[pos] != c) {
       return pos;
@@ -169,6 +245,13 @@ string_view::size_type string_view::find_last_of(string_view s,
   if (empty() || s.empty()) return npos;
   // Avoid the cost of LookupTable() for a single-character search.
   if (s.length_ == 1) return find_last_of(s.ptr_[0], pos);
+  const size_type searched = std::min(pos, length_ - 1) + 1;
+  strings_internal::NibbleTables tables;
+  if (searched >= kMinVectorLength &&
+      strings_internal::MakeNibbleTables(s, &tables)) {
+    const size_type i = strings_internal::FindLastOf(tables, ptr_, searched);
+    return i != searched ? i : npos;
+  }
   LookupTable tbl(s);
   for (size_type i = std::min(pos, length_ - 1);; --i) {
     if (tbl[ptr_[i]]) {
@@ -187,6 +270,12 @@ string_view::size_type string_view::find_last_not_of(string_view s,
   if (s.empty()) return i;
   // Avoid the cost of LookupTable() for a single-character search.
   if (s.length_ == 1) return find_last_not_of(s.ptr_[0], pos);
+  strings_internal::NibbleTables tables;
+  if (i + 1 >= kMinVectorLength &&
+      strings_internal::MakeNibbleTables(s, &tables)) {
+    const size_type j = strings_internal::FindLastNotOf(tables, ptr_, i + 1);
+    return j != i + 1 ? j : npos;
+  }
   LookupTable tbl(s);
   for (;; --i) {
     if (!tbl[ptr_[i]]) {
@@ -202,6 +291,11 @@ string_view::size_type string_view::find_last_not_of(char c,
     noexcept {
   if (empty()) return npos;
   size_type i = std::min(pos, length_ - 1);
+  if (i + 1 >= kMinVectorLength) {
+    const size_type j =
+        strings_internal::FindLastNotOf(CharTables(c), ptr_, i + 1);
+    return j != i + 1 ? j : npos;
+  }
   for (;; --i) {
     if (ptr_[i] != c) {
       return i;
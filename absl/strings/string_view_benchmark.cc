@@ -26,6 +26,7 @@
 #include "absl/base/attributes.h"
 #include "absl/base/internal/raw_logging.h"
 #include "absl/base/macros.h"
+#include "absl/strings/char_set.h"
 #include "absl/strings/str_cat.h"
 
 namespace {
@@ -183,6 +184,24 @@ void BM_find_string_view_len_two(benchmark::State& state) {
 }
 BENCHMARK(BM_find_string_view_len_two)->Range(1, 1 << 20);
 
+void BM_find_string_view_common_first_byte(benchmark::State& state) {
+  std::string haystack(state.range(0), '0');
+  absl::string_view s(haystack);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.find("0x"));  // not present; '0' everywhere
+  }
+}
+BENCHMARK(BM_find_string_view_common_first_byte)->Range(1, 1 << 20);
+
+void BM_rfind_string_view_len_two(benchmark::State& state) {
+  std::string haystack(state.range(0), '0');
+  absl::string_view s(haystack);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.rfind("xx"));  // not present; length 2
+  }
+}
+BENCHMARK(BM_rfind_string_view_len_two)->Range(1, 1 << 20);
+
 void BM_find_one_char(benchmark::State& state) {
   std::string haystack(state.range(0), '0');
   absl::string_view s(haystack);
@@ -201,6 +220,15 @@ void BM_rfind_one_char(benchmark::State& state) {
 }
 BENCHMARK(BM_rfind_one_char)->Range(1, 1 << 20);
 
+void BM_find_first_not_of_one_char(benchmark::State& state) {
+  std::string haystack(state.range(0), '0');
+  absl::string_view s(haystack);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.find_first_not_of('0'));  // not present
+  }
+}
+BENCHMARK(BM_find_first_not_of_one_char)->Range(1, 1 << 20);
+
 void BM_worst_case_find_first_of(benchmark::State& state, int haystack_len) {
   const int needle_len = state.range(0);
   std::string needle;
@@ -231,6 +259,40 @@ BENCHMARK(BM_find_first_of_short)->DenseRange(0, 4)->Arg(8)->Arg(16)->Arg(32);
 BENCHMARK(BM_find_first_of_medium)->DenseRange(0, 4)->Arg(8)->Arg(16)->Arg(32);
 BENCHMARK(BM_find_first_of_long)->DenseRange(0, 4)->Arg(8)->Arg(16)->Arg(32);
 
+void BM_worst_case_find_last_of(benchmark::State& state) {
+  std::string needle;
+  for (int i = 0; i < state.range(0); ++i) {
+    needle += 'a' + i;
+  }
+  std::string haystack(1000, '0');
+
+  absl::string_view s(haystack);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.find_last_of(needle));
+  }
+}
+BENCHMARK(BM_worst_case_find_last_of)->Arg(2)->Arg(4)->Arg(8)->Arg(32);
+
+// As BM_find_first_of_*, with the set prepared once.
+void BM_worst_case_char_set_find_first_of(benchmark::State& state) {
+  std::string needle;
+  for (int i = 0; i < state.range(1); ++i) {
+    needle += 'a' + i;
+  }
+  const absl::CharSet set(needle);
+  std::string haystack(state.range(0), '0');
+
+  absl::string_view s(haystack);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set.FindFirstOf(s));
+  }
+}
+BENCHMARK(BM_worst_case_char_set_find_first_of)
+    ->ArgPair(10, 8)
+    ->ArgPair(100, 8)
+    ->ArgPair(1000, 8)
+    ->ArgPair(1000, 32);
+
 struct EasyMap : public std::map<absl::string_view, uint64_t> {
   explicit EasyMap(size_t) {}
 };
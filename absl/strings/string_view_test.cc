@@ -19,6 +19,7 @@
 #include <iterator>
 #include <limits>
 #include <map>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -758,6 +759,48 @@ TEST(StringViewTest, FindConformance) {
   }
 }
 
+// Long enough strings for the vectorized searches to come into play, with
+// sets that they can and cannot represent.
+TEST(StringViewTest, FindConformanceLongStrings) {
+  std::mt19937 rng(1234);
+  const std::string alphabet("ab\0\xff\x80z\t!", 8);
+  auto random_string = [&](size_t max_length, size_t alphabet_size) {
+    std::uniform_int_distribution<size_t> length(0, max_length);
+    std::uniform_int_distribution<size_t> index(0, alphabet_size - 1);
+    std::string s(length(rng), '\0');
+    for (char& c : s) c = alphabet[index(rng)];
+    return s;
+  };
+  for (int iter = 0; iter < 500; ++iter) {
+    // Mostly 'a', so that the needles' first and last bytes are common.
+    std::string st = random_string(150, iter % 2 == 0 ? 2 : alphabet.size());
+    std::string needle = random_string(5, iter % 3 == 0 ? 2 : alphabet.size());
+    if (iter % 5 == 0) {
+      // Bytes with more distinct high nibbles than the vectorized set
+      // searches support.
+      for (int c = 0; c < 256; c += 16) needle += static_cast<char>(c);
+    }
+    SCOPED_TRACE(st);
+    SCOPED_TRACE(needle);
+    absl::string_view sp = st;
+    for (size_t i = 0; i <= sp.size() + 1; ++i) {
+      size_t pos = (i == sp.size() + 1) ? absl::string_view::npos : i;
+      SCOPED_TRACE(pos);
+      ASSERT_EQ(sp.find(needle, pos), st.find(needle, pos));
+      ASSERT_EQ(sp.rfind(needle, pos), st.rfind(needle, pos));
+      ASSERT_EQ(sp.find_first_of(needle, pos), st.find_first_of(needle, pos));
+      ASSERT_EQ(sp.find_first_not_of(needle, pos),
+                st.find_first_not_of(needle, pos));
+      ASSERT_EQ(sp.find_last_of(needle, pos), st.find_last_of(needle, pos));
+      ASSERT_EQ(sp.find_last_not_of(needle, pos),
+                st.find_last_not_of(needle, pos));
+      ASSERT_EQ(sp.rfind('a', pos), st.rfind('a', pos));
+      ASSERT_EQ(sp.find_first_not_of('a', pos), st.find_first_not_of('a', pos));
+      ASSERT_EQ(sp.find_last_not_of('a', pos), st.find_last_not_of('a', pos));
+    }
+  }
+}
+
 TEST(StringViewTest, Remove) {
   absl::string_view a("foobar");
   std::string s1("123");
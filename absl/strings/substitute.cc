@@ -15,6 +15,7 @@
 #include "absl/strings/substitute.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "absl/base/internal/raw_logging.h"
 #include "absl/strings/ascii.h"
@@ -94,6 +95,54 @@ void SubstituteAndAppendArray(std::string* output, absl::string_view format,
   assert(target == output->data() + output->size());
 }
 
+void SubstituteAndAppendTemplate(
+    std::string* output, const SubstituteTemplate& format,
+    std::initializer_list<absl::string_view> args) {
+  if (!format.ok_) return;
+  if (args.size() < format.num_args_) {
+#ifndef NDEBUG
+    ABSL_RAW_LOG(
+        FATAL,
+        "Invalid strings::Substitute() format std::string: asked for \"$"
+        "%d\", but only %d args were given.  Full format std::string was: "
+        "\"%s\".",
+        static_cast<int>(format.num_args_ - 1), static_cast<int>(args.size()),
+        absl::CEscape(format.format_).c_str());
+#endif
+    return;
+  }
+
+  // The size of the result follows from the literal text and how many times
+  // each argument is used, without walking the segments.
+  const absl::string_view* args_array = args.begin();
+  size_t size = format.literals_.size();
+  for (size_t i = 0; i < format.num_args_; ++i) {
+    size += format.arg_uses_[i] * args_array[i].size();
+  }
+  if (size == 0) return;
+
+  size_t original_size = output->size();
+  strings_internal::STLStringResizeUninitialized(output, original_size + size);
+  char* target = &(*output)[original_size];
+  const char* literals = format.literals_.data();
+  size_t literal_begin = 0;
+  for (const SubstituteTemplate::Segment& segment : format.segments_) {
+    const size_t literal_size = segment.literal_end - literal_begin;
+    memcpy(target, literals + literal_begin, literal_size);
+    target += literal_size;
+    literal_begin = segment.literal_end;
+    if (segment.arg != SubstituteTemplate::kNoArg) {
+      const absl::string_view arg = args_array[segment.arg];
+      if (!arg.empty()) {
+        memcpy(target, arg.data(), arg.size());
+        target += arg.size();
+      }
+    }
+  }
+
+  assert(target == output->data() + output->size());
+}
+
 static const char kHexDigits[] = "0123456789abcdef";
 Arg::Arg(const void* value) {
   static_assert(sizeof(scratch_) >= sizeof(value) * 2 + 2,
@@ -167,4 +216,38 @@ Arg::Arg(Dec dec) {
 }
 
 }  // namespace substitute_internal
+
+constexpr int SubstituteTemplate::kNoArg;
+
+SubstituteTemplate::SubstituteTemplate(absl::string_view format)
+    : format_(format) {
+  literals_.reserve(format.size());
+  size_t i = 0;
+  while (i < format.size()) {
+    const size_t dollar = std::min(format.find('$', i), format.size());
+    literals_.append(format.data() + i, dollar - i);
+    if (dollar == format.size()) break;
+    if (dollar + 1 < format.size() && absl::ascii_isdigit(format[dollar + 1])) {
+      const int index = format[dollar + 1] - '0';
+      segments_.push_back(Segment{literals_.size(), index});
+      ++arg_uses_[index];
+      num_args_ = std::max(num_args_, static_cast<size_t>(index) + 1);
+    } else if (dollar + 1 < format.size() && format[dollar + 1] == '$') {
+      literals_.push_back('$');
+    } else {
+#ifndef NDEBUG
+      ABSL_RAW_LOG(
+          FATAL, "Invalid strings::Substitute() format std::string: \"%s\".",
+          absl::CEscape(format).c_str());
+#endif
+      ok_ = false;
+      literals_.clear();
+      segments_.clear();
+      return;
+    }
+    i = dollar + 2;
+  }
+  segments_.push_back(Segment{literals_.size(), kNoArg});
+}
+
 }  // namespace absl
@@ -70,7 +70,9 @@
 #ifndef ABSL_STRINGS_SUBSTITUTE_H_
 #define ABSL_STRINGS_SUBSTITUTE_H_
 
+#include <cstddef>
 #include <cstring>
+#include <initializer_list>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -86,6 +88,9 @@
 #include "absl/strings/strip.h"
 
 namespace absl {
+
+class SubstituteTemplate;
+
 namespace substitute_internal {
 
 // Arg
@@ -187,6 +192,11 @@ void SubstituteAndAppendArray(std::string* output, absl::string_view format,
                               const absl::string_view* args_array,
                               size_t num_args);
 
+// Like `SubstituteAndAppendArray()`, for a parsed format.
+void SubstituteAndAppendTemplate(std::string* output,
+                                 const SubstituteTemplate& format,
+                                 std::initializer_list<absl::string_view> args);
+
 #if defined(ABSL_BAD_CALL_IF)
 constexpr int CalculateOneBit(const char* format) {
   return (*format < '0' || *format > '9') ? 0 : (1 << (*format - '0'));
@@ -681,6 +691,82 @@ std::string Substitute(
                      "format std::string doesn't contain all of $0 through $9");
 #endif  // ABSL_BAD_CALL_IF
 
+// SubstituteTemplate
+//
+// A `Substitute()` format string parsed ahead of time, for formats that are
+// used over and over. Substituting into a template skips the parse, and sizes
+// the output from the precomputed length of the literal text and the lengths
+// of the arguments, so that it is filled in with a single allocation.
+//
+// Example:
+//
+//   static const absl::SubstituteTemplate* const kGreeting =
+//       new absl::SubstituteTemplate("Hello $0, you are visitor $1.");
+//   std::string s = absl::Substitute(*kGreeting, name, count);
+//
+// Formats are invalid in the same cases as for `Substitute()`, as is
+// substituting too few arguments. Substituting into an invalid template
+// produces nothing; in debug mode, such errors terminate the program.
+class SubstituteTemplate {
+ public:
+  explicit SubstituteTemplate(absl::string_view format);
+
+  // Returns false if the format string was invalid.
+  bool ok() const { return ok_; }
+
+  // Returns the number of arguments the template refers to, which is one more
+  // than its highest `$n`.
+  size_t num_args() const { return num_args_; }
+
+  // Returns the length of the literal text of the template, with each `$$`
+  // counting as one character.
+  size_t literal_size() const { return literals_.size(); }
+
+ private:
+  friend void substitute_internal::SubstituteAndAppendTemplate(
+      std::string* output, const SubstituteTemplate& format,
+      std::initializer_list<absl::string_view> args);
+
+  // The template is the literal text up to `literal_end`, starting where the
+  // previous segment's ended, followed by argument `arg`, if any.
+  struct Segment {
+    size_t literal_end;
+    int arg;
+  };
+
+  static constexpr int kNoArg = -1;
+
+  std::string format_;  // For error messages.
+  std::string literals_;
+  std::vector<Segment> segments_;
+  // How many times each argument appears.
+  size_t arg_uses_[10] = {};
+  size_t num_args_ = 0;
+  bool ok_ = true;
+};
+
+// Substitute()
+// SubstituteAndAppend()
+//
+// Substitutes arguments into a `SubstituteTemplate`.
+template <typename... Args>
+inline void SubstituteAndAppend(std::string* output,
+                                const SubstituteTemplate& format,
+                                const Args&... args) {
+  static_assert(sizeof...(Args) <= 10, "Substitute() takes at most 10 args");
+  substitute_internal::SubstituteAndAppendTemplate(
+      output, format,
+      {static_cast<const substitute_internal::Arg&>(args).piece()...});
+}
+
+template <typename... Args>
+ABSL_MUST_USE_RESULT inline std::string Substitute(
+    const SubstituteTemplate& format, const Args&... args) {
+  std::string result;
+  SubstituteAndAppend(&result, format, args...);
+  return result;
+}
+
 }  // namespace absl
 
 #endif  // ABSL_STRINGS_SUBSTITUTE_H_
@@ -0,0 +1,88 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/substitute.h"
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr char kShortFormat[] = "$0:$1";
+constexpr char kLogFormat[] =
+    "[$0] request $1 from $2 took $3 ms and returned status $4 ($5 bytes)";
+
+void BM_SubstituteShort(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::Substitute(absl::string_view(kShortFormat), "localhost", 8080));
+  }
+}
+BENCHMARK(BM_SubstituteShort);
+
+void BM_SubstituteTemplateShort(benchmark::State& state) {
+  const absl::SubstituteTemplate format(kShortFormat);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Substitute(format, "localhost", 8080));
+  }
+}
+BENCHMARK(BM_SubstituteTemplateShort);
+
+void BM_SubstituteLog(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Substitute(
+        absl::string_view(kLogFormat), "INFO", "/api/v1/users/12345",
+        "192.168.1.100", 42, 200, 123456));
+  }
+}
+BENCHMARK(BM_SubstituteLog);
+
+void BM_SubstituteTemplateLog(benchmark::State& state) {
+  const absl::SubstituteTemplate format(kLogFormat);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::Substitute(format, "INFO", "/api/v1/users/12345",
+                         "192.168.1.100", 42, 200, 123456));
+  }
+}
+BENCHMARK(BM_SubstituteTemplateLog);
+
+// Appending into a reused string isolates the cost of the substitution from
+// that of allocating the result.
+void BM_SubstituteAndAppendLog(benchmark::State& state) {
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    absl::SubstituteAndAppend(&out, absl::string_view(kLogFormat), "INFO",
+                              "/api/v1/users/12345", "192.168.1.100", 42, 200,
+                              123456);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_SubstituteAndAppendLog);
+
+void BM_SubstituteTemplateAndAppendLog(benchmark::State& state) {
+  const absl::SubstituteTemplate format(kLogFormat);
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    absl::SubstituteAndAppend(&out, format, "INFO", "/api/v1/users/12345",
+                              "192.168.1.100", 42, 200, 123456);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_SubstituteTemplateAndAppendLog);
+
+}  // namespace
@@ -184,6 +184,66 @@ TEST(SubstituteTest, VectorBoolRef) {
   EXPECT_EQ("Logic be like: true false true false", str);
 }
 
+TEST(SubstituteTest, Template) {
+  const absl::SubstituteTemplate greeting("$1 purchased $0 $2 for $$10. $1!");
+  EXPECT_TRUE(greeting.ok());
+  EXPECT_EQ(3, greeting.num_args());
+  EXPECT_EQ(std::string(" purchased   for $10. !").size(),
+            greeting.literal_size());
+  EXPECT_EQ("Bob purchased 5 Apples for $10. Bob!",
+            absl::Substitute(greeting, 5, "Bob", "Apples"));
+  EXPECT_EQ("Al purchased 10 Pears for $10. Al!",
+            absl::Substitute(greeting, 10, std::string("Al"), "Pears"));
+
+  // Extra arguments are ignored, as for Substitute().
+  EXPECT_EQ("Bob purchased 5 Apples for $10. Bob!",
+            absl::Substitute(greeting, 5, "Bob", "Apples", 'x'));
+
+  std::string str = "Receipt: ";
+  absl::SubstituteAndAppend(&str, greeting, 1.5, "Eve", "kg of flour");
+  EXPECT_EQ("Receipt: Eve purchased 1.5 kg of flour for $10. Eve!", str);
+
+  // All argument types.
+  const absl::SubstituteTemplate all("$0 $1 $2 $3 $4 $5 $6 $7 $8 $9");
+  int x = 0;
+  EXPECT_EQ(absl::StrCat("-1 2 0.5 true x beef NULL ",
+                         absl::Substitute("$0", &x), " 007 s"),
+            absl::Substitute(all, -1, 2u, 0.5, true, 'x', absl::Hex(0xbeef),
+                             static_cast<void*>(nullptr), &x,
+                             absl::Dec(7, absl::kZeroPad3), std::string("s")));
+
+  std::vector<bool> v = {true, false};
+  EXPECT_EQ("true false",
+            absl::Substitute(absl::SubstituteTemplate("$0 $1"), v[0], v[1]));
+}
+
+TEST(SubstituteTest, TemplateEdgeCases) {
+  const absl::SubstituteTemplate empty("");
+  EXPECT_TRUE(empty.ok());
+  EXPECT_EQ(0, empty.num_args());
+  EXPECT_EQ("", absl::Substitute(empty));
+
+  const absl::SubstituteTemplate literal("no args $$");
+  EXPECT_EQ(0, literal.num_args());
+  EXPECT_EQ("no args $", absl::Substitute(literal));
+
+  const absl::SubstituteTemplate only_args("$0$0$1");
+  EXPECT_EQ(0, only_args.literal_size());
+  EXPECT_EQ("aab", absl::Substitute(only_args, "a", "b"));
+  EXPECT_EQ("", absl::Substitute(only_args, "", ""));
+
+  std::string str = "unchanged";
+  absl::SubstituteAndAppend(&str, only_args, "", "");
+  EXPECT_EQ("unchanged", str);
+
+#ifdef NDEBUG
+  const absl::SubstituteTemplate invalid("-$z-");
+  EXPECT_FALSE(invalid.ok());
+  EXPECT_EQ("", absl::Substitute(invalid, "a"));
+  EXPECT_EQ("", absl::Substitute(only_args, "a"));
+#endif
+}
+
 #ifdef GTEST_HAS_DEATH_TEST
 
 TEST(SubstituteDeathTest, SubstituteDeath) {
@@ -199,6 +259,20 @@ TEST(SubstituteDeathTest, SubstituteDeath) {
       "Invalid strings::Substitute\\(\\) format std::string: \"-\\$\"");
 }
 
+TEST(SubstituteDeathTest, TemplateDeath) {
+  const absl::SubstituteTemplate two_args("-$1");
+  EXPECT_DEBUG_DEATH(
+      static_cast<void>(absl::Substitute(two_args, "a")),
+      "Invalid strings::Substitute\\(\\) format std::string: asked for \"\\$1\", "
+      "but only 1 args were given.");
+  EXPECT_DEBUG_DEATH(
+      absl::SubstituteTemplate("-$z-"),
+      "Invalid strings::Substitute\\(\\) format std::string: \"-\\$z-\"");
+  EXPECT_DEBUG_DEATH(
+      absl::SubstituteTemplate("-$"),
+      "Invalid strings::Substitute\\(\\) format std::string: \"-\\$\"");
+}
+
 #endif  // GTEST_HAS_DEATH_TEST
 
 }  // namespace
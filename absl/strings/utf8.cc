@@ -0,0 +1,410 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/utf8.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "absl/strings/internal/resize_uninitialized.h"
+#include "absl/strings/internal/utf8.h"
+#include "absl/strings/internal/utf8_simd.h"
+
+namespace absl {
+namespace {
+
+using strings_internal::BestSimdLevel;
+using strings_internal::SimdLevel;
+
+constexpr char32_t kReplacementChar = 0xfffd;
+
+// Returns the length of the sequence lead byte `c` starts, or 0 if it cannot
+// start one. Sets `*lo` and `*hi` to the range of the second byte, which is
+// narrower than that of continuation bytes after some lead bytes; the rest
+// are plain continuation bytes.
+inline size_t SequenceLength(unsigned char c, unsigned char* lo,
+                             unsigned char* hi) {
+  *lo = 0x80;
+  *hi = 0xbf;
+  if (c >= 0xc2 && c <= 0xdf) return 2;
+  if (c >= 0xe0 && c <= 0xef) {
+    if (c == 0xe0) *lo = 0xa0;       // Overlong.
+    else if (c == 0xed) *hi = 0x9f;  // Surrogate.
+    return 3;
+  }
+  if (c >= 0xf0 && c <= 0xf4) {
+    if (c == 0xf0) *lo = 0x90;       // Overlong.
+    else if (c == 0xf4) *hi = 0x8f;  // Above U+10FFFF.
+    return 4;
+  }
+  return 0;
+}
+
+// Returns the offset of the first byte at or after `pos` that does not start
+// a well-formed sequence, or `size` if there is none. `pos` must be on a
+// character boundary.
+size_t ScalarFindFirstInvalidUtf8(const unsigned char* s, size_t size,
+                                  size_t pos) {
+  while (pos < size) {
+    // Skip ASCII eight bytes at a time.
+    while (size - pos >= 8) {
+      uint64_t word;
+      std::memcpy(&word, s + pos, sizeof(word));
+      if ((word & 0x8080808080808080) != 0) break;
+      pos += 8;
+    }
+    if (pos == size) break;
+
+    if (s[pos] < 0x80) {
+      ++pos;
+      continue;
+    }
+    unsigned char lo, hi;
+    const size_t len = SequenceLength(s[pos], &lo, &hi);
+    if (len == 0 || size - pos < len || s[pos + 1] < lo || s[pos + 1] > hi) {
+      return pos;
+    }
+    for (size_t i = 2; i < len; ++i) {
+      if ((s[pos + i] & 0xc0) != 0x80) return pos;
+    }
+    pos += len;
+  }
+  return size;
+}
+
+// Returns the length of the maximal ill-formed subsequence at the front of
+// `s`, which must not start with a well-formed sequence.
+size_t MaximalSubpartLength(const unsigned char* s, size_t size) {
+  unsigned char lo, hi;
+  const size_t len = SequenceLength(s[0], &lo, &hi);
+  if (len == 0 || size < 2 || s[1] < lo || s[1] > hi) return 1;
+  size_t i = 2;
+  while (i < len && i < size && (s[i] & 0xc0) == 0x80) ++i;
+  return i;
+}
+
+// Returns the length of the longest well-formed prefix of `s`.
+inline size_t ValidPrefixLength(absl::string_view s) {
+  const size_t pos = FindFirstInvalidUtf8(s);
+  return pos == absl::string_view::npos ? s.size() : pos;
+}
+
+size_t CountFourByteLeads(absl::string_view s) {
+  size_t count = 0;
+  size_t i = strings_internal::CountUtf8FourByteLeadsSimd(
+      BestSimdLevel(), s.data(), s.size(), &count);
+  for (; i < s.size(); ++i) {
+    count += static_cast<unsigned char>(s[i]) >= 0xf0;
+  }
+  return count;
+}
+
+inline size_t Utf8ToUtfNSimd(SimdLevel level, const char* src, size_t szsrc,
+                             char16_t* dest, size_t szdest, size_t* written) {
+  return strings_internal::Utf8ToUtf16Simd(level, src, szsrc, dest, szdest,
+                                           written);
+}
+
+inline size_t Utf8ToUtfNSimd(SimdLevel level, const char* src, size_t szsrc,
+                             char32_t* dest, size_t szdest, size_t* written) {
+  return strings_internal::Utf8ToUtf32Simd(level, src, szsrc, dest, szdest,
+                                           written);
+}
+
+// Writes `c` to `dest` in UTF-16 or UTF-32, and returns the number of code
+// units written.
+inline size_t EncodeUtfN(char32_t c, char16_t* dest) {
+  if (c < 0x10000) {
+    dest[0] = static_cast<char16_t>(c);
+    return 1;
+  }
+  c -= 0x10000;
+  dest[0] = static_cast<char16_t>(0xd800 + (c >> 10));
+  dest[1] = static_cast<char16_t>(0xdc00 + (c & 0x3ff));
+  return 2;
+}
+
+inline size_t EncodeUtfN(char32_t c, char32_t* dest) {
+  dest[0] = c;
+  return 1;
+}
+
+// Converts `src`, which must be well-formed UTF-8, to UTF-16 or UTF-32,
+// stopping at a character boundary if `dest` fills up. Sets `*read` to the
+// number of bytes converted and returns the number of code units written.
+template <typename CharT>
+size_t ConvertValidUtf8(absl::string_view src, CharT* dest, size_t szdest,
+                        size_t* read) {
+  const SimdLevel level = BestSimdLevel();
+  const unsigned char* s = reinterpret_cast<const unsigned char*>(src.data());
+  const size_t size = src.size();
+  size_t i = 0;
+  size_t w = 0;
+  // Where to next try the vector kernel. It stops at the first block that is
+  // not a uniform run, so after that it is only worth retrying a block later.
+  size_t next_simd = 0;
+  while (i < size) {
+    if (level != SimdLevel::kNone && i >= next_simd && size - i >= 16) {
+      size_t written;
+      const size_t n = Utf8ToUtfNSimd(level, src.data() + i, size - i,
+                                      dest + w, szdest - w, &written);
+      i += n;
+      w += written;
+      if (n == 0) next_simd = i + 16;
+      continue;
+    }
+    const unsigned char c = s[i];
+    char32_t cp;
+    size_t len;
+    if (c < 0x80) {
+      cp = c;
+      len = 1;
+    } else if (c < 0xe0) {
+      cp = ((c & 0x1f) << 6) | (s[i + 1] & 0x3f);
+      len = 2;
+    } else if (c < 0xf0) {
+      cp = ((c & 0x0f) << 12) | ((s[i + 1] & 0x3f) << 6) | (s[i + 2] & 0x3f);
+      len = 3;
+    } else {
+      cp = ((c & 0x07) << 18) | ((s[i + 1] & 0x3f) << 12) |
+           ((s[i + 2] & 0x3f) << 6) | (s[i + 3] & 0x3f);
+      len = 4;
+    }
+    const size_t units = (sizeof(CharT) == 2 && cp >= 0x10000) ? 2 : 1;
+    if (szdest - w < units) break;
+    w += EncodeUtfN(cp, dest + w);
+    i += len;
+  }
+  *read = i;
+  return w;
+}
+
+// Converts UTF-8 to UTF-16 or UTF-32 one well-formed run at a time, applying
+// `policy` to the ill-formed subsequences between runs.
+template <typename CharT>
+TranscodeResult TranscodeUtf8(absl::string_view src, CharT* dest,
+                              size_t szdest, TranscodeErrorPolicy policy) {
+  TranscodeResult result = {0, 0, false};
+  while (result.read < src.size()) {
+    absl::string_view rest = src.substr(result.read);
+    const size_t space = szdest - result.written;
+    // Every code unit takes at least a byte and at most four, so when `dest`
+    // is small only validate what could fit. A sequence cut short by the
+    // window looks ill-formed, but the valid part before it fills `dest`.
+    if (space < rest.size() / 4) rest = rest.substr(0, 4 * space + 4);
+    const size_t valid = ValidPrefixLength(rest);
+    size_t read;
+    result.written += ConvertValidUtf8(rest.substr(0, valid),
+                                       dest + result.written, space, &read);
+    result.read += read;
+    if (read < valid || result.read == src.size()) break;
+
+    if (policy == TranscodeErrorPolicy::kStop) {
+      result.malformed = true;
+      break;
+    }
+    if (policy == TranscodeErrorPolicy::kReplace) {
+      if (result.written == szdest) break;
+      dest[result.written++] = kReplacementChar;
+    }
+    result.malformed = true;
+    result.read += MaximalSubpartLength(
+        reinterpret_cast<const unsigned char*>(src.data()) + result.read,
+        src.size() - result.read);
+  }
+  return result;
+}
+
+// Returns the number of UTF-16 or UTF-32 code units converting `src` writes.
+template <typename CharT>
+size_t TranscodedLengthOfUtf8(absl::string_view src,
+                              TranscodeErrorPolicy policy) {
+  size_t length = 0;
+  size_t pos = 0;
+  while (pos < src.size()) {
+    const absl::string_view rest = src.substr(pos);
+    const absl::string_view valid = rest.substr(0, ValidPrefixLength(rest));
+    length += Utf8CharCount(valid);
+    // Characters beyond the BMP take a surrogate pair in UTF-16.
+    if (sizeof(CharT) == 2) length += CountFourByteLeads(valid);
+    pos += valid.size();
+    if (pos == src.size() || policy == TranscodeErrorPolicy::kStop) break;
+    if (policy == TranscodeErrorPolicy::kReplace) ++length;
+    pos += MaximalSubpartLength(
+        reinterpret_cast<const unsigned char*>(src.data()) + pos,
+        src.size() - pos);
+  }
+  return length;
+}
+
+inline bool IsSurrogate(char16_t u) { return (u & 0xf800) == 0xd800; }
+
+// Returns whether `src[i]` starts a surrogate pair.
+inline bool IsSurrogatePair(absl::Span<const char16_t> src, size_t i) {
+  return src[i] <= 0xdbff && src.size() - i >= 2 && src[i + 1] >= 0xdc00 &&
+         src[i + 1] <= 0xdfff;
+}
+
+inline char32_t DecodeSurrogatePair(char16_t high, char16_t low) {
+  return 0x10000 + ((static_cast<char32_t>(high) - 0xd800) << 10) +
+         (static_cast<char32_t>(low) - 0xdc00);
+}
+
+}  // namespace
+
+size_t FindFirstInvalidUtf8(absl::string_view s) {
+  const size_t valid = strings_internal::Utf8ValidPrefixSimd(
+      BestSimdLevel(), s.data(), s.size());
+  const size_t pos = ScalarFindFirstInvalidUtf8(
+      reinterpret_cast<const unsigned char*>(s.data()), s.size(), valid);
+  return pos == s.size() ? absl::string_view::npos : pos;
+}
+
+bool IsValidUtf8(absl::string_view s) {
+  return FindFirstInvalidUtf8(s) == absl::string_view::npos;
+}
+
+size_t Utf8CharCount(absl::string_view s) {
+  size_t count = 0;
+  size_t i = strings_internal::CountUtf8LeadBytesSimd(BestSimdLevel(),
+                                                      s.data(), s.size(),
+                                                      &count);
+  for (; i < s.size(); ++i) {
+    count += (static_cast<unsigned char>(s[i]) & 0xc0) != 0x80;
+  }
+  return count;
+}
+
+size_t Utf8ToUtf16Length(absl::string_view src, TranscodeErrorPolicy policy) {
+  return TranscodedLengthOfUtf8<char16_t>(src, policy);
+}
+
+size_t Utf8ToUtf32Length(absl::string_view src, TranscodeErrorPolicy policy) {
+  return TranscodedLengthOfUtf8<char32_t>(src, policy);
+}
+
+size_t Utf16ToUtf8Length(absl::Span<const char16_t> src,
+                         TranscodeErrorPolicy policy) {
+  const SimdLevel level = BestSimdLevel();
+  size_t length = 0;
+  size_t i = 0;
+  size_t next_simd = 0;
+  while (i < src.size()) {
+    if (level != SimdLevel::kNone && i >= next_simd && src.size() - i >= 8) {
+      const size_t n = strings_internal::Utf16ToUtf8LengthSimd(
+          level, src.data() + i, src.size() - i, &length);
+      i += n;
+      if (n == 0) next_simd = i + 8;
+      continue;
+    }
+    const char16_t u = src[i];
+    if (!IsSurrogate(u)) {
+      length += 1 + (u >= 0x80) + (u >= 0x800);
+    } else if (IsSurrogatePair(src, i)) {
+      length += 4;
+      ++i;
+    } else if (policy == TranscodeErrorPolicy::kReplace) {
+      length += 3;
+    } else if (policy == TranscodeErrorPolicy::kStop) {
+      break;
+    }
+    ++i;
+  }
+  return length;
+}
+
+TranscodeResult Utf8ToUtf16(absl::string_view src, absl::Span<char16_t> dest,
+                            TranscodeErrorPolicy policy) {
+  return TranscodeUtf8(src, dest.data(), dest.size(), policy);
+}
+
+TranscodeResult Utf8ToUtf32(absl::string_view src, absl::Span<char32_t> dest,
+                            TranscodeErrorPolicy policy) {
+  return TranscodeUtf8(src, dest.data(), dest.size(), policy);
+}
+
+TranscodeResult Utf16ToUtf8(absl::Span<const char16_t> src,
+                            absl::Span<char> dest,
+                            TranscodeErrorPolicy policy) {
+  const SimdLevel level = BestSimdLevel();
+  TranscodeResult result = {0, 0, false};
+  size_t& i = result.read;
+  size_t& w = result.written;
+  size_t next_simd = 0;
+  while (i < src.size()) {
+    if (level != SimdLevel::kNone && i >= next_simd && src.size() - i >= 8) {
+      size_t written;
+      const size_t n = strings_internal::Utf16ToUtf8Simd(
+          level, src.data() + i, src.size() - i, dest.data() + w,
+          dest.size() - w, &written);
+      i += n;
+      w += written;
+      if (n == 0) next_simd = i + 8;
+      continue;
+    }
+    char32_t cp = src[i];
+    size_t units = 1;
+    bool malformed = false;
+    if (IsSurrogate(src[i])) {
+      if (IsSurrogatePair(src, i)) {
+        cp = DecodeSurrogatePair(src[i], src[i + 1]);
+        units = 2;
+      } else if (policy == TranscodeErrorPolicy::kReplace) {
+        cp = kReplacementChar;
+        malformed = true;
+      } else {
+        result.malformed = true;
+        if (policy == TranscodeErrorPolicy::kStop) break;
+        ++i;
+        continue;
+      }
+    }
+    const size_t len = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+    if (dest.size() - w < len) break;
+    strings_internal::EncodeUTF8Char(dest.data() + w, cp);
+    result.malformed |= malformed;
+    i += units;
+    w += len;
+  }
+  return result;
+}
+
+std::u16string Utf8ToUtf16(absl::string_view src,
+                           TranscodeErrorPolicy policy) {
+  std::u16string result;
+  strings_internal::STLStringResizeUninitialized(
+      &result, Utf8ToUtf16Length(src, policy));
+  Utf8ToUtf16(src, absl::MakeSpan(&result[0], result.size()), policy);
+  return result;
+}
+
+std::u32string Utf8ToUtf32(absl::string_view src,
+                           TranscodeErrorPolicy policy) {
+  std::u32string result;
+  strings_internal::STLStringResizeUninitialized(
+      &result, Utf8ToUtf32Length(src, policy));
+  Utf8ToUtf32(src, absl::MakeSpan(&result[0], result.size()), policy);
+  return result;
+}
+
+std::string Utf16ToUtf8(absl::Span<const char16_t> src,
+                        TranscodeErrorPolicy policy) {
+  std::string result;
+  strings_internal::STLStringResizeUninitialized(
+      &result, Utf16ToUtf8Length(src, policy));
+  Utf16ToUtf8(src, absl::MakeSpan(&result[0], result.size()), policy);
+  return result;
+}
+
+}  // namespace absl
@@ -0,0 +1,164 @@
+//
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: utf8.h
+// -----------------------------------------------------------------------------
+//
+// This file contains functions for checking and measuring UTF-8 text, and
+// for converting it to and from UTF-16 and UTF-32.
+//
+// Well-formed UTF-8 follows RFC 3629: every code point is encoded in the
+// shortest possible sequence (no "overlong" encodings), and there are no
+// encoded surrogates (U+D800 through U+DFFF), no code points above U+10FFFF,
+// and no sequences cut short or stray continuation bytes. Large inputs are
+// checked many bytes at a time where the CPU supports it, and runs of ASCII
+// are skipped quickly.
+//
+// Example:
+//
+//   size_t pos = absl::FindFirstInvalidUtf8(field);
+//   if (pos != absl::string_view::npos) {
+//     *error = absl::StrCat("invalid UTF-8 at offset ", pos);
+//     return false;
+//   }
+//
+// The conversions come in two forms: one returns a new string, and the other
+// writes into a caller-provided buffer, converting as much as fits, and
+// reports how far it got. The buffer for a whole conversion can be sized in
+// advance with the matching `*Length()` function:
+//
+//   std::vector<char16_t> buf(absl::Utf8ToUtf16Length(text));
+//   absl::Utf8ToUtf16(text, absl::MakeSpan(buf));
+
+#ifndef ABSL_STRINGS_UTF8_H_
+#define ABSL_STRINGS_UTF8_H_
+
+#include <cstddef>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace absl {
+
+// IsValidUtf8()
+//
+// Returns whether `s` is well-formed UTF-8.
+bool IsValidUtf8(absl::string_view s);
+
+// FindFirstInvalidUtf8()
+//
+// Returns the offset of the first byte of `s` that does not start a
+// well-formed UTF-8 sequence, or `absl::string_view::npos` if all of `s` is
+// well-formed. Everything before the returned offset is well-formed, so
+// `s.substr(0, absl::FindFirstInvalidUtf8(s))` is the longest valid prefix.
+size_t FindFirstInvalidUtf8(absl::string_view s);
+
+// Utf8CharCount()
+//
+// Returns the number of code points in `s`. If `s` is not well-formed UTF-8,
+// returns the number of bytes that are not continuation bytes (10xxxxxx).
+size_t Utf8CharCount(absl::string_view s);
+
+// TranscodeErrorPolicy
+//
+// Selects what the conversion functions below do with malformed input:
+// ill-formed UTF-8, or unpaired surrogates in UTF-16.
+enum class TranscodeErrorPolicy {
+  // Replace each maximal ill-formed subsequence (the longest prefix of a
+  // well-formed sequence, or else a single code unit) with U+FFFD, as
+  // recommended by the Unicode Standard.
+  kReplace,
+  // Stop at the first malformed input.
+  kStop,
+  // Drop malformed input.
+  kSkip,
+};
+
+// TranscodeResult
+//
+// Reports the progress of a conversion into a caller-provided buffer.
+struct TranscodeResult {
+  // Number of code units of the input converted. Less than the input length
+  // if the buffer filled up or, under `kStop`, at malformed input.
+  size_t read;
+  // Number of code units written to the buffer.
+  size_t written;
+  // Whether any malformed input was found: replaced, skipped, or, under
+  // `kStop`, stopped at.
+  bool malformed;
+};
+
+// Utf8ToUtf16Length()
+// Utf8ToUtf32Length()
+// Utf16ToUtf8Length()
+//
+// Return the number of code units the matching conversion of all of `src`
+// writes.
+size_t Utf8ToUtf16Length(
+    absl::string_view src,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+size_t Utf8ToUtf32Length(
+    absl::string_view src,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+size_t Utf16ToUtf8Length(
+    absl::Span<const char16_t> src,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+
+// Utf8ToUtf16()
+// Utf8ToUtf32()
+// Utf16ToUtf8()
+//
+// Convert `src` between UTF-8, UTF-16 and UTF-32, treating malformed input
+// according to `policy`. Under `kStop`, the result is the conversion of the
+// well-formed part before the first error.
+//
+// Note that a UTF-16 string literal converts to a `Span` that includes its
+// terminating NUL; pass `std::u16string(u"...")` instead.
+std::u16string Utf8ToUtf16(
+    absl::string_view src,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+std::u32string Utf8ToUtf32(
+    absl::string_view src,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+std::string Utf16ToUtf8(
+    absl::Span<const char16_t> src,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+
+// Utf8ToUtf16()
+// Utf8ToUtf32()
+// Utf16ToUtf8()
+//
+// Convert as much of `src` as fits in `dest`, stopping at a character
+// boundary, without allocating. Converting in a loop, resuming from
+// `src.substr(result.read)`, gives the same output as a single conversion.
+//
+// Only the first `result.written` code units of `dest` hold the output. The
+// rest of `dest` may be overwritten as well, so it must not hold anything the
+// caller wants to keep.
+TranscodeResult Utf8ToUtf16(
+    absl::string_view src, absl::Span<char16_t> dest,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+TranscodeResult Utf8ToUtf32(
+    absl::string_view src, absl::Span<char32_t> dest,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+TranscodeResult Utf16ToUtf8(
+    absl::Span<const char16_t> src, absl::Span<char> dest,
+    TranscodeErrorPolicy policy = TranscodeErrorPolicy::kReplace);
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_UTF8_H_
@@ -0,0 +1,134 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/utf8.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// Samples of text in different scripts, which exercise sequences of
+// different lengths.
+const char* const kAscii[] = {"The ", "quick ", "brown ", "fox ", "jumps.\n"};
+const char* const kLatin[] = {"caf\xc3\xa9 ", "na\xc3\xafve ", "se\xc3\xb1or ",
+                              "stra\xc3\x9f" "e ", "\xc3\xa5r.\n"};
+const char* const kCjk[] = {"\xe4\xb8\xad\xe6\x96\x87",
+                            "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e",
+                            "\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4",
+                            "\xe3\x80\x82", "\xe3\x81\x82"};
+const char* const kEmoji[] = {"\xf0\x9f\x98\x80", "\xf0\x9f\x8e\x89",
+                              "\xf0\x9f\x9a\x80", "\xf0\x9f\x91\x8d",
+                              "\xf0\x9f\x94\xa5"};
+
+enum Corpus { kAsciiText, kLatinText, kCjkText, kEmojiText };
+
+std::string MakeText(int corpus, size_t len) {
+  const char* const* words;
+  switch (corpus) {
+    case kAsciiText: words = kAscii; break;
+    case kLatinText: words = kLatin; break;
+    case kCjkText: words = kCjk; break;
+    default: words = kEmoji; break;
+  }
+  std::minstd_rand rng(len);
+  std::string s;
+  while (s.size() < len) s += words[rng() % 5];
+  return s;
+}
+
+void BM_IsValidUtf8(benchmark::State& state) {
+  const std::string s = MakeText(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::IsValidUtf8(s));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_IsValidUtf8)
+    ->ArgPair(kAsciiText, 64)
+    ->ArgPair(kAsciiText, 4096)
+    ->ArgPair(kAsciiText, 1 << 20)
+    ->ArgPair(kLatinText, 64)
+    ->ArgPair(kLatinText, 4096)
+    ->ArgPair(kLatinText, 1 << 20)
+    ->ArgPair(kCjkText, 64)
+    ->ArgPair(kCjkText, 4096)
+    ->ArgPair(kCjkText, 1 << 20)
+    ->ArgPair(kEmojiText, 64)
+    ->ArgPair(kEmojiText, 4096)
+    ->ArgPair(kEmojiText, 1 << 20);
+
+void BM_Utf8CharCount(benchmark::State& state) {
+  const std::string s = MakeText(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Utf8CharCount(s));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_Utf8CharCount)
+    ->ArgPair(kAsciiText, 4096)
+    ->ArgPair(kLatinText, 4096)
+    ->ArgPair(kCjkText, 4096)
+    ->ArgPair(kEmojiText, 4096);
+
+void BM_Utf8ToUtf16(benchmark::State& state) {
+  const std::string s = MakeText(state.range(0), 4096);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Utf8ToUtf16(s));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_Utf8ToUtf16)->DenseRange(kAsciiText, kEmojiText);
+
+void BM_Utf8ToUtf16_IntoBuffer(benchmark::State& state) {
+  const std::string s = MakeText(state.range(0), 4096);
+  std::vector<char16_t> buf(absl::Utf8ToUtf16Length(s));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Utf8ToUtf16(s, absl::MakeSpan(buf)));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_Utf8ToUtf16_IntoBuffer)->DenseRange(kAsciiText, kEmojiText);
+
+void BM_Utf8ToUtf16Length(benchmark::State& state) {
+  const std::string s = MakeText(state.range(0), 4096);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Utf8ToUtf16Length(s));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_Utf8ToUtf16Length)->DenseRange(kAsciiText, kEmojiText);
+
+void BM_Utf8ToUtf32(benchmark::State& state) {
+  const std::string s = MakeText(state.range(0), 4096);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Utf8ToUtf32(s));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_Utf8ToUtf32)->DenseRange(kAsciiText, kEmojiText);
+
+void BM_Utf16ToUtf8(benchmark::State& state) {
+  const std::u16string s = absl::Utf8ToUtf16(MakeText(state.range(0), 4096));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Utf16ToUtf8(s));
+  }
+  state.SetBytesProcessed(state.iterations() * s.size() * sizeof(char16_t));
+}
+BENCHMARK(BM_Utf16ToUtf8)->DenseRange(kAsciiText, kEmojiText);
+
+}  // namespace
@@ -0,0 +1,417 @@
+// Copyright 2019 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/utf8.h"
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/internal/utf8.h"
+
+namespace {
+
+// Decodes the code point starting at `s[pos]` the slow way, returning its
+// length, or 0 if it is not well-formed.
+size_t ReferenceDecode(const std::string& s, size_t pos) {
+  const unsigned char c = static_cast<unsigned char>(s[pos]);
+  size_t len;
+  char32_t cp;
+  if (c < 0x80) return 1;
+  if ((c & 0xe0) == 0xc0) {
+    len = 2;
+    cp = c & 0x1f;
+  } else if ((c & 0xf0) == 0xe0) {
+    len = 3;
+    cp = c & 0x0f;
+  } else if ((c & 0xf8) == 0xf0) {
+    len = 4;
+    cp = c & 0x07;
+  } else {
+    return 0;
+  }
+  if (s.size() - pos < len) return 0;
+  for (size_t i = 1; i < len; ++i) {
+    const unsigned char cc = static_cast<unsigned char>(s[pos + i]);
+    if ((cc & 0xc0) != 0x80) return 0;
+    cp = (cp << 6) | (cc & 0x3f);
+  }
+  static const char32_t kMin[] = {0, 0, 0x80, 0x800, 0x10000};
+  if (cp < kMin[len] || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) {
+    return 0;
+  }
+  return len;
+}
+
+size_t ReferenceFindFirstInvalidUtf8(const std::string& s) {
+  size_t pos = 0;
+  while (pos < s.size()) {
+    size_t len = ReferenceDecode(s, pos);
+    if (len == 0) return pos;
+    pos += len;
+  }
+  return std::string::npos;
+}
+
+// Returns `len` bytes of well-formed UTF-8, cut short if needed, drawing code
+// points of every length.
+std::string RandomUtf8(std::mt19937* gen, size_t len) {
+  std::uniform_int_distribution<int> pick_len(1, 4);
+  std::string s;
+  while (s.size() < len) {
+    char32_t cp;
+    switch (pick_len(*gen)) {
+      case 1:
+        cp = std::uniform_int_distribution<char32_t>(0, 0x7f)(*gen);
+        break;
+      case 2:
+        cp = std::uniform_int_distribution<char32_t>(0x80, 0x7ff)(*gen);
+        break;
+      case 3:
+        do {
+          cp = std::uniform_int_distribution<char32_t>(0x800, 0xffff)(*gen);
+        } while (cp >= 0xd800 && cp <= 0xdfff);
+        break;
+      default:
+        cp = std::uniform_int_distribution<char32_t>(0x10000, 0x10ffff)(*gen);
+        break;
+    }
+    char buf[4];
+    size_t n = absl::strings_internal::EncodeUTF8Char(buf, cp);
+    if (s.size() + n > len) break;
+    s.append(buf, n);
+  }
+  s.append(len - s.size(), 'a');
+  return s;
+}
+
+TEST(Utf8, Valid) {
+  const char* const kValid[] = {
+      "",
+      "hello",
+      "\xc2\x80",                  // U+0080
+      "\xdf\xbf",                  // U+07FF
+      "\xe0\xa0\x80",              // U+0800
+      "\xed\x9f\xbf",              // U+D7FF
+      "\xee\x80\x80",              // U+E000
+      "\xef\xbf\xbf",              // U+FFFF
+      "\xf0\x90\x80\x80",          // U+10000
+      "\xf4\x8f\xbf\xbf",          // U+10FFFF
+      "caf\xc3\xa9 \xe4\xb8\xad",  // "café 中"
+  };
+  for (const char* s : kValid) {
+    EXPECT_TRUE(absl::IsValidUtf8(s)) << s;
+    EXPECT_EQ(absl::FindFirstInvalidUtf8(s), absl::string_view::npos) << s;
+  }
+  EXPECT_TRUE(absl::IsValidUtf8(absl::string_view("a\0b", 3)));
+}
+
+TEST(Utf8, Invalid) {
+  const struct {
+    const char* s;
+    size_t pos;
+  } kCases[] = {
+      {"\x80", 0},                    // Stray continuation byte.
+      {"ab\xbf", 2},                  // Stray continuation byte.
+      {"\xc0\x80", 0},                // Overlong U+0000.
+      {"\xc1\xbf", 0},                // Overlong U+007F.
+      {"\xe0\x9f\xbf", 0},            // Overlong U+07FF.
+      {"\xf0\x8f\xbf\xbf", 0},        // Overlong U+FFFF.
+      {"\xed\xa0\x80", 0},            // Surrogate U+D800.
+      {"\xed\xbf\xbf", 0},            // Surrogate U+DFFF.
+      {"\xf4\x90\x80\x80", 0},        // U+110000.
+      {"\xf5\x80\x80\x80", 0},        // Lead byte out of range.
+      {"\xff", 0},                    // Never appears in UTF-8.
+      {"x\xc3", 1},                   // Truncated at end.
+      {"x\xe4\xb8", 1},               // Truncated at end.
+      {"x\xf0\x9f\x98", 1},           // Truncated at end.
+      {"\xe4\xb8x", 0},               // Truncated by ASCII.
+      {"\xc3\xa9\xc3\xc3\xa9", 2},    // Truncated by a lead byte.
+  };
+  for (const auto& c : kCases) {
+    EXPECT_FALSE(absl::IsValidUtf8(c.s)) << c.s;
+    EXPECT_EQ(absl::FindFirstInvalidUtf8(c.s), c.pos) << c.s;
+  }
+}
+
+TEST(Utf8, LongInputs) {
+  std::mt19937 gen(1);
+  for (size_t len : {15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+    std::string s = RandomUtf8(&gen, len);
+    ASSERT_TRUE(absl::IsValidUtf8(s));
+    for (size_t i = 0; i < len; ++i) {
+      for (unsigned char bad : {0x80, 0xbf, 0xc0, 0xe0, 0xed, 0xf4, 0xff}) {
+        std::string t = s;
+        t[i] = static_cast<char>(bad);
+        ASSERT_EQ(absl::FindFirstInvalidUtf8(t),
+                  ReferenceFindFirstInvalidUtf8(t))
+            << "len " << len << " position " << i << " byte " << int{bad};
+      }
+    }
+  }
+}
+
+TEST(Utf8, LongAsciiWithErrorAtEnd) {
+  for (size_t len = 1; len < 200; ++len) {
+    std::string s(len, 'a');
+    s.back() = '\x80';
+    EXPECT_EQ(absl::FindFirstInvalidUtf8(s), len - 1);
+    s.back() = '\xc3';
+    EXPECT_EQ(absl::FindFirstInvalidUtf8(s), len - 1);
+  }
+}
+
+TEST(Utf8CharCount, Basic) {
+  EXPECT_EQ(absl::Utf8CharCount(""), 0);
+  EXPECT_EQ(absl::Utf8CharCount("hello"), 5);
+  EXPECT_EQ(absl::Utf8CharCount("caf\xc3\xa9"), 4);
+  EXPECT_EQ(absl::Utf8CharCount("\xe4\xb8\xad\xe6\x96\x87"), 2);
+  EXPECT_EQ(absl::Utf8CharCount("\xf0\x9f\x98\x80!"), 2);
+  // Invalid input counts the bytes that are not continuation bytes.
+  EXPECT_EQ(absl::Utf8CharCount("\x80\x80\xc3"), 1);
+}
+
+TEST(Utf8CharCount, LongInputs) {
+  std::mt19937 gen(2);
+  for (size_t len = 0; len < 1100; len += 7) {
+    std::string s = RandomUtf8(&gen, len);
+    size_t expected = 0;
+    for (size_t pos = 0; pos < s.size(); pos += ReferenceDecode(s, pos)) {
+      ++expected;
+    }
+    EXPECT_EQ(absl::Utf8CharCount(s), expected) << len;
+  }
+  // Long enough to overflow a per-lane byte counter if it is never flushed.
+  EXPECT_EQ(absl::Utf8CharCount(std::string(100000, 'x')), 100000);
+}
+
+// Returns whether `s` is a proper prefix of the encoding of some code point.
+bool IsSequencePrefix(const std::string& s) {
+  static const std::set<std::string>* prefixes = [] {
+    auto* set = new std::set<std::string>;
+    for (char32_t c = 0x80; c <= 0x10ffff; ++c) {
+      if (c >= 0xd800 && c <= 0xdfff) continue;
+      char buf[4];
+      size_t n = absl::strings_internal::EncodeUTF8Char(buf, c);
+      for (size_t i = 1; i < n; ++i) set->insert(std::string(buf, i));
+    }
+    return set;
+  }();
+  return prefixes->count(s) != 0;
+}
+
+// Decodes `s` to code points, applying `policy` the slow way.
+std::u32string ReferenceDecodeAll(const std::string& s,
+                                  absl::TranscodeErrorPolicy policy) {
+  std::u32string out;
+  size_t pos = 0;
+  while (pos < s.size()) {
+    size_t len = ReferenceDecode(s, pos);
+    if (len != 0) {
+      char32_t c = static_cast<unsigned char>(s[pos]);
+      if (len > 1) {
+        c &= 0x7f >> len;
+        for (size_t i = 1; i < len; ++i) c = (c << 6) | (s[pos + i] & 0x3f);
+      }
+      out.push_back(c);
+      pos += len;
+      continue;
+    }
+    if (policy == absl::TranscodeErrorPolicy::kStop) break;
+    if (policy == absl::TranscodeErrorPolicy::kReplace) out.push_back(0xfffd);
+    size_t subpart = 1;
+    while (pos + subpart < s.size() &&
+           IsSequencePrefix(s.substr(pos, subpart + 1))) {
+      ++subpart;
+    }
+    pos += subpart;
+  }
+  return out;
+}
+
+std::u16string ToUtf16(const std::u32string& s) {
+  std::u16string out;
+  for (char32_t c : s) {
+    if (c < 0x10000) {
+      out.push_back(static_cast<char16_t>(c));
+    } else {
+      out.push_back(static_cast<char16_t>(0xd800 + ((c - 0x10000) >> 10)));
+      out.push_back(static_cast<char16_t>(0xdc00 + (c & 0x3ff)));
+    }
+  }
+  return out;
+}
+
+// Runs of characters of one length, and mixtures of them, so that the
+// vectorized paths for uniform blocks and the fallbacks between them are
+// exercised.
+std::string RandomUtf8Runs(std::mt19937* gen, size_t len) {
+  static const char32_t kFirst[] = {0x20, 0x400, 0x4e00, 0x1f600};
+  std::uniform_int_distribution<int> pick(0, 4);
+  std::string s;
+  while (s.size() < len) {
+    const int kind = pick(*gen);
+    const size_t run = std::uniform_int_distribution<size_t>(1, 40)(*gen);
+    for (size_t i = 0; i < run; ++i) {
+      char32_t c;
+      if (kind < 4) {
+        c = kFirst[kind] + (*gen)() % 64;
+      } else {
+        c = kFirst[(*gen)() % 4] + (*gen)() % 64;
+      }
+      char buf[4];
+      s.append(buf, absl::strings_internal::EncodeUTF8Char(buf, c));
+    }
+  }
+  return s;
+}
+
+const absl::TranscodeErrorPolicy kPolicies[] = {
+    absl::TranscodeErrorPolicy::kReplace, absl::TranscodeErrorPolicy::kStop,
+    absl::TranscodeErrorPolicy::kSkip};
+
+TEST(Utf8ToUtf16, Basic) {
+  EXPECT_EQ(absl::Utf8ToUtf16(""), u"");
+  EXPECT_EQ(absl::Utf8ToUtf16("abc"), u"abc");
+  EXPECT_EQ(absl::Utf8ToUtf16("caf\xc3\xa9"), u"café");
+  EXPECT_EQ(absl::Utf8ToUtf16("\xe4\xb8\xad"), u"中");
+  EXPECT_EQ(absl::Utf8ToUtf16("\xf0\x9f\x98\x80"), u"\U0001f600");
+  EXPECT_EQ(absl::Utf8ToUtf32("a\xf0\x9f\x98\x80"), U"a\U0001f600");
+  EXPECT_EQ(absl::Utf16ToUtf8(std::u16string(u"aé中\U0001f600")),
+            "a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80");
+}
+
+TEST(Utf8ToUtf16, ErrorPolicies) {
+  using absl::TranscodeErrorPolicy;
+  // Each maximal subpart becomes one U+FFFD.
+  EXPECT_EQ(absl::Utf8ToUtf16("a\xf0\x9f\x98z"), u"a�z");
+  EXPECT_EQ(absl::Utf8ToUtf16("\xc0\xaf"), u"��");
+  EXPECT_EQ(absl::Utf8ToUtf16("\xed\xa0\x80"), u"���");
+  EXPECT_EQ(absl::Utf8ToUtf16("x\xe4\xb8"), u"x�");
+  EXPECT_EQ(absl::Utf8ToUtf16("a\xf0\x9f\x98z", TranscodeErrorPolicy::kStop),
+            u"a");
+  EXPECT_EQ(absl::Utf8ToUtf16("a\xf0\x9f\x98z", TranscodeErrorPolicy::kSkip),
+            u"az");
+
+  const std::u16string unpaired = {u'a', 0xd800, u'b', 0xdc00};
+  EXPECT_EQ(absl::Utf16ToUtf8(unpaired), "a\xef\xbf\xbd" "b\xef\xbf\xbd");
+  EXPECT_EQ(absl::Utf16ToUtf8(unpaired, TranscodeErrorPolicy::kStop), "a");
+  EXPECT_EQ(absl::Utf16ToUtf8(unpaired, TranscodeErrorPolicy::kSkip), "ab");
+}
+
+TEST(Utf8ToUtf16, MatchesReference) {
+  std::mt19937 gen(3);
+  for (int iter = 0; iter < 300; ++iter) {
+    std::string s = RandomUtf8Runs(&gen, iter);
+    const int corruptions = iter % 3;
+    for (int i = 0; i < corruptions && !s.empty(); ++i) {
+      s[gen() % s.size()] = static_cast<char>(gen());
+    }
+    for (absl::TranscodeErrorPolicy policy : kPolicies) {
+      const std::u32string expected = ReferenceDecodeAll(s, policy);
+      const std::u16string expected16 = ToUtf16(expected);
+      EXPECT_EQ(absl::Utf8ToUtf32(s, policy), expected);
+      EXPECT_EQ(absl::Utf8ToUtf16(s, policy), expected16);
+      EXPECT_EQ(absl::Utf8ToUtf32Length(s, policy), expected.size());
+      EXPECT_EQ(absl::Utf8ToUtf16Length(s, policy), expected16.size());
+    }
+    // Well-formed input round trips through UTF-16.
+    const std::string valid = s.substr(0, absl::FindFirstInvalidUtf8(s));
+    const std::u16string utf16 = absl::Utf8ToUtf16(valid);
+    EXPECT_EQ(absl::Utf16ToUtf8Length(utf16), valid.size());
+    EXPECT_EQ(absl::Utf16ToUtf8(utf16), valid);
+  }
+}
+
+TEST(Utf8ToUtf16, IntoBuffer) {
+  std::mt19937 gen(4);
+  const std::string s = RandomUtf8Runs(&gen, 2000) + "\xe4\xb8" +
+                        RandomUtf8Runs(&gen, 100) + "\x80";
+  for (absl::TranscodeErrorPolicy policy : kPolicies) {
+    const std::u16string expected = absl::Utf8ToUtf16(s, policy);
+    // Two code units is the least that always makes progress, as characters
+    // beyond the BMP take a surrogate pair.
+    for (size_t size : {2, 3, 7, 40, 100, 5000}) {
+      std::vector<char16_t> buf(size);
+      std::u16string out;
+      absl::string_view rest = s;
+      bool malformed = false;
+      while (!rest.empty()) {
+        absl::TranscodeResult result =
+            absl::Utf8ToUtf16(rest, absl::MakeSpan(buf), policy);
+        ASSERT_LE(result.written, size);
+        out.append(buf.data(), result.written);
+        rest.remove_prefix(result.read);
+        malformed |= result.malformed;
+        if (result.malformed && policy == absl::TranscodeErrorPolicy::kStop) {
+          break;
+        }
+        ASSERT_GT(result.read, 0);
+      }
+      EXPECT_EQ(out, expected) << size;
+      EXPECT_TRUE(malformed) << size;
+    }
+  }
+}
+
+TEST(Utf16ToUtf8, MatchesReference) {
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> unit(0, 0xffff);
+  for (int iter = 0; iter < 300; ++iter) {
+    const std::string valid = RandomUtf8Runs(&gen, iter);
+    std::u16string s = absl::Utf8ToUtf16(valid);
+    ASSERT_EQ(absl::Utf16ToUtf8(s), valid);
+    // Corrupt it with stray surrogates.
+    const int corruptions = iter % 3;
+    for (int i = 0; i < corruptions && !s.empty(); ++i) {
+      s[gen() % s.size()] = static_cast<char16_t>(0xd800 + gen() % 0x800);
+    }
+    for (absl::TranscodeErrorPolicy policy : kPolicies) {
+      std::string expected;
+      for (size_t i = 0; i < s.size(); ++i) {
+        char32_t c = s[i];
+        if (c >= 0xd800 && c <= 0xdbff && i + 1 < s.size() &&
+            s[i + 1] >= 0xdc00 && s[i + 1] <= 0xdfff) {
+          c = 0x10000 + ((c - 0xd800) << 10) + (s[++i] - 0xdc00);
+        } else if (c >= 0xd800 && c <= 0xdfff) {
+          if (policy == absl::TranscodeErrorPolicy::kStop) break;
+          if (policy == absl::TranscodeErrorPolicy::kSkip) continue;
+          c = 0xfffd;
+        }
+        char buf[4];
+        expected.append(buf, absl::strings_internal::EncodeUTF8Char(buf, c));
+      }
+      EXPECT_EQ(absl::Utf16ToUtf8(s, policy), expected);
+      EXPECT_EQ(absl::Utf16ToUtf8Length(s, policy), expected.size());
+
+      // Converting through a small buffer gives the same result.
+      char buf[37];
+      std::string out;
+      absl::Span<const char16_t> rest = s;
+      while (!rest.empty()) {
+        absl::TranscodeResult result =
+            absl::Utf16ToUtf8(rest, absl::MakeSpan(buf), policy);
+        out.append(buf, result.written);
+        rest.remove_prefix(result.read);
+        if (result.read == 0) break;
+      }
+      EXPECT_EQ(out, expected);
+    }
+  }
+}
+
+}  // namespace